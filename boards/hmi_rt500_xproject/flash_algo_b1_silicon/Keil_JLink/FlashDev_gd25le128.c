@@ -38,14 +38,14 @@ struct FlashDevice const FlashDevice = {
    EXTSPI,                     // Device Type
    0x08000000,                 // Device Start Address
    0x01000000,                 // Device Size is 16MB
-   256,                        // Programming Page Size
+   FLASH_PROGRAM_PAGE_SIZE,    // Programming Page Size, RAM buffer of ProgramPage
    0,                          // Reserved, must be 0
    0xFF,                       // Initial Content of Erased Memory
-   300,                        // Program Page Timeout 300 mSec
+   3000,                       // Program Page Timeout 3000 mSec
    3000,                       // Erase Sector Timeout 3000 mSec
 
 // Specify Size and Address of Sectors
-   0x1000, 0x0,                // sectors are 4 KB
-   SECTOR_END
+   {{0x1000, 0x0},             // sectors are 4 KB
+    {SECTOR_END}}
 };
 
@@ -10,12 +10,62 @@
 
 #include "FlashOS.H" // FlashOS Structures
 #include "flexspi_nor/flexspi_nor_flash.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
 
 #define FLEXSPI_NOR_INSTANCE 0
 #define SECTOR_SIZE          (32768)
 #define BASE_ADDRESS         (0x60000000)
 
-flexspi_nor_config_t config = {1};
+flexspi_nor_config_t config = {.memConfig = {.tag = 1}};
+
+/*
+ *  Config block cache
+ *
+ *  Init keeps the config block generated from SFDP in OCRAM outside of the algorithm and reuses it while the
+ *  JEDEC ID and SFDP headers of the device stay the same, which spares the SFDP probe of the following Init
+ *  calls. The application may overwrite that RAM between downloads, a cache whose CRC32 does not match is
+ *  discarded and the device probed again. Set CONFIG_CACHE_ADDRESS to 0 to probe the device on every Init.
+ */
+
+#ifndef CONFIG_CACHE_ADDRESS
+#define CONFIG_CACHE_ADDRESS (0x2023FC00) // Last 1KB of the default 256KB OCRAM
+#endif
+
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (config.sectorSize)
+#define DEVICE_PAGE_SIZE   (config.pageSize)
+
+/*
+ *  Background programming
+ *
+ *  With BACKGROUND_PROGRAM set, see flash_program/flash_program.h, the last device page of a ProgramPage call
+ *  is started with DevicePageProgramStart. Every function that accesses the device calls BackgroundComplete.
+ */
+
+#if BACKGROUND_PROGRAM
+static bool s_backgroundPending;     // A device page is being programmed in the background
+static uint32_t s_backgroundAddress; // Device address of that page
+#endif
+
+int BackgroundComplete(void)
+{
+#if BACKGROUND_PROGRAM
+    if (s_backgroundPending)
+    {
+        s_backgroundPending = false;
+        return (flexspi_nor_flash_page_program_complete(FLEXSPI_NOR_INSTANCE, &config, s_backgroundAddress) !=
+                kStatus_Success);
+    }
+#endif
+    return (0);
+}
+
+int DeviceSectorErase(unsigned long adr, unsigned long sz)
+{
+    status_t status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr - BASE_ADDRESS, sz);
+    return (status != kStatus_Success);
+}
 
 /*
  *  Initialize Flash Programming Functions
@@ -27,6 +77,13 @@ flexspi_nor_config_t config = {1};
 
 int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 {
+#if INCREMENTAL_PROGRAM
+    IncrementalReset(fnc);
+#endif
+#if BACKGROUND_PROGRAM
+    s_backgroundPending = false;
+#endif
+
     status_t status;
     serial_nor_config_option_t option;
     option.option0.U = 0xc0000003;
@@ -47,7 +104,8 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
     RTWDOG->CNT   = 0xD928C520U; /* 0xD928C520U is the update key */
     RTWDOG->TOVAL = 0xFFFF;
     RTWDOG->CS    = (uint32_t)((RTWDOG->CS) & ~RTWDOG_CS_EN_MASK) | RTWDOG_CS_UPDATE_MASK;
-    status        = flexspi_nor_get_config(FLEXSPI_NOR_INSTANCE, &config, &option);
+    status        = flexspi_nor_get_config_cached(FLEXSPI_NOR_INSTANCE, &config, &option,
+                                                  (flexspi_nor_config_cache_t *)CONFIG_CACHE_ADDRESS);
     if (status != kStatus_Success)
     {
         return (1);
@@ -71,7 +129,16 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 
 int UnInit(unsigned long fnc)
 {
-    /* Add your Code */
+    if (BackgroundComplete())
+    {
+        return (1);
+    }
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFlush(fnc))
+    {
+        return (1);
+    }
+#endif
     return (0); // Finished without Errors
 }
 
@@ -83,6 +150,10 @@ int UnInit(unsigned long fnc)
 int EraseChip(void)
 {
     status_t status;
+    if (BackgroundComplete())
+    {
+        return (1);
+    }
     status = flexspi_nor_flash_erase_all(FLEXSPI_NOR_INSTANCE, &config); // Erase all
     if (status != kStatus_Success)
     {
@@ -102,28 +173,75 @@ int EraseChip(void)
 
 int EraseSector(unsigned long adr)
 {
-    status_t status;
-    adr    = adr - BASE_ADDRESS;
-    status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr, SECTOR_SIZE); // Erase 1 sector
-    if (status != kStatus_Success)
+    unsigned long size = DEVICE_SECTOR_SIZE;
+    unsigned long end  = adr + SECTOR_SIZE;
+
+    if (BackgroundComplete())
     {
         return (1);
     }
-    else
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFinish())
     {
-        return (0);
+        return (1);
+    }
+#endif
+#if INCREMENTAL_PROGRAM
+    // Erase device sector by device sector, skipping the blank ones and deferring the others
+    for (; adr < end; adr += size)
+    {
+        if (!BlankCheck(adr, size, 0xFF))
+        {
+            g_incrementalStats.eraseHits++;
+            continue;
+        }
+        if (IncrementalDefer(adr, size))
+        {
+            continue;
+        }
+        g_incrementalStats.eraseMisses++;
+        if (DeviceSectorErase(adr, size))
+        {
+            return (1);
+        }
+    }
+#else
+    // One erase for the whole sector, so the driver can use its block erase commands
+    g_incrementalStats.eraseMisses += SECTOR_SIZE / size;
+    if (DeviceSectorErase(adr, SECTOR_SIZE))
+    {
+        return (1);
     }
+#endif
+    return (0);
 }
 
 /*
  *  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
- *                    sz:   Page Size
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
  *                    buf:  Page Data
  *    Return Value:   0 - OK,  1 - Failed
  */
 
 int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    if (BackgroundComplete())
+    {
+        return (1);
+    }
+    return (FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE));
+}
+
+/*
+ *  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram(unsigned long adr, unsigned long sz, unsigned char *buf)
 {
     status_t status;
     adr = adr - BASE_ADDRESS;
@@ -138,3 +256,26 @@ int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
         return (0);
     }
 }
+
+#if BACKGROUND_PROGRAM
+/*
+ *  Program Page in Flash Memory in the background, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data, can be overwritten on return
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgramStart(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    status_t status;
+    (void)sz;
+
+    // Wait for the page even if sending it failed, the device may have accepted the command
+    s_backgroundAddress = adr - BASE_ADDRESS;
+    s_backgroundPending = true;
+
+    status = flexspi_nor_flash_page_program_start(FLEXSPI_NOR_INSTANCE, &config, s_backgroundAddress, (uint32_t *)buf);
+    return (status != kStatus_Success);
+}
+#endif
@@ -14,7 +14,7 @@
 extern struct FlashDevice const FlashDevice;
 
 volatile int ret;        // Return Code
-unsigned char buf[1024]; // Programming Buffer
+unsigned char buf[FLASH_PROGRAM_PAGE_SIZE]; // Programming Buffer, the Programming Page Size of FlashDev
 
 /*----------------------------------------------------------------------------
   Main Function
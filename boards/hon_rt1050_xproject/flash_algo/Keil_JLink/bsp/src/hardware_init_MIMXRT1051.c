@@ -5,6 +5,7 @@
  */
 
 #include "fsl_device_registers.h"
+#include "fsl_clock.h"
 #include "flexspi/fsl_flexspi.h"
 #include "flexspi_nor/flexspi_nor_flash.h"
 ////////////////////////////////////////////////////////////////////////////////
@@ -93,6 +94,7 @@ void flexspi_iomux_config(uint32_t instance, flexspi_mem_config_t *config)
     uint32_t sclkPadCtlValue = FLEXSPI_SW_PAD_CTL_VAL;
     uint32_t dataPadCtlValue = FLEXSPI_SW_PAD_CTL_VAL;
 
+    (void)instance;
     if (flexspi_is_padsetting_override_enable(config))
     {
         csPadCtlValue   = config->csPadSettingOverride;
@@ -10,16 +10,16 @@
 #include "FlashOS.H" // FlashOS Structures
 
 struct FlashDevice const FlashDevice = {FLASH_DRV_VERS,                     // Driver Version, do not modify!
-                                        "MIMXRT106x IS25LP256 FLEXSPI",     // Device Name
+                                        "MIMXRT106x QSPI FLEXSPI",          // Device Name
                                         EXTSPI,                             // Device Type
                                         0x60000000,                         // Device Start Address
-                                        0x02000000,                         // Device Size in Bytes (32mB)
-                                        256,                                // Programming Page Size
+                                        0x04000000,                         // Largest supported part (64mB)
+                                        FLASH_PROGRAM_PAGE_SIZE,            // Programming Page Size, RAM buffer of ProgramPage
                                         0,                                  // Reserved, must be 0
                                         0xFF,                               // Initial Content of Erased Memory
-                                        100,                                // Program Page Timeout 100 mSec
+                                        3000,                               // Program Page Timeout 3000 mSec
                                         5000,                               // Erase Sector Timeout 5000 mSec
 
                                         // Specify Size and Address of Sectors
-                                        0x8000, 0x00000000, // Sector Size  32kB (256 Sectors)
-                                        SECTOR_END};
+                                        {{0x1000, 0x00000000}, // Sector Size  4kB, the smallest of the parts
+                                         {SECTOR_END}}};
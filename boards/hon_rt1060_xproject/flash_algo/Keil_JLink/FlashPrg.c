@@ -0,0 +1,390 @@
+/***********************************************************************/
+/*  This file is part of the ARM Toolchain package                     */
+/*  Copyright (c) 2010 Keil - An ARM Company. All rights reserved.     */
+/***********************************************************************/
+/*                                                                     */
+/*  FlashDev.C:  Flash Programming Functions adapted                   */
+/*               for New Device 256kB Flash                            */
+/*                                                                     */
+/***********************************************************************/
+
+#include "FlashOS.H" // FlashOS Structures
+#include "bl_api.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
+
+#define FLEXSPI_NOR_INSTANCE 0
+#define SECTOR_SIZE (4096)
+#define BASE_ADDRESS (0x60000000)
+
+flexspi_nor_config_t config = {.memConfig = {.tag = 1}};
+
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (config.sectorSize)
+#define DEVICE_PAGE_SIZE   (config.pageSize)
+
+int DeviceSectorErase(unsigned long adr, unsigned long sz)
+{
+    status_t status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr - BASE_ADDRESS, sz);
+    return (status != kStatus_Success);
+}
+
+/*
+ *  Part table
+ *
+ *  Init reads the JEDEC ID of the flash, on the primary pinmux group and then on the secondary one, and
+ *  looks it up in a table sorted by ID for the option of the ROM probe of the part: its QE bit sequence
+ *  and the clock it was qualified at. The SFDP tables the ROM probe reads give the rest, 3 or 4-byte
+ *  addressing, page size, erase opcodes and sizes. A part that is not in the table is probed with SFDP
+ *  alone. The table is part of the algorithm image, so the lookup runs from RAM.
+ */
+
+#define PART_OPTION0(quadMode, maxFreq) (0xc0000000U | ((uint32_t)(quadMode) << 8) | (maxFreq))
+#define PART_OPTION0_DEFAULT PART_OPTION0(kSerialNorQuadMode_NotConfig, kFlexSpiSerialClk_100MHz)
+#define PART_OPTION0_SIZE_1 (0x01000000U)  // option1 follows option0
+#define PART_OPTION1_PINMUX_2 (0x00010000U) // Secondary pinmux group
+#define JEDEC_ID_NONE(id) (((id) == 0) || ((id) == 0xFFFFFFU))
+
+typedef struct _flash_part
+{
+    uint32_t jedecId; // Manufacturer ID, memory type and capacity of Read JEDEC ID
+    uint32_t option0; // Option of the ROM probe
+} flash_part_t;
+
+static const flash_part_t s_parts[] = {
+    {0x9D6017, PART_OPTION0(kSerialNorQuadMode_NotConfig, kFlexSpiSerialClk_100MHz)},          // IS25LP064
+    {0x9D6019, PART_OPTION0(kSerialNorQuadMode_NotConfig, kFlexSpiSerialClk_100MHz)},          // IS25LP256
+    {0x9D701A, PART_OPTION0(kSerialNorQuadMode_NotConfig, kFlexSpiSerialClk_100MHz)},          // IS25WP512
+    {0xC84017, PART_OPTION0(kSerialNorQuadMode_StatusReg2_Bit1_0x31, kFlexSpiSerialClk_80MHz)}, // GD25Q64
+    {0xEF4017, PART_OPTION0(kSerialNorQuadMode_StatusReg2_Bit1_0x31, kFlexSpiSerialClk_80MHz)}, // W25Q64
+    {0xEF4019, PART_OPTION0(kSerialNorQuadMode_NotConfig, kFlexSpiSerialClk_100MHz)},          // W25Q256
+};
+
+uint32_t g_jedecId; // JEDEC ID read by the last Init
+
+static const flash_part_t *FindPart(uint32_t jedecId)
+{
+    uint32_t low  = 0;
+    uint32_t high = sizeof(s_parts) / sizeof(s_parts[0]);
+
+    while (low < high)
+    {
+        uint32_t middle = (low + high) / 2;
+        if (s_parts[middle].jedecId == jedecId)
+        {
+            return &s_parts[middle];
+        }
+        if (s_parts[middle].jedecId < jedecId)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return NULL;
+}
+
+// Read the JEDEC ID in SPI at 30MHz, with config holding a minimal config block for the pinmux group
+static status_t ReadJedecId(bool isSecondPinmux, uint32_t *jedecId)
+{
+    status_t status;
+    flexspi_xfer_t xfer;
+    uint32_t id = 0;
+
+    memset(&config, 0, sizeof(config));
+    config.memConfig.tag              = FLEXSPI_CFG_BLK_TAG;
+    config.memConfig.version          = FLEXSPI_CFG_BLK_VERSION;
+    config.memConfig.readSampleClkSrc = kFlexSPIReadSampleClk_LoopbackInternally;
+    config.memConfig.dataHoldTime     = 3;
+    config.memConfig.dataSetupTime    = 3;
+    config.memConfig.deviceType       = kFlexSpiDeviceType_SerialNOR;
+    config.memConfig.sflashPadType    = kSerialFlash_1Pad;
+    config.memConfig.serialClkFreq    = kFlexSpiSerialClk_30MHz;
+    config.memConfig.sflashA1Size     = 0x1000000;
+    if (isSecondPinmux)
+    {
+        config.memConfig.controllerMiscOption = FLEXSPI_BITMASK(kFlexSpiMiscOffset_SecondPinMux);
+    }
+    config.memConfig.lookupTable[0] = FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, 0x9F, READ_SDR, FLEXSPI_1PAD, 0x03);
+
+    status = flexspi_nor_flash_init(FLEXSPI_NOR_INSTANCE, &config);
+    if (status == kStatus_Success)
+    {
+        xfer.operation            = kFlexSpiOperation_Read;
+        xfer.baseAddress          = 0;
+        xfer.seqId                = 0;
+        xfer.seqNum               = 1;
+        xfer.isParallelModeEnable = false;
+        xfer.rxBuffer             = &id;
+        xfer.rxSize               = 3;
+        status                    = flexspi_command_xfer(FLEXSPI_NOR_INSTANCE, &xfer);
+    }
+    // Manufacturer ID comes first
+    *jedecId = ((id & 0xFFU) << 16) | (id & 0xFF00U) | ((id >> 16) & 0xFFU);
+    return status;
+}
+
+// Select the option of the ROM probe for the flash that answers
+static status_t ProbePart(serial_nor_config_option_t *option)
+{
+    status_t status          = kStatus_Fail;
+    const flash_part_t *part = NULL;
+
+    for (uint32_t group = 0; group < 2; group++)
+    {
+        g_jedecId = 0;
+        if ((ReadJedecId(group != 0, &g_jedecId) != kStatus_Success) || JEDEC_ID_NONE(g_jedecId))
+        {
+            continue;
+        }
+        part              = FindPart(g_jedecId);
+        option->option0.U = part ? part->option0 : PART_OPTION0_DEFAULT;
+        option->option1.U = 0;
+        if (group != 0)
+        {
+            option->option0.U |= PART_OPTION0_SIZE_1;
+            option->option1.U = PART_OPTION1_PINMUX_2;
+        }
+        status = kStatus_Success;
+        break;
+    }
+    return status;
+}
+
+/*
+ *  Initialize Flash Programming Functions
+ *    Parameter:      adr:  Device Base Address
+ *                    clk:  Clock Frequency (Hz)
+ *                    fnc:  Function Code (1 - Erase, 2 - Program, 3 - Verify)
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
+{
+#if INCREMENTAL_PROGRAM
+    IncrementalReset(fnc);
+#endif
+
+    status_t status;
+    serial_nor_config_option_t option;
+    /* Disable Watchdog Power Down Counter */
+    WDOG1->WMCR &= ~WDOG_WMCR_PDE_MASK;
+    WDOG2->WMCR &= ~WDOG_WMCR_PDE_MASK;
+
+    /* Watchdog disable */
+
+    if (WDOG1->WCR & WDOG_WCR_WDE_MASK)
+    {
+        WDOG1->WCR &= ~WDOG_WCR_WDE_MASK;
+    }
+    if (WDOG2->WCR & WDOG_WCR_WDE_MASK)
+    {
+        WDOG2->WCR &= ~WDOG_WCR_WDE_MASK;
+    }
+    RTWDOG->CNT   = 0xD928C520U; /* 0xD928C520U is the update key */
+    RTWDOG->TOVAL = 0xFFFF;
+    RTWDOG->CS    = (uint32_t)((RTWDOG->CS) & ~RTWDOG_CS_EN_MASK) | RTWDOG_CS_UPDATE_MASK;
+
+    bl_api_init();
+    if (CCM_ANALOG->PLL_ARM & CCM_ANALOG_PLL_ARM_BYPASS_MASK)
+    {
+        // Configure ARM_PLL
+        CCM_ANALOG->PLL_ARM =
+            CCM_ANALOG_PLL_ARM_BYPASS(1) | CCM_ANALOG_PLL_ARM_ENABLE(1) | CCM_ANALOG_PLL_ARM_DIV_SELECT(24);
+        // Wait Until clock is locked
+        while ((CCM_ANALOG->PLL_ARM & CCM_ANALOG_PLL_ARM_LOCK_MASK) == 0)
+        {
+        }
+
+        // Configure PLL_SYS
+        CCM_ANALOG->PLL_SYS &= ~CCM_ANALOG_PLL_SYS_POWERDOWN_MASK;
+        // Wait Until clock is locked
+        while ((CCM_ANALOG->PLL_SYS & CCM_ANALOG_PLL_SYS_LOCK_MASK) == 0)
+        {
+        }
+
+        // Configure PFD_528
+        CCM_ANALOG->PFD_528 = CCM_ANALOG_PFD_528_PFD0_FRAC(24) | CCM_ANALOG_PFD_528_PFD1_FRAC(24) |
+                              CCM_ANALOG_PFD_528_PFD2_FRAC(19) | CCM_ANALOG_PFD_528_PFD3_FRAC(24);
+
+        // Configure USB1_PLL
+        CCM_ANALOG->PLL_USB1 =
+            CCM_ANALOG_PLL_USB1_DIV_SELECT(0) | CCM_ANALOG_PLL_USB1_POWER(1) | CCM_ANALOG_PLL_USB1_ENABLE(1);
+        while ((CCM_ANALOG->PLL_USB1 & CCM_ANALOG_PLL_USB1_LOCK_MASK) == 0)
+        {
+        }
+        CCM_ANALOG->PLL_USB1 &= ~CCM_ANALOG_PLL_USB1_BYPASS_MASK;
+
+        // Configure PFD_480
+        CCM_ANALOG->PFD_480 = CCM_ANALOG_PFD_480_PFD0_FRAC(35) | CCM_ANALOG_PFD_480_PFD1_FRAC(35) |
+                              CCM_ANALOG_PFD_480_PFD2_FRAC(26) | CCM_ANALOG_PFD_480_PFD3_FRAC(15);
+
+        // Configure Clock PODF
+        CCM->CACRR = CCM_CACRR_ARM_PODF(1);
+
+        CCM->CBCDR = (CCM->CBCDR & (~(CCM_CBCDR_SEMC_PODF_MASK | CCM_CBCDR_AHB_PODF_MASK | CCM_CBCDR_IPG_PODF_MASK))) |
+                     CCM_CBCDR_SEMC_PODF(2) | CCM_CBCDR_AHB_PODF(2) | CCM_CBCDR_IPG_PODF(2);
+
+        // Configure FLEXSPI2 CLOCKS
+        CCM->CBCMR =
+            (CCM->CBCMR &
+             (~(CCM_CBCMR_PRE_PERIPH_CLK_SEL_MASK | CCM_CBCMR_FLEXSPI2_CLK_SEL_MASK | CCM_CBCMR_FLEXSPI2_PODF_MASK))) |
+            CCM_CBCMR_PRE_PERIPH_CLK_SEL(3) | CCM_CBCMR_FLEXSPI2_CLK_SEL(1) | CCM_CBCMR_FLEXSPI2_PODF(7);
+
+        // Confgiure FLEXSPI CLOCKS
+        CCM->CSCMR1 = ((CCM->CSCMR1 & ~(CCM_CSCMR1_FLEXSPI_CLK_SEL_MASK | CCM_CSCMR1_FLEXSPI_PODF_MASK |
+                                        CCM_CSCMR1_PERCLK_PODF_MASK | CCM_CSCMR1_PERCLK_CLK_SEL_MASK)) |
+                       CCM_CSCMR1_FLEXSPI_CLK_SEL(3) | CCM_CSCMR1_FLEXSPI_PODF(7) | CCM_CSCMR1_PERCLK_PODF(1));
+
+        // Finally, Enable PLL_ARM, PLL_SYS and PLL_USB1
+        CCM_ANALOG->PLL_ARM &= ~CCM_ANALOG_PLL_ARM_BYPASS_MASK;
+        CCM_ANALOG->PLL_SYS &= ~CCM_ANALOG_PLL_SYS_BYPASS_MASK;
+        CCM_ANALOG->PLL_USB1 &= ~CCM_ANALOG_PLL_USB1_BYPASS_MASK;
+    }
+    status = ProbePart(&option);
+    if (status != kStatus_Success)
+    {
+        return (1);
+    }
+    status = flexspi_nor_get_config(FLEXSPI_NOR_INSTANCE, &config, &option);
+    if (status != kStatus_Success)
+    {
+        return (1);
+    }
+    status = flexspi_nor_flash_init(FLEXSPI_NOR_INSTANCE, &config);
+    if (status != kStatus_Success)
+    {
+        return (1);
+    }
+    else
+    {
+        return (0); // Finished without Errors
+    }
+}
+
+/*
+ *  De-Initialize Flash Programming Functions
+ *    Parameter:      fnc:  Function Code (1 - Erase, 2 - Program, 3 - Verify)
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int UnInit(unsigned long fnc)
+{
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFlush(fnc))
+    {
+        return (1);
+    }
+#endif
+    return (0); // Finished without Errors
+}
+
+/*
+ *  Erase complete Flash Memory
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int EraseChip(void)
+{
+    status_t status;
+    status = flexspi_nor_flash_erase_all(FLEXSPI_NOR_INSTANCE, &config); // Erase all
+    if (status != kStatus_Success)
+    {
+        return (1);
+    }
+    else
+    {
+        return (0); // Finished without Errors
+    }
+}
+
+/*
+ *  Erase Sector in Flash Memory
+ *    Parameter:      adr:  Sector Address
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int EraseSector(unsigned long adr)
+{
+    unsigned long size = DEVICE_SECTOR_SIZE;
+    unsigned long end  = adr + SECTOR_SIZE;
+
+    // FlashDev covers the largest part, the ROM wraps addresses past the detected one
+    if (end - BASE_ADDRESS > config.memConfig.sflashA1Size)
+    {
+        return (1);
+    }
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFinish())
+    {
+        return (1);
+    }
+#endif
+#if INCREMENTAL_PROGRAM
+    // Erase device sector by device sector, skipping the blank ones and deferring the others
+    for (; adr < end; adr += size)
+    {
+        if (!BlankCheck(adr, size, 0xFF))
+        {
+            g_incrementalStats.eraseHits++;
+            continue;
+        }
+        if (IncrementalDefer(adr, size))
+        {
+            continue;
+        }
+        g_incrementalStats.eraseMisses++;
+        if (DeviceSectorErase(adr, size))
+        {
+            return (1);
+        }
+    }
+#else
+    // One erase for the whole sector, so the driver can use its block erase commands
+    g_incrementalStats.eraseMisses += SECTOR_SIZE / size;
+    if (DeviceSectorErase(adr, SECTOR_SIZE))
+    {
+        return (1);
+    }
+#endif
+    return (0);
+}
+
+/*
+ *  Program Page in Flash Memory
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    return (FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE));
+}
+
+/*
+ *  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    status_t status;
+    adr = adr - BASE_ADDRESS;
+    // Program data to destination
+    status = flexspi_nor_flash_page_program(FLEXSPI_NOR_INSTANCE, &config, adr, (uint32_t *)buf); // program 1 page
+    if (status != kStatus_Success)
+    {
+        return (1);
+    }
+    else
+    {
+        return (0);
+    }
+}
@@ -36,6 +36,8 @@
 #include "bl_api.h"
 #include "flash_config.h"
 #include "cmsis_compiler.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
 
 /** local definitions **/
 
@@ -53,9 +55,6 @@ void configBootClk(void)
 {
   uint32_t v;
   __disable_irq();
-  // Disable cache
-  MEM_WriteU32(0x40033800, 0);
-  MEM_WriteU32(0x4003301C, 0);
   // PMC->MEMSEQCTRL = 0x1U;
   MEM_WriteU32(0x40135030, 0x1U);
   // Power FFRO
@@ -103,6 +102,134 @@ void configBootClk(void)
   MEM_WriteU32(0x40002380, 0x0U);
 }
 
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (flashConfig.sectorSize)
+#define DEVICE_PAGE_SIZE   (flashConfig.pageSize)
+
+int DeviceSectorErase (unsigned long adr, unsigned long sz) {
+
+  status_t status = flexspi_nor_flash_erase(FLEXSPI_INSTANCE_SEL, &flashConfig, adr - FLASH_BASE_ADDR, sz);
+  return (int)status;
+}
+
+/*  CACHE64
+ *
+ *  Init keeps the CACHE64 of the FlexSPI window on, enabling it write-through over the whole window when
+ *  it is off, so that Verify and BlankCheck read the flash with line fills. They invalidate the lines of
+ *  their range before reading it. UnInit turns a cache Init enabled off again and puts back its policy.
+ *  The device header has no CACHE64 definitions, the registers are those of the SDK fsl_cache driver.
+ */
+
+#define CACHE64_CTRL_CCR        (0x40033800) // ENCACHE bit 0, INVW0 bit 24, INVW1 bit 26, GO bit 31
+#define CACHE64_POLSEL_REG0_TOP (0x40033014)
+#define CACHE64_POLSEL_POLSEL   (0x4003301C) // REG0_POLICY bits 1:0, 1 - write-through
+#define CACHE64_LINE_SIZE       (32)
+#define CACHE64_WINDOW_SIZE     (0x08000000) // FlexSPI window served by the cache
+
+static uint32_t s_cacheEnabled;             // EnableCache turned the cache on
+static uint32_t s_cacheRegion0Top;          // POLSEL_REG0_TOP before EnableCache
+static uint32_t s_cachePolicy;              // POLSEL_POLSEL before EnableCache
+
+static void EnableCache (void) {
+
+  volatile uint32_t *ccr = (volatile uint32_t *)CACHE64_CTRL_CCR;
+
+  if (!(*ccr & 0x1U))
+  {
+    s_cacheRegion0Top = *((volatile uint32_t *)CACHE64_POLSEL_REG0_TOP);
+    s_cachePolicy     = *((volatile uint32_t *)CACHE64_POLSEL_POLSEL);
+    s_cacheEnabled    = 1;
+    // Region 0 covers the whole window
+    MEM_WriteU32(CACHE64_POLSEL_REG0_TOP, CACHE64_WINDOW_SIZE - 0x400U);
+    MEM_WriteU32(CACHE64_POLSEL_POLSEL, 0x1U);
+  }
+  // Invalidate both ways, the flash may have changed since the cache was last used, then enable
+  *ccr |= (1U << 24) | (1U << 26) | (1U << 31);
+  while (*ccr & (1U << 31))
+  {
+  }
+  *ccr = (*ccr & ~((1U << 24) | (1U << 26))) | 0x1U;
+}
+
+static void RestoreCache (void) {
+
+  if (s_cacheEnabled)
+  {
+    // Write-through leaves no dirty line, the policy can only be changed with the cache off
+    *((volatile uint32_t *)CACHE64_CTRL_CCR) &= ~0x1U;
+    MEM_WriteU32(CACHE64_POLSEL_REG0_TOP, s_cacheRegion0Top);
+    MEM_WriteU32(CACHE64_POLSEL_POLSEL, s_cachePolicy);
+    s_cacheEnabled = 0;
+  }
+}
+
+/*  AHB RX buffers
+ *
+ *  Init gives the AHB RX buffer memory to one prefetching buffer of whole CACHE64 lines, the one of the
+ *  masters without a buffer, for the sequential reads of Verify and BlankCheck. UnInit puts back the
+ *  assignment the ROM made for execute-in-place.
+ */
+
+#define FLEXSPI_MCR0            (0x40134000) // SWRESET bit 0
+#define FLEXSPI_AHBCR           (0x4013400C) // PREFETCHEN bit 5
+#define FLEXSPI_AHBRXBUFCR0     (0x40134020) // BUFSZ bits 7:0 in 64-bit units, PRIORITY bits 25:24, PREFETCHEN bit 31
+#define FLEXSPI_STS0            (0x401340E0) // ARBIDLE bit 1
+#define FLEXSPI_AHBRXBUF_COUNT  (4)
+#define FLEXSPI_AHBRXBUF_SIZE   (1024)       // Memory shared by the buffers
+
+static uint32_t s_ahbProfile[1 + FLEXSPI_AHBRXBUF_COUNT]; // AHBCR, then AHBRXBUFCR0 of each buffer
+static int s_ahbProfileSaved;
+
+static void SetAhbBuffers (const uint32_t *profile) {
+
+  volatile uint32_t *mcr0 = (volatile uint32_t *)FLEXSPI_MCR0;
+  volatile uint32_t *bufcr = (volatile uint32_t *)FLEXSPI_AHBRXBUFCR0;
+  int i;
+
+  while (!(*((volatile uint32_t *)FLEXSPI_STS0) & 0x2U))
+  {
+  }
+  MEM_WriteU32(FLEXSPI_AHBCR, profile[0]);
+  for (i = 0; i < FLEXSPI_AHBRXBUF_COUNT; i++)
+  {
+    bufcr[i] = profile[1 + i];
+  }
+  // Drop what the buffers held under the former assignment
+  *mcr0 |= 0x1U;
+  while (*mcr0 & 0x1U)
+  {
+  }
+}
+
+static void EnterVerifyAhbProfile (void) {
+
+  volatile uint32_t *bufcr = (volatile uint32_t *)FLEXSPI_AHBRXBUFCR0;
+  uint32_t profile[1 + FLEXSPI_AHBRXBUF_COUNT];
+  int i;
+
+  s_ahbProfile[0] = *((volatile uint32_t *)FLEXSPI_AHBCR);
+  profile[0] = s_ahbProfile[0] | 0x20U;
+  for (i = 0; i < FLEXSPI_AHBRXBUF_COUNT; i++)
+  {
+    s_ahbProfile[1 + i] = bufcr[i];
+    profile[1 + i] = bufcr[i] & ~0x30000FFU;
+  }
+  s_ahbProfileSaved = 1;
+  // The last buffer serves the masters without a buffer, give it all the memory, the others none
+  profile[FLEXSPI_AHBRXBUF_COUNT] |=
+      0x80000000U | ((FLEXSPI_AHBRXBUF_SIZE / CACHE64_LINE_SIZE) * CACHE64_LINE_SIZE / 8);
+  SetAhbBuffers(profile);
+}
+
+static void RestoreAhbProfile (void) {
+
+  if (s_ahbProfileSaved)
+  {
+    SetAhbBuffers(s_ahbProfile);
+    s_ahbProfileSaved = 0;
+  }
+}
+
 /*  Initialize Flash Programming Functions
  *    Parameter:      adr:  Device Base Address
  *                    clk:  Clock Frequency (Hz)
@@ -111,6 +238,10 @@ void configBootClk(void)
  */
 
 int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
+
+#if INCREMENTAL_PROGRAM
+  IncrementalReset(fnc);
+#endif
 	
   configBootClk();
 	
@@ -121,7 +252,15 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
 
   flexspi_nor_get_config(FLEXSPI_INSTANCE_SEL, &flashConfig, &configOption);
 	
-  return (int)flexspi_nor_flash_init(FLEXSPI_INSTANCE_SEL, &flashConfig);
+  s_ahbProfileSaved = 0;                     // Saved again below, the previous UnInit restored it
+  s_cacheEnabled = 0;
+  int status = (int)flexspi_nor_flash_init(FLEXSPI_INSTANCE_SEL, &flashConfig);
+  if (!status)
+  {
+    EnterVerifyAhbProfile();
+    EnableCache();
+  }
+  return status;
 }
 
 
@@ -132,8 +271,15 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
 
 int UnInit (unsigned long fnc) {
 
+#if INCREMENTAL_PROGRAM
+  if (IncrementalFlush(fnc))
+  {
+    return 1;
+  }
+#endif
+  RestoreAhbProfile();
+  RestoreCache();
 
-  
   return 0;                                  // Finished without Errors
 }
 
@@ -157,22 +303,67 @@ int EraseChip (void) {
 
 int EraseSector (unsigned long adr) {
 
-  /*Erase Sector*/
-  status_t status =  flexspi_nor_flash_erase(FLEXSPI_INSTANCE_SEL, &flashConfig, adr - FLASH_BASE_ADDR, flashConfig.sectorSize);
-  
-  return (int)status;
+  unsigned long size = DEVICE_SECTOR_SIZE;
+  unsigned long end  = adr + flashConfig.sectorSize;
+
+#if INCREMENTAL_PROGRAM
+  if (IncrementalFinish())
+  {
+    return 1;
+  }
+#endif
+#if INCREMENTAL_PROGRAM
+  // Erase device sector by device sector, skipping the blank ones and deferring the others
+  for (; adr < end; adr += size)
+  {
+    if (!BlankCheck(adr, size, 0xFF))
+    {
+      g_incrementalStats.eraseHits++;
+      continue;
+    }
+    if (IncrementalDefer(adr, size))
+    {
+      continue;
+    }
+    g_incrementalStats.eraseMisses++;
+    if (DeviceSectorErase(adr, size))
+    {
+      return 1;
+    }
+  }
+#else
+  // One erase for the whole sector, so the driver can use its block erase commands
+  g_incrementalStats.eraseMisses += flashConfig.sectorSize / size;
+  if (DeviceSectorErase(adr, flashConfig.sectorSize))
+  {
+    return 1;
+  }
+#endif
+  return 0;
 }
 
 
 /*  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
- *                    sz:   Page Size
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
  *                    buf:  Page Data
  *    Return Value:   0 - OK,  1 - Failed
  */
 
 int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf) {
 
+  return FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE);
+}
+
+/*  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram (unsigned long adr, unsigned long sz, unsigned char *buf) {
+
   status_t status = 0;
 
   for(uint32_t size = 0; size < sz; size+=flashConfig.pageSize,
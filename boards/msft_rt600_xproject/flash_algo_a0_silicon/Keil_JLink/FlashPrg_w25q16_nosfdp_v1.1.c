@@ -34,6 +34,8 @@
 #include "FlashOS.H"        // FlashOS Structures
 #include <string.h>
 #include "bl_api.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
 
 /** local definitions **/
 
@@ -115,6 +117,16 @@ quadspi_mem_config_t w25q_config = {
 
 };
 
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (flashConfig.sectorSize)
+#define DEVICE_PAGE_SIZE   (flashConfig.pageSize)
+
+int DeviceSectorErase (unsigned long adr, unsigned long sz) {
+
+  status_t status = quadspi_nor_erase(&flashConfig, adr, sz);
+  return (int)status;
+}
+
 /*  Initialize Flash Programming Functions
  *    Parameter:      adr:  Device Base Address
  *                    clk:  Clock Frequency (Hz)
@@ -124,6 +136,10 @@ quadspi_mem_config_t w25q_config = {
 
 int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
 
+#if INCREMENTAL_PROGRAM
+  IncrementalReset(fnc);
+#endif
+
   memset((void *)&flashConfig, 0U, sizeof(quadspi_nor_config_t));
 
   flashConfig.memConfig = w25q_config; 
@@ -153,8 +169,13 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
 
 int UnInit (unsigned long fnc) {
 
+#if INCREMENTAL_PROGRAM
+  if (IncrementalFlush(fnc))
+  {
+    return 1;
+  }
+#endif
 
-  
   return 0;                                  // Finished without Errors
 }
 
@@ -187,23 +208,67 @@ void delay(void)
 
 int EraseSector (unsigned long adr) {
 
-  /*Erase Sector*/
-  status_t status =  quadspi_nor_erase(&flashConfig, adr, flashConfig.sectorSize);
-  //delay();
-  
-  return status;
+  unsigned long size = DEVICE_SECTOR_SIZE;
+  unsigned long end  = adr + flashConfig.sectorSize;
+
+#if INCREMENTAL_PROGRAM
+  if (IncrementalFinish())
+  {
+    return 1;
+  }
+#endif
+#if INCREMENTAL_PROGRAM
+  // Erase device sector by device sector, skipping the blank ones and deferring the others
+  for (; adr < end; adr += size)
+  {
+    if (!BlankCheck(adr, size, 0xFF))
+    {
+      g_incrementalStats.eraseHits++;
+      continue;
+    }
+    if (IncrementalDefer(adr, size))
+    {
+      continue;
+    }
+    g_incrementalStats.eraseMisses++;
+    if (DeviceSectorErase(adr, size))
+    {
+      return 1;
+    }
+  }
+#else
+  // One erase for the whole sector, so the driver can use its block erase commands
+  g_incrementalStats.eraseMisses += flashConfig.sectorSize / size;
+  if (DeviceSectorErase(adr, flashConfig.sectorSize))
+  {
+    return 1;
+  }
+#endif
+  return 0;
 }
 
 
 /*  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
- *                    sz:   Page Size
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
  *                    buf:  Page Data
  *    Return Value:   0 - OK,  1 - Failed
  */
 
 int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf) {
 
+  return FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE);
+}
+
+/*  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram (unsigned long adr, unsigned long sz, unsigned char *buf) {
+
   status_t status = 0;
 
   for(uint32_t size = 0; size < sz; size+=flashConfig.pageSize,
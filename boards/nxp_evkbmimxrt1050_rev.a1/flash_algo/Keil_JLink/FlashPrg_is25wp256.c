@@ -10,12 +10,147 @@
 
 #include "FlashOS.H" // FlashOS Structures
 #include "flexspi_nor/flexspi_nor_flash.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
 
 #define FLEXSPI_NOR_INSTANCE 0
 #define SECTOR_SIZE          (4096)
 #define BASE_ADDRESS         (0x60000000)
 
-flexspi_nor_config_t config = {1};
+flexspi_nor_config_t config = {.memConfig = {.tag = 1}};
+
+/*
+ *  AHB RX buffers
+ *
+ *  Init gives the AHB RX buffer memory to one prefetching buffer for the sequential reads of Verify and
+ *  BlankCheck, UnInit puts back the execute-in-place assignment of flexspi_init. Like the other state of the
+ *  algorithm it is set by Init, the debugger does not clear zero-initialized data.
+ */
+
+static flexspi_ahb_profile_t s_ahbProfile;
+
+/*
+ *  Config block cache
+ *
+ *  Init keeps the config block generated from SFDP in OCRAM outside of the algorithm and reuses it while the
+ *  JEDEC ID and SFDP headers of the device stay the same, which spares the SFDP probe of the following Init
+ *  calls. The application may overwrite that RAM between downloads, a cache whose CRC32 does not match is
+ *  discarded and the device probed again. Set CONFIG_CACHE_ADDRESS to 0 to probe the device on every Init.
+ */
+
+#ifndef CONFIG_CACHE_ADDRESS
+#define CONFIG_CACHE_ADDRESS (0x2023FC00) // Last 1KB of the default 256KB OCRAM
+#endif
+
+/*
+ *  Trace
+ *
+ *  Built with FLEXSPI_ENABLE_TRACE set, Init attaches the trace of the FlexSPI middleware at TRACE_ADDRESS,
+ *  in OCRAM outside of the algorithm, so that it accumulates over the calls of a download. Dump
+ *  sizeof(flexspi_trace_t) bytes from there and decode them with tools/flexspi_trace.
+ */
+
+#ifndef TRACE_ADDRESS
+#define TRACE_ADDRESS (0x2023EC00) // 4KB below the config block cache in the default 256KB OCRAM
+#endif
+
+/*
+ *  Read clock tuning
+ *
+ *  Init raises the serial clock of the read sequence up to READ_TUNE_MAX_FREQ and the IS25WP256D rating
+ *  READ_TUNE_MAX_CLOCK_HZ, to one clock step below the fastest clock and dummy cycles that read back the
+ *  first 4KB blocks of the device unchanged. Program, erase and the other commands keep the clock of option0.
+ *  The result is kept in the config block cache. Set READ_TUNE_MAX_FREQ to 0 to read at the clock of option0.
+ */
+
+#ifndef READ_TUNE_MAX_FREQ
+#define READ_TUNE_MAX_FREQ (kFlexSpiSerialClk_133MHz)
+#endif
+#ifndef READ_TUNE_MAX_CLOCK_HZ
+#define READ_TUNE_MAX_CLOCK_HZ (133000000UL) // Fast read clock of the IS25WP256D datasheet
+#endif
+
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (config.sectorSize)
+#define DEVICE_PAGE_SIZE   (config.pageSize)
+
+/*
+ *  Background programming
+ *
+ *  With BACKGROUND_PROGRAM set, see flash_program/flash_program.h, the last device page of a ProgramPage call
+ *  is started with DevicePageProgramStart. Every function that accesses the device calls BackgroundComplete.
+ */
+
+#if BACKGROUND_PROGRAM
+static bool s_backgroundPending;     // A device page is being programmed in the background
+static uint32_t s_backgroundAddress; // Device address of that page
+#endif
+
+int BackgroundComplete(void)
+{
+#if BACKGROUND_PROGRAM
+    if (s_backgroundPending)
+    {
+        s_backgroundPending = false;
+        return (flexspi_nor_flash_page_program_complete(FLEXSPI_NOR_INSTANCE, &config, s_backgroundAddress) !=
+                kStatus_Success);
+    }
+#endif
+    return (0);
+}
+
+int DeviceSectorErase(unsigned long adr, unsigned long sz)
+{
+    status_t status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr - BASE_ADDRESS, sz);
+    return (status != kStatus_Success);
+}
+
+/*
+ *  D-Cache
+ *
+ *  Init turns the D-Cache on, so that Verify and BlankCheck read the AHB window with line fills instead of
+ *  one AHB access per word, and forces it to write-through: the config block cache and the trace reach OCRAM
+ *  as they are written, where the debugger reads them, and dropping lines never loses data. ProgramPage and
+ *  Verify drop the lines of the buffer the debugger wrote since the last call. Init saves CACR and CCR.DC of
+ *  the debugger and UnInit puts them back, so the application starts with the cache setup it had.
+ */
+
+typedef struct
+{
+    uint32_t cacr;   // CACR with the FORCEWT setting of the debugger
+    bool isDCacheOn; // CCR.DC of the debugger
+} cache_state_t;
+
+static cache_state_t s_cacheState;
+
+static void EnableCache(void)
+{
+    s_cacheState.cacr       = SCB->CACR;
+    s_cacheState.isDCacheOn = (SCB_CCR_DC_Msk == (SCB_CCR_DC_Msk & SCB->CCR));
+
+    SCB->CACR |= SCB_CACR_FORCEWT_Msk;
+    if (s_cacheState.isDCacheOn)
+    {
+        // Write back what was cached before write-through, drop what the debugger changed in RAM since
+        SCB_CleanInvalidateDCache();
+    }
+    else
+    {
+        SCB_EnableDCache();
+    }
+}
+
+static void RestoreCache(void)
+{
+    if (!s_cacheState.isDCacheOn)
+    {
+        // Nothing is dirty in write-through, disabling cleans and invalidates every line
+        SCB_DisableDCache();
+    }
+    SCB->CACR = s_cacheState.cacr;
+    __DSB();
+    __ISB();
+}
 
 /*
  *  Initialize Flash Programming Functions
@@ -27,6 +162,23 @@ flexspi_nor_config_t config = {1};
 
 int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 {
+    EnableCache();
+#if FLEXSPI_ENABLE_TRACE
+    flexspi_trace_attach((flexspi_trace_t *)TRACE_ADDRESS);
+#endif
+    uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
+    (void)adr;
+    (void)clk;
+#if INCREMENTAL_PROGRAM
+    IncrementalReset(fnc);
+#else
+    (void)fnc;
+#endif
+#if BACKGROUND_PROGRAM
+    s_backgroundPending = false;
+#endif
+    s_ahbProfile.isSaved = false; // Saved again below, the previous UnInit restored it
+
     status_t status;
     serial_nor_config_option_t option;
     option.option0.U = 0xc0000005;
@@ -46,7 +198,8 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
     RTWDOG->CNT   = 0xD928C520U; /* 0xD928C520U is the update key */
     RTWDOG->TOVAL = 0xFFFF;
     RTWDOG->CS    = (uint32_t)((RTWDOG->CS) & ~RTWDOG_CS_EN_MASK) | RTWDOG_CS_UPDATE_MASK;
-    status        = flexspi_nor_get_config(FLEXSPI_NOR_INSTANCE, &config, &option);
+    status        = flexspi_nor_get_config_cached(FLEXSPI_NOR_INSTANCE, &config, &option,
+                                           (flexspi_nor_config_cache_t *)CONFIG_CACHE_ADDRESS);
     if (status != kStatus_Success)
     {
         return (1);
@@ -56,8 +209,19 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
     {
         return (1);
     }
+    status = flexspi_nor_flash_tune_read(FLEXSPI_NOR_INSTANCE, &config, READ_TUNE_MAX_FREQ,
+                                         READ_TUNE_MAX_CLOCK_HZ, (flexspi_nor_config_cache_t *)CONFIG_CACHE_ADDRESS);
+    if (status == kStatus_Success)
+    {
+        status = flexspi_enter_verify_ahb_profile(FLEXSPI_NOR_INSTANCE, &s_ahbProfile);
+    }
+    if (status != kStatus_Success)
+    {
+        return (1);
+    }
     else
     {
+        FLEXSPI_TRACE_END(kFlexSpiTracePhase_Init, traceStart, 0);
         return (0); // Finished without Errors
     }
 }
@@ -70,7 +234,23 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 
 int UnInit(unsigned long fnc)
 {
-    /* Add your Code */
+    if (BackgroundComplete())
+    {
+        return (1);
+    }
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFlush(fnc))
+    {
+        return (1);
+    }
+#else
+    (void)fnc;
+#endif
+    if (flexspi_restore_ahb_profile(FLEXSPI_NOR_INSTANCE, &s_ahbProfile) != kStatus_Success)
+    {
+        return (1);
+    }
+    RestoreCache();
     return (0); // Finished without Errors
 }
 
@@ -82,6 +262,10 @@ int UnInit(unsigned long fnc)
 int EraseChip(void)
 {
     status_t status;
+    if (BackgroundComplete())
+    {
+        return (1);
+    }
     status = flexspi_nor_flash_erase_all(FLEXSPI_NOR_INSTANCE, &config); // Erase all
     if (status != kStatus_Success)
     {
@@ -101,30 +285,117 @@ int EraseChip(void)
 
 int EraseSector(unsigned long adr)
 {
-    status_t status;
-    adr    = adr - BASE_ADDRESS;
-    status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr, SECTOR_SIZE); // Erase 1 sector
-    if (status != kStatus_Success)
+    unsigned long size  = DEVICE_SECTOR_SIZE;
+    uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
+
+    if (BackgroundComplete())
     {
         return (1);
     }
-    else
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFinish())
     {
-        return (0);
+        return (1);
+    }
+#endif
+#if INCREMENTAL_PROGRAM
+    // Erase device sector by device sector, skipping the blank ones and deferring the others
+    for (unsigned long end = adr + SECTOR_SIZE; adr < end; adr += size)
+    {
+        if (!BlankCheck(adr, size, 0xFF))
+        {
+            g_incrementalStats.eraseHits++;
+            continue;
+        }
+        if (IncrementalDefer(adr, size))
+        {
+            continue;
+        }
+        g_incrementalStats.eraseMisses++;
+        if (DeviceSectorErase(adr, size))
+        {
+            return (1);
+        }
+    }
+#else
+    // One erase for the whole sector, so the driver can use its block erase commands
+    g_incrementalStats.eraseMisses += SECTOR_SIZE / size;
+    if (DeviceSectorErase(adr, SECTOR_SIZE))
+    {
+        return (1);
     }
+#endif
+    FLEXSPI_TRACE_END(kFlexSpiTracePhase_EraseSector, traceStart, SECTOR_SIZE);
+    return (0);
+}
+
+/*
+ *  Erase Sectors in Flash Memory, SEGGER_OPEN extension J-Link calls instead of EraseSector
+ *    Parameter:      SectorAddr:   First Sector Address
+ *                    SectorIndex:  Index of that Sector
+ *                    NumSectors:   Number of Sectors
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int SEGGER_OPEN_Erase(unsigned long SectorAddr, unsigned long SectorIndex, unsigned long NumSectors)
+{
+    unsigned long start = SectorAddr;
+    unsigned long end   = SectorAddr + NumSectors * SECTOR_SIZE;
+
+    (void)SectorIndex;
+#if INCREMENTAL_PROGRAM
+    // Deferred erases are tracked sector by sector
+    for (; start < end; start += SECTOR_SIZE)
+    {
+        if (EraseSector(start))
+        {
+            return (1);
+        }
+    }
+    return (0);
+#else
+    if (BackgroundComplete())
+    {
+        return (1);
+    }
+    // The whole extent in one call, so that the middleware uses block or chip erases where they are faster
+    g_incrementalStats.eraseMisses += (end - start) / DEVICE_SECTOR_SIZE;
+    return (DeviceSectorErase(start, end - start));
+#endif
 }
 
 /*
  *  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
- *                    sz:   Page Size
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
  *                    buf:  Page Data
  *    Return Value:   0 - OK,  1 - Failed
  */
 
 int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
+
+    if (BackgroundComplete() || FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE))
+    {
+        return (1);
+    }
+    FLEXSPI_TRACE_END(kFlexSpiTracePhase_ProgramPage, traceStart, sz);
+    return (0);
+}
+
+/*
+ *  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram(unsigned long adr, unsigned long sz, unsigned char *buf)
 {
     status_t status;
+    (void)sz;
     adr = adr - BASE_ADDRESS;
     // Program data to destination
     status = flexspi_nor_flash_page_program(FLEXSPI_NOR_INSTANCE, &config, adr, (uint32_t *)buf); // program 1 page
@@ -137,3 +408,26 @@ int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
         return (0);
     }
 }
+
+#if BACKGROUND_PROGRAM
+/*
+ *  Program Page in Flash Memory in the background, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data, can be overwritten on return
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgramStart(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    status_t status;
+    (void)sz;
+
+    // Wait for the page even if sending it failed, the device may have accepted the command
+    s_backgroundAddress = adr - BASE_ADDRESS;
+    s_backgroundPending = true;
+
+    status = flexspi_nor_flash_page_program_start(FLEXSPI_NOR_INSTANCE, &config, s_backgroundAddress, (uint32_t *)buf);
+    return (status != kStatus_Success);
+}
+#endif
@@ -20,6 +20,8 @@
 #define SECTOR_NUM 512 // Max Number of Sector Items
 #define PAGE_MAX 65536 // Max Page Size for Programming
 
+#include "FlashLayout.h" // Programming Page Size and RAM for Algorithm
+
 struct FlashSectors
 {
     unsigned long szSector;   // Sector Size in Bytes
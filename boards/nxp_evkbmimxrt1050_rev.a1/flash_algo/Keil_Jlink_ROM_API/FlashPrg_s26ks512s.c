@@ -10,12 +10,24 @@
 
 #include "FlashOS.H" // FlashOS Structures
 #include "bl_api.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
 
 #define FLEXSPI_NOR_INSTANCE 0
 #define SECTOR_SIZE (262144)
 #define BASE_ADDRESS (0x60000000)
 
-flexspi_nor_config_t config = {1};
+flexspi_nor_config_t config = {.memConfig = {.tag = 1}};
+
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (config.sectorSize)
+#define DEVICE_PAGE_SIZE   (config.pageSize)
+
+int DeviceSectorErase(unsigned long adr, unsigned long sz)
+{
+    status_t status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr - BASE_ADDRESS, sz);
+    return (status != kStatus_Success);
+}
 
 /*
  *  Initialize Flash Programming Functions
@@ -27,6 +39,10 @@ flexspi_nor_config_t config = {1};
 
 int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 {
+#if INCREMENTAL_PROGRAM
+    IncrementalReset(fnc);
+#endif
+
 		status_t status;
     serial_nor_config_option_t option;
     option.option0.U = 0xc0233007; // HyperFLASH 1V8, Query pads: Octal, CMD pads: 8, Frequency: 133MHz
@@ -74,7 +90,12 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 
 int UnInit(unsigned long fnc)
 {
-    /* Add your Code */
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFlush(fnc))
+    {
+        return (1);
+    }
+#endif
     return (0); // Finished without Errors
 }
 
@@ -105,28 +126,67 @@ int EraseChip(void)
 
 int EraseSector(unsigned long adr)
 {
-    status_t status;
-    adr    = adr - BASE_ADDRESS;
-    status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr, SECTOR_SIZE); // Erase 1 sector
-    if (status != kStatus_Success)
+    unsigned long size = DEVICE_SECTOR_SIZE;
+    unsigned long end  = adr + SECTOR_SIZE;
+
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFinish())
     {
         return (1);
     }
-    else
+#endif
+#if INCREMENTAL_PROGRAM
+    // Erase device sector by device sector, skipping the blank ones and deferring the others
+    for (; adr < end; adr += size)
     {
-        return (0);
+        if (!BlankCheck(adr, size, 0xFF))
+        {
+            g_incrementalStats.eraseHits++;
+            continue;
+        }
+        if (IncrementalDefer(adr, size))
+        {
+            continue;
+        }
+        g_incrementalStats.eraseMisses++;
+        if (DeviceSectorErase(adr, size))
+        {
+            return (1);
+        }
     }
+#else
+    // One erase for the whole sector, so the driver can use its block erase commands
+    g_incrementalStats.eraseMisses += SECTOR_SIZE / size;
+    if (DeviceSectorErase(adr, SECTOR_SIZE))
+    {
+        return (1);
+    }
+#endif
+    return (0);
 }
 
 /*
  *  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
- *                    sz:   Page Size
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
  *                    buf:  Page Data
  *    Return Value:   0 - OK,  1 - Failed
  */
 
 int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    return (FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE));
+}
+
+/*
+ *  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram(unsigned long adr, unsigned long sz, unsigned char *buf)
 {
     status_t status;
     adr = adr - BASE_ADDRESS;
@@ -27,11 +27,16 @@ void bl_api_init(void)
 /*******************************************************************************
  * FlexSPI NOR driver
  ******************************************************************************/
+#if BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI
+
+#if ROM_API_HAS_FLEXSPI_NOR_INIT
 status_t flexspi_nor_flash_init(uint32_t instance, flexspi_nor_config_t *config)
 {
     return g_bootloaderTree->flexSpiNorDriver->init(instance, config);
 }
+#endif
 
+#if ROM_API_HAS_FELXSPI_NOR_PROGRAM
 status_t flexspi_nor_flash_page_program(uint32_t instance,
                                         flexspi_nor_config_t *config,
                                         uint32_t dstAddr,
@@ -39,19 +44,28 @@ status_t flexspi_nor_flash_page_program(uint32_t instance,
 {
     return g_bootloaderTree->flexSpiNorDriver->program(instance, config, dstAddr, src);
 }
+#endif
 
+#if ROM_API_HAS_FLEXSPI_NOR_ERASE_ALL
 status_t flexspi_nor_flash_erase_all(uint32_t instance, flexspi_nor_config_t *config)
 {
     return g_bootloaderTree->flexSpiNorDriver->erase_all(instance, config);
 }
+#endif
 
+#if ROM_API_HAS_FLEXSPI_NOR_ERASE
 status_t flexspi_nor_flash_erase(uint32_t instance, flexspi_nor_config_t *config, uint32_t start, uint32_t length)
 {
     return g_bootloaderTree->flexSpiNorDriver->erase(instance, config, start, length);
 }
+#endif
 
+#if ROM_API_HAS_FLEXSPI_NOR_READ
 status_t flexspi_nor_flash_read(
     uint32_t instance, flexspi_nor_config_t *config, uint32_t *dst, uint32_t start, uint32_t bytes)
 {
     return g_bootloaderTree->flexSpiNorDriver->read(instance, config, dst, start, bytes);
 }
+#endif
+
+#endif // BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI
@@ -12,7 +12,7 @@
 
 #include "fsl_device_registers.h"
 #include "fsl_clock.h"
-#include "flexspi_nor_flash.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
 #include "fsl_rtwdog.h"
 #include "fsl_wdog.h"
 #include <string.h>
@@ -6,7 +6,7 @@
  */
 
 //#include "bl_context.h"
-#include "bl_flexspi.h"
+#include "flexspi/fsl_flexspi.h"
 #include "bootloader_common.h"
 #include "fsl_device_registers.h"
 #include "microseconds.h"
@@ -403,11 +403,18 @@ uint32_t get_bus_clock(void)
     return SystemCoreClock / ahbBusDivider;
 }
 
+// Nothing starts the microseconds timer in the flash algorithm, count core cycles instead
 void flexspi_sw_delay_us(uint64_t us)
 {
+    uint32_t ticksPerUs = SystemCoreClock / 1000000u;
     while (us--)
     {
-        microseconds_delay(1);
+        volatile uint32_t ticksCount = ticksPerUs / 3;
+
+        while (ticksCount--)
+        {
+            __NOP();
+        }
     }
 }
 
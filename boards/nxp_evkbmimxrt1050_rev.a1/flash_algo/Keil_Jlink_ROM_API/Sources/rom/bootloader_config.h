@@ -72,6 +72,9 @@
 
 #define BL_FEATURE_FLEXSPI_NOR_MODULE (1)
 
+// bl_api.c routes the functions selected by the ROM_API_HAS_xxx switches of target_config.h to the boot ROM
+#define BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI (1)
+
 #if BL_FEATURE_FLEXSPI_NOR_MODULE
 #define BL_FEATURE_FLEXSPI_NOR_MODULE_PERIPHERAL_INSTANCE (0)
 #define BL_FEATURE_FLEXSPI_NOR_MODULE_ERASE_VERIFY (1)
@@ -14,8 +14,8 @@
 #include "bl_app_crc_check.h"
 #endif
 #if BL_FEATURE_FLEXSPI_NOR_MODULE || BL_FEATURE_SPINAND_MODULE
-#include "bl_flexspi.h"
-#include "flexspi_nor_flash.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
 #endif // #if BL_FEATURE_FLEXSPI_NOR_MODULE || BL_FEATURE_SPINAND_MODULE
 #if BL_FEATURE_SPI_NOR_EEPROM_MODULE
 #include "microseconds.h"
@@ -26,19 +26,20 @@ enum _target_version_constants
     kTarget_Version_Bugfix = 0
 };
 
-//! @brief FlexSPI supported speed defintions
-enum
-{
-    kFlexSpiSerialClk_30MHz = 1,
-    kFlexSpiSerialClk_50MHz = 2,
-    kFlexSpiSerialClk_60MHz = 3,
-    kFlexSpiSerialClk_75MHz = 4,
-    kFlexSpiSerialClk_80MHz = 5,
-    kFlexSpiSerialClk_100MHz = 6,
-    kFlexSpiSerialClk_133MHz = 7,
-    kFlexSpiSerialClk_166MHz = 8,
-    kFlexSpiSerialClk_200MHz = 9,
-};
+//! @brief FlexSPI NOR driver functions the boot ROM provides
+#define ROM_API_HAS_FLEXSPI_NOR_INIT (1)
+#define ROM_API_HAS_FELXSPI_NOR_PROGRAM (1)
+#define ROM_API_HAS_FLEXSPI_NOR_ERASE (1)
+#define ROM_API_HAS_FLEXSPI_NOR_ERASE_SECTOR (0)
+#define ROM_API_HAS_FLEXSPI_NOR_ERASE_BLOCK (0)
+#define ROM_API_HAS_FLEXSPI_NOR_ERASE_ALL (1)
+#define ROM_API_HAS_FLEXSPI_NOR_READ (1)
+#define ROM_API_HAS_FLEXSPI_NOR_GET_CFG (0)
+#define ROM_API_HAS_FLEXSPI_CLEAR_CACHE (0)
+#define ROM_API_HAS_FLEXSPI_XFER (0)
+
+//! @brief The ROM functions update the LUT themselves, IP commands of the driver copy their sequences
+#define FLEXSPI_ENABLE_RESIDENT_LUT (0)
 
 #endif // __TARGET_CONFIG_H__
 ////////////////////////////////////////////////////////////////////////////////
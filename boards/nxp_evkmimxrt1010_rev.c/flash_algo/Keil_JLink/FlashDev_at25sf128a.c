@@ -14,12 +14,12 @@ struct FlashDevice const FlashDevice = {FLASH_DRV_VERS,                      //
                                         EXTSPI,                              // Device Type
                                         0x60000000,                          // Device Start Address
                                         0x1000000,                           // Device Size in Bytes (16mB)
-                                        256,                                 // Programming Page Size
+                                        FLASH_PROGRAM_PAGE_SIZE,             // Programming Page Size, RAM buffer of ProgramPage
                                         0,                                   // Reserved, must be 0
                                         0xFF,                                // Initial Content of Erased Memory
-                                        100,                                 // Program Page Timeout 100 mSec
+                                        3000,                                // Program Page Timeout 3000 mSec
                                         5000,                                // Erase Sector Timeout 5000 mSec
 
                                         // Specify Size and Address of Sectors
-                                        0x1000, 0x00000000, // Sector Size  4kB (2048 Sectors)
-                                        SECTOR_END};
+                                        {{0x1000, 0x00000000}, // Sector Size  4kB (2048 Sectors)
+                                         {SECTOR_END}}};
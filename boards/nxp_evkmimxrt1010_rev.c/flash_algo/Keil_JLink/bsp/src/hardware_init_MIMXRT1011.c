@@ -5,6 +5,7 @@
  */
 
 #include "fsl_device_registers.h"
+#include "fsl_clock.h"
 #include "flexspi/fsl_flexspi.h"
 #include "flexspi_nor/flexspi_nor_flash.h"
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +95,7 @@ void flexspi_iomux_config(uint32_t instance, flexspi_mem_config_t *config)
     uint32_t sclkPadCtlValue = FLEXSPI_SW_PAD_CTL_VAL;
     uint32_t dataPadCtlValue = FLEXSPI_SW_PAD_CTL_VAL;
 
+    (void)instance;
     if (flexspi_is_padsetting_override_enable(config))
     {
         csPadCtlValue   = config->csPadSettingOverride;
@@ -273,6 +275,25 @@ status_t flexspi_nor_read_persistent(uint32_t *data)
     return kStatus_Success;
 }
 
+void flexspi_update_padsetting(flexspi_mem_config_t *config, uint32_t driveStrength)
+{
+#define IOMUXC_PAD_SETTING_DSE_SHIFT (3)
+#define IOMUXC_PAD_SETTING_DSE_MASK (0x07 << IOMUXC_PAD_SETTING_DSE_SHIFT)
+#define IOMUXC_PAD_SETTING_DSE(x) (((x) << IOMUXC_PAD_SETTING_DSE_SHIFT) & IOMUXC_PAD_SETTING_DSE_MASK)
+    if (driveStrength)
+    {
+        config->dqsPadSettingOverride =
+            (FLEXSPI_DQS_SW_PAD_CTL_VAL & ~IOMUXC_PAD_SETTING_DSE_MASK) | IOMUXC_PAD_SETTING_DSE(driveStrength);
+        config->sclkPadSettingOverride =
+            (FLEXSPI_SW_PAD_CTL_VAL & ~IOMUXC_PAD_SETTING_DSE_MASK) | IOMUXC_PAD_SETTING_DSE(driveStrength);
+        config->dataPadSettingOverride =
+            (FLEXSPI_SW_PAD_CTL_VAL & ~IOMUXC_PAD_SETTING_DSE_MASK) | IOMUXC_PAD_SETTING_DSE(driveStrength);
+
+        config->csPadSettingOverride =
+            (FLEXSPI_DQS_SW_PAD_CTL_VAL & ~IOMUXC_PAD_SETTING_DSE_MASK) | IOMUXC_PAD_SETTING_DSE(driveStrength);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // EOF
 ////////////////////////////////////////////////////////////////////////////////
@@ -9,15 +9,30 @@
 /***********************************************************************/
 
 #include "FlashOS.H" // FlashOS Structures
-#include "flexspi_nor_flash.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
 #include "bl_api.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
 
 #define FLEXSPI_NOR_INSTANCE 0
 #define SECTOR_SIZE          (4096)
 #define BASE_ADDRESS         (0x60000000)
 
 /* Init this global variable to workaround of the issue to running this flash algo in Segger */
-flexspi_nor_config_t config = {1};
+flexspi_nor_config_t config = {.memConfig = {.tag = 1}};
+
+/*
+ *  Config block cache
+ *
+ *  Init keeps the config block generated from SFDP in OCRAM outside of the algorithm and reuses it while the
+ *  JEDEC ID and SFDP headers of the device stay the same, which spares the SFDP probe of the following Init
+ *  calls. The application may overwrite that RAM between downloads, a cache whose CRC32 does not match is
+ *  discarded and the device probed again. Set CONFIG_CACHE_ADDRESS to 0 to probe the device on every Init.
+ */
+
+#ifndef CONFIG_CACHE_ADDRESS
+#define CONFIG_CACHE_ADDRESS (0x2020FC00) // Last 1KB of the 64KB OCRAM
+#endif
 
 void disableWatchdog()
 {
@@ -52,6 +67,16 @@ void disableWatchdog()
     }
 }
 
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (config.sectorSize)
+#define DEVICE_PAGE_SIZE   (config.pageSize)
+
+int DeviceSectorErase(unsigned long adr, unsigned long sz)
+{
+    status_t status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr - BASE_ADDRESS, sz);
+    return (status != kStatus_Success);
+}
+
 /*
  *  Initialize Flash Programming Functions
  *    Parameter:      adr:  Device Base Address
@@ -62,11 +87,16 @@ void disableWatchdog()
 
 int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 {
+#if INCREMENTAL_PROGRAM
+    IncrementalReset(fnc);
+#endif
+
     status_t status;
     serial_nor_config_option_t option;
     disableWatchdog();
     option.option0.U = 0xc0000006; // QuadSPI NOR, Frequency: 100MHz
-    status           = flexspi_nor_get_config(FLEXSPI_NOR_INSTANCE, &config, &option);
+    status           = flexspi_nor_get_config_cached(FLEXSPI_NOR_INSTANCE, &config, &option,
+                                                     (flexspi_nor_config_cache_t *)CONFIG_CACHE_ADDRESS);
     if (status != kStatus_Success)
     {
         return 1;
@@ -82,7 +112,12 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 
 int UnInit(unsigned long fnc)
 {
-    /* Add your Code */
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFlush(fnc))
+    {
+        return (1);
+    }
+#endif
     return (0); // Finished without Errors
 }
 
@@ -104,20 +139,67 @@ int EraseChip(void)
 
 int EraseSector(unsigned long adr)
 {
-    adr = adr - BASE_ADDRESS;
-    return (kStatus_Success !=
-            flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr, SECTOR_SIZE)); // Erase 1 sector
+    unsigned long size = DEVICE_SECTOR_SIZE;
+    unsigned long end  = adr + SECTOR_SIZE;
+
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFinish())
+    {
+        return (1);
+    }
+#endif
+#if INCREMENTAL_PROGRAM
+    // Erase device sector by device sector, skipping the blank ones and deferring the others
+    for (; adr < end; adr += size)
+    {
+        if (!BlankCheck(adr, size, 0xFF))
+        {
+            g_incrementalStats.eraseHits++;
+            continue;
+        }
+        if (IncrementalDefer(adr, size))
+        {
+            continue;
+        }
+        g_incrementalStats.eraseMisses++;
+        if (DeviceSectorErase(adr, size))
+        {
+            return (1);
+        }
+    }
+#else
+    // One erase for the whole sector, so the driver can use its block erase commands
+    g_incrementalStats.eraseMisses += SECTOR_SIZE / size;
+    if (DeviceSectorErase(adr, SECTOR_SIZE))
+    {
+        return (1);
+    }
+#endif
+    return (0);
 }
 
 /*
  *  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
- *                    sz:   Page Size
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
  *                    buf:  Page Data
  *    Return Value:   0 - OK,  1 - Failed
  */
 
 int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    return (FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE));
+}
+
+/*
+ *  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram(unsigned long adr, unsigned long sz, unsigned char *buf)
 {
     adr = adr - BASE_ADDRESS;
     // Program data to destination
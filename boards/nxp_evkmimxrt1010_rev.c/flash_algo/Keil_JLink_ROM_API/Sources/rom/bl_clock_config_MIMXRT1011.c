@@ -7,7 +7,7 @@
  */
 
 //#include "bl_context.h"
-#include "bl_flexspi.h"
+#include "flexspi/fsl_flexspi.h"
 //#include "bl_ocotp.h"
 #include "bootloader_common.h"
 #include "fsl_assert.h"
@@ -72,6 +72,9 @@
 
 #define BL_FEATURE_FLEXSPI_NOR_MODULE (1)
 
+// bl_api.c does not route the FlexSPI NOR driver to the boot ROM, middleware/ provides all of it
+#define BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI (0)
+
 #if BL_FEATURE_FLEXSPI_NOR_MODULE
 #define BL_FEATURE_FLEXSPI_NOR_MODULE_PERIPHERAL_INSTANCE (0)
 #define BL_FEATURE_FLEXSPI_NOR_MODULE_ERASE_VERIFY (1)
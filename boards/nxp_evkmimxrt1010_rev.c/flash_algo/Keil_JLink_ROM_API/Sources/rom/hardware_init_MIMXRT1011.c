@@ -14,8 +14,8 @@
 #if BL_ENABLE_CRC_CHECK
 #include "bl_app_crc_check.h"
 #endif
-#include "bl_flexspi.h"
-#include "flexspi_nor_flash.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
 #include "fusemap.h"
 //#include "peripherals_pinmux.h"
 ////////////////////////////////////////////////////////////////////////////////
@@ -638,6 +638,26 @@ status_t flexspi_nor_read_persistent(uint32_t *data)
     return kStatus_Success;
 }
 
+//!@brief Override the drive strength of the FlexSPI pads
+void flexspi_update_padsetting(flexspi_mem_config_t *config, uint32_t driveStrength)
+{
+#define IOMUXC_PAD_SETTING_DSE_SHIFT (3)
+#define IOMUXC_PAD_SETTING_DSE_MASK (0x07 << IOMUXC_PAD_SETTING_DSE_SHIFT)
+#define IOMUXC_PAD_SETTING_DSE(x) (((x) << IOMUXC_PAD_SETTING_DSE_SHIFT) & IOMUXC_PAD_SETTING_DSE_MASK)
+    if (driveStrength)
+    {
+        config->dqsPadSettingOverride =
+            (FLEXSPI_DQS_SW_PAD_CTL_VAL & ~IOMUXC_PAD_SETTING_DSE_MASK) | IOMUXC_PAD_SETTING_DSE(driveStrength);
+        config->sclkPadSettingOverride =
+            (FLEXSPI_SW_PAD_CTL_VAL & ~IOMUXC_PAD_SETTING_DSE_MASK) | IOMUXC_PAD_SETTING_DSE(driveStrength);
+        config->dataPadSettingOverride =
+            (FLEXSPI_SW_PAD_CTL_VAL & ~IOMUXC_PAD_SETTING_DSE_MASK) | IOMUXC_PAD_SETTING_DSE(driveStrength);
+
+        config->csPadSettingOverride =
+            (FLEXSPI_DQS_SW_PAD_CTL_VAL & ~IOMUXC_PAD_SETTING_DSE_MASK) | IOMUXC_PAD_SETTING_DSE(driveStrength);
+    }
+}
+
 //!@brief Configure IOMUX for FlexSPI Peripheral
 void flexspi_iomux_config(uint32_t instance, flexspi_mem_config_t *config)
 {
@@ -126,7 +126,7 @@ void clock_init(void)
 }
 
 //!@brief Configure clock for FlexSPI peripheral
-void flexspi_clock_config(uint32_t instance, flexspi_serial_clk_freq_t freq, uint32_t sampleClkMode)
+void flexspi_clock_config(uint32_t instance, uint32_t freq, uint32_t sampleClkMode)
 {
     uint32_t pfd480 = 0;
     uint32_t cscmr1 = 0;
@@ -206,12 +206,14 @@ void flexspi_clock_config(uint32_t instance, flexspi_serial_clk_freq_t freq, uin
 //!@brief Gate on the clock for the FlexSPI peripheral
 void flexspi_clock_gate_enable(uint32_t instance)
 {
+    (void)instance;
     CCM->CCGR6 |= CCM_CCGR6_CG5_MASK;
 }
 
 //!@brief Gate off the clock the FlexSPI peripheral
 void flexspi_clock_gate_disable(uint32_t instance)
 {
+    (void)instance;
     CCM->CCGR6 &= (uint32_t)~CCM_CCGR6_CG5_MASK;
 }
 
@@ -225,6 +227,7 @@ status_t flexspi_get_clock(uint32_t instance, flexspi_clock_type_t type, uint32_
     uint32_t seralRootClkDivider;
     uint32_t arm_clock = SystemCoreClock;
 
+    (void)instance;
     switch (type)
     {
         case kFlexSpiClock_CoreClock:
@@ -242,10 +245,6 @@ status_t flexspi_get_clock(uint32_t instance, flexspi_clock_type_t type, uint32_
             uint32_t pfdFrac;
             uint32_t pfdClk;
 
-            // FLEXPI CLK SEL
-            uint32_t flexspi_clk_src =
-                (CCM->CSCMR1 & CCM_CSCMR1_FLEXSPI_CLK_SEL_MASK) >> CCM_CSCMR1_FLEXSPI_CLK_SEL_SHIFT;
-
             // PLL_480_PFD0
             pfdFrac = (CCM_ANALOG->PFD_480 & CCM_ANALOG_PFD_480_PFD0_FRAC_MASK) >> CCM_ANALOG_PFD_480_PFD0_FRAC_SHIFT;
             pfdClk  = FREQ_480MHz / pfdFrac * 18;
@@ -9,8 +9,8 @@
 #define __BL_API_H__
 
 #include <string.h>
-#include "bl_flexspi.h"
-#include "flexspi_nor_flash.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
 #include "fsl_device_registers.h"
 
 /*******************************************************************************
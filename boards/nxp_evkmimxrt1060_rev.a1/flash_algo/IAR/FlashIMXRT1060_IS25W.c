@@ -29,14 +29,50 @@
 #include <ctype.h>
 #include "flash_loader.h"       // The flash loader framework API declarations.
 #include "flash_loader_extra.h"
+#include "sw_crc.h"
 #include "bl_api.h"
 
 /** local definitions **/
 
 #define FLEXSPI_NOR_INSTANCE 0
+#define FLEXSPI_NOR_BASE FLEXSPI
 #define FLASH_BASE_ADDR 0x60000000
 #define FLASH_CONTEXT (*(uint32_t*)0x50002380)
    
+/* LUT sequences of the config block used by the streaming page program */
+#define LUT_SEQ_IDX_READSTATUS 1
+#define LUT_SEQ_IDX_READSTATUS_XPI 2
+#define LUT_SEQ_IDX_WRITEENABLE 3
+#define LUT_SEQ_IDX_WRITEENABLE_XPI 4
+#define LUT_SEQ_IDX_PAGEPROGRAM 9
+#define SERIAL_NOR_TYPE_STANDARD_SPI 0
+#define SERIAL_NOR_TYPE_XPI 2
+/* Bytes moved by one IP TX/RX FIFO watermark event, TXWMRK/RXWMRK = 0 */
+#define FLEXSPI_FIFO_WATERMARK 8
+/* Core cycles covering 10 serial clocks at 30MHz with a 600MHz core */
+#define FLEXSPI_CLOCK_STABLE_CYCLES 200
+/* FLEXSPI_CLK_SEL of PLL3 PFD0, the only root clock the IP command clock is switched on */
+#define FLEXSPI_CLK_SEL_PLL3_PFD0 3
+/* PLL3 output and PFD fraction and divider ranges */
+#define PLL3_FREQ_KHZ 480000
+#define PLL3_PFD_FRAC_MIN 12
+#define PLL3_PFD_FRAC_MAX 35
+#define FLEXSPI_PODF_MAX 8
+/* Fastest core clock of the RT106x, counting the busy timeout with it never makes it shorter than timeoutInMs */
+#define CORE_CLOCK_MAX_KHZ 600000
+/* Core cycle counter of the busy timeout, the host build of the loader counts the virtual time instead */
+#ifdef FLEXSPI_TRACE_GET_CYCLES
+#define STREAM_GET_CYCLES() FLEXSPI_TRACE_GET_CYCLES()
+#else
+#define STREAM_GET_CYCLES() (DWT->CYCCNT)
+#endif
+/* FlashChecksum backends, both return the Crc16() value the debugger compares with */
+#define CHECKSUM_BACKEND_FRAMEWORK 0 /* Crc16() of the flash loader framework, bit by bit */
+#define CHECKSUM_BACKEND_SW_CRC 1    /* sw_crc16(), table driven, SW_CRC_METHOD selects the tables */
+#ifndef CHECKSUM_BACKEND
+#define CHECKSUM_BACKEND CHECKSUM_BACKEND_SW_CRC
+#endif
+
 /** default settings **/
 
 /** external functions **/
@@ -49,8 +85,25 @@
 
 /** private data **/
 flexspi_nor_config_t config;
+/* Part of a page that is moved into the IP TX FIFO */
+typedef struct
+{
+  const uint8_t *src;
+  uint32_t size;
+  uint32_t pushed;
+} tx_page_t;
+/* Serial clock of a flexspi_serial_clk_freq_t in MHz, the encoding of the config block */
+static const uint8_t serialClkFreqMHz[kFlexSpiSerialClk_166MHz + 1] = {
+  0, 30, 50, 60, 75, 80, 100, 120, 133, 166};
 /** internal functions **/
 static uint32_t strToUint(const char *str);
+static bool stream_write_supported(void);
+static void stream_clock_param(uint32_t freq, uint32_t *pfd480, uint32_t *cscmr1);
+static void stream_clock_config(uint32_t pfd480, uint32_t cscmr1);
+static void stream_push_tx(tx_page_t *page);
+static status_t stream_ip_command(uint32_t addr, uint32_t seqId, uint32_t size, tx_page_t *page);
+static status_t stream_wait_busy(uint32_t addr, uint32_t seqId, tx_page_t *next);
+static status_t stream_write(uint32_t addr, uint32_t count, const uint8_t *buffer);
 /** public functions **/
 
 /*************************************************************************
@@ -150,6 +203,11 @@ uint32_t FlashInit(void *base_of_flash, uint32_t image_size,
         CCM_ANALOG->PLL_USB1 &= ~CCM_ANALOG_PLL_USB1_BYPASS_MASK;
     }
     
+    /* Cycle counter of the busy timeout of the streaming page program */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     bl_api_init();
     
 #if USE_ARGC_ARGV
@@ -255,6 +313,13 @@ uint32_t FlashWrite(void *block_start,
   uint32_t addr = (uint32_t)block_start+offset_into_block - FLASH_BASE_ADDR;
   status_t status = 0;
 
+  /* Stream the pages with IP commands when the device allows it, the ROM
+   * page program reloads the LUT and flushes the AHB buffers on every page */
+  if(stream_write_supported())
+  {
+    return stream_write(addr, count, (const uint8_t *)buffer);
+  }
+
   for(uint32_t size = 0; size < count; size+=config.pageSize,
                                        buffer+=config.pageSize,
                                        addr+=config.pageSize)
@@ -292,17 +357,22 @@ uint32_t FlashErase(void *block_start,
 
 /*************************************************************************
  * Function Name: FlashChecksum
- * Parameters:  none
+ * Parameters:  start address and size of the range
  *
- * Return: 0
+ * Return: CRC-16 of the range, same value as Crc16()
  *
- * Description: Restore the performance mode.
+ * Description: Checksum of the programmed range, compared by the debugger
+ *              with the one of the image.
  *************************************************************************/
 OPTIONAL_CHECKSUM
 
 uint32_t FlashChecksum(void const *begin, uint32_t count)
 {
+#if CHECKSUM_BACKEND == CHECKSUM_BACKEND_SW_CRC
+  return sw_crc16(0, begin, count);
+#else
   return Crc16((uint8_t const *)begin, count);
+#endif
 }
 
 OPTIONAL_SIGNOFF
@@ -356,3 +426,299 @@ static uint32_t strToUint(const char *str)
     return result;
 }
 #endif
+
+/*************************************************************************
+ * Function Name: stream_write_supported
+ * Parameters:  none
+ *
+ * Return: true if FlashWrite can stream the pages with IP commands
+ *
+ * Description: The streaming page program drives a single Serial NOR on
+ *              port A1 with the LUT of the config block. The IP command
+ *              clock is only switched when the FlexSPI root clock is PLL3
+ *              PFD0 and the DLL setting does not depend on the serial
+ *              clock, i.e. with a loopback read sample clock. Devices that
+ *              need custom LUT sequences, half clock or no-command mode
+ *              handling keep the ROM page program.
+ *************************************************************************/
+static bool stream_write_supported(void)
+{
+    uint32_t miscOption = config.memConfig.controllerMiscOption;
+    uint32_t clockSel   = (CCM->CSCMR1 & CCM_CSCMR1_FLEXSPI_CLK_SEL_MASK) >> CCM_CSCMR1_FLEXSPI_CLK_SEL_SHIFT;
+    bool isClockSupported =
+        (config.ipcmdSerialClkFreq == kFlexSpiSerialClk_NoChange) ||
+        ((config.ipcmdSerialClkFreq <= kFlexSpiSerialClk_166MHz) && (clockSel == FLEXSPI_CLK_SEL_PLL3_PFD0) &&
+         (config.memConfig.readSampleClkSrc != kFlexSPIReadSampleClk_ExternalInputFromDqsPad));
+
+    return (config.memConfig.deviceType == kFlexSpiDeviceType_SerialNOR) &&
+           ((config.serialNorType == SERIAL_NOR_TYPE_STANDARD_SPI) ||
+            (config.serialNorType == SERIAL_NOR_TYPE_XPI)) &&
+           !config.memConfig.lutCustomSeqEnable && isClockSupported && !config.halfClkForNonReadCmd &&
+           !config.needExitNoCmdMode && !config.needRestoreNoCmdMode && !config.isDataOrderSwapped &&
+           (config.pageSize != 0) && (config.pageSize <= FLEXSPI_IPCR1_IDATSZ_MASK) &&
+           !(miscOption &
+             ((1u << kFlexSpiMiscOffset_ParallelEnable) | (1u << kFlexSpiMiscOffset_WordAddressableEnable)));
+}
+
+/*************************************************************************
+ * Function Name: stream_clock_param
+ * Parameters:  serial clock, flexspi_serial_clk_freq_t, PFD_480 and
+ *              CSCMR1 values
+ *
+ * Return: none
+ *
+ * Description: Derive the PLL3 PFD0 fraction and FLEXSPI_PODF divider of
+ *              a serial clock of the config block: the fastest root clock
+ *              that does not exceed it, twice the serial clock in DDR
+ *              mode. Only PFD0 and the divider are changed.
+ *************************************************************************/
+static void stream_clock_param(uint32_t freq, uint32_t *pfd480, uint32_t *cscmr1)
+{
+    bool isDdr      = (config.memConfig.controllerMiscOption & (1u << kFlexSpiMiscOffset_DdrModeEnable)) != 0;
+    uint32_t maxKHz = serialClkFreqMHz[freq] * 1000u * (isDdr ? 2u : 1u);
+    uint32_t bestKHz = 0;
+    uint32_t bestFrac = PLL3_PFD_FRAC_MAX;
+    uint32_t bestPodf = FLEXSPI_PODF_MAX;
+
+    for (uint32_t podf = 1; podf <= FLEXSPI_PODF_MAX; podf++)
+    {
+        for (uint32_t frac = PLL3_PFD_FRAC_MIN; frac <= PLL3_PFD_FRAC_MAX; frac++)
+        {
+            uint32_t rootKHz = PLL3_FREQ_KHZ * 18u / (frac * podf);
+
+            if ((rootKHz <= maxKHz) && (rootKHz > bestKHz))
+            {
+                bestKHz  = rootKHz;
+                bestFrac = frac;
+                bestPodf = podf;
+            }
+        }
+    }
+
+    *pfd480 = (CCM_ANALOG->PFD_480 & ~CCM_ANALOG_PFD_480_PFD0_FRAC_MASK) | CCM_ANALOG_PFD_480_PFD0_FRAC(bestFrac);
+    *cscmr1 = (CCM->CSCMR1 & ~CCM_CSCMR1_FLEXSPI_PODF_MASK) | CCM_CSCMR1_FLEXSPI_PODF(bestPodf - 1);
+}
+
+/*************************************************************************
+ * Function Name: stream_clock_config
+ * Parameters:  PFD_480 and CSCMR1 values
+ *
+ * Return: none
+ *
+ * Description: Switch the FlexSPI serial root clock the way the ROM does
+ *              around each IP command, with the module disabled and the
+ *              clock gated off.
+ *************************************************************************/
+static void stream_clock_config(uint32_t pfd480, uint32_t cscmr1)
+{
+    FLEXSPI_Type *base = FLEXSPI_NOR_BASE;
+
+    if ((pfd480 == CCM_ANALOG->PFD_480) && (cscmr1 == CCM->CSCMR1))
+    {
+        return;
+    }
+
+    while ((base->STS0 & (FLEXSPI_STS0_ARBIDLE_MASK | FLEXSPI_STS0_SEQIDLE_MASK)) !=
+           (FLEXSPI_STS0_ARBIDLE_MASK | FLEXSPI_STS0_SEQIDLE_MASK))
+    {
+    }
+    base->MCR0 |= FLEXSPI_MCR0_MDIS_MASK;
+    CCM->CCGR6 &= ~CCM_CCGR6_CG5_MASK;
+    CCM_ANALOG->PFD_480 = pfd480;
+    CCM->CSCMR1         = cscmr1;
+    CCM->CCGR6 |= CCM_CCGR6_CG5_MASK;
+    base->MCR0 &= ~FLEXSPI_MCR0_MDIS_MASK;
+
+    /* Let the serial clock output become stable, at least 10 serial clocks */
+    for (uint32_t i = 0; i < FLEXSPI_CLOCK_STABLE_CYCLES; i++)
+    {
+        __no_operation();
+    }
+}
+
+/*************************************************************************
+ * Function Name: stream_push_tx
+ * Parameters:  page being moved into the IP TX FIFO
+ *
+ * Return: none
+ *
+ * Description: Fill the IP TX FIFO with the page as long as it has room.
+ *              Data pushed before the program command is triggered stays
+ *              in the FIFO, so the next page is queued while the current
+ *              one is still programming.
+ *************************************************************************/
+static void stream_push_tx(tx_page_t *page)
+{
+    FLEXSPI_Type *base = FLEXSPI_NOR_BASE;
+
+    while ((page->pushed < page->size) && (base->INTR & FLEXSPI_INTR_IPTXWE_MASK))
+    {
+        uint32_t data[FLEXSPI_FIFO_WATERMARK / sizeof(uint32_t)] = {0};
+        uint32_t size = page->size - page->pushed;
+
+        if (size > FLEXSPI_FIFO_WATERMARK)
+        {
+            size = FLEXSPI_FIFO_WATERMARK;
+        }
+        memcpy(data, page->src + page->pushed, size);
+        base->TFDR[0] = data[0];
+        base->TFDR[1] = data[1];
+        base->INTR    = FLEXSPI_INTR_IPTXWE_MASK;
+        page->pushed += size;
+    }
+}
+
+/*************************************************************************
+ * Function Name: stream_ip_command
+ * Parameters:  flash address, LUT sequence, data size, page to keep
+ *              pushing into the IP TX FIFO while the command runs
+ *
+ * Return: kStatus_Success or kStatus_Fail on IP command error
+ *
+ * Description: Run one IP command and wait for its completion.
+ *************************************************************************/
+static status_t stream_ip_command(uint32_t addr, uint32_t seqId, uint32_t size, tx_page_t *page)
+{
+    FLEXSPI_Type *base = FLEXSPI_NOR_BASE;
+
+    base->FLSHCR2[0] |= FLEXSPI_FLSHCR2_CLRINSTRPTR_MASK;
+    base->INTR  = FLEXSPI_INTR_IPCMDDONE_MASK | FLEXSPI_INTR_IPCMDERR_MASK;
+    base->IPCR0 = addr;
+    base->IPCR1 = FLEXSPI_IPCR1_IDATSZ(size) | FLEXSPI_IPCR1_ISEQID(seqId);
+    base->IPCMD = FLEXSPI_IPCMD_TRG_MASK;
+    while (!(base->INTR & (FLEXSPI_INTR_IPCMDDONE_MASK | FLEXSPI_INTR_IPCMDERR_MASK)))
+    {
+        stream_push_tx(page);
+    }
+
+    return (base->INTR & FLEXSPI_INTR_IPCMDERR_MASK) ? kStatus_Fail : kStatus_Success;
+}
+
+/*************************************************************************
+ * Function Name: stream_wait_busy
+ * Parameters:  flash address, read status LUT sequence, next page
+ *
+ * Return: kStatus_Success, kStatus_Fail on IP command error or
+ *         kStatus_Timeout
+ *
+ * Description: Poll the status register until the program completes and
+ *              prefill the IP TX FIFO with the next page meanwhile. Like
+ *              the ROM, give up once the device has been busy for
+ *              timeoutInMs of the config block, 0 waits forever.
+ *************************************************************************/
+static status_t stream_wait_busy(uint32_t addr, uint32_t seqId, tx_page_t *next)
+{
+    FLEXSPI_Type *base     = FLEXSPI_NOR_BASE;
+    uint32_t busyMask      = 1u << config.memConfig.busyOffset;
+    uint32_t busyValue     = config.memConfig.busyBitPolarity ? 0 : busyMask;
+    uint64_t timeoutCycles = (uint64_t)config.memConfig.timeoutInMs * CORE_CLOCK_MAX_KHZ;
+    uint64_t elapsedCycles = 0;
+    uint32_t lastCycles    = STREAM_GET_CYCLES();
+    uint32_t flashStatus;
+    status_t status;
+
+    do
+    {
+        base->IPRXFCR = FLEXSPI_IPRXFCR_CLRIPRXF_MASK;
+        status        = stream_ip_command(addr, seqId, sizeof(flashStatus), next);
+        flashStatus   = base->RFDR[0];
+
+        /* Accumulate the cycles poll by poll, CYCCNT wraps within seconds */
+        if ((status == kStatus_Success) && timeoutCycles)
+        {
+            uint32_t cycles = STREAM_GET_CYCLES();
+
+            elapsedCycles += cycles - lastCycles;
+            lastCycles = cycles;
+            if ((elapsedCycles >= timeoutCycles) && ((flashStatus & busyMask) == busyValue))
+            {
+                status = kStatus_Timeout;
+            }
+        }
+    } while ((status == kStatus_Success) && ((flashStatus & busyMask) == busyValue));
+
+    return status;
+}
+
+/*************************************************************************
+ * Function Name: stream_write
+ * Parameters:  flash offset, data size, ram buffer pointer
+ *
+ * Return: RESULT_OK or RESULT_ERROR
+ *
+ * Description: Program all pages of the buffer with one IP clock switch,
+ *              one LUT update and one AHB buffer flush. The next page is
+ *              queued in the IP TX FIFO while the current one is
+ *              programming, so the program command starts right after the
+ *              write enable.
+ *************************************************************************/
+static status_t stream_write(uint32_t addr, uint32_t count, const uint8_t *buffer)
+{
+    FLEXSPI_Type *base       = FLEXSPI_NOR_BASE;
+    const uint32_t *lut      = config.memConfig.lookupTable;
+    bool isXpi               = (config.serialNorType == SERIAL_NOR_TYPE_XPI);
+    uint32_t seqReadStatus   = isXpi ? LUT_SEQ_IDX_READSTATUS_XPI : LUT_SEQ_IDX_READSTATUS;
+    uint32_t seqWriteEnable  = isXpi ? LUT_SEQ_IDX_WRITEENABLE_XPI : LUT_SEQ_IDX_WRITEENABLE;
+    status_t status          = kStatus_Success;
+    uint32_t pfd480          = CCM_ANALOG->PFD_480;
+    uint32_t cscmr1          = CCM->CSCMR1;
+    tx_page_t page;
+
+    /* The read clock the ROM set from the config block is restored as it was */
+    if (config.ipcmdSerialClkFreq != kFlexSpiSerialClk_NoChange)
+    {
+        uint32_t ipcmdPfd480;
+        uint32_t ipcmdCscmr1;
+
+        stream_clock_param(config.ipcmdSerialClkFreq, &ipcmdPfd480, &ipcmdCscmr1);
+        stream_clock_config(ipcmdPfd480, ipcmdCscmr1);
+    }
+
+    /* The ROM keeps its last IP command in the read status slot, reload the
+     * sequences once for the whole buffer */
+    flexspi_update_lut(FLEXSPI_NOR_INSTANCE, seqReadStatus, &lut[4 * seqReadStatus], 1);
+    flexspi_update_lut(FLEXSPI_NOR_INSTANCE, seqWriteEnable, &lut[4 * seqWriteEnable], 1);
+    flexspi_update_lut(FLEXSPI_NOR_INSTANCE, LUT_SEQ_IDX_PAGEPROGRAM, &lut[4 * LUT_SEQ_IDX_PAGEPROGRAM], 1);
+
+    base->IPTXFCR = FLEXSPI_IPTXFCR_CLRIPTXF_MASK;
+    page.src      = buffer;
+    page.size     = config.pageSize - (addr % config.pageSize);
+    page.size     = (page.size > count) ? count : page.size;
+    page.pushed   = 0;
+    stream_push_tx(&page);
+
+    while (page.size != 0)
+    {
+        uint32_t pageAddr = addr;
+
+        status = stream_ip_command(pageAddr, seqWriteEnable, 0, &page);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+        status = stream_ip_command(pageAddr, LUT_SEQ_IDX_PAGEPROGRAM, page.size, &page);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+
+        /* Drop the padding of a partial FIFO entry, then queue the next page */
+        base->IPTXFCR = FLEXSPI_IPTXFCR_CLRIPTXF_MASK;
+        addr += page.size;
+        count -= page.size;
+        page.src += page.size;
+        page.size   = (count > config.pageSize) ? config.pageSize : count;
+        page.pushed = 0;
+
+        status = stream_wait_busy(pageAddr, seqReadStatus, &page);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+    }
+
+    stream_clock_config(pfd480, cscmr1);
+    flexspi_clear_cache(FLEXSPI_NOR_INSTANCE);
+
+    return (status == kStatus_Success) ? RESULT_OK : RESULT_ERROR;
+}
@@ -29,13 +29,37 @@
 #include <ctype.h>
 #include "flash_loader.h"       // The flash loader framework API declarations.
 #include "flash_loader_extra.h"
+#include "sw_crc.h"
 #include "fsl_device_registers.h"
 #include "fsl_clock.h"
 #include "fsl_rtwdog.h"
 #include "fsl_wdog.h"
+#include "fsl_semc.h"
 
 /** local definitions **/
-   
+
+/* FlashChecksum backends, both return the Crc16() value the debugger compares with */
+#define CHECKSUM_BACKEND_FRAMEWORK 0 /* Crc16() of the flash loader framework, bit by bit */
+#define CHECKSUM_BACKEND_SW_CRC 1    /* sw_crc16(), table driven, SW_CRC_METHOD selects the tables */
+#ifndef CHECKSUM_BACKEND
+#define CHECKSUM_BACKEND CHECKSUM_BACKEND_SW_CRC
+#endif
+
+/* SDRAM of the EVK on SEMC CS0: IS42S16160J-6, 32MB, 16-bit, 166MHz at most */
+#define SEMC_SDRAM_BASE_ADDR 0x80000000
+#define SEMC_SDRAM_SIZE 0x02000000
+#define SEMC_SDRAM_MAX_FREQ 166000000
+#define SEMC_EMC_PAD_COUNT 40 /* GPIO_EMC_00 to GPIO_EMC_39 */
+#define SEMC_EMC_PAD_CTL 0x000110F9 /* Fast slew, R0/7 drive, 200MHz, keeper, hysteresis */
+
+/* FlashWrite copies COPY_CHUNK_SIZE bytes at a time with 64-bit accesses, then reads the chunk back for the
+   CRC-16, so that FlashChecksum of a written range needs no second pass over the RAM */
+#ifndef COPY_CHUNK_SIZE
+#define COPY_CHUNK_SIZE 4096
+#endif
+/* Contiguous ranges written since FlashInit whose CRC-16 is known */
+#define CHECKSUM_MAX_RUNS 8
+
 /** default settings **/
 
 /** external functions **/
@@ -47,9 +71,25 @@
 /** public data **/
 
 /** private data **/
+#if CHECKSUM_BACKEND == CHECKSUM_BACKEND_SW_CRC
+typedef struct _checksum_run
+{
+  uint32_t start;
+  uint32_t end;
+  uint16_t crc;
+} checksum_run_t;
+
+static checksum_run_t s_checksumRuns[CHECKSUM_MAX_RUNS];
+static uint32_t s_checksumRunCount;
+#endif
 
 /** internal functions **/
 static uint32_t strToUint(const char *str);
+static status_t sdramInit(void);
+static uint16_t copyAndCrc(uint8_t *dst, const uint8_t *src, uint32_t count, uint16_t crc);
+#if CHECKSUM_BACKEND == CHECKSUM_BACKEND_SW_CRC
+static void checksumRecord(uint32_t addr, uint32_t count, char const *buffer);
+#endif
 /** public functions **/
 
 /*************************************************************************
@@ -88,7 +128,20 @@ uint32_t FlashInit(void *base_of_flash, uint32_t image_size,
     RTWDOG->CNT   = 0xD928C520U; /* 0xD928C520U is the update key */
     RTWDOG->TOVAL = 0xFFFF;
     RTWDOG->CS    = (uint32_t)((RTWDOG->CS) & ~RTWDOG_CS_EN_MASK) | RTWDOG_CS_UPDATE_MASK;
-    
+
+#if CHECKSUM_BACKEND == CHECKSUM_BACKEND_SW_CRC
+    s_checksumRunCount = 0;
+#endif
+    /* The same loader serves ITCM, DTCM and SDRAM, only SDRAM needs the controller set up */
+    if (((uint32_t)base_of_flash >= SEMC_SDRAM_BASE_ADDR) &&
+        ((uint32_t)base_of_flash < SEMC_SDRAM_BASE_ADDR + SEMC_SDRAM_SIZE))
+    {
+        if (sdramInit() != kStatus_Success)
+        {
+            status = RESULT_ERROR;
+        }
+    }
+
     return status; 
 }
 
@@ -107,7 +160,11 @@ uint32_t FlashWrite(void *block_start,
 {
   uint32_t addr = (uint32_t)block_start+offset_into_block;
 
-  memcpy((void *)addr, buffer, count);
+#if CHECKSUM_BACKEND == CHECKSUM_BACKEND_SW_CRC
+  checksumRecord(addr, count, buffer);
+#else
+  copyAndCrc((uint8_t *)addr, (const uint8_t *)buffer, count, 0);
+#endif
   
   return RESULT_OK;
 }
@@ -118,29 +175,41 @@ uint32_t FlashWrite(void *block_start,
  *
  * Return: 0
  *
- * Description: Erase block
+ * Description: RAM needs no erase, FlashWrite overwrites it. The block is
+ *              left as it is.
  *************************************************************************/
 uint32_t FlashErase(void *block_start,
                     uint32_t block_size)
 {
-  memset(block_start, 0xFF, block_size);
-  
   return RESULT_OK;
 }
 
 /*************************************************************************
  * Function Name: FlashChecksum
- * Parameters:  none
+ * Parameters:  start address and size of the range
  *
- * Return: 0
+ * Return: CRC-16 of the range, same value as Crc16()
  *
- * Description: Restore the performance mode.
+ * Description: Checksum of the programmed range, compared by the debugger
+ *              with the one of the image. A range FlashWrite wrote in one
+ *              run returns the CRC-16 it computed on the data read back.
  *************************************************************************/
 OPTIONAL_CHECKSUM
 
 uint32_t FlashChecksum(void const *begin, uint32_t count)
 {
+#if CHECKSUM_BACKEND == CHECKSUM_BACKEND_SW_CRC
+  for (uint32_t i = 0; i < s_checksumRunCount; i++)
+  {
+    if ((s_checksumRuns[i].start == (uint32_t)begin) && (s_checksumRuns[i].end == (uint32_t)begin + count))
+    {
+      return s_checksumRuns[i].crc;
+    }
+  }
+  return sw_crc16(0, begin, count);
+#else
   return Crc16((uint8_t const *)begin, count);
+#endif
 }
 
 OPTIONAL_SIGNOFF
@@ -158,6 +227,172 @@ uint32_t FlashSignoff(void)
   return (RESULT_OK);
 }
 /** private functions **/
+/*************************************************************************
+ * Set up the SEMC clock, pins and controller, then the SDRAM on CS0
+ *************************************************************************/
+static status_t sdramInit(void)
+{
+  semc_config_t config;
+  semc_sdram_config_t sdramconfig;
+
+  /* Controller clocks and IOMUXC, gated on by the drivers of the SDK */
+  CCM->CCGR1 |= CCM_CCGR1_CG9_MASK;
+  CCM->CCGR3 |= CCM_CCGR3_CG2_MASK;
+  CCM->CCGR4 |= CCM_CCGR4_CG1_MASK;
+
+  /* SEMC_CLK from PLL2 PFD2. The PFD keeps its fraction, the core may run from it, only the SEMC
+     divider is set to stay within the SDRAM clock. */
+  if ((CCM_ANALOG->PLL_SYS & (CCM_ANALOG_PLL_SYS_ENABLE_MASK | CCM_ANALOG_PLL_SYS_BYPASS_MASK)) !=
+      CCM_ANALOG_PLL_SYS_ENABLE_MASK)
+  {
+    CCM_ANALOG->PLL_SYS = CCM_ANALOG_PLL_SYS_ENABLE_MASK | CCM_ANALOG_PLL_SYS_BYPASS_MASK | CCM_ANALOG_PLL_SYS_DIV_SELECT(1);
+    while ((CCM_ANALOG->PLL_SYS & CCM_ANALOG_PLL_SYS_LOCK_MASK) == 0)
+    {
+    }
+    CCM_ANALOG->PLL_SYS &= ~CCM_ANALOG_PLL_SYS_BYPASS_MASK;
+  }
+  CCM_ANALOG->PFD_528 &= ~CCM_ANALOG_PFD_528_PFD2_CLKGATE_MASK;
+  uint32_t frac = (CCM_ANALOG->PFD_528 & CCM_ANALOG_PFD_528_PFD2_FRAC_MASK) >> CCM_ANALOG_PFD_528_PFD2_FRAC_SHIFT;
+  uint32_t pfdHz = (uint32_t)(528000000ULL * 18 / frac);
+  uint32_t podf = (pfdHz + SEMC_SDRAM_MAX_FREQ - 1) / SEMC_SDRAM_MAX_FREQ;
+  uint32_t semcHz = pfdHz / podf;
+  CCM->CBCDR = (CCM->CBCDR & ~(CCM_CBCDR_SEMC_ALT_CLK_SEL_MASK | CCM_CBCDR_SEMC_PODF_MASK)) |
+               CCM_CBCDR_SEMC_CLK_SEL_MASK | CCM_CBCDR_SEMC_PODF(podf - 1);
+  while (CCM->CDHIPR & CCM_CDHIPR_SEMC_PODF_BUSY_MASK)
+  {
+  }
+
+  /* GPIO_EMC_00..39 as SEMC (ALT0), EMC_39 is DQS and loops the read strobe back */
+  for (uint32_t i = 0; i < SEMC_EMC_PAD_COUNT; i++)
+  {
+    IOMUXC->SW_MUX_CTL_PAD[kIOMUXC_SW_MUX_CTL_PAD_GPIO_EMC_00 + i] = 0;
+    IOMUXC->SW_PAD_CTL_PAD[kIOMUXC_SW_PAD_CTL_PAD_GPIO_EMC_00 + i] = SEMC_EMC_PAD_CTL;
+  }
+  IOMUXC->SW_MUX_CTL_PAD[kIOMUXC_SW_MUX_CTL_PAD_GPIO_EMC_39] = IOMUXC_SW_MUX_CTL_PAD_SION_MASK;
+
+  SEMC_GetDefaultConfig(&config);
+  config.dqsMode = kSEMC_Loopbackdqspad;
+  SEMC_Init(SEMC, &config);
+
+  memset(&sdramconfig, 0, sizeof(sdramconfig));
+  sdramconfig.csxPinMux = kSEMC_MUXCSX0;
+  sdramconfig.address = SEMC_SDRAM_BASE_ADDR;
+  sdramconfig.memsize_kbytes = SEMC_SDRAM_SIZE / 1024;
+  sdramconfig.portSize = kSEMC_PortSize16Bit;
+  sdramconfig.burstLen = kSEMC_Sdram_BurstLen8;
+  sdramconfig.columnAddrBitNum = kSEMC_SdramColunm_9bit;
+  sdramconfig.casLatency = kSEMC_LatencyThree;
+  sdramconfig.tPrecharge2Act_Ns = 18;   /* Trp */
+  sdramconfig.tAct2ReadWrite_Ns = 18;   /* Trcd */
+  sdramconfig.tRefreshRecovery_Ns = 67; /* Larger of Trfc and Txsr */
+  sdramconfig.tWriteRecovery_Ns = 12;
+  sdramconfig.tCkeOff_Ns = 42;          /* CKE stays off for Tras in self refresh */
+  sdramconfig.tAct2Prechage_Ns = 42;    /* Tras */
+  sdramconfig.tSelfRefRecovery_Ns = 67;
+  sdramconfig.tRefresh2Refresh_Ns = 60;
+  sdramconfig.tAct2Act_Ns = 60;
+  sdramconfig.tPrescalePeriod_Ns = 160 * (1000000000 / semcHz);
+  sdramconfig.refreshPeriod_nsPerRow = 64 * 1000000 / 8192; /* 64ms for 8192 rows */
+  sdramconfig.refreshUrgThreshold = sdramconfig.refreshPeriod_nsPerRow;
+  sdramconfig.refreshBurstLen = 1;
+
+  return SEMC_ConfigureSDRAM(SEMC, kSEMC_SDRAM_CS0, &sdramconfig, semcHz);
+}
+
+/*************************************************************************
+ * Copy count bytes and return the CRC-16 of the copy continued from crc.
+ * 8-byte aligned chunks move with 64-bit loads and stores, each chunk is
+ * read back from the destination for the CRC right after it is written.
+ *************************************************************************/
+static uint16_t copyAndCrc(uint8_t *dst, const uint8_t *src, uint32_t count, uint16_t crc)
+{
+  while (count)
+  {
+    uint32_t chunk = (count < COPY_CHUNK_SIZE) ? count : COPY_CHUNK_SIZE;
+    uint32_t head = (8 - ((uint32_t)dst & 7)) & 7;
+
+    if (head && (head < chunk))
+    {
+      /* Align the destination first, the next chunks then start aligned */
+      chunk = head;
+    }
+    if (((((uint32_t)dst | (uint32_t)src) & 7) == 0) && ((chunk & 7) == 0))
+    {
+      uint64_t *d = (uint64_t *)dst;
+      const uint64_t *s = (const uint64_t *)src;
+      for (uint32_t i = 0; i < chunk / 32; i++)
+      {
+        uint64_t a = s[0], b = s[1], c = s[2], e = s[3];
+        d[0] = a;
+        d[1] = b;
+        d[2] = c;
+        d[3] = e;
+        d += 4;
+        s += 4;
+      }
+      for (uint32_t i = 0; i < (chunk & 31) / 8; i++)
+      {
+        *d++ = *s++;
+      }
+    }
+    else
+    {
+      memcpy(dst, src, chunk);
+    }
+#if CHECKSUM_BACKEND == CHECKSUM_BACKEND_SW_CRC
+    crc = sw_crc16(crc, dst, chunk);
+#endif
+    dst += chunk;
+    src += chunk;
+    count -= chunk;
+  }
+
+  return crc;
+}
+
+#if CHECKSUM_BACKEND == CHECKSUM_BACKEND_SW_CRC
+/*************************************************************************
+ * Copy a FlashWrite buffer and keep the CRC-16 of the run it continues.
+ * Runs the write overlaps no longer match memory and are dropped.
+ *************************************************************************/
+static void checksumRecord(uint32_t addr, uint32_t count, char const *buffer)
+{
+  checksum_run_t *run = NULL;
+  uint32_t kept = 0;
+
+  for (uint32_t i = 0; i < s_checksumRunCount; i++)
+  {
+    checksum_run_t *item = &s_checksumRuns[i];
+    if ((item->end == addr) && (run == NULL))
+    {
+      run = &s_checksumRuns[kept];
+    }
+    else if ((item->start < addr + count) && (addr < item->end))
+    {
+      continue;
+    }
+    s_checksumRuns[kept++] = *item;
+  }
+  s_checksumRunCount = kept;
+
+  if (run == NULL)
+  {
+    if (s_checksumRunCount == CHECKSUM_MAX_RUNS)
+    {
+      /* Forget the oldest run, FlashChecksum computes it again if asked */
+      memmove(&s_checksumRuns[0], &s_checksumRuns[1], sizeof(s_checksumRuns) - sizeof(s_checksumRuns[0]));
+      s_checksumRunCount--;
+    }
+    run = &s_checksumRuns[s_checksumRunCount++];
+    run->start = addr;
+    run->end = addr;
+    run->crc = 0;
+  }
+  run->crc = copyAndCrc((uint8_t *)addr, (const uint8_t *)buffer, count, run->crc);
+  run->end = addr + count;
+}
+#endif
+
 #if USE_ARGC_ARGV
 /*************************************************************************
 * String to unsigned integer
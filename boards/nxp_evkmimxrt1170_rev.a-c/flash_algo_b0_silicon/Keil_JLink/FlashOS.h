@@ -20,6 +20,8 @@
 #define SECTOR_NUM 512 // Max Number of Sector Items
 #define PAGE_MAX 65536 // Max Page Size for Programming
 
+#include "FlashLayout.h" // Programming Page Size and RAM for Algorithm
+
 #ifndef ALIAS_PROGRAM
 #define FLASH_BASE_ADDRESS 0x30000000
 #else
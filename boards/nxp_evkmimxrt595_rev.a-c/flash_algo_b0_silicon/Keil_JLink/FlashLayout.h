@@ -0,0 +1,8 @@
+/* -----------------------------------------------------------------------------
+ * Project:      RAM layout of the Flash driver, shared by FlashOS.H and the
+ *               scatter file Target.lin, which armlink preprocesses
+ * --------------------------------------------------------------------------- */
+
+#define FLASH_PROGRAM_PAGE_SIZE 0x4000      // Programming Page Size of FlashDev, RAM buffer of ProgramPage
+#define FLASH_ALGO_STACK_SIZE   0x1000      // Stack the debugger reserves in the RAM for Algorithm
+#define FLASH_ALGO_RAM_SIZE     0x10000     // RAM for Algorithm of the Flash Download settings
@@ -325,6 +325,9 @@ status_t flexspi_nor_flash_erase(uint32_t instance, flexspi_nor_config_t *config
 status_t flexspi_nor_flash_read(
     uint32_t instance, flexspi_nor_config_t *config, uint32_t *dst, uint32_t start, uint32_t bytes);
 
+//!@brief Execute a FlexSPI transfer with a sequence of the Lookup table
+status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer);
+
 //!@brief Set the clock source for FlexSPI NOR
 extern status_t flexspi_nor_set_clock_source(uint32_t clockSource);
 
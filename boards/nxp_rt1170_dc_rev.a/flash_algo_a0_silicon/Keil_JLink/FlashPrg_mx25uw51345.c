@@ -11,6 +11,8 @@
 #include "FlashOS.H" // FlashOS Structures
 #include "bl_api.h"
 #include "clock_config.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
 
 #define FLEXSPI_NOR_INSTANCE 1
 #define SECTOR_SIZE (0x1000)
@@ -18,7 +20,7 @@
 #define CONFIG_OPTION (0xc0403007)
 
 /* Init this global variable to workaround of the issue to running this flash algo in Segger */
-flexspi_nor_config_t config = {1};
+flexspi_nor_config_t config = {.memConfig = {.tag = 1}};
 
 static void restore_clock()
 {
@@ -29,6 +31,107 @@ static void restore_clock()
         }
 }
 
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (config.sectorSize)
+#define DEVICE_PAGE_SIZE   (config.pageSize)
+
+int DeviceSectorErase(unsigned long adr, unsigned long sz)
+{
+    status_t status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr - BASE_ADDRESS, sz);
+    return (status != kStatus_Success);
+}
+
+/*
+ *  OPI session
+ *
+ *  The first Init of a download has the ROM probe the flash, which restores SPI and switches the flash to
+ *  OPI again, and keeps the config block it returns. The later Inits of the download find the flash still
+ *  in OPI: they set FlexSPI up with that config block, the mode switch left out, so that no command goes
+ *  out in SPI. The flash is taken as still in OPI when its WEL bit toggles through the OPI write enable and
+ *  read status sequences, WEL then stays set until the next program or erase. Otherwise Init probes the
+ *  flash again. The ROM keeps the mode in its persistent flash context and restores SPI the next time it
+ *  probes the flash.
+ */
+
+#define SERIAL_NOR_TYPE_XPI (2)
+#define NOR_CMD_LUT_SEQ_IDX_READSTATUS_XPI (2)  // Read status OPI sequence id in lookupTable
+#define NOR_CMD_LUT_SEQ_IDX_WRITEENABLE_XPI (4) // Write Enable OPI sequence id in lookupTable
+#define FLASH_STATUS_WIP (0x1U)
+#define FLASH_STATUS_WEL (0x2U)
+
+static bool s_opiSession; // config holds the config block of the flash in OPI
+
+static status_t OpiCommand(uint32_t seqId, flexspi_operation_t operation, uint32_t *status)
+{
+    flexspi_xfer_t xfer;
+
+    xfer.operation            = operation;
+    xfer.baseAddress          = 0;
+    xfer.seqId                = seqId;
+    xfer.seqNum               = 1;
+    xfer.isParallelModeEnable = false;
+    xfer.txBuffer             = NULL;
+    xfer.txSize               = 0;
+    xfer.rxBuffer             = status;
+    xfer.rxSize               = status ? sizeof(*status) : 0;
+    return flexspi_command_xfer(FLEXSPI_NOR_INSTANCE, &xfer);
+}
+
+static void StartOpiSession(void)
+{
+    s_opiSession = (config.serialNorType == SERIAL_NOR_TYPE_XPI);
+    if (s_opiSession)
+    {
+        // The flash stays in OPI, later Inits must not send the mode switch again
+        config.memConfig.deviceModeCfgEnable = 0;
+        config.memConfig.configCmdEnable     = 0;
+    }
+}
+
+static status_t ResumeOpiSession(void)
+{
+    status_t status = kStatus_Fail;
+    uint32_t before = 0;
+    uint32_t after  = 0;
+
+    do
+    {
+        if (!s_opiSession)
+        {
+            break;
+        }
+        // Started again by the probe unless the flash answers
+        s_opiSession = false;
+        status       = flexspi_nor_flash_init(FLEXSPI_NOR_INSTANCE, &config);
+        if (status == kStatus_Success)
+        {
+            status = OpiCommand(NOR_CMD_LUT_SEQ_IDX_READSTATUS_XPI, kFlexSpiOperation_Read, &before);
+        }
+        if (status == kStatus_Success)
+        {
+            status = OpiCommand(NOR_CMD_LUT_SEQ_IDX_WRITEENABLE_XPI, kFlexSpiOperation_Command, NULL);
+        }
+        if (status == kStatus_Success)
+        {
+            status = OpiCommand(NOR_CMD_LUT_SEQ_IDX_READSTATUS_XPI, kFlexSpiOperation_Read, &after);
+        }
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+        before &= FLASH_STATUS_WIP | FLASH_STATUS_WEL;
+        after &= FLASH_STATUS_WIP | FLASH_STATUS_WEL;
+        if (before || (after != FLASH_STATUS_WEL))
+        {
+            status = kStatus_Fail;
+            break;
+        }
+        s_opiSession = true;
+    } while (0);
+
+    return status;
+}
+
 /*
  *  Initialize Flash Programming Functions
  *    Parameter:      adr:  Device Base Address
@@ -39,6 +142,10 @@ static void restore_clock()
 
 int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 {
+#if INCREMENTAL_PROGRAM
+    IncrementalReset(fnc);
+#endif
+
     status_t status;
     serial_nor_config_option_t option;
 
@@ -67,6 +174,11 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
     CCM->CLOCK_ROOT[kCLOCK_Root_Flexspi1].CONTROL_SET = 0x503;
     option.option0.U = CONFIG_OPTION;
 
+    if (ResumeOpiSession() == kStatus_Success)
+    {
+        return (0);
+    }
+
     status = flexspi_nor_get_config(FLEXSPI_NOR_INSTANCE, &config, &option);
     if (status != kStatus_Success)
     {
@@ -80,6 +192,7 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
     }
     else
     {
+        StartOpiSession();
         return (0); // Finished without Errors
     }
 }
@@ -92,7 +205,12 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 
 int UnInit(unsigned long fnc)
 {
-    /* Add your Code */
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFlush(fnc))
+    {
+        return (1);
+    }
+#endif
     return (0); // Finished without Errors
 }
 
@@ -123,28 +241,67 @@ int EraseChip(void)
 
 int EraseSector(unsigned long adr)
 {
-    status_t status;
-    adr    = adr - BASE_ADDRESS;
-    status = flexspi_nor_flash_erase(FLEXSPI_NOR_INSTANCE, &config, adr, SECTOR_SIZE); // Erase 1 sector
-    if (status != kStatus_Success)
+    unsigned long size = DEVICE_SECTOR_SIZE;
+    unsigned long end  = adr + SECTOR_SIZE;
+
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFinish())
     {
         return (1);
     }
-    else
+#endif
+#if INCREMENTAL_PROGRAM
+    // Erase device sector by device sector, skipping the blank ones and deferring the others
+    for (; adr < end; adr += size)
     {
-        return (0);
+        if (!BlankCheck(adr, size, 0xFF))
+        {
+            g_incrementalStats.eraseHits++;
+            continue;
+        }
+        if (IncrementalDefer(adr, size))
+        {
+            continue;
+        }
+        g_incrementalStats.eraseMisses++;
+        if (DeviceSectorErase(adr, size))
+        {
+            return (1);
+        }
     }
+#else
+    // One erase for the whole sector, so the driver can use its block erase commands
+    g_incrementalStats.eraseMisses += SECTOR_SIZE / size;
+    if (DeviceSectorErase(adr, SECTOR_SIZE))
+    {
+        return (1);
+    }
+#endif
+    return (0);
 }
 
 /*
  *  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
- *                    sz:   Page Size
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
  *                    buf:  Page Data
  *    Return Value:   0 - OK,  1 - Failed
  */
 
 int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    return (FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE));
+}
+
+/*
+ *  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram(unsigned long adr, unsigned long sz, unsigned char *buf)
 {
     status_t status;
     adr = adr - BASE_ADDRESS;
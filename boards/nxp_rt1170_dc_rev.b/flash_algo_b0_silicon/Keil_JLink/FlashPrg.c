@@ -33,6 +33,8 @@ static flexspi_nor_config_t *config = (flexspi_nor_config_t *)0x20230000;
 #include "fsl_clock.h"
 #include "fsl_flexspi.h"
 #include "app.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flash_program/flash_program.h"
 extern status_t flexspi_nor_flash_erase_sector(FLEXSPI_Type *base, uint32_t address);
 extern status_t flexspi_nor_flash_page_program(FLEXSPI_Type *base, uint32_t dstAddr, const uint32_t *src);
 extern status_t flexspi_nor_get_vendor_id(FLEXSPI_Type *base, uint8_t *vendorId);
@@ -199,6 +201,26 @@ static void restore_clock()
     }
 }
 
+// Device sector and page of flash_incremental and flash_program
+#define DEVICE_SECTOR_SIZE (FLASH_SECTOR_SIZE)
+#define DEVICE_PAGE_SIZE   (FLASH_PAGE_SIZE)
+
+int DeviceSectorErase(unsigned long adr, unsigned long sz)
+{
+    status_t status = kStatus_Success;
+
+    adr = adr - FLASH_BASE_ADDRESS;
+#ifdef USE_ROM_API
+    status = ROM_FLEXSPI_NorFlash_Erase(FLEXSPI_NOR_INSTANCE, config, adr, sz);
+#else
+    for (unsigned long offset = 0; (offset < sz) && (status == kStatus_Success); offset += FLASH_SECTOR_SIZE)
+    {
+        status = flexspi_nor_flash_erase_sector(FLEXSPIx, adr + offset);
+    }
+#endif
+    return (status != kStatus_Success);
+}
+
 /*
  *  Initialize Flash Programming Functions
  *    Parameter:      adr:  Device Base Address
@@ -209,6 +231,10 @@ static void restore_clock()
 
 int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 {
+#if INCREMENTAL_PROGRAM
+    IncrementalReset(fnc);
+#endif
+
     status_t status;
     static unsigned int index = 0;
     unsigned int state        = 0;
@@ -292,6 +318,12 @@ int Init(unsigned long adr, unsigned long clk, unsigned long fnc)
 
 int UnInit(unsigned long fnc)
 {
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFlush(fnc))
+    {
+        return (1);
+    }
+#endif
     return (0); // Finished without Errors
 }
 
@@ -326,52 +358,67 @@ int EraseChip(void)
 
 int EraseSector(unsigned long adr)
 {
-    status_t status;
-#ifndef USE_ROM_API
-    unsigned int i = 0;
-#endif
-    adr = adr - FLASH_BASE_ADDRESS;
-    if (adr % FLASH_ALGO_SECTOR_SIZE)
-    {
-        return (1);
-    }
+    unsigned long size = DEVICE_SECTOR_SIZE;
+    unsigned long end  = adr + FLASH_ALGO_SECTOR_SIZE;
 
-#ifdef USE_ROM_API
-    status = ROM_FLEXSPI_NorFlash_Erase(FLEXSPI_NOR_INSTANCE, config, adr, FLASH_ALGO_SECTOR_SIZE); // Erase 1 sector
-#else
-    for (i = 0; i < FLASH_ALGO_SECTOR_SIZE / FLASH_SECTOR_SIZE; i++)
-    {
-        status = flexspi_nor_flash_erase_sector(FLEXSPIx, adr + (i * FLASH_SECTOR_SIZE));
-#endif
-
-#ifdef USE_ROM_API
-    if (status != kStatus_Success)
+#if INCREMENTAL_PROGRAM
+    if (IncrementalFinish())
     {
         return (1);
     }
-    else
+#endif
+#if INCREMENTAL_PROGRAM
+    // Erase device sector by device sector, skipping the blank ones and deferring the others
+    for (; adr < end; adr += size)
     {
-        return (0);
-    }
-#else
-        if (status != kStatus_Success)
+        if (!BlankCheck(adr, size, 0xFF))
+        {
+            g_incrementalStats.eraseHits++;
+            continue;
+        }
+        if (IncrementalDefer(adr, size))
+        {
+            continue;
+        }
+        g_incrementalStats.eraseMisses++;
+        if (DeviceSectorErase(adr, size))
         {
             return (1);
         }
     }
-    return (0);
+#else
+    // One erase for the whole sector, so the driver can use its block erase commands
+    g_incrementalStats.eraseMisses += FLASH_ALGO_SECTOR_SIZE / size;
+    if (DeviceSectorErase(adr, FLASH_ALGO_SECTOR_SIZE))
+    {
+        return (1);
+    }
 #endif
+    return (0);
 }
 
 /*
  *  Program Page in Flash Memory
  *    Parameter:      adr:  Page Start Address
- *                    sz:   Page Size
+ *                    sz:   Page Size, up to the Programming Page Size of FlashDev
  *                    buf:  Page Data
  *    Return Value:   0 - OK,  1 - Failed
  */
 
 int ProgramPage(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    return (FlashProgramPages(adr, sz, buf, DEVICE_PAGE_SIZE));
+}
+
+/*
+ *  Program Page in Flash Memory, without comparing it first
+ *    Parameter:      adr:  Page Start Address
+ *                    sz:   Page Size
+ *                    buf:  Page Data
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int DevicePageProgram(unsigned long adr, unsigned long sz, unsigned char *buf)
 {
     status_t status;
     unsigned int i                          = 0;
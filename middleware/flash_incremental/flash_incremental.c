@@ -0,0 +1,201 @@
+/*
+ * Copyright 2019 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "flash_incremental.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#if INCREMENTAL_PROGRAM
+typedef struct _incremental_range
+{
+    unsigned long start;
+    unsigned long end;
+} incremental_range_t;
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+incremental_stats_t g_incrementalStats;
+
+#if INCREMENTAL_PROGRAM
+static incremental_range_t s_pendingRanges[INCREMENTAL_MAX_RANGES];
+static uint32_t s_pendingCount;
+static unsigned long s_sectorSize;   // Device sector size of the deferred sectors
+static unsigned long s_pageSize;     // Device page size of the kept pages
+static unsigned long s_activeSector; // Deferred sector being programmed, 0 if none
+static unsigned long s_activeKeep;   // End of the pages at the start of the active sector that match the image
+static uint32_t s_keepBuffer[INCREMENTAL_BUFFER_SIZE / 4];
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+#if INCREMENTAL_PROGRAM
+void IncrementalReset(unsigned long fnc)
+{
+    // A download starts with the erase
+    if (fnc == 1)
+    {
+        s_pendingCount = 0;
+        s_activeSector = 0;
+    }
+}
+
+int IncrementalDefer(unsigned long adr, unsigned long sz)
+{
+    if (sz > INCREMENTAL_BUFFER_SIZE)
+    {
+        return (0);
+    }
+    s_sectorSize = sz;
+    for (uint32_t i = 0; i < s_pendingCount; i++)
+    {
+        if ((adr >= s_pendingRanges[i].start) && (adr < s_pendingRanges[i].end))
+        {
+            return (1);
+        }
+    }
+    if (s_pendingCount && (s_pendingRanges[s_pendingCount - 1].end == adr))
+    {
+        s_pendingRanges[s_pendingCount - 1].end += sz;
+        return (1);
+    }
+    if (s_pendingCount < INCREMENTAL_MAX_RANGES)
+    {
+        s_pendingRanges[s_pendingCount].start = adr;
+        s_pendingRanges[s_pendingCount].end   = adr + sz;
+        s_pendingCount++;
+        return (1);
+    }
+    return (0);
+}
+
+// Erase a deferred sector unless it is blank from keep on, then program [adr, keep) back
+static int IncrementalEraseKeep(unsigned long adr, unsigned long keep)
+{
+    unsigned long size = s_sectorSize;
+
+    if (!BlankCheck(keep, adr + size - keep, 0xFF))
+    {
+        g_incrementalStats.eraseHits++;
+        return (0);
+    }
+    for (uint32_t i = 0; i < (keep - adr) / 4; i++)
+    {
+        s_keepBuffer[i] = ((const volatile uint32_t *)adr)[i];
+    }
+    g_incrementalStats.eraseMisses++;
+    if (DeviceSectorErase(adr, size))
+    {
+        return (1);
+    }
+    for (unsigned long offset = 0; offset < (keep - adr); offset += s_pageSize)
+    {
+        if (DevicePageProgram(adr + offset, s_pageSize, (unsigned char *)s_keepBuffer + offset))
+        {
+            return (1);
+        }
+    }
+    return (0);
+}
+
+int IncrementalFinish(void)
+{
+    unsigned long sector = s_activeSector;
+
+    s_activeSector = 0;
+    return (sector ? IncrementalEraseKeep(sector, s_activeKeep) : 0);
+}
+
+// Make sector the active one if it is deferred, the deferred sectors before it in its run are not
+// part of the image as pages come in ascending order and are erased
+static int IncrementalActivate(unsigned long sector)
+{
+    for (uint32_t i = 0; i < s_pendingCount; i++)
+    {
+        incremental_range_t *range = &s_pendingRanges[i];
+        if ((sector >= range->start) && (sector < range->end))
+        {
+            for (; range->start < sector; range->start += s_sectorSize)
+            {
+                if (IncrementalEraseKeep(range->start, range->start))
+                {
+                    return (1);
+                }
+            }
+            range->start += s_sectorSize;
+            if (range->start == range->end)
+            {
+                *range = s_pendingRanges[--s_pendingCount];
+            }
+            s_activeSector = sector;
+            s_activeKeep   = sector;
+            break;
+        }
+    }
+    return (0);
+}
+
+int IncrementalKeep(unsigned long adr, unsigned long sz, unsigned char *buf, int *kept)
+{
+    unsigned long sector;
+
+    *kept = 0;
+    if (!s_pendingCount && !s_activeSector)
+    {
+        return (0);
+    }
+    s_pageSize = sz;
+    sector     = adr & ~(s_sectorSize - 1);
+    if (sector != s_activeSector)
+    {
+        if (IncrementalFinish() || IncrementalActivate(sector))
+        {
+            return (1);
+        }
+    }
+    if (s_activeSector)
+    {
+        // Keep the pages of a deferred sector while they match, erase it at the first one that differs
+        if ((adr == s_activeKeep) && (Verify(adr, sz, buf) == adr + sz))
+        {
+            s_activeKeep += sz;
+            g_incrementalStats.programHits++;
+            *kept = 1;
+            return (0);
+        }
+        return (IncrementalFinish());
+    }
+    return (0);
+}
+
+int IncrementalFlush(unsigned long fnc)
+{
+    int status = 0;
+
+    if (fnc == 2)
+    {
+        status = IncrementalFinish();
+        for (uint32_t i = 0; (i < s_pendingCount) && !status; i++)
+        {
+            incremental_range_t *range = &s_pendingRanges[i];
+            for (unsigned long adr = range->start; (adr < range->end) && !status; adr += s_sectorSize)
+            {
+                status = IncrementalEraseKeep(adr, adr);
+            }
+        }
+        s_pendingCount = 0;
+    }
+    return (status);
+}
+#endif
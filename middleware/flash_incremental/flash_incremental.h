@@ -0,0 +1,89 @@
+/*
+ * Copyright 2019 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_INCREMENTAL_H__
+#define __FLASH_INCREMENTAL_H__
+
+#include <stdint.h>
+
+/*
+ *  Incremental programming
+ *
+ *  With INCREMENTAL_PROGRAM set in the project defines, EraseSector skips the device sectors that are already
+ *  blank and defers the erase of the others, and ProgramPage skips the pages the flash already holds. For a
+ *  deferred sector ProgramPage keeps the pages that match the image, erases the sector at the first page that
+ *  differs and programs the kept pages back, so sectors that already hold the image are neither erased nor
+ *  programmed. Deferred sectors the image does not cover are erased by UnInit(2), the mode is meant for the
+ *  erase, program, verify sequence of a download. With INCREMENTAL_PROGRAM 0 the algorithm erases and
+ *  programs without reading the flash first.
+ *
+ *  The algorithm provides DeviceSectorErase and DevicePageProgram, the plain device operations, the FlashOS
+ *  BlankCheck and Verify come from flash_program/flash_program.c. Addresses are the ones of the AHB window.
+ */
+
+#ifndef INCREMENTAL_PROGRAM
+#define INCREMENTAL_PROGRAM 0
+#endif
+
+//!@brief Largest device sector whose erase can be deferred
+#ifndef INCREMENTAL_BUFFER_SIZE
+#define INCREMENTAL_BUFFER_SIZE (4096)
+#endif
+
+//!@brief Runs of contiguous deferred sectors
+#ifndef INCREMENTAL_MAX_RANGES
+#define INCREMENTAL_MAX_RANGES (8)
+#endif
+
+//!@brief Counters of the device sectors and pages the algorithm left as they were or wrote
+typedef struct _incremental_stats
+{
+    uint32_t eraseHits;     //!< Device sectors left as they were
+    uint32_t eraseMisses;   //!< Device sectors erased
+    uint32_t programHits;   //!< Pages the flash already held
+    uint32_t programMisses; //!< Pages programmed
+} incremental_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern incremental_stats_t g_incrementalStats;
+
+//!@brief Erase device sectors, provided by the algorithm, 0 - OK, 1 - Failed
+int DeviceSectorErase(unsigned long adr, unsigned long sz);
+
+//!@brief Program one device page, provided by the algorithm, 0 - OK, 1 - Failed
+int DevicePageProgram(unsigned long adr, unsigned long sz, unsigned char *buf);
+
+//!@brief FlashOS functions of the algorithm
+int BlankCheck(unsigned long adr, unsigned long sz, unsigned char pat);
+unsigned long Verify(unsigned long adr, unsigned long sz, unsigned char *buf);
+
+#if INCREMENTAL_PROGRAM
+//!@brief Forget the deferred sectors when a download starts, called by Init
+void IncrementalReset(unsigned long fnc);
+
+//!@brief Defer the erase of a device sector that is not blank, returns 1 if it is deferred
+int IncrementalDefer(unsigned long adr, unsigned long sz);
+
+//!@brief Keep a device page of a deferred sector that matches the image, sets kept to 1 if the page is kept
+int IncrementalKeep(unsigned long adr, unsigned long sz, unsigned char *buf, int *kept);
+
+//!@brief Complete the deferred sector being programmed
+int IncrementalFinish(void);
+
+//!@brief Erase the deferred sectors the image did not cover, called by UnInit
+int IncrementalFlush(unsigned long fnc);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FLASH_INCREMENTAL_H__
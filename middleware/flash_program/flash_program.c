@@ -0,0 +1,203 @@
+/*
+ * Copyright 2019 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "flash_program.h"
+#include "flash_incremental/flash_incremental.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uint32_t s_pageBuffer[PROGRAM_PAGE_BUFFER_SIZE / 4];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *  Program a Device Page in Flash Memory, unless the flash already holds it
+ *    Parameter:      adr:  Device Page Start Address
+ *                    sz:   Device Page Size
+ *                    buf:  Page Data
+ *                    last: Last device page of the Programming Page
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+static int ProgramDevicePage(unsigned long adr, unsigned long sz, unsigned char *buf, int last)
+{
+#if INCREMENTAL_PROGRAM
+    int kept;
+
+    if (IncrementalKeep(adr, sz, buf, &kept))
+    {
+        return (1);
+    }
+    if (kept)
+    {
+        return (0);
+    }
+    if (Verify(adr, sz, buf) == adr + sz)
+    {
+        g_incrementalStats.programHits++;
+        return (0);
+    }
+#endif
+    g_incrementalStats.programMisses++;
+#if BACKGROUND_PROGRAM
+    if (last)
+    {
+        return (DevicePageProgramStart(adr, sz, buf));
+    }
+#else
+    (void)last;
+#endif
+    return (DevicePageProgram(adr, sz, buf));
+}
+
+int FlashProgramPages(unsigned long adr, unsigned long sz, unsigned char *buf, unsigned long pageSize)
+{
+    unsigned long end = adr + sz;
+
+    if (pageSize > PROGRAM_PAGE_BUFFER_SIZE)
+    {
+        return (1);
+    }
+    InvalidateCache((unsigned long)buf, sz);
+    // Program device page by device page, padding the ones the data only partly covers
+    while (adr < end)
+    {
+        unsigned long offset = adr & (pageSize - 1);
+        unsigned long count  = pageSize - offset;
+        unsigned char *page  = buf;
+
+        if (count > end - adr)
+        {
+            count = end - adr;
+        }
+        if (count != pageSize)
+        {
+            page = (unsigned char *)s_pageBuffer;
+            for (unsigned long i = 0; i < pageSize; i++)
+            {
+                page[i] = 0xFF;
+            }
+            for (unsigned long i = 0; i < count; i++)
+            {
+                page[offset + i] = buf[i];
+            }
+        }
+        if (ProgramDevicePage(adr - offset, pageSize, page, adr + count == end))
+        {
+            return (1);
+        }
+        adr += count;
+        buf += count;
+    }
+    return (0);
+}
+
+/*
+ *  Blank Check Checks if Memory is Blank
+ *    Parameter:      adr:  Block Start Address
+ *                    sz:   Block Size (in bytes)
+ *                    pat:  Block Pattern
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int BlankCheck(unsigned long adr, unsigned long sz, unsigned char pat)
+{
+    unsigned long end = adr + sz;
+    uint32_t pattern  = pat * 0x01010101U;
+
+#if BACKGROUND_PROGRAM
+    if (BackgroundComplete())
+    {
+        return (1);
+    }
+#endif
+    InvalidateCache(adr, sz);
+
+    // Compare one 32-byte line per iteration over the AHB window, exit on the first difference
+    if (!(adr & 0x3))
+    {
+        while ((end - adr) >= 32)
+        {
+            const volatile uint32_t *src = (const volatile uint32_t *)adr;
+            uint32_t diff                = 0;
+            for (uint32_t i = 0; i < 8; i++)
+            {
+                diff |= src[i] ^ pattern;
+            }
+            if (diff)
+            {
+                return (1);
+            }
+            adr += 32;
+        }
+    }
+    while (adr < end)
+    {
+        if (*(const volatile uint8_t *)adr != pat)
+        {
+            return (1);
+        }
+        adr++;
+    }
+
+    return (0);
+}
+
+/*
+ *  Verify Flash Contents
+ *    Parameter:      adr:  Start Address
+ *                    sz:   Size (in bytes)
+ *                    buf:  Data
+ *    Return Value:   (adr+sz) - OK, Failed Address
+ */
+
+unsigned long Verify(unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+    unsigned long end = adr + sz;
+
+#if BACKGROUND_PROGRAM
+    if (BackgroundComplete())
+    {
+        return (adr);
+    }
+#endif
+    InvalidateCache(adr, sz);
+    InvalidateCache((unsigned long)buf, sz);
+
+    // Compare one 32-byte line per iteration over the AHB window, then locate the first mismatching byte
+    if (!((adr | (unsigned long)buf) & 0x3))
+    {
+        while ((end - adr) >= 32)
+        {
+            const volatile uint32_t *src = (const volatile uint32_t *)adr;
+            const uint32_t *ref          = (const uint32_t *)buf;
+            uint32_t diff                = 0;
+            for (uint32_t i = 0; i < 8; i++)
+            {
+                diff |= src[i] ^ ref[i];
+            }
+            if (diff)
+            {
+                break;
+            }
+            adr += 32;
+            buf += 32;
+        }
+    }
+    while ((adr < end) && (*(const volatile uint8_t *)adr == *buf))
+    {
+        adr++;
+        buf++;
+    }
+
+    return (adr);
+}
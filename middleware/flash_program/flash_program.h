@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_PROGRAM_H__
+#define __FLASH_PROGRAM_H__
+
+#include <stdint.h>
+
+/*
+ *  Program buffer
+ *
+ *  FlashDev advertises a Programming Page of several device pages, so that the debugger downloads and calls
+ *  ProgramPage once per buffer instead of once per device page. FlashProgramPages programs the device pages one
+ *  by one, see flash_incremental/flash_incremental.h for the pages it skips, and pads a device page the data
+ *  only partly covers with the erased value in a buffer of PROGRAM_PAGE_BUFFER_SIZE bytes. The default fits
+ *  the 256-byte page of the serial NOR devices, the HyperFLASH projects set 512 in their defines.
+ *
+ *  BlankCheck and Verify read the AHB window one 32-byte line per iteration, after InvalidateCache dropped
+ *  the cached lines of the range. flash_program_dcache.c provides InvalidateCache for the Cortex-M7 D-Cache,
+ *  flash_program_cache64.c for the CACHE64 of the FlexSPI window, a project builds one of them.
+ *
+ *  Background programming: with BACKGROUND_PROGRAM set, FlashProgramPages returns once the last device page of
+ *  the buffer is sent with DevicePageProgramStart, while the device is still programming it, so that the
+ *  debugger downloads the next buffer meanwhile. The device holds the data at that point and the buffer can
+ *  be overwritten. BackgroundComplete waits for that page, BlankCheck and Verify call it first and so must
+ *  every other function of the algorithm that accesses the device.
+ */
+
+#ifndef PROGRAM_PAGE_BUFFER_SIZE
+#define PROGRAM_PAGE_BUFFER_SIZE (256)
+#endif
+
+#ifndef BACKGROUND_PROGRAM
+#define BACKGROUND_PROGRAM 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//!@brief Program the device pages of a Programming Page, 0 - OK, 1 - Failed
+int FlashProgramPages(unsigned long adr, unsigned long sz, unsigned char *buf, unsigned long pageSize);
+
+//!@brief Drop the cached lines of a range so that reads return what was programmed or written by the debugger
+void InvalidateCache(unsigned long adr, unsigned long sz);
+
+#if BACKGROUND_PROGRAM
+//!@brief Start the program of one device page, provided by the algorithm, 0 - OK, 1 - Failed
+int DevicePageProgramStart(unsigned long adr, unsigned long sz, unsigned char *buf);
+
+//!@brief Wait for the device page started last, provided by the algorithm, 0 - OK, 1 - Failed
+int BackgroundComplete(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FLASH_PROGRAM_H__
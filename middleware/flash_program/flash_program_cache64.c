@@ -0,0 +1,53 @@
+/*
+ * Copyright 2019 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "flash_program.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+// The device headers have no CACHE64 definitions, the registers are those of the SDK fsl_cache driver
+#define CACHE64_CTRL_CCR    (0x40033800) // ENCACHE bit 0
+#define CACHE64_CTRL_CLCR   (0x40033804) // LCMD bits 25:24, LADSEL bit 26
+#define CACHE64_CTRL_CSAR   (0x40033808) // LGO bit 0, PHYADDR bits 31:29 and 27:1
+#define CACHE64_LINE_SIZE   (32)
+#define CACHE64_WINDOW_BASE (0x08000000) // FlexSPI window served by the cache, also at 0x18000000
+#define CACHE64_WINDOW_SIZE (0x08000000)
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *  Invalidate the CACHE64 lines of a range so that AHB reads return what was programmed via IP commands. The
+ *  cache only serves the FlexSPI window, RAM ranges such as the buffer of the debugger are left alone.
+ */
+
+void InvalidateCache(unsigned long adr, unsigned long sz)
+{
+    volatile uint32_t *csar = (volatile uint32_t *)CACHE64_CTRL_CSAR;
+    volatile uint32_t *clcr = (volatile uint32_t *)CACHE64_CTRL_CLCR;
+    unsigned long end       = adr + sz;
+
+    // ENCACHE, secure and non-secure aliases of the window
+    if (!(*((volatile uint32_t *)CACHE64_CTRL_CCR) & 0x1U) ||
+        (((adr & 0xEFFFFFFFU) - CACHE64_WINDOW_BASE) >= CACHE64_WINDOW_SIZE))
+    {
+        return;
+    }
+    // Line command invalidate (LCMD 1) by physical address (LADSEL)
+    *clcr = (*clcr & ~0x3000000U) | 0x1000000U | 0x4000000U;
+    for (adr &= ~(unsigned long)(CACHE64_LINE_SIZE - 1); adr < end; adr += CACHE64_LINE_SIZE)
+    {
+        *csar = (adr & 0xEFFFFFFEU) | 0x1U;
+        while (*csar & 0x1U)
+        {
+        }
+    }
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2019 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "fsl_device_registers.h"
+#include "flash_program.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *  Drop D-Cache lines of the range so that AHB reads return what was programmed via IP commands and RAM reads
+ *  what the debugger wrote. The core of a device without D-Cache, e.g. the Cortex-M4 of RT1170, reads through.
+ */
+
+void InvalidateCache(unsigned long adr, unsigned long sz)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (SCB_CCR_DC_Msk == (SCB_CCR_DC_Msk & SCB->CCR))
+    {
+        SCB_InvalidateDCache_by_Addr((void *)adr, (int32_t)sz);
+    }
+#else
+    (void)adr;
+    (void)sz;
+#endif
+}
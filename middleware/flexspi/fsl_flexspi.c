@@ -10,6 +10,9 @@
 #include <assert.h>
 #include <stdbool.h>
 #include "fsl_device_registers.h"
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+#include "fsl_clock.h"
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
 
 /*******************************************************************************
  * Definitions
@@ -34,10 +37,34 @@ enum
 
 #define FLEXSPI_PINMUX_VAL 0x08
 
+#if FLEXSPI_ENABLE_TRACE
+#ifndef FLEXSPI_TRACE_GET_CYCLES
+#define FLEXSPI_TRACE_GET_CYCLES() (DWT->CYCCNT) //!< Core cycle counter of the trace
+#endif
+#define FLEXSPI_DWT_LAR_KEY (0xC5ACCE55UL) //!< Unlocks the DWT registers of the Cortex-M7
+#endif // FLEXSPI_ENABLE_TRACE
+
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+#if !defined(DMA0) || !defined(DMAMUX)
+#error "FLEXSPI_ENABLE_DMA_TRANSFER requires the eDMA and DMAMUX of the i.MXRT10xx"
+#endif
+#define FLEXSPI_DMA_RX_CHANNEL (0U)
+#define FLEXSPI_DMA_TX_CHANNEL (1U)
+#define FLEXSPI_DMA_WAIT_TIMEOUT (0x100000U) //!< Status reads before a DMA transfer is considered stuck
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
+
 /*******************************************************************************
  * Local variables
  ******************************************************************************/
 static FLEXSPI_Type *const g_flexSpiInstances[] = FLEXSPI_BASE_PTRS;
+static flexspi_poll_stats_t s_pollStats;
+#if FLEXSPI_ENABLE_RESIDENT_LUT
+//!@brief lookupTable held by the LUT of each instance, NULL once any sequence was overwritten
+static const uint32_t *s_residentLut[sizeof(g_flexSpiInstances) / sizeof(g_flexSpiInstances[0])];
+#endif // FLEXSPI_ENABLE_RESIDENT_LUT
+#if FLEXSPI_ENABLE_TRACE
+static flexspi_trace_t *s_trace;
+#endif // FLEXSPI_ENABLE_TRACE
 
 /*******************************************************************************
  * Prototypes
@@ -64,6 +91,15 @@ status_t flexspi_get_ticks(uint32_t *ticks, uint32_t intervalNs, uint32_t freq,
 //!@brief Extract received data under parallel mode
 static status_t flexspi_extract_parallel_data(uint32_t *dst0, uint32_t *dst1, uint32_t *src, uint32_t length);
 #endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+//!@brief Check the busy bit of the status read from the device, or of both devices under parallel mode
+static bool flexspi_is_busy_status(flexspi_mem_config_t *config, uint32_t *statusDataBuffer, bool isParallelMode);
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+//!@brief Trigger an IP command whose data is moved by DMA, returns false if the CPU has to move it
+static bool flexspi_dma_start_xfer(
+    uint32_t instance, FLEXSPI_Type *base, bool isRead, uint32_t *buffer, uint32_t bytes, uint32_t burstBytes);
+//!@brief Wait for the end of the IP command started by flexspi_dma_start_xfer and release the DMA channel
+static status_t flexspi_dma_finish_xfer(FLEXSPI_Type *base, flexspi_xfer_t *xfer);
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
 
 //!@brief Configure Device workmode via FlexSPI
 static status_t flexspi_device_workmode_config(uint32_t instance, flexspi_mem_config_t *config, uint32_t baseAddr);
@@ -462,6 +498,7 @@ status_t flexspi_config_flash_control_registers(uint32_t instance, flexspi_mem_c
             base->FLSHCR0[index] = flashSize / 1024;
 
             // Configure FLSHCR1
+            // Same config block bytes as the dataSetupTime/dataHoldTime of older revisions, the value is unchanged
             temp = FLEXSPI_FLSHCR1_TCSS(config->csSetupTime) | FLEXSPI_FLSHCR1_TCSH(config->csHoldTime) |
                    FLEXSPI_FLSHCR1_CAS(config->columnAddressWidth);
             if (flexspi_is_word_addressable(config))
@@ -543,6 +580,83 @@ status_t flexspi_config_ahb_buffers(FLEXSPI_Type *base, flexspi_mem_config_t *co
     return status;
 }
 
+status_t flexspi_enter_verify_ahb_profile(uint32_t instance, flexspi_ahb_profile_t *profile)
+{
+    status_t status = kStatus_InvalidArgument;
+
+    do
+    {
+        FLEXSPI_Type *base = flexspi_get_module_base(instance);
+        if ((base == NULL) || (profile == NULL))
+        {
+            break;
+        }
+
+        if (!profile->isSaved)
+        {
+            profile->ahbcr = base->AHBCR;
+            for (uint32_t index = 0; index < FLEXSPI_AHBRXBUFCR0_COUNT; index++)
+            {
+                profile->rxBufCr0[index] = base->AHBRXBUFCR0[index];
+            }
+            profile->isSaved = true;
+        }
+
+        flexspi_wait_idle(instance);
+        base->AHBCR |= FLEXSPI_AHBCR_PREFETCHEN_MASK;
+        for (uint32_t index = 0; index < FLEXSPI_AHBRXBUFCR0_COUNT - 1; index++)
+        {
+            base->AHBRXBUFCR0[index] &= ~(FLEXSPI_AHBRXBUFCR0_BUFSZ_MASK | FLEXSPI_AHBRXBUFCR0_PRIORITY_MASK);
+        }
+        // A prefetch buffer of whole lines, so that the line fills of a sequential read never straddle two
+        // read sequences
+        base->AHBRXBUFCR0[FLEXSPI_AHBRXBUFCR0_COUNT - 1] =
+            (base->AHBRXBUFCR0[FLEXSPI_AHBRXBUFCR0_COUNT - 1] &
+             ~(FLEXSPI_AHBRXBUFCR0_BUFSZ_MASK | FLEXSPI_AHBRXBUFCR0_PRIORITY_MASK)) |
+            FLEXSPI_AHBRXBUFCR0_BUFSZ((FlexSPI_AHB_RX_BUF_SIZE / FlexSPI_AHB_CACHE_LINE_SIZE) *
+                                      FlexSPI_AHB_CACHE_LINE_SIZE / 8) |
+            FLEXSPI_AHBRXBUFCR0_PREFETCHEN_MASK;
+        // Drop what the buffers held under the former assignment
+        flexspi_clear_cache(instance);
+
+        status = kStatus_Success;
+
+    } while (0);
+
+    return status;
+}
+
+status_t flexspi_restore_ahb_profile(uint32_t instance, flexspi_ahb_profile_t *profile)
+{
+    status_t status = kStatus_InvalidArgument;
+
+    do
+    {
+        FLEXSPI_Type *base = flexspi_get_module_base(instance);
+        if ((base == NULL) || (profile == NULL))
+        {
+            break;
+        }
+
+        if (profile->isSaved)
+        {
+            flexspi_wait_idle(instance);
+            base->AHBCR = profile->ahbcr;
+            for (uint32_t index = 0; index < FLEXSPI_AHBRXBUFCR0_COUNT; index++)
+            {
+                base->AHBRXBUFCR0[index] = profile->rxBufCr0[index];
+            }
+            profile->isSaved = false;
+            flexspi_clear_cache(instance);
+        }
+
+        status = kStatus_Success;
+
+    } while (0);
+
+    return status;
+}
+
 status_t flexspi_device_write_enable(uint32_t instance,
                                      flexspi_mem_config_t *config,
                                      bool isParallelMode,
@@ -571,8 +685,7 @@ status_t flexspi_device_write_enable(uint32_t instance,
             flashXfer.seqId = config->lutCustomSeq[CMD_INDEX_WRITEENABLE].seqId;
             flashXfer.seqNum = config->lutCustomSeq[CMD_INDEX_WRITEENABLE].seqNum;
         }
-        flexspi_update_lut(instance, CMD_LUT_FOR_IP_CMD, &config->lookupTable[4 * flashXfer.seqId], flashXfer.seqNum);
-        flashXfer.seqId = CMD_LUT_FOR_IP_CMD;
+        flashXfer.seqId = flexspi_select_ip_seq(instance, config, flashXfer.seqId, flashXfer.seqNum);
         status = flexspi_command_xfer(instance, &flashXfer);
 
     } while (0);
@@ -611,8 +724,7 @@ status_t flexspi_device_workmode_config(uint32_t instance, flexspi_mem_config_t
 
         flexspi_device_write_enable(instance, config, false, baseAddr);
         // Update LUT 1 for device mode config command
-        flexspi_update_lut(instance, CMD_LUT_FOR_IP_CMD, &config->lookupTable[4 * flashXfer.seqId], flashXfer.seqNum);
-        flashXfer.seqId = CMD_LUT_FOR_IP_CMD;
+        flashXfer.seqId = flexspi_select_ip_seq(instance, config, flashXfer.seqId, flashXfer.seqNum);
         status = flexspi_command_xfer(instance, &flashXfer);
         if (status != kStatus_Success)
         {
@@ -705,9 +817,7 @@ status_t flexspi_device_cmd_config(uint32_t instance, flexspi_mem_config_t *conf
                     return status;
                 }
 
-                flexspi_update_lut(instance, CMD_LUT_FOR_IP_CMD, &config->lookupTable[4 * flashXfer.seqId],
-                                   flashXfer.seqNum);
-                flashXfer.seqId = CMD_LUT_FOR_IP_CMD;
+                flashXfer.seqId = flexspi_select_ip_seq(instance, config, flashXfer.seqId, flashXfer.seqNum);
                 status = flexspi_command_xfer(instance, &flashXfer);
                 if (status != kStatus_Success)
                 {
@@ -769,6 +879,8 @@ status_t flexspi_device_cmd_config_all_chips(uint32_t instance, flexspi_mem_conf
     return status;
 }
 
+// The boot ROM initializes FlexSPI as part of flexspi_nor_flash_init when it provides that function
+#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_INIT)
 status_t flexspi_init(uint32_t instance, flexspi_mem_config_t *config)
 {
     uint32_t mcr0;
@@ -787,9 +899,17 @@ status_t flexspi_init(uint32_t instance, flexspi_mem_config_t *config)
          *
          *  ROM configures the FlexSPI Serial clock to 30MHz if one of below case is met:
          *  1. ROM is required to configure external device to certain modes at safe frequency
+         *  2. Device is under DDR mode. In such case, the serial clock is twice
+         *     than the request clock for SDR command, it may exceed the highest frequency
          */
+#if FLEXSPI_ENABLE_DDR_SAFE_CONFIG_FREQ
+        bool need_safe_freq = (config->deviceModeCfgEnable || config->configCmdEnable) &&
+                              ((config->controllerMiscOption & (1 << kFlexSpiMiscOffset_SafeConfigFreqEnable)) ||
+                               flexspi_is_ddr_mode_enable(config));
+#else
         bool need_safe_freq = (config->deviceModeCfgEnable || config->configCmdEnable) &&
                               ((config->controllerMiscOption & (1 << kFlexSpiMiscOffset_SafeConfigFreqEnable)));
+#endif
 
         if (config->tag != FLEXSPI_CFG_BLK_TAG)
         {
@@ -805,7 +925,11 @@ status_t flexspi_init(uint32_t instance, flexspi_mem_config_t *config)
         if (need_safe_freq)
         {
             // Configure FlexSPI serial clock using safe frequency
+#if FLEXSPI_ENABLE_DDR_SAFE_CONFIG_FREQ
+            flexspi_clock_config(instance, kFlexSpiSerialClk_30MHz, kFlexSpiClk_SDR);
+#else
             flexspi_clock_config(instance, kFlexSpiSerialClk_SafeFreq, kFlexSpiClk_SDR);
+#endif
         }
         else
         {
@@ -923,6 +1047,7 @@ status_t flexspi_init(uint32_t instance, flexspi_mem_config_t *config)
 
     return status;
 }
+#endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_INIT)
 
 status_t flexspi_update_lut(uint32_t instance, uint32_t seqIndex, const uint32_t *lutBase, uint32_t seqNumber)
 {
@@ -957,6 +1082,9 @@ status_t flexspi_update_lut(uint32_t instance, uint32_t seqIndex, const uint32_t
         }
 
         flexspi_lock_lut(base);
+#if FLEXSPI_ENABLE_RESIDENT_LUT
+        s_residentLut[instance] = NULL;
+#endif
 
         status = kStatus_Success;
 
@@ -965,6 +1093,42 @@ status_t flexspi_update_lut(uint32_t instance, uint32_t seqIndex, const uint32_t
     return status;
 }
 
+status_t flexspi_load_lut(uint32_t instance, const uint32_t *lookupTable)
+{
+    status_t status = flexspi_update_lut(instance, 0, lookupTable, 16);
+#if FLEXSPI_ENABLE_RESIDENT_LUT
+    if (status == kStatus_Success)
+    {
+        s_residentLut[instance] = lookupTable;
+    }
+#endif
+
+    return status;
+}
+
+void flexspi_clear_resident_lut(uint32_t instance)
+{
+#if FLEXSPI_ENABLE_RESIDENT_LUT
+    if (flexspi_get_module_base(instance) != NULL)
+    {
+        s_residentLut[instance] = NULL;
+    }
+#endif
+}
+
+uint32_t flexspi_select_ip_seq(uint32_t instance, flexspi_mem_config_t *config, uint32_t seqId, uint32_t seqNum)
+{
+#if FLEXSPI_ENABLE_RESIDENT_LUT
+    if ((flexspi_get_module_base(instance) != NULL) && (s_residentLut[instance] == config->lookupTable))
+    {
+        return seqId;
+    }
+#endif
+
+    flexspi_update_lut(instance, CMD_LUT_FOR_IP_CMD, &config->lookupTable[4 * seqId], seqNum);
+    return CMD_LUT_FOR_IP_CMD;
+}
+
 #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_XFER)
 status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer)
 {
@@ -984,6 +1148,10 @@ status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer)
 #else
         bool isParallelMode = xfer->isParallelModeEnable;
 #endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+        bool isDmaXfer = false;
+        status_t dmaStatus = kStatus_Success;
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
 
         flexspi_wait_until_ip_idle(base);
 
@@ -1028,8 +1196,19 @@ status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer)
             // Clear FIFO before read
             flexspi_clear_ip_rxfifo(base);
 
-            // Start Read
-            base->IPCMD |= FLEXSPI_IPCMD_TRG_MASK;
+            uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+            isDmaXfer = flexspi_dma_start_xfer(instance, base, true, xferBufferPtr, xferRemainingSize, burst_rx_size);
+            if (isDmaXfer)
+            {
+                xferRemainingSize = 0;
+            }
+            else
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
+            {
+                // Start Read
+                base->IPCMD |= FLEXSPI_IPCMD_TRG_MASK;
+            }
             while (xferRemainingSize > 0)
             {
                 register volatile uint32_t *rx_fifo_reg = (volatile uint32_t *)&base->RFDR[0];
@@ -1075,6 +1254,7 @@ status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer)
                     break;
                 }
             }
+            FLEXSPI_TRACE_END(kFlexSpiTracePhase_FifoDrain, traceStart, xfer->rxSize);
         }
 
         if ((xfer->operation == kFlexSpiOperation_Write) || (xfer->operation == kFlexSpiOperation_Config))
@@ -1096,6 +1276,16 @@ status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer)
             // Clear FIFO before write
             flexspi_clear_ip_txfifo(base);
 
+            uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+            isDmaXfer = flexspi_dma_start_xfer(instance, base, false, xferBufferPtr, (uint32_t)xferRemainingSize,
+                                               burst_tx_size);
+            if (isDmaXfer)
+            {
+                xferRemainingSize = 0;
+            }
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
+
             bool is_transfer_started = false;
             while (xferRemainingSize > 0)
             {
@@ -1104,7 +1294,7 @@ status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer)
                 if (base->INTR & FLEXSPI_INTR_IPTXWE_MASK)
                 {
                     register uint32_t burst_tx_round = burst_tx_size / sizeof(uint32_t);
-                    if (xferRemainingSize >= burst_tx_size)
+                    if ((uint32_t)xferRemainingSize >= burst_tx_size)
                     {
                         while (burst_tx_round--)
                         {
@@ -1142,13 +1332,23 @@ status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer)
                     break;
                 }
             }
+            FLEXSPI_TRACE_END(kFlexSpiTracePhase_FifoFill, traceStart, xfer->txSize);
         }
         if (xfer->operation == kFlexSpiOperation_Command)
         {
             base->IPCMD |= FLEXSPI_IPCMD_TRG_MASK;
         }
 
-        flexspi_wait_until_ip_idle(base);
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+        if (isDmaXfer)
+        {
+            dmaStatus = flexspi_dma_finish_xfer(base, xfer);
+        }
+        else
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
+        {
+            flexspi_wait_until_ip_idle(base);
+        }
 
         if (base->INTR & FLEXSPI_INTR_IPCMDERR_MASK)
         {
@@ -1164,13 +1364,150 @@ status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer)
         }
         else
         {
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+            status = dmaStatus;
+#else
             status = kStatus_Success;
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
         }
 
     } while (0);
 
     return status;
 }
+
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+static bool flexspi_dma_start_xfer(
+    uint32_t instance, FLEXSPI_Type *base, bool isRead, uint32_t *buffer, uint32_t bytes, uint32_t burstBytes)
+{
+    uint32_t channel = isRead ? FLEXSPI_DMA_RX_CHANNEL : FLEXSPI_DMA_TX_CHANNEL;
+    uint32_t source = isRead ? kDmaRequestMuxFlexSPIRx : kDmaRequestMuxFlexSPITx;
+    uint32_t fifo = isRead ? (uint32_t)(uintptr_t)&base->RFDR[0] : (uint32_t)(uintptr_t)&base->TFDR[0];
+    uint32_t fifoMod = 31U - __CLZ(burstBytes);
+    uint32_t address = (uint32_t)(uintptr_t)buffer;
+
+    // Only the first instance has DMA requests, every FIFO watermark request moves a whole burst and eDMA
+    // addresses are 32-bit, small or partial transfers and buffers of host builds above 4GB stay with the CPU
+    if ((instance != 0) || (bytes < FLEXSPI_DMA_MIN_TRANSFER_SIZE) || (bytes % burstBytes) ||
+        ((uintptr_t)buffer > UINT32_MAX) ||
+        ((bytes / burstBytes) > (DMA_CITER_ELINKNO_CITER_MASK >> DMA_CITER_ELINKNO_CITER_SHIFT)))
+    {
+        return false;
+    }
+
+#if defined(__DCACHE_PRESENT) && __DCACHE_PRESENT
+    if (isRead)
+    {
+        // The lines of the buffer are invalidated before and after the transfer, they must not hold other data
+        if (address & (__SCB_DCACHE_LINE_SIZE - 1U))
+        {
+            return false;
+        }
+        SCB_InvalidateDCache_by_Addr(buffer, (int32_t)bytes);
+    }
+    else
+    {
+        // The eDMA reads the memory behind the data cache
+        SCB_CleanDCache_by_Addr(buffer, (int32_t)bytes);
+    }
+#endif // __DCACHE_PRESENT
+
+    CLOCK_EnableClock(kCLOCK_Dma);
+
+    // Stop the channel before its TCD is rewritten, the FIFO side address wraps around the watermark area
+    DMA0->ERQ &= ~(1U << channel);
+    DMAMUX->CHCFG[channel] = 0;
+    DMA0->TCD[channel].CSR = 0;
+    if (isRead)
+    {
+        DMA0->TCD[channel].SADDR = fifo;
+        DMA0->TCD[channel].DADDR = address;
+        DMA0->TCD[channel].ATTR = DMA_ATTR_SSIZE(2) | DMA_ATTR_DSIZE(2) | DMA_ATTR_SMOD(fifoMod);
+    }
+    else
+    {
+        DMA0->TCD[channel].SADDR = address;
+        DMA0->TCD[channel].DADDR = fifo;
+        DMA0->TCD[channel].ATTR = DMA_ATTR_SSIZE(2) | DMA_ATTR_DSIZE(2) | DMA_ATTR_DMOD(fifoMod);
+    }
+    DMA0->TCD[channel].SOFF = sizeof(uint32_t);
+    DMA0->TCD[channel].DOFF = sizeof(uint32_t);
+    DMA0->TCD[channel].NBYTES_MLNO = burstBytes;
+    DMA0->TCD[channel].SLAST = 0;
+    DMA0->TCD[channel].DLAST_SGA = 0;
+    DMA0->TCD[channel].CITER_ELINKNO = bytes / burstBytes;
+    DMA0->TCD[channel].BITER_ELINKNO = bytes / burstBytes;
+    // The request is disabled by hardware at the end of the major loop
+    DMA0->TCD[channel].CSR = DMA_CSR_DREQ_MASK;
+    DMAMUX->CHCFG[channel] = DMAMUX_CHCFG_ENBL_MASK | DMAMUX_CHCFG_SOURCE(source);
+    DMA0->ERQ |= 1U << channel;
+
+    // The TX FIFO is filled as soon as the requests are enabled, so the command starts with data available
+    if (isRead)
+    {
+        base->IPRXFCR |= FLEXSPI_IPRXFCR_RXDMAEN_MASK;
+    }
+    else
+    {
+        base->IPTXFCR |= FLEXSPI_IPTXFCR_TXDMAEN_MASK;
+    }
+    base->IPCMD |= FLEXSPI_IPCMD_TRG_MASK;
+
+    return true;
+}
+
+static status_t flexspi_dma_finish_xfer(FLEXSPI_Type *base, flexspi_xfer_t *xfer)
+{
+    bool isRead = (xfer->operation == kFlexSpiOperation_Read);
+    uint32_t channel = isRead ? FLEXSPI_DMA_RX_CHANNEL : FLEXSPI_DMA_TX_CHANNEL;
+    uint32_t idleMask = FLEXSPI_STS0_SEQIDLE_MASK | FLEXSPI_STS0_ARBIDLE_MASK;
+    status_t status = kStatus_Timeout;
+
+    // A channel halted by an error no longer serves the FIFO and a stuck sequence never goes idle, the wait is
+    // bounded so both end the command instead of hanging the algorithm
+    for (uint32_t i = 0; i < FLEXSPI_DMA_WAIT_TIMEOUT; i++)
+    {
+        if (DMA0->ERR & (1U << channel))
+        {
+            status = kStatus_Fail;
+            break;
+        }
+        if (((base->STS0 & idleMask) == idleMask) && (DMA0->TCD[channel].CSR & DMA_CSR_DONE_MASK))
+        {
+            status = kStatus_Success;
+            break;
+        }
+    }
+
+    DMA0->ERQ &= ~(1U << channel);
+    DMAMUX->CHCFG[channel] = 0;
+    DMA0->TCD[channel].CSR = 0;
+    if (isRead)
+    {
+        base->IPRXFCR &= ~FLEXSPI_IPRXFCR_RXDMAEN_MASK;
+    }
+    else
+    {
+        base->IPTXFCR &= ~FLEXSPI_IPTXFCR_TXDMAEN_MASK;
+    }
+
+    if (status != kStatus_Success)
+    {
+        // Abort the command still waiting for its FIFO data, ES holds the cause of the error
+        flexspi_swreset(base);
+        DMA0->CERR = DMA_CERR_CERR(channel);
+    }
+#if defined(__DCACHE_PRESENT) && __DCACHE_PRESENT
+    else if (isRead)
+    {
+        // Drop the lines the core may have fetched from the buffer while the eDMA was writing it
+        SCB_InvalidateDCache_by_Addr(xfer->rxBuffer, (int32_t)xfer->rxSize);
+    }
+#endif // __DCACHE_PRESENT
+
+    return status;
+}
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
 #endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_XFER)
 
 void flexspi_wait_idle(uint32_t instance)
@@ -1202,7 +1539,9 @@ void flexspi_clear_cache(uint32_t instance)
             break;
         }
 
+        uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
         flexspi_swreset(base);
+        FLEXSPI_TRACE_END(kFlexSpiTracePhase_CacheClear, traceStart, 0);
 
     } while (0);
 }
@@ -1241,8 +1580,19 @@ status_t flexspi_device_wait_busy(uint32_t instance,
                                   flexspi_mem_config_t *config,
                                   bool isParallelMode,
                                   uint32_t baseAddr)
+{
+    return flexspi_device_poll_busy(instance, config, CMD_LUT_SEQ_IDX_READSTATUS, isParallelMode, baseAddr, 0);
+}
+
+status_t flexspi_device_poll_busy(uint32_t instance,
+                                  flexspi_mem_config_t *config,
+                                  uint32_t seqId,
+                                  bool isParallelMode,
+                                  uint32_t baseAddr,
+                                  uint32_t typicalUs)
 {
     status_t status = kStatus_InvalidArgument;
+    uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
 
     do
     {
@@ -1251,99 +1601,271 @@ status_t flexspi_device_wait_busy(uint32_t instance,
             break;
         }
         uint32_t statusDataBuffer[2];
-        uint32_t busyMask;
-        uint32_t busyPolarity;
         bool isBusy = false;
-#if FLEXSPI_FEATURE_HAS_PARALLEL_MODE
-        uint32_t status0, status1;
-#else
+#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
         isParallelMode = false;
 #endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
         flexspi_xfer_t flashXfer;
 
-        busyMask = 1 << config->busyOffset;
-        busyPolarity = config->busyBitPolarity;
-
         flashXfer.baseAddress = baseAddr;
         flashXfer.operation = kFlexSpiOperation_Read;
         flashXfer.seqNum = 1;
-        flashXfer.seqId = CMD_LUT_SEQ_IDX_READSTATUS;
+        flashXfer.seqId = seqId;
         flashXfer.rxBuffer = &statusDataBuffer[0];
 
         flashXfer.rxSize = isParallelMode ? sizeof(statusDataBuffer) : sizeof(statusDataBuffer[0]);
         flashXfer.isParallelModeEnable = isParallelMode;
 
-        if (config->lutCustomSeqEnable && config->lutCustomSeq[CMD_INDEX_READSTATUS].seqNum)
+        if ((seqId == CMD_LUT_SEQ_IDX_READSTATUS) && config->lutCustomSeqEnable &&
+            config->lutCustomSeq[CMD_INDEX_READSTATUS].seqNum)
         {
             flashXfer.seqId = config->lutCustomSeq[CMD_INDEX_READSTATUS].seqId;
             flashXfer.seqNum = config->lutCustomSeq[CMD_INDEX_READSTATUS].seqNum;
         }
 
-        flexspi_update_lut(instance, flashXfer.seqId, &config->lookupTable[4 * flashXfer.seqId], flashXfer.seqNum);
+        flashXfer.seqId = flexspi_select_ip_seq(instance, config, flashXfer.seqId, flashXfer.seqNum);
 
         bool enableTimeoutCheck = config->timeoutInMs ? true : false;
-        uint64_t remainingMs = config->timeoutInMs;
+        uint64_t timeoutUs = (uint64_t)config->timeoutInMs * 1000;
+        uint64_t elapsedUs = 0;
+
+        // Without typical time, poll back to back, or every 1ms if the timeout has to be checked. Otherwise
+        // let half of the typical time elapse, then poll at a fraction of it, doubling the interval once the
+        // typical time is exceeded.
+        uint32_t delayUs = typicalUs / 2;
+        uint32_t intervalUs = typicalUs / FLEXSPI_POLL_INTERVAL_DIVIDER;
+        if (intervalUs < FLEXSPI_POLL_INTERVAL_MIN_US)
+        {
+            intervalUs = FLEXSPI_POLL_INTERVAL_MIN_US;
+        }
+        else if (intervalUs > FLEXSPI_POLL_INTERVAL_MAX_US)
+        {
+            intervalUs = FLEXSPI_POLL_INTERVAL_MAX_US;
+        }
+        s_pollStats.waits++;
 
         do
         {
+            if (delayUs)
+            {
+                flexspi_sw_delay_us(delayUs);
+                elapsedUs += delayUs;
+                s_pollStats.delayUs += delayUs;
+            }
+
             status = flexspi_command_xfer(instance, &flashXfer);
+            s_pollStats.polls++;
             if (status != kStatus_Success)
             {
                 break;
             }
-            else
+            isBusy = flexspi_is_busy_status(config, statusDataBuffer, isParallelMode);
+
+            if (isBusy)
             {
-#if FLEXSPI_FEATURE_HAS_PARALLEL_MODE
-                if (isParallelMode)
+                if (enableTimeoutCheck && (elapsedUs >= timeoutUs))
                 {
-                    // Extract parallel data to serial data
-                    flexspi_extract_parallel_data(&status0, &status1, statusDataBuffer, sizeof(statusDataBuffer));
+                    status = kStatus_FLEXSPI_DeviceTimeout;
+                    break;
+                }
 
-                    if (busyPolarity)
-                    {
-                        isBusy = ((~status0) & busyMask) | ((~status1) & busyMask);
-                    }
-                    else
-                    {
-                        isBusy = (status0 & busyMask) | (status1 & busyMask);
-                    }
+                if (typicalUs == 0)
+                {
+                    delayUs = enableTimeoutCheck ? 1000 : 0;
                 }
                 else
-#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
                 {
-                    // Busy bit is 0 if polarity is 1
-                    if (busyPolarity)
+                    if ((elapsedUs >= typicalUs) && (intervalUs < FLEXSPI_POLL_INTERVAL_MAX_US))
                     {
-                        isBusy = (~statusDataBuffer[0]) & busyMask;
-                    }
-                    else
-                    {
-                        isBusy = statusDataBuffer[0] & busyMask;
+                        intervalUs = (intervalUs * 2 < FLEXSPI_POLL_INTERVAL_MAX_US) ? (intervalUs * 2) :
+                                                                                       FLEXSPI_POLL_INTERVAL_MAX_US;
                     }
+                    delayUs = intervalUs;
                 }
             }
+        } while (isBusy);
 
-            if (isBusy && enableTimeoutCheck)
-            {
-                if (remainingMs > 0)
-                {
-                    flexspi_sw_delay_us(1000);
-                    remainingMs--;
-                }
-                else
-                {
-                    status = kStatus_FLEXSPI_DeviceTimeout;
-                    break;
-                }
-            }
+    } while (0);
 
-        } while (isBusy);
+    FLEXSPI_TRACE_END(kFlexSpiTracePhase_BusyPoll, traceStart, 0);
+
+    return status;
+}
+
+status_t flexspi_device_read_busy(uint32_t instance,
+                                  flexspi_mem_config_t *config,
+                                  uint32_t seqId,
+                                  bool isParallelMode,
+                                  uint32_t baseAddr,
+                                  bool *isBusy)
+{
+    status_t status = kStatus_InvalidArgument;
+
+    do
+    {
+        if ((config == NULL) || (isBusy == NULL))
+        {
+            break;
+        }
+        uint32_t statusDataBuffer[2];
+#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+        isParallelMode = false;
+#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+        flexspi_xfer_t flashXfer;
+
+        flashXfer.baseAddress = baseAddr;
+        flashXfer.operation = kFlexSpiOperation_Read;
+        flashXfer.seqNum = 1;
+        flashXfer.seqId = seqId;
+        flashXfer.rxBuffer = &statusDataBuffer[0];
+        flashXfer.rxSize = isParallelMode ? sizeof(statusDataBuffer) : sizeof(statusDataBuffer[0]);
+        flashXfer.isParallelModeEnable = isParallelMode;
+
+        if ((seqId == CMD_LUT_SEQ_IDX_READSTATUS) && config->lutCustomSeqEnable &&
+            config->lutCustomSeq[CMD_INDEX_READSTATUS].seqNum)
+        {
+            flashXfer.seqId = config->lutCustomSeq[CMD_INDEX_READSTATUS].seqId;
+            flashXfer.seqNum = config->lutCustomSeq[CMD_INDEX_READSTATUS].seqNum;
+        }
+
+        flashXfer.seqId = flexspi_select_ip_seq(instance, config, flashXfer.seqId, flashXfer.seqNum);
+        status = flexspi_command_xfer(instance, &flashXfer);
+        s_pollStats.polls++;
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+        *isBusy = flexspi_is_busy_status(config, statusDataBuffer, isParallelMode);
 
     } while (0);
 
     return status;
 }
 
+bool flexspi_is_busy_status(flexspi_mem_config_t *config, uint32_t *statusDataBuffer, bool isParallelMode)
+{
+    uint32_t busyMask = 1 << config->busyOffset;
+    bool isBusy;
+
+#if FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+    if (isParallelMode)
+    {
+        uint32_t status0, status1;
+
+        // Extract parallel data to serial data
+        flexspi_extract_parallel_data(&status0, &status1, statusDataBuffer, 2 * sizeof(uint32_t));
+
+        if (config->busyBitPolarity)
+        {
+            isBusy = ((~status0) & busyMask) | ((~status1) & busyMask);
+        }
+        else
+        {
+            isBusy = (status0 & busyMask) | (status1 & busyMask);
+        }
+    }
+    else
+#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+    {
+        // Busy bit is 0 if polarity is 1
+        if (config->busyBitPolarity)
+        {
+            isBusy = (~statusDataBuffer[0]) & busyMask;
+        }
+        else
+        {
+            isBusy = statusDataBuffer[0] & busyMask;
+        }
+    }
+
+    return isBusy;
+}
+
+void flexspi_get_poll_stats(flexspi_poll_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_pollStats;
+    }
+}
+
+void flexspi_reset_poll_stats(void)
+{
+    s_pollStats.waits = 0;
+    s_pollStats.polls = 0;
+    s_pollStats.delayUs = 0;
+}
+
+#if FLEXSPI_ENABLE_TRACE
+void flexspi_trace_attach(flexspi_trace_t *trace)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = FLEXSPI_DWT_LAR_KEY;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    if ((trace != NULL) &&
+        ((trace->tag != FLEXSPI_TRACE_TAG) || (trace->version != FLEXSPI_TRACE_VERSION) ||
+         (trace->phaseCount != kFlexSpiTracePhase_Count) || (trace->entryCount != FLEXSPI_TRACE_ENTRIES)))
+    {
+        memset(trace, 0, sizeof(*trace));
+        trace->tag = FLEXSPI_TRACE_TAG;
+        trace->version = FLEXSPI_TRACE_VERSION;
+        trace->phaseCount = kFlexSpiTracePhase_Count;
+        trace->entryCount = FLEXSPI_TRACE_ENTRIES;
+    }
+    if (trace != NULL)
+    {
+        trace->coreClockHz = SystemCoreClock;
+    }
+    s_trace = trace;
+}
+
+flexspi_trace_t *flexspi_trace_get(void)
+{
+    return s_trace;
+}
+
+uint32_t flexspi_trace_get_cycles(void)
+{
+    return FLEXSPI_TRACE_GET_CYCLES();
+}
+
+void flexspi_trace_record(flexspi_trace_phase_t phase, uint32_t startCycles, uint32_t bytes)
+{
+    uint32_t cycles = FLEXSPI_TRACE_GET_CYCLES() - startCycles;
+    flexspi_trace_t *trace = s_trace;
+
+    do
+    {
+        if ((trace == NULL) || (phase >= kFlexSpiTracePhase_Count))
+        {
+            break;
+        }
+
+        flexspi_trace_phase_stats_t *stats = &trace->phases[phase];
+        if ((stats->count == 0) || (cycles < stats->minCycles))
+        {
+            stats->minCycles = cycles;
+        }
+        if (cycles > stats->maxCycles)
+        {
+            stats->maxCycles = cycles;
+        }
+        stats->count++;
+        stats->totalCycles += cycles;
+        stats->buckets[cycles ? (31U - __CLZ(cycles)) : 0U]++;
+
+        flexspi_trace_entry_t *entry = &trace->entries[trace->writeIndex % FLEXSPI_TRACE_ENTRIES];
+        entry->startCycles = startCycles;
+        entry->cycles = cycles;
+        entry->phase = phase;
+        entry->bytes = bytes;
+        trace->writeIndex++;
+
+    } while (0);
+}
+#endif // FLEXSPI_ENABLE_TRACE
+
 void flexspi_clear_sequence_pointer(uint32_t instance)
 {
     uint32_t index;
@@ -11,6 +11,12 @@
 #define __FSL_FLEXSPI_H__
 
 #include "fsl_common.h"
+#if defined(BL_TARGET_ROM_API)
+// BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI and the ROM_API_HAS_xxx switches of the target, the functions they select come
+// from the boot ROM through bl_api.c instead of the driver
+#include "bootloader_common.h"
+#endif
+#include "fsl_flexspi_trace.h"
 
 /**********************************************************************************************************************
  * Definitions
@@ -21,6 +27,17 @@
 #define FlexSPI_AHB_RX_BUF_COUNT (4U)
 /* AHB RX_BUF depth, in longwords */
 #define FlexSPI_AHB_RX_BUF_DEPTH (512U)
+/* AHB RX buffer memory shared by the buffers, in bytes */
+#ifndef FlexSPI_AHB_RX_BUF_SIZE
+#define FlexSPI_AHB_RX_BUF_SIZE (1024U)
+#endif
+/* Line size of the cache in front of the AHB window, the size of its reads */
+#ifndef FlexSPI_AHB_CACHE_LINE_SIZE
+#define FlexSPI_AHB_CACHE_LINE_SIZE (32U)
+#endif
+#if (FlexSPI_AHB_RX_BUF_SIZE / 8U) > 0xFFU
+#error "FlexSPI_AHB_RX_BUF_SIZE does not fit AHBRXBUFCR0[BUFSZ]"
+#endif
 /* AHB TX BUF depth, in longwords */
 #define FlexSPI_AHB_TX_BUF_DEPTH (32U)
 /* IP_RX_BUF depth, in longwords */
@@ -36,6 +53,13 @@
 /* FLEXSPI Feature related definitions */
 #define FLEXSPI_FEATURE_HAS_PARALLEL_MODE 1
 
+/* IP FIFO DMA related definitions, the transfer is waited for within flexspi_command_xfer and nothing overlaps
+ * it, so it brings no throughput gain and stays off by default */
+#ifndef FLEXSPI_ENABLE_DMA_TRANSFER
+#define FLEXSPI_ENABLE_DMA_TRANSFER 0 // Move IP command data with eDMA channel 0 (RX) and 1 (TX)
+#endif
+#define FLEXSPI_DMA_MIN_TRANSFER_SIZE (256U) // Smaller transfers are moved by the CPU
+
 /* Lookup table related defintions */
 #define CMD_INDEX_READ 0
 #define CMD_INDEX_READSTATUS 1
@@ -47,6 +71,16 @@
 #define CMD_LUT_SEQ_IDX_WRITEENABLE 3
 #define CMD_LUT_SEQ_IDX_WRITE 9
 
+/* Status polling related definitions */
+//!@brief Read status commands issued per typical operation time once half of it elapsed
+#define FLEXSPI_POLL_INTERVAL_DIVIDER (32UL)
+#define FLEXSPI_POLL_INTERVAL_MIN_US (2UL)    //!< Minimum interval between two read status commands
+#define FLEXSPI_POLL_INTERVAL_MAX_US (1000UL) //!< Maximum interval between two read status commands
+
+#ifndef FLEXSPI_ENABLE_RESIDENT_LUT
+#define FLEXSPI_ENABLE_RESIDENT_LUT 1 // Keep the whole lookupTable in the LUT, IP commands run it in place
+#endif
+
 #define CMD_SDR 0x01
 #define CMD_DDR 0x21
 #define RADDR_SDR 0x02
@@ -205,8 +239,8 @@ typedef struct _FlexSPIConfig
     uint32_t version;           //!< [0x004-0x007] Version,[31:24] -'V', [23:16] - Major, [15:8] - Minor, [7:0] - bugfix
     uint32_t reserved0;         //!< [0x008-0x00b] Reserved for future use
     uint8_t readSampleClkSrc;   //!< [0x00c-0x00c] Read Sample Clock Source, valid value: 0/1/3
-    uint8_t csHoldTime;         //!< [0x00d-0x00d] CS hold time, default value: 3
-    uint8_t csSetupTime;        //!< [0x00e-0x00e] CS setup time, default value: 3
+    uint8_t csHoldTime;         //!< [0x00d-0x00d] CS hold time, default value: 3, dataHoldTime in older revisions
+    uint8_t csSetupTime;        //!< [0x00e-0x00e] CS setup time, default value: 3, dataSetupTime in older revisions
     uint8_t columnAddressWidth; //!< [0x00f-0x00f] Column Address with, for HyperBus protocol, it is fixed to 3, For
     //! Serial NAND, need to refer to datasheet
     uint8_t deviceModeCfgEnable; //!< [0x010-0x010] Device Mode Configure enable flag, 1 - Enable, 0 - Disable
@@ -279,6 +313,22 @@ typedef struct _FlexSpiXfer
     uint32_t rxSize;               //!< Rx size in bytes
 } flexspi_xfer_t;
 
+//!@brief Status polling statistics of flexspi_device_poll_busy, used to tune the poll back-off
+typedef struct _flexspi_poll_stats
+{
+    uint32_t waits;   //!< Waits for the device to become idle
+    uint32_t polls;   //!< Read status commands issued
+    uint32_t delayUs; //!< Time spent in delays between read status commands
+} flexspi_poll_stats_t;
+
+//!@brief AHB RX buffer assignment saved by flexspi_enter_verify_ahb_profile
+typedef struct _flexspi_ahb_profile
+{
+    bool isSaved;                                //!< The fields hold the assignment to restore
+    uint32_t ahbcr;                              //!< AHBCR
+    uint32_t rxBufCr0[FlexSPI_AHB_RX_BUF_COUNT]; //!< AHBRXBUFCR0 of each AHB RX buffer
+} flexspi_ahb_profile_t;
+
 //!@brief FlexSPI Clock Type
 typedef enum
 {
@@ -299,6 +349,12 @@ typedef enum
 #define FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT (1)
 #endif
 
+//!@brief Configure the device at 30MHz also when it runs in DDR mode, 0 - only with SafeConfigFreqEnable, at
+//!       kFlexSpiSerialClk_SafeFreq
+#ifndef FLEXSPI_ENABLE_DDR_SAFE_CONFIG_FREQ
+#define FLEXSPI_ENABLE_DDR_SAFE_CONFIG_FREQ (1)
+#endif
+
 /**********************************************************************************************************************
  * API
  *********************************************************************************************************************/
@@ -323,9 +379,46 @@ extern "C"
                                       bool isParallelMode,
                                       uint32_t baseAddr);
 
+    //!@brief Wait until device is idle, reading its status with LUT sequence seqId
+    //!
+    //! typicalUs is the typical time of the operation in progress, 0 if unknown. When it is known, the first
+    //! read status is issued after half of it and the next ones are spaced by a back-off derived from it,
+    //! instead of back to back.
+    status_t flexspi_device_poll_busy(uint32_t instance,
+                                      flexspi_mem_config_t *config,
+                                      uint32_t seqId,
+                                      bool isParallelMode,
+                                      uint32_t baseAddr,
+                                      uint32_t typicalUs);
+
+    //!@brief Read the device status once with LUT sequence seqId, isBusy tells whether it is still busy
+    status_t flexspi_device_read_busy(uint32_t instance,
+                                      flexspi_mem_config_t *config,
+                                      uint32_t seqId,
+                                      bool isParallelMode,
+                                      uint32_t baseAddr,
+                                      bool *isBusy);
+
+    //!@brief Get status polling statistics
+    void flexspi_get_poll_stats(flexspi_poll_stats_t *stats);
+
+    //!@brief Reset status polling statistics
+    void flexspi_reset_poll_stats(void);
+
     //!@brief Configure FlexSPI Lookup table
     status_t flexspi_update_lut(uint32_t instance, uint32_t seqIndex, const uint32_t *lutBase, uint32_t numberOfSeq);
 
+    //!@brief Load all 16 sequences of lookupTable, they stay resident until another LUT update
+    status_t flexspi_load_lut(uint32_t instance, const uint32_t *lookupTable);
+
+    //!@brief Forget the resident lookupTable, for callers about to change it
+    void flexspi_clear_resident_lut(uint32_t instance);
+
+    //!@brief Get the LUT sequence an IP command runs for sequence seqId of config
+    //!
+    //! Returns seqId if config->lookupTable is resident, otherwise the sequences are copied to the IP command slot
+    uint32_t flexspi_select_ip_seq(uint32_t instance, flexspi_mem_config_t *config, uint32_t seqId, uint32_t seqNum);
+
     //!@brief Perform FlexSPI command
     status_t flexspi_command_xfer(uint32_t instance, flexspi_xfer_t *xfer);
 
@@ -338,6 +431,16 @@ extern "C"
     //!@brief Clear FlexSPI cache
     void flexspi_clear_cache(uint32_t instance);
 
+    //!@brief Give the AHB RX buffer memory to the sequential reads of a verify
+    //!
+    //! The last buffer, which serves every master without a buffer of its own, gets all the memory in whole
+    //! cache lines with prefetch on, the others none. The assignment in place is saved to profile, unless
+    //! profile already holds one, for flexspi_restore_ahb_profile.
+    status_t flexspi_enter_verify_ahb_profile(uint32_t instance, flexspi_ahb_profile_t *profile);
+
+    //!@brief Restore the AHB RX buffer assignment saved by flexspi_enter_verify_ahb_profile
+    status_t flexspi_restore_ahb_profile(uint32_t instance, flexspi_ahb_profile_t *profile);
+
     //!@brief Clear FlexSPI sequence pointer
     void flexspi_clear_sequence_pointer(uint32_t instance);
 
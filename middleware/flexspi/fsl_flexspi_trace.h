@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FSL_FLEXSPI_TRACE_H__
+#define __FSL_FLEXSPI_TRACE_H__
+
+#include <stdint.h>
+
+/**********************************************************************************************************************
+ * Definitions
+ *********************************************************************************************************************/
+#ifndef FLEXSPI_ENABLE_TRACE
+#define FLEXSPI_ENABLE_TRACE 0 // Time the phases of program and erase into the trace given to flexspi_trace_attach
+#endif
+
+#define FLEXSPI_TRACE_TAG (0x43525446UL) // ascii "FTRC" Big Endian
+#define FLEXSPI_TRACE_VERSION (1UL)
+#ifndef FLEXSPI_TRACE_ENTRIES
+#define FLEXSPI_TRACE_ENTRIES (128U) // Last phases kept in the ring
+#endif
+#define FLEXSPI_TRACE_BUCKETS (32U) // Bucket n counts durations of 2^n to 2^(n+1)-1 cycles, bucket 0 also 0
+
+//!@brief Phases timed by the trace
+typedef enum _flexspi_trace_phase
+{
+    kFlexSpiTracePhase_ClockSwitch, //!< Serial clock update or restore around IP commands
+    kFlexSpiTracePhase_WriteEnable, //!< Write Enable command
+    kFlexSpiTracePhase_FifoFill,    //!< IP TX FIFO fill of flexspi_command_xfer
+    kFlexSpiTracePhase_FifoDrain,   //!< IP RX FIFO drain of flexspi_command_xfer
+    kFlexSpiTracePhase_BusyPoll,    //!< Wait for the device to become idle, delays and read status included
+    kFlexSpiTracePhase_CacheClear,  //!< AHB buffer flush by software reset
+    kFlexSpiTracePhase_Init,        //!< FlashOS entry points, recorded by the algorithm
+    kFlexSpiTracePhase_EraseSector,
+    kFlexSpiTracePhase_ProgramPage,
+    kFlexSpiTracePhase_Count,
+} flexspi_trace_phase_t;
+
+//!@brief Durations of one phase since the trace was reset
+typedef struct _flexspi_trace_phase_stats
+{
+    uint64_t totalCycles;
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t reserved;
+    uint32_t buckets[FLEXSPI_TRACE_BUCKETS]; //!< log2 histogram of the durations
+} flexspi_trace_phase_stats_t;
+
+//!@brief One phase of the ring
+typedef struct _flexspi_trace_entry
+{
+    uint32_t startCycles; //!< Cycle counter when the phase started
+    uint32_t cycles;      //!< Duration
+    uint32_t phase;       //!< flexspi_trace_phase_t
+    uint32_t bytes;       //!< Data moved, programmed or erased, 0 if none
+} flexspi_trace_entry_t;
+
+//!@brief Trace kept in RAM, where a debugger or host script can dump it
+//!
+//! Cycles are the ones of the core, 32 bits wide: a phase longer than 2^32 cycles (8.6s at 500MHz) wraps.
+//! Writing 0 to tag resets the trace on the next flexspi_trace_attach.
+typedef struct _flexspi_trace
+{
+    uint32_t tag;         //!< FLEXSPI_TRACE_TAG
+    uint32_t version;     //!< FLEXSPI_TRACE_VERSION
+    uint32_t coreClockHz; //!< Core clock the cycles count
+    uint16_t phaseCount;  //!< kFlexSpiTracePhase_Count
+    uint16_t entryCount;  //!< FLEXSPI_TRACE_ENTRIES
+    uint32_t writeIndex;  //!< Phases recorded since reset, the next one goes to entries[writeIndex % entryCount]
+    uint32_t reserved;
+    flexspi_trace_phase_stats_t phases[kFlexSpiTracePhase_Count];
+    flexspi_trace_entry_t entries[FLEXSPI_TRACE_ENTRIES];
+} flexspi_trace_t;
+
+//!@brief Time a phase: start = FLEXSPI_TRACE_BEGIN(); ...; FLEXSPI_TRACE_END(phase, start, bytes);
+#if FLEXSPI_ENABLE_TRACE
+#define FLEXSPI_TRACE_BEGIN() flexspi_trace_get_cycles()
+#define FLEXSPI_TRACE_END(phase, startCycles, bytes) flexspi_trace_record((phase), (startCycles), (bytes))
+#else
+#define FLEXSPI_TRACE_BEGIN() (0U)
+#define FLEXSPI_TRACE_END(phase, startCycles, bytes) ((void)(startCycles))
+#endif // FLEXSPI_ENABLE_TRACE
+
+/**********************************************************************************************************************
+ * API
+ *********************************************************************************************************************/
+
+#if FLEXSPI_ENABLE_TRACE
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    //!@brief Record the following phases into trace, NULL stops recording
+    //!
+    //! Starts the cycle counter. The content of trace is kept if it is a trace of the same layout, so that it
+    //! accumulates over the Init calls of a download, and reset otherwise.
+    void flexspi_trace_attach(flexspi_trace_t *trace);
+
+    //!@brief Get the trace phases are recorded into, NULL if none
+    flexspi_trace_t *flexspi_trace_get(void);
+
+    //!@brief Get the cycle counter phases are timed with
+    uint32_t flexspi_trace_get_cycles(void);
+
+    //!@brief Record a phase that started at startCycles and ends now
+    void flexspi_trace_record(flexspi_trace_phase_t phase, uint32_t startCycles, uint32_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // FLEXSPI_ENABLE_TRACE
+
+#endif // __FSL_FLEXSPI_TRACE_H__
@@ -7,6 +7,7 @@
  *
  */
 
+#include <stddef.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -21,6 +22,26 @@
 #define MAX_24BIT_ADDRESSING_SIZE (16UL * 1024 * 1024)
 
 #define NOR_CMD_LUT_FOR_IP_CMD 1 //!< 1 Dedicated LUT Sequence Index for IP Command
+#define NOR_CMD_INDEX_NONE 0xFFu //!< No custom sequence can replace the command
+
+//!@brief Chip selects of a FlexSPI instance: A1, A2, B1, B2
+#define FLEXSPI_NOR_MAX_CHIPS (4)
+
+//!@brief Read clock tuning, see flexspi_nor_flash_tune_read
+#ifndef FLEXSPI_NOR_TUNE_ADDRESS
+#define FLEXSPI_NOR_TUNE_ADDRESS (0) //!< Device address of the reference data, the config block on boot devices
+#endif
+#define FLEXSPI_NOR_TUNE_SIZE (64)              //!< Bytes of the reference data of a region
+#define FLEXSPI_NOR_TUNE_REGIONS (4)            //!< Regions of the reference data
+#define FLEXSPI_NOR_TUNE_REGION_STRIDE (0x1000) //!< Distance between regions: config block, IVT, vectors, code
+#define FLEXSPI_NOR_TUNE_READS (2)              //!< Reads of every region that must all match at a tuning point
+#define FLEXSPI_NOR_TUNE_DUMMY_SPAN (2)         //!< Dummy cycles tried above the ones of the read sequence
+
+//!@brief HyperFLASH Blank Check, HyperBus devices have no 0-4-4/0-8-8 mode to exit so its sequence is free
+#define NOR_CMD_LUT_SEQ_IDX_HYPERFLASH_BLANKCHECK NOR_CMD_LUT_SEQ_IDX_EXIT_NOCMD
+//!@brief Sector Erase Status Bit, SR[5] of HyperFLASH, set when Blank Check found a programmed bit. The status
+//! word arrives big-endian, so SR[7:0] is the second byte read.
+#define HYPERFLASH_STATUS_ESB_MASK (1UL << (5 + 8))
 
 //!@brief Typical Serial NOR commands supported by most Serial NOR devices
 enum
@@ -50,6 +71,8 @@ enum
 {
     kSerialNorCmd_SE4K_3B = 0x20,
     kSerialNorCmd_SE4K_4B = 0x21,
+    kSerialNorCmd_SE32K_3B = 0x52,
+    kSerialNorCmd_SE32K_4B = 0x5C,
     kSerialNorCmd_SE64K_3B = 0xD8,
     kSerialNorCmd_SE64K_4B = 0xDC,
 };
@@ -217,7 +240,12 @@ typedef struct _jedec_flash_param_table
     {
         uint32_t reserved0 : 4;
         uint32_t page_size : 4;
-        uint32_t reserved1 : 24;
+        uint32_t page_program_time : 5;
+        uint32_t page_program_time_unit : 1;
+        uint32_t reserved1 : 10;
+        uint32_t chip_erase_time : 5;
+        uint32_t chip_erase_time_unit : 2;
+        uint32_t reserved2 : 1;
     } chip_erase_progrm_info;
 
     struct
@@ -345,6 +373,31 @@ typedef struct _jdec_query_table
     jedec_4byte_addressing_inst_table_t flash_4b_inst_tbl;
 } jedec_info_table_t;
 
+//!@brief Program or erase state of one chip select, see flexspi_nor_run_chips
+typedef struct _flexspi_nor_chip_state
+{
+    uint32_t next;        //!< Next address to program or erase
+    uint32_t end;         //!< End of the range in this chip
+    uint32_t chipBase;    //!< Start address of the chip
+    uint32_t chipSize;    //!< Size of the chip, 0 if it cannot be erased as a whole
+    uint32_t busyAddress; //!< Address of the operation in progress
+    uint32_t startUs;     //!< Time the operation in progress started at
+    uint32_t typicalUs;   //!< Typical time of the operation in progress, 0 if unknown
+    uint32_t pollUs;      //!< Time of the next read status
+    uint32_t intervalUs;  //!< Time between two read status
+    uint32_t traceStart;  //!< Cycle counter when the operation in progress started, see FLEXSPI_TRACE_BEGIN
+    bool isBusy;          //!< An operation is in progress
+} flexspi_nor_chip_state_t;
+
+//!@brief Erase command of the erase planner
+typedef struct _flexspi_nor_erase_type
+{
+    uint32_t size;     //!< Bytes erased
+    uint32_t timeMs;   //!< Typical time from SFDP, 0 if unknown
+    uint32_t seqId;    //!< LUT sequence
+    uint32_t cmdIndex; //!< Custom sequence that can replace it, NOR_CMD_INDEX_NONE if none
+} flexspi_nor_erase_type_t;
+
 /*******************************************************************************
  * Local prototypes
  *******************************************************************************/
@@ -365,11 +418,23 @@ static status_t flexspi_nor_write_enable(uint32_t instance,
                                          bool isParalleMode,
                                          uint32_t baseAddr);
 
-//!@brief Wait until Flash device is idle
+//!@brief Wait until Flash device is idle, typicalUs is the typical time of the operation in progress
 static status_t flexspi_nor_wait_busy(uint32_t instance,
                                       flexspi_nor_config_t *config,
                                       bool isParalleMode,
-                                      uint32_t baseAddr);
+                                      uint32_t baseAddr,
+                                      uint32_t typicalUs);
+
+//!@brief Send Write Enable and Page Program commands with the page data to Serial NOR via FlexSPI
+static status_t flexspi_nor_page_program_send(uint32_t instance,
+                                              flexspi_nor_config_t *config,
+                                              bool isParallelMode,
+                                              uint32_t dstAddr,
+                                              const uint32_t *src);
+
+//!@brief Wait until the Page Program in progress completes, typicalUs is 0 if it may be complete already
+static status_t flexspi_nor_page_program_wait(
+    uint32_t instance, flexspi_nor_config_t *config, bool isParallelMode, uint32_t dstAddr, uint32_t typicalUs);
 
 //!@brief Update Serial Clock for IP command execution
 static void flexspi_change_serial_clock(uint32_t instance, flexspi_nor_config_t *config, uint32_t operation);
@@ -397,6 +462,26 @@ static status_t probe_dtr_quad_read_dummy_cycles(uint32_t instance,
 //!@brief Read SFDP Info back
 static status_t flexspi_nor_read_sfdp_info(uint32_t instance, jedec_info_table_t *tbl, bool address_shift_enable);
 
+//!@brief Initialize FlexSPI and load the Read SFDP sequence for probing the Flash device
+static status_t flexspi_nor_prepare_sfdp_read(uint32_t instance,
+                                              flexspi_nor_config_t *config,
+                                              serial_nor_config_option_t *option);
+
+//!@brief Read the JEDEC ID and the CRC32 of the SFDP headers that identify the Flash device
+static status_t flexspi_nor_read_device_fingerprint(uint32_t instance, uint32_t *jedec_id, uint32_t *sfdp_crc);
+
+//!@brief Calculate CRC32 (IEEE 802.3) of the data
+static uint32_t flexspi_nor_crc32(const uint8_t *data, uint32_t length);
+
+//!@brief Calculate the CRC32 of a configuration block cache, over every field but crc32
+static uint32_t flexspi_nor_config_cache_crc32(const flexspi_nor_config_cache_t *cache);
+
+//!@brief Check that a configuration block cache holds a config block and was not overwritten since it was filled
+static bool flexspi_nor_config_cache_is_valid(const flexspi_nor_config_cache_t *cache);
+
+//!@brief Configure the Configuration block to default value and apply the controller settings in option
+static void flexspi_nor_set_default_config(flexspi_nor_config_t *config, serial_nor_config_option_t *option);
+
 //!@brief Generate FlexSPI NOR Configuration Block by reading SFDP info
 static status_t flexspi_nor_generate_config_block_using_sfdp(uint32_t instance,
                                                              flexspi_nor_config_t *config,
@@ -430,6 +515,20 @@ static status_t flexspi_nor_generate_config_block_adesto_octalflash(uint32_t ins
                                                                     serial_nor_config_option_t *option);
 #endif // FLEXSPI_ENABLE_OCTAL_FLASH_SUPPORT
 
+//!@brief Get the erase type between sector and block advertised by SFDP, returns its size or 0 if there is none
+static uint32_t get_half_block_size_from_sfdp(flexspi_nor_config_t *config,
+                                              jedec_info_table_t *tbl,
+                                              uint32_t *half_block_erase_cmd);
+
+//!@brief Get the typical program and erase times advertised by SFDP, 0 for the ones that are not
+static void get_typical_times_from_sfdp(flexspi_nor_config_t *config, jedec_info_table_t *tbl);
+
+//!@brief Get the size of all the devices connected to the FlexSPI, 0 if it cannot be erased by a chip erase
+static uint32_t flexspi_nor_get_device_size(flexspi_nor_config_t *config);
+
+//!@brief Check whether an erase type can be used at address with remaining bytes left to erase
+static bool is_erase_type_usable(uint32_t erase_size, uint32_t address, uint32_t remaining_size);
+
 #if FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT
 //!@brief Generate 0-4-4 mode enable sequence, currently only applicable to Micron QuadSPI FLASH
 //        For other QuadSPI NOR Flash device, it is not required.
@@ -439,6 +538,91 @@ static status_t prepare_0_4_4_mode_enable_sequence(uint32_t instance,
                                                    serial_nor_config_option_t *option);
 #endif // FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT
 
+//!@brief Initialize FlexSPI while the config block is still being generated, its LUT is not kept resident
+static status_t flexspi_nor_probe_init(uint32_t instance, flexspi_nor_config_t *config);
+
+//!@brief LUT sequence that reads the status of the device
+static uint32_t flexspi_nor_get_status_seq(flexspi_nor_config_t *config);
+
+//!@brief Send Write Enable and the erase command of sequence seqId, cmdIndex selects the custom sequence
+static status_t flexspi_nor_erase_send(uint32_t instance,
+                                       flexspi_nor_config_t *config,
+                                       bool isParallelMode,
+                                       uint32_t address,
+                                       uint32_t seqId,
+                                       uint32_t cmdIndex);
+
+//!@brief Largest erase type aligned at address that fits in remaining_size
+static void flexspi_nor_pick_erase_type(flexspi_nor_config_t *config,
+                                        uint32_t address,
+                                        uint32_t remaining_size,
+                                        flexspi_nor_erase_type_t *type);
+
+//!@brief Typical time of the erases flexspi_nor_pick_erase_type selects for [address, address + size)
+static uint32_t flexspi_nor_get_erase_time_ms(flexspi_nor_config_t *config, uint32_t address, uint32_t size);
+
+//!@brief Split [start, end) between the chip selects, returns the number of chips, 0 if it exceeds the devices
+static uint32_t flexspi_nor_split_chips(
+    flexspi_nor_config_t *config, bool isParallelMode, uint32_t start, uint32_t end, flexspi_nor_chip_state_t *chips);
+
+//!@brief Start the next program (src != NULL) or erase operation of a chip, src holds the data from start
+static status_t flexspi_nor_start_chip(uint32_t instance,
+                                       flexspi_nor_config_t *config,
+                                       bool isParallelMode,
+                                       flexspi_nor_chip_state_t *chip,
+                                       uint32_t start,
+                                       const uint32_t *src,
+                                       uint32_t nowUs);
+
+//!@brief Program (src != NULL) or erase [start, end), keeping one operation in progress on every chip it covers
+static status_t flexspi_nor_run_chips(uint32_t instance,
+                                      flexspi_nor_config_t *config,
+                                      bool isParallelMode,
+                                      uint32_t start,
+                                      uint32_t end,
+                                      const uint32_t *src);
+
+//!@brief Wait for the operations still in progress on the chips after flexspi_nor_run_chips stopped on an error
+static void flexspi_nor_wait_chips(uint32_t instance,
+                                   flexspi_nor_config_t *config,
+                                   bool isParallelMode,
+                                   flexspi_nor_chip_state_t *chips,
+                                   uint32_t count,
+                                   uint32_t nowUs);
+
+//!@brief Wait at least 10 serial clocks after a serial clock change
+static void flexspi_nor_wait_clock_stable(uint32_t instance, bool isDdrModeEnabled);
+
+//!@brief Index of the dummy instruction in the read sequence, 0-7, -1 if it has none
+static int32_t flexspi_nor_get_read_dummy_index(flexspi_nor_config_t *config);
+
+//!@brief Set the serial clock of reads and, if dummyIndex >= 0, the dummy cycles of the read sequence
+static void flexspi_nor_set_read_point(
+    uint32_t instance, flexspi_nor_config_t *config, uint32_t freq, int32_t dummyIndex, uint32_t dummyCycles);
+
+//!@brief Serial clock of the device in Hz at the current clock configuration
+static uint32_t flexspi_nor_get_serial_clock(uint32_t instance, flexspi_nor_config_t *config);
+
+//!@brief Read one region of the tuning reference with the read sequence
+static status_t flexspi_nor_read_tune_data(uint32_t instance,
+                                           flexspi_nor_config_t *config,
+                                           uint32_t region,
+                                           uint32_t *buffer);
+
+//!@brief Read every region of the tuning reference reads times, true if every read matches reference
+static bool flexspi_nor_check_read_point(uint32_t instance,
+                                         flexspi_nor_config_t *config,
+                                         const uint32_t *reference,
+                                         uint32_t reads);
+
+//!@brief Search the dummy cycles from *dummyCycles up the reference reads back with at freq, true if any does
+static bool flexspi_nor_search_read_point(uint32_t instance,
+                                          flexspi_nor_config_t *config,
+                                          uint32_t freq,
+                                          int32_t dummyIndex,
+                                          uint32_t *dummyCycles,
+                                          const uint32_t *reference);
+
 /*******************************************************************************
  * Code
  *******************************************************************************/
@@ -457,8 +641,13 @@ status_t flexspi_nor_flash_init(uint32_t instance, flexspi_nor_config_t *config)
             break;
         }
 
+#if FLEXSPI_ENABLE_RESIDENT_LUT
+        // Lay out the whole Lookup table once, IP commands run their sequences in place
+        flexspi_load_lut(instance, config->memConfig.lookupTable);
+#else
         // Configure Lookup table for Read
         flexspi_update_lut(instance, 0, config->memConfig.lookupTable, 1);
+#endif
 
         // QE bit is nonvolatile bit, should be programmed only once
         if (config->memConfig.deviceModeType == kDeviceConfigCmdType_QuadEnable)
@@ -472,6 +661,15 @@ status_t flexspi_nor_flash_init(uint32_t instance, flexspi_nor_config_t *config)
 }
 #endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_INIT)
 
+status_t flexspi_nor_probe_init(uint32_t instance, flexspi_nor_config_t *config)
+{
+    status_t status = flexspi_nor_flash_init(instance, config);
+    // The probe keeps changing lookupTable, IP commands have to copy their sequences until the final init
+    flexspi_clear_resident_lut(instance);
+
+    return status;
+}
+
 status_t flexspi_nor_exit_no_cmd_mode(uint32_t instance,
                                       flexspi_nor_config_t *config,
                                       bool isParallelMode,
@@ -486,9 +684,7 @@ status_t flexspi_nor_exit_no_cmd_mode(uint32_t instance,
     flashXfer.seqNum = 1;
     flashXfer.isParallelModeEnable = isParallelMode;
     flashXfer.baseAddress = baseAddr;
-    flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, &config->memConfig.lookupTable[4 * flashXfer.seqId],
-                       flashXfer.seqNum);
-    flashXfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
+    flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, flashXfer.seqId, flashXfer.seqNum);
 
     return flexspi_command_xfer(instance, &flashXfer);
 }
@@ -519,9 +715,7 @@ static status_t flexspi_nor_restore_no_cmd_mode(uint32_t instance,
         flashXfer.isParallelModeEnable = isParallelMode;
         flashXfer.baseAddress = baseAddr;
 
-        flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, &config->memConfig.lookupTable[4 * flashXfer.seqId],
-                           flashXfer.seqNum);
-        flashXfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
+        flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, flashXfer.seqId, flashXfer.seqNum);
         status = flexspi_command_xfer(instance, &flashXfer);
     } while (0);
 
@@ -534,7 +728,7 @@ status_t flexspi_nor_write_enable(uint32_t instance,
                                   uint32_t baseAddr)
 {
     status_t status = kStatus_InvalidArgument;
-    uint32_t lut_tmp[4];
+    uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
     do
     {
         if (config == NULL)
@@ -555,22 +749,26 @@ status_t flexspi_nor_write_enable(uint32_t instance,
 #endif
 
 #if FLEXSPI_ENABLE_OCTAL_FLASH_SUPPORT
-        if (config->serialNorType == kSerialNorType_XPI)
+        // XPI devices take their own Write Enable sequence unless a custom one is configured
+        if ((config->serialNorType == kSerialNorType_XPI) &&
+            !(config->memConfig.lutCustomSeqEnable && config->memConfig.lutCustomSeq[CMD_INDEX_WRITEENABLE].seqNum))
         {
-            memcpy(lut_tmp, &config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_WRITEENABLE], 16);
-            memcpy(&config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_WRITEENABLE],
-                   &config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_WRITEENABLE_XPI], 16);
+#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+            isParallelMode = false;
+#endif
+            flexspi_xfer_t flashXfer;
+            flashXfer.operation = kFlexSpiOperation_Command;
+            flashXfer.seqNum = 1;
+            flashXfer.isParallelModeEnable = isParallelMode;
+            flashXfer.baseAddress = baseAddr;
+            flashXfer.seqId =
+                flexspi_select_ip_seq(instance, &config->memConfig, NOR_CMD_LUT_SEQ_IDX_WRITEENABLE_XPI, 1);
+            status = flexspi_command_xfer(instance, &flashXfer);
+            break;
         }
 #endif
 
         status = flexspi_device_write_enable(instance, &config->memConfig, isParallelMode, baseAddr);
-#if FLEXSPI_ENABLE_OCTAL_FLASH_SUPPORT
-        // Restore LUT
-        if (config->serialNorType == kSerialNorType_XPI)
-        {
-            memcpy(&config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_WRITEENABLE], lut_tmp, 16);
-        }
-#endif
         if (status != kStatus_Success)
         {
             break;
@@ -578,13 +776,28 @@ status_t flexspi_nor_write_enable(uint32_t instance,
 
     } while (0);
 
+    FLEXSPI_TRACE_END(kFlexSpiTracePhase_WriteEnable, traceStart, 0);
+
     return status;
 }
 
-status_t flexspi_nor_wait_busy(uint32_t instance, flexspi_nor_config_t *config, bool isParallMode, uint32_t baseAddr)
+uint32_t flexspi_nor_get_status_seq(flexspi_nor_config_t *config)
+{
+#if FLEXSPI_ENABLE_OCTAL_FLASH_SUPPORT
+    // XPI devices are polled with their own read status sequence
+    if (config->serialNorType == kSerialNorType_XPI)
+    {
+        return NOR_CMD_LUT_SEQ_IDX_READSTATUS_XPI;
+    }
+#endif
+
+    return NOR_CMD_LUT_SEQ_IDX_READSTATUS;
+}
+
+status_t flexspi_nor_wait_busy(
+    uint32_t instance, flexspi_nor_config_t *config, bool isParallMode, uint32_t baseAddr, uint32_t typicalUs)
 {
     status_t status = kStatus_InvalidArgument;
-    uint32_t lut_tmp[4];
 
     do
     {
@@ -592,15 +805,9 @@ status_t flexspi_nor_wait_busy(uint32_t instance, flexspi_nor_config_t *config,
         {
             break;
         }
-#if FLEXSPI_ENABLE_OCTAL_FLASH_SUPPORT
-        if (config->serialNorType == kSerialNorType_XPI)
-        {
-            memcpy(lut_tmp, &config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_READSTATUS], 16);
-            memcpy(&config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_READSTATUS],
-                   &config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_READSTATUS_XPI], 16);
-        }
-#endif
-        status = flexspi_device_wait_busy(instance, &config->memConfig, isParallMode, baseAddr);
+
+        status = flexspi_device_poll_busy(instance, &config->memConfig, flexspi_nor_get_status_seq(config),
+                                          isParallMode, baseAddr, typicalUs);
         if (status != kStatus_Success)
         {
             break;
@@ -608,14 +815,6 @@ status_t flexspi_nor_wait_busy(uint32_t instance, flexspi_nor_config_t *config,
 
     } while (0);
 
-#if FLEXSPI_ENABLE_OCTAL_FLASH_SUPPORT
-    // Restore LUT
-    if ((config != NULL) && (config->serialNorType == kSerialNorType_XPI))
-    {
-        memcpy(&config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_READSTATUS], lut_tmp, 16);
-    }
-#endif
-
     return status;
 }
 
@@ -633,6 +832,7 @@ void flexspi_change_serial_clock(uint32_t instance, flexspi_nor_config_t *config
         {
             break;
         }
+        uint32_t traceStart = FLEXSPI_TRACE_BEGIN();
 
         bool isDdrModeEnabled =
             config->memConfig.controllerMiscOption & FLEXSPI_BITMASK(kFlexSpiMiscOffset_DdrModeEnable) ? true : false;
@@ -666,48 +866,43 @@ void flexspi_change_serial_clock(uint32_t instance, flexspi_nor_config_t *config
             }
         }
 
-        // Per IP requirement, wait at least 10 serial clocks to let the Serial Clock output become stable
-        uint32_t serial_clock;
-        flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &serial_clock);
-        if (isDdrModeEnabled)
-        {
-            serial_clock /= 2;
-        }
-
-        uint32_t core_clock;
-        flexspi_get_clock(instance, kFlexSpiClock_CoreClock, &core_clock);
-        // Note: The while loop needs 4 instructions, so the dummy_cnt needs to be divided by 4 to calculate the actual
-        //       dummy cylces
-        register uint32_t dummy_cnt = 10 * (1 + core_clock / serial_clock) / 4;
-        while (dummy_cnt--)
-        {
-            __NOP();
-        }
+        flexspi_nor_wait_clock_stable(instance, isDdrModeEnabled);
+        FLEXSPI_TRACE_END(kFlexSpiTracePhase_ClockSwitch, traceStart, 0);
 
     } while (0);
 }
 
-#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FELXSPI_NOR_PROGRAM)
-// See flexspi_nor_flash.h for more details
-status_t flexspi_nor_flash_page_program(uint32_t instance,
-                                        flexspi_nor_config_t *config,
-                                        uint32_t dstAddr,
-                                        const uint32_t *src)
+void flexspi_nor_wait_clock_stable(uint32_t instance, bool isDdrModeEnabled)
+{
+    // Per IP requirement, wait at least 10 serial clocks to let the Serial Clock output become stable
+    uint32_t serial_clock;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &serial_clock);
+    if (isDdrModeEnabled)
+    {
+        serial_clock /= 2;
+    }
+
+    uint32_t core_clock;
+    flexspi_get_clock(instance, kFlexSpiClock_CoreClock, &core_clock);
+    // Note: The while loop needs 4 instructions, so the dummy_cnt needs to be divided by 4 to calculate the actual
+    //       dummy cylces
+    register uint32_t dummy_cnt = 10 * (1 + core_clock / serial_clock) / 4;
+    while (dummy_cnt--)
+    {
+        __NOP();
+    }
+}
+
+status_t flexspi_nor_page_program_send(uint32_t instance,
+                                       flexspi_nor_config_t *config,
+                                       bool isParallelMode,
+                                       uint32_t dstAddr,
+                                       const uint32_t *src)
 {
     status_t status;
     flexspi_xfer_t flashXfer;
     flexspi_mem_config_t *memCfg = (flexspi_mem_config_t *)config;
 
-#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
-    bool isParallelMode = false;
-#else
-    bool isParallelMode = flexspi_is_parallel_mode(memCfg);
-#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
-
-    // Update serial clock for IP command, for some devices, it cannot erase/program the
-    // device with the highest clock for read.
-    flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Update);
-
     do
     {
         // Send write enable before executing page program command
@@ -731,17 +926,23 @@ status_t flexspi_nor_flash_page_program(uint32_t instance,
         flashXfer.txBuffer = (uint32_t *)src;
         flashXfer.txSize = config->pageSize;
 
-        flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, &config->memConfig.lookupTable[4 * flashXfer.seqId],
-                           flashXfer.seqNum);
-        flashXfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
+        flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, flashXfer.seqId, flashXfer.seqNum);
         status = flexspi_command_xfer(instance, &flashXfer);
-        if (status != kStatus_Success)
-        {
-            break;
-        }
 
+    } while (0);
+
+    return status;
+}
+
+status_t flexspi_nor_page_program_wait(
+    uint32_t instance, flexspi_nor_config_t *config, bool isParallelMode, uint32_t dstAddr, uint32_t typicalUs)
+{
+    status_t status;
+
+    do
+    {
         // Wait until the program operation completes on Serial NOR Flash side.
-        status = flexspi_nor_wait_busy(instance, config, isParallelMode, dstAddr);
+        status = flexspi_nor_wait_busy(instance, config, isParallelMode, dstAddr, typicalUs);
         if (status != kStatus_Success)
         {
             break;
@@ -756,6 +957,34 @@ status_t flexspi_nor_flash_page_program(uint32_t instance,
 
     } while (0);
 
+    return status;
+}
+
+#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FELXSPI_NOR_PROGRAM)
+// See flexspi_nor_flash.h for more details
+status_t flexspi_nor_flash_page_program(uint32_t instance,
+                                        flexspi_nor_config_t *config,
+                                        uint32_t dstAddr,
+                                        const uint32_t *src)
+{
+    status_t status;
+
+#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+    bool isParallelMode = false;
+#else
+    bool isParallelMode = flexspi_is_parallel_mode((flexspi_mem_config_t *)config);
+#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+
+    // Update serial clock for IP command, for some devices, it cannot erase/program the
+    // device with the highest clock for read.
+    flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Update);
+
+    status = flexspi_nor_page_program_send(instance, config, isParallelMode, dstAddr, src);
+    if (status == kStatus_Success)
+    {
+        status = flexspi_nor_page_program_wait(instance, config, isParallelMode, dstAddr, config->pageProgramTimeUs);
+    }
+
     flexspi_clear_cache(instance);
 
     // Restore clock for AHB command
@@ -765,101 +994,69 @@ status_t flexspi_nor_flash_page_program(uint32_t instance,
 }
 #endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FELXSPI_NOR_PROGRAM)
 
-
-#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE_ALL)
 // See flexspi_nor_flash.h for more details
-status_t flexspi_nor_flash_erase_all(uint32_t instance, flexspi_nor_config_t *config)
+status_t flexspi_nor_flash_page_program_start(uint32_t instance,
+                                              flexspi_nor_config_t *config,
+                                              uint32_t dstAddr,
+                                              const uint32_t *src)
 {
-    uint32_t *flashSizeStart = NULL;
-    uint32_t currentFlashSize = 0;
-    uint32_t baseAddr = 0;
-    uint32_t index = 0;
-    status_t status = kStatus_Success;
-    flexspi_xfer_t flashXfer;
-    flexspi_mem_config_t *memCfg = (flexspi_mem_config_t *)config;
+    status_t status;
 
-    flashXfer.operation = kFlexSpiOperation_Command;
-    flashXfer.seqNum = 1;
-    flashXfer.seqId = NOR_CMD_LUT_SEQ_IDX_CHIPERASE;
-    flashXfer.isParallelModeEnable = kSerialNOR_IndividualMode;
-    if (memCfg->lutCustomSeqEnable && memCfg->lutCustomSeq[NOR_CMD_INDEX_CHIPERASE].seqNum)
-    {
-        flashXfer.seqId = memCfg->lutCustomSeq[NOR_CMD_INDEX_CHIPERASE].seqId;
-        flashXfer.seqNum = memCfg->lutCustomSeq[NOR_CMD_INDEX_CHIPERASE].seqNum;
-    }
-    uint32_t chipEraseSeqId = flashXfer.seqId;
-    uint32_t chipEraseSeqNum = flashXfer.seqNum;
+#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+    bool isParallelMode = false;
+#else
+    bool isParallelMode = flexspi_is_parallel_mode((flexspi_mem_config_t *)config);
+#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
 
-    // Update serial clock for IP command, for some devices, it cannot erase/program the
-    // device with the highest clock for read.
     flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Update);
 
-    // Send Chip Erase command to each device if needed.
-    baseAddr = 0;
-    flashSizeStart = &memCfg->sflashA1Size;
-    for (index = 0; index < 4; index++)
-    {
-        currentFlashSize = *flashSizeStart++;
+    status = flexspi_nor_page_program_send(instance, config, isParallelMode, dstAddr, src);
 
-        if (currentFlashSize > 0)
-        {
-            status = flexspi_nor_write_enable(instance, config, kSerialNOR_IndividualMode, baseAddr);
-            if (status != kStatus_Success)
-            {
-                break;
-            }
+    flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Restore);
 
-            flashXfer.baseAddress = baseAddr;
-            flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, &config->memConfig.lookupTable[4 * chipEraseSeqId],
-                               chipEraseSeqNum);
-            flashXfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
-            status = flexspi_command_xfer(instance, &flashXfer);
-            if (status != kStatus_Success)
-            {
-                break;
-            }
-        }
+    return status;
+}
 
-        baseAddr += currentFlashSize;
-    }
+// See flexspi_nor_flash.h for more details
+status_t flexspi_nor_flash_page_program_complete(uint32_t instance, flexspi_nor_config_t *config, uint32_t dstAddr)
+{
+    status_t status;
 
-    if (status == kStatus_Success)
-    {
-        baseAddr = 0;
-        flashSizeStart = &memCfg->sflashA1Size;
-        for (index = 0; index < 4; index++)
-        {
-            currentFlashSize = *flashSizeStart++;
-            if (currentFlashSize > 0)
-            {
-                // Wait until the chip erase operation completes on Serial NOR Flash side.
-                status = flexspi_nor_wait_busy(instance, config, kSerialNOR_IndividualMode, baseAddr);
-                if (status != kStatus_Success)
-                {
-                    break;
-                }
-#if FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT
-                if (config->needRestoreNoCmdMode)
-                {
-                    status = flexspi_nor_restore_no_cmd_mode(instance, config, kSerialNOR_IndividualMode, baseAddr);
-                    if (status != kStatus_Success)
-                    {
-                        break;
-                    }
-                }
-#endif
-            }
-            baseAddr += currentFlashSize;
-        }
-    }
+#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+    bool isParallelMode = false;
+#else
+    bool isParallelMode = flexspi_is_parallel_mode((flexspi_mem_config_t *)config);
+#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+
+    flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Update);
+
+    // The caller did other work since the start, poll right away instead of waiting for the typical time first
+    status = flexspi_nor_page_program_wait(instance, config, isParallelMode, dstAddr, 0);
 
     flexspi_clear_cache(instance);
 
-    // Restore clock for AHB command
     flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Restore);
 
     return status;
 }
+
+
+
+#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE_ALL)
+// See flexspi_nor_flash.h for more details
+status_t flexspi_nor_flash_erase_all(uint32_t instance, flexspi_nor_config_t *config)
+{
+    uint32_t *flashSizeStart = &config->memConfig.sflashA1Size;
+    uint32_t totalSize = 0;
+
+    for (uint32_t index = 0; index < FLEXSPI_NOR_MAX_CHIPS; index++)
+    {
+        totalSize += flashSizeStart[index];
+    }
+
+    // Each device gets its own Chip Erase command, all of them erase at the same time
+    return flexspi_nor_run_chips(instance, config, kSerialNOR_IndividualMode, 0, totalSize, NULL);
+}
 #endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE_ALL)
 
 
@@ -897,9 +1094,7 @@ status_t flexspi_nor_flash_erase_sector(uint32_t instance, flexspi_nor_config_t
             flashXfer.seqNum = memCfg->lutCustomSeq[NOR_CMD_INDEX_ERASESECTOR].seqNum;
         }
 
-        flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, &config->memConfig.lookupTable[4 * flashXfer.seqId],
-                           flashXfer.seqNum);
-        flashXfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
+        flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, flashXfer.seqId, flashXfer.seqNum);
         status = flexspi_command_xfer(instance, &flashXfer);
         if (status != kStatus_Success)
         {
@@ -907,7 +1102,7 @@ status_t flexspi_nor_flash_erase_sector(uint32_t instance, flexspi_nor_config_t
         }
 
         // Wait until the sector erase operation completes on Serial NOR Flash side.
-        status = flexspi_nor_wait_busy(instance, config, isParallelMode, address);
+        status = flexspi_nor_wait_busy(instance, config, isParallelMode, address, config->sectorEraseTimeMs * 1000);
         if (status != kStatus_Success)
         {
             break;
@@ -934,59 +1129,122 @@ status_t flexspi_nor_flash_erase_sector(uint32_t instance, flexspi_nor_config_t
 }
 #endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE_SECTOR)
 
-
-#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE_BLOCK)
-status_t flexspi_nor_flash_erase_block(uint32_t instance, flexspi_nor_config_t *config, uint32_t address)
+// See flexspi_nor_flash.h for more details.
+status_t flexspi_nor_flash_blank_check(uint32_t instance,
+                                       flexspi_nor_config_t *config,
+                                       uint32_t address,
+                                       bool *isBlank)
 {
-    status_t status;
+    status_t status = kStatus_InvalidArgument;
     flexspi_xfer_t flashXfer;
-    bool isParallelMode;
     flexspi_mem_config_t *memCfg = (flexspi_mem_config_t *)config;
-    isParallelMode = flexspi_is_parallel_mode(memCfg);
+    uint32_t statusWord = 0;
+
+    if ((config == NULL) || (isBlank == NULL))
+    {
+        return status;
+    }
+    if ((config->serialNorType != kSerialNorType_HyperBus) || (config->sectorSize == 0))
+    {
+        return kStatus_FlexSPINOR_NotSupported;
+    }
 
-    // Update serial clock for IP command, for some devices, it cannot erase/program the
-    // device with the highest clock for read.
     flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Update);
 
     do
     {
-        status = flexspi_nor_write_enable(instance, config, isParallelMode, address);
-        if (status != kStatus_Success)
-        {
-            break;
-        }
-
-        flashXfer.baseAddress = address;
+        // The device reads the sector while the command runs, the status then tells whether a bit was programmed
+        address &= ~(config->sectorSize - 1);
+        flashXfer.baseAddress = address + 0x555 * 2;
         flashXfer.operation = kFlexSpiOperation_Command;
         flashXfer.seqNum = 1;
-        flashXfer.seqId = NOR_CMD_LUT_SEQ_IDX_ERASEBLOCK;
-        flashXfer.isParallelModeEnable = isParallelMode;
-
-        if (memCfg->lutCustomSeqEnable && memCfg->lutCustomSeq[NOR_CMD_INDEX_ERASEBLOCK].seqNum)
+        flashXfer.seqId = flexspi_select_ip_seq(instance, memCfg, NOR_CMD_LUT_SEQ_IDX_HYPERFLASH_BLANKCHECK, 1);
+        flashXfer.isParallelModeEnable = false;
+        status = flexspi_command_xfer(instance, &flashXfer);
+        if (status != kStatus_Success)
         {
-            flashXfer.seqId = memCfg->lutCustomSeq[NOR_CMD_INDEX_ERASEBLOCK].seqId;
-            flashXfer.seqNum = memCfg->lutCustomSeq[NOR_CMD_INDEX_ERASEBLOCK].seqNum;
+            break;
         }
 
-        flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, &config->memConfig.lookupTable[4 * flashXfer.seqId],
-                           flashXfer.seqNum);
-        flashXfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
-        status = flexspi_command_xfer(instance, &flashXfer);
+        status = flexspi_nor_wait_busy(instance, config, false, address, 0);
         if (status != kStatus_Success)
         {
             break;
         }
 
-        // Wait until the block erase operation completes on Serial NOR Flash side.
-        status = flexspi_nor_wait_busy(instance, config, isParallelMode, address);
+        flashXfer.baseAddress = address;
+        flashXfer.operation = kFlexSpiOperation_Read;
+        flashXfer.seqId = memCfg->lutCustomSeq[NOR_CMD_INDEX_READSTATUS].seqId;
+        flashXfer.seqNum = memCfg->lutCustomSeq[NOR_CMD_INDEX_READSTATUS].seqNum;
+        flashXfer.seqId = flexspi_select_ip_seq(instance, memCfg, flashXfer.seqId, flashXfer.seqNum);
+        flashXfer.rxBuffer = &statusWord;
+        flashXfer.rxSize = sizeof(statusWord);
+        status = flexspi_command_xfer(instance, &flashXfer);
         if (status != kStatus_Success)
         {
             break;
         }
-#if FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT
-        if (config->needRestoreNoCmdMode)
-        {
-            status = flexspi_nor_restore_no_cmd_mode(instance, config, isParallelMode, address);
+
+        *isBlank = (statusWord & HYPERFLASH_STATUS_ESB_MASK) ? false : true;
+
+    } while (0);
+
+    flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Restore);
+
+    return status;
+}
+
+
+#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE_BLOCK)
+status_t flexspi_nor_flash_erase_block(uint32_t instance, flexspi_nor_config_t *config, uint32_t address)
+{
+    status_t status;
+    flexspi_xfer_t flashXfer;
+    bool isParallelMode;
+    flexspi_mem_config_t *memCfg = (flexspi_mem_config_t *)config;
+    isParallelMode = flexspi_is_parallel_mode(memCfg);
+
+    // Update serial clock for IP command, for some devices, it cannot erase/program the
+    // device with the highest clock for read.
+    flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Update);
+
+    do
+    {
+        status = flexspi_nor_write_enable(instance, config, isParallelMode, address);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+
+        flashXfer.baseAddress = address;
+        flashXfer.operation = kFlexSpiOperation_Command;
+        flashXfer.seqNum = 1;
+        flashXfer.seqId = NOR_CMD_LUT_SEQ_IDX_ERASEBLOCK;
+        flashXfer.isParallelModeEnable = isParallelMode;
+
+        if (memCfg->lutCustomSeqEnable && memCfg->lutCustomSeq[NOR_CMD_INDEX_ERASEBLOCK].seqNum)
+        {
+            flashXfer.seqId = memCfg->lutCustomSeq[NOR_CMD_INDEX_ERASEBLOCK].seqId;
+            flashXfer.seqNum = memCfg->lutCustomSeq[NOR_CMD_INDEX_ERASEBLOCK].seqNum;
+        }
+
+        flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, flashXfer.seqId, flashXfer.seqNum);
+        status = flexspi_command_xfer(instance, &flashXfer);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+
+        // Wait until the block erase operation completes on Serial NOR Flash side.
+        status = flexspi_nor_wait_busy(instance, config, isParallelMode, address, config->blockEraseTimeMs * 1000);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+#if FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT
+        if (config->needRestoreNoCmdMode)
+        {
+            status = flexspi_nor_restore_no_cmd_mode(instance, config, isParallelMode, address);
             if (status != kStatus_Success)
             {
                 break;
@@ -1003,6 +1261,24 @@ status_t flexspi_nor_flash_erase_block(uint32_t instance, flexspi_nor_config_t *
 
     return status;
 }
+
+uint32_t flexspi_nor_get_device_size(flexspi_nor_config_t *config)
+{
+    flexspi_mem_config_t *memCfg = (flexspi_mem_config_t *)config;
+
+    // In parallel mode the address space is interleaved across two devices, erase them block by block
+    if (flexspi_is_parallel_mode(memCfg))
+    {
+        return 0;
+    }
+
+    return memCfg->sflashA1Size + memCfg->sflashA2Size + memCfg->sflashB1Size + memCfg->sflashB2Size;
+}
+
+bool is_erase_type_usable(uint32_t erase_size, uint32_t address, uint32_t remaining_size)
+{
+    return (erase_size != 0) && !(address & (erase_size - 1)) && (remaining_size >= erase_size);
+}
 #endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE_BLOCK)
 
 // Read SFDP parameters from specified offset
@@ -1192,6 +1468,10 @@ status_t prepare_0_4_4_mode_enable_sequence(uint32_t instance,
     status_t status = kStatus_InvalidArgument;
     uint32_t lut_seq[4];
 
+    // The parameters are kept to match the other mode enable sequence helpers
+    (void)tbl;
+    (void)option;
+
     // See JESD216B 6.4.18 for more details.
     do
     {
@@ -1256,9 +1536,7 @@ status_t probe_dtr_quad_read_dummy_cycles(uint32_t instance, flexspi_nor_config_
         flashXfer.operation = kFlexSpiOperation_Read;
         flashXfer.rxBuffer = buffer;
         flashXfer.rxSize = sizeof(buffer);
-        flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, &config->memConfig.lookupTable[4 * flashXfer.seqId],
-                           flashXfer.seqNum);
-        flashXfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
+        flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, flashXfer.seqId, flashXfer.seqNum);
         status = flexspi_command_xfer(instance, &flashXfer);
         if (status != kStatus_Success)
         {
@@ -1290,9 +1568,7 @@ status_t probe_dtr_quad_read_dummy_cycles(uint32_t instance, flexspi_nor_config_
             flashXfer.operation = kFlexSpiOperation_Write;
             flashXfer.txBuffer = (uint32_t *)probe_pattern;
             flashXfer.txSize = sizeof(probe_pattern);
-            flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, &config->memConfig.lookupTable[4 * flashXfer.seqId],
-                               flashXfer.seqNum);
-            flashXfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
+            flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, flashXfer.seqId, flashXfer.seqNum);
             status = flexspi_command_xfer(instance, &flashXfer);
             if (status != kStatus_Success)
             {
@@ -1512,6 +1788,101 @@ status_t get_page_sector_block_size_from_sfdp(flexspi_nor_config_t *config,
     return kStatus_Success;
 }
 
+uint32_t get_half_block_size_from_sfdp(flexspi_nor_config_t *config,
+                                       jedec_info_table_t *tbl,
+                                       uint32_t *half_block_erase_cmd)
+{
+    jedec_flash_param_table_t *param_tbl = &tbl->flash_param_tbl;
+    jedec_4byte_addressing_inst_table_t *flash_4b_tbl = &tbl->flash_4b_inst_tbl;
+    uint32_t half_block_size = 0;
+
+    for (uint32_t index = 0; index < 4; index++)
+    {
+        if (param_tbl->erase_info[index].size == 0)
+        {
+            continue;
+        }
+
+        uint32_t current_erase_size = 1U << param_tbl->erase_info[index].size;
+        uint32_t erase_cmd = param_tbl->erase_info[index].inst;
+        if ((current_erase_size <= config->sectorSize) || (current_erase_size >= config->blockSize) ||
+            (current_erase_size <= half_block_size))
+        {
+            continue;
+        }
+
+        if (config->memConfig.sflashA1Size > MAX_24BIT_ADDRESSING_SIZE)
+        {
+            if (tbl->has_4b_addressing_inst_table)
+            {
+                erase_cmd = flash_4b_tbl->erase_inst_info.erase_inst[index];
+            }
+            else if (erase_cmd == kSerialNorCmd_SE32K_3B)
+            {
+                erase_cmd = kSerialNorCmd_SE32K_4B;
+            }
+            else
+            {
+                // No known 4-byte address variant of this erase instruction
+                continue;
+            }
+        }
+
+        half_block_size = current_erase_size;
+        *half_block_erase_cmd = erase_cmd;
+    }
+
+    return half_block_size;
+}
+
+void get_typical_times_from_sfdp(flexspi_nor_config_t *config, jedec_info_table_t *tbl)
+{
+    // Units of the typical times in DWORD10 and DWORD11 of the Basic Flash Parameter Table
+    static const uint16_t k_erase_time_units_ms[] = { 1, 16, 128, 1000 };
+    static const uint32_t k_chip_erase_time_units_ms[] = { 16, 256, 4000, 64000 };
+    jedec_flash_param_table_t *param_tbl = &tbl->flash_param_tbl;
+
+    config->pageProgramTimeUs = 0;
+    config->sectorEraseTimeMs = 0;
+    config->halfBlockEraseTimeMs = 0;
+    config->blockEraseTimeMs = 0;
+    config->chipEraseTimeMs = 0;
+    if (tbl->flash_param_tbl_size < kSfdp_BasicProtocolTableSize_RevA)
+    {
+        return;
+    }
+
+    for (uint32_t index = 0; index < 4; index++)
+    {
+        if (param_tbl->erase_info[index].size == 0)
+        {
+            continue;
+        }
+
+        // 5-bit count and 2-bit unit per erase type, starting at bit 4
+        uint32_t erase_size = 1U << param_tbl->erase_info[index].size;
+        uint32_t timing = (param_tbl->erase_timing >> (4 + 7 * index)) & 0x7F;
+        uint32_t erase_time = ((timing & 0x1F) + 1) * k_erase_time_units_ms[timing >> 5];
+        if (erase_size == config->sectorSize)
+        {
+            config->sectorEraseTimeMs = erase_time;
+        }
+        if (erase_size == config->halfBlockSize)
+        {
+            config->halfBlockEraseTimeMs = erase_time;
+        }
+        if (erase_size == config->blockSize)
+        {
+            config->blockEraseTimeMs = erase_time;
+        }
+    }
+
+    config->pageProgramTimeUs = (param_tbl->chip_erase_progrm_info.page_program_time + 1) *
+                                (param_tbl->chip_erase_progrm_info.page_program_time_unit ? 64 : 8);
+    config->chipEraseTimeMs = (param_tbl->chip_erase_progrm_info.chip_erase_time + 1) *
+                              k_chip_erase_time_units_ms[param_tbl->chip_erase_progrm_info.chip_erase_time_unit];
+}
+
 // Parse SFDP parameters and then fill into FlexSPI Serial NOR Configuration Block
 status_t parse_sfdp(uint32_t instance,
                     flexspi_nor_config_t *config,
@@ -1640,6 +2011,16 @@ status_t parse_sfdp(uint32_t instance,
         config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_ERASEBLOCK] =
             FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, block_erase_cmd, RADDR_SDR, FLEXSPI_1PAD, address_bits);
 
+        // Erase Half Block, only if the device has an erase type between sector and block
+        uint32_t half_block_erase_cmd;
+        config->halfBlockSize = get_half_block_size_from_sfdp(config, tbl, &half_block_erase_cmd);
+        if (config->halfBlockSize)
+        {
+            config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_ERASEHALFBLOCK] =
+                FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, half_block_erase_cmd, RADDR_SDR, FLEXSPI_1PAD, address_bits);
+        }
+        get_typical_times_from_sfdp(config, tbl);
+
         // Erase All
         config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_CHIPERASE] =
             FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialNorCmd_ChipErase, STOP, FLEXSPI_1PAD, 0);
@@ -1665,7 +2046,7 @@ status_t parse_sfdp(uint32_t instance,
                 config->memConfig.lookupTable[1] = FLEXSPI_LUT_SEQ(READ_SDR, FLEXSPI_1PAD, 0x04, STOP, FLEXSPI_1PAD, 1);
             }
 
-            status = flexspi_nor_flash_init(instance, config);
+            status = flexspi_nor_probe_init(instance, config);
             if (status != kStatus_Success)
             {
                 break;
@@ -2015,24 +2396,24 @@ status_t flexspi_nor_read_sfdp_info(uint32_t instance, jedec_info_table_t *tbl,
     return status;
 }
 
-status_t flexspi_nor_generate_config_block_using_sfdp(uint32_t instance,
-                                                      flexspi_nor_config_t *config,
-                                                      serial_nor_config_option_t *option)
+status_t flexspi_nor_prepare_sfdp_read(uint32_t instance,
+                                       flexspi_nor_config_t *config,
+                                       serial_nor_config_option_t *option)
 {
     status_t status = kStatus_InvalidArgument;
 
     const lut_seq_t k_sdfp_lut[4] = {
         // Read SFDP LUT sequence for 1 pad instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_1PAD, 24),
-          FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_1PAD, 8, READ_SDR, FLEXSPI_1PAD, 0xFF), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_1PAD, 24),
+            FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_1PAD, 8, READ_SDR, FLEXSPI_1PAD, 0xFF), 0, 0 } },
 
         // Read SFDP LUT sequence for 2 pad instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_2PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_2PAD, 24),
-          FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_2PAD, 8, READ_SDR, FLEXSPI_2PAD, 0xFF), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_2PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_2PAD, 24),
+            FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_2PAD, 8, READ_SDR, FLEXSPI_2PAD, 0xFF), 0, 0 } },
 
         // Read SFDP LUT sequence for 4 pad instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_4PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_4PAD, 24),
-          FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_4PAD, 8, READ_SDR, FLEXSPI_4PAD, 0xFF), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_4PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_4PAD, 24),
+            FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_4PAD, 8, READ_SDR, FLEXSPI_4PAD, 0xFF), 0, 0 } },
     };
 
     do
@@ -2047,7 +2428,7 @@ status_t flexspi_nor_generate_config_block_using_sfdp(uint32_t instance,
         config->memConfig.lookupTable[0] = FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, 0x03, RADDR_SDR, FLEXSPI_1PAD, 24);
         config->memConfig.lookupTable[1] = FLEXSPI_LUT_SEQ(READ_SDR, FLEXSPI_1PAD, 0x04, STOP, FLEXSPI_1PAD, 1);
 
-        status = flexspi_nor_flash_init(instance, config);
+        status = flexspi_nor_probe_init(instance, config);
         if (status != kStatus_Success)
         {
             break;
@@ -2071,10 +2452,88 @@ status_t flexspi_nor_generate_config_block_using_sfdp(uint32_t instance,
         }
 #endif // FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT
 
-        // Read SFDP, probe whether the Flash device is present or not.
-        jedec_info_table_t jedec_info_tbl;
         flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD,
                            (const uint32_t *)&k_sdfp_lut[option->option0.B.query_pads], 1);
+
+    } while (0);
+
+    return status;
+}
+
+status_t flexspi_nor_read_device_fingerprint(uint32_t instance, uint32_t *jedec_id, uint32_t *sfdp_crc)
+{
+    status_t status;
+    flexspi_xfer_t xfer;
+    // SFDP header and the first parameter headers, they hold the revision, location and size of the tables
+    uint32_t sfdp_headers[(sizeof(sfdp_header_t) + 7 * sizeof(sfdp_parameter_header_t)) / sizeof(uint32_t)];
+
+    const lut_seq_t k_rdid_lut = {
+        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadManufacturerId, READ_SDR, FLEXSPI_1PAD, 3), 0, 0, 0 }
+    };
+
+    do
+    {
+        // The Read SFDP sequence was loaded by flexspi_nor_prepare_sfdp_read
+        status = flexspi_nor_read_sfdp(instance, 0, sfdp_headers, sizeof(sfdp_headers));
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+
+        if (sfdp_headers[0] != SFDP_SIGNATURE)
+        {
+            status = kStatus_FlexSPINOR_SFDP_NotFound;
+            break;
+        }
+        *sfdp_crc = flexspi_nor_crc32((const uint8_t *)sfdp_headers, sizeof(sfdp_headers));
+
+        *jedec_id = 0;
+        flexspi_update_lut(instance, NOR_CMD_LUT_FOR_IP_CMD, (const uint32_t *)&k_rdid_lut, 1);
+        memset(&xfer, 0, sizeof(xfer));
+        xfer.operation = kFlexSpiOperation_Read;
+        xfer.seqId = NOR_CMD_LUT_FOR_IP_CMD;
+        xfer.seqNum = 1;
+        xfer.rxBuffer = jedec_id;
+        xfer.rxSize = 3;
+        status = flexspi_command_xfer(instance, &xfer);
+
+    } while (0);
+
+    return status;
+}
+
+uint32_t flexspi_nor_crc32(const uint8_t *data, uint32_t length)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    while (length--)
+    {
+        crc ^= *data++;
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+    }
+
+    return ~crc;
+}
+
+status_t flexspi_nor_generate_config_block_using_sfdp(uint32_t instance,
+                                                      flexspi_nor_config_t *config,
+                                                      serial_nor_config_option_t *option)
+{
+    status_t status;
+
+    do
+    {
+        status = flexspi_nor_prepare_sfdp_read(instance, config, option);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+
+        // Read SFDP, probe whether the Flash device is present or not.
+        jedec_info_table_t jedec_info_tbl;
         status = flexspi_nor_read_sfdp_info(instance, &jedec_info_tbl, false);
         if (status != kStatus_Success)
         {
@@ -2201,9 +2660,15 @@ status_t flexspi_nor_generate_config_block_hyperflash(uint32_t instance, flexspi
         config->blockSize = config->sectorSize;
         config->isUniformBlockSize = true;
 
+        // Typical times of S26KS/S26KL, a page is the whole 512-byte write buffer programmed by one burst after
+        // the Word Program command. Status polls then back off instead of running back to back.
+        config->pageProgramTimeUs = 475;
+        config->sectorEraseTimeMs = 930;
+        config->blockEraseTimeMs = config->sectorEraseTimeMs;
+
         uint32_t lut_seq[4];
 
-        status = flexspi_nor_flash_init(instance, config);
+        status = flexspi_nor_probe_init(instance, config);
         if (status != kStatus_Success)
         {
             break;
@@ -2257,6 +2722,8 @@ status_t flexspi_nor_generate_config_block_hyperflash(uint32_t instance, flexspi
         if ((buffer[0] >= 0x17) && (buffer[0] <= 0x20))
         {
             config->memConfig.sflashA1Size = 1UL << buffer[0];
+            // Chip Erase takes the time of the sector erases it replaces
+            config->chipEraseTimeMs = config->sectorEraseTimeMs * (config->memConfig.sflashA1Size / config->sectorSize);
         }
         else
         {
@@ -2405,6 +2872,14 @@ status_t flexspi_nor_generate_config_block_hyperflash(uint32_t instance, flexspi
         config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_CHIPERASE + 15] =
             FLEXSPI_LUT_SEQ(CMD_DDR, FLEXSPI_8PAD, 0x00, CMD_DDR, FLEXSPI_8PAD, 0x10);
 
+        // Blank Check, 0x33 to SA + 0x555, the IP command address carries the word offset
+        config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_HYPERFLASH_BLANKCHECK] =
+            FLEXSPI_LUT_SEQ(CMD_DDR, FLEXSPI_8PAD, 0x00, RADDR_DDR, FLEXSPI_8PAD, 0x18);
+        config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_HYPERFLASH_BLANKCHECK + 1] =
+            FLEXSPI_LUT_SEQ(CADDR_DDR, FLEXSPI_8PAD, 0x10, CMD_DDR, FLEXSPI_8PAD, 0x00);
+        config->memConfig.lookupTable[4 * NOR_CMD_LUT_SEQ_IDX_HYPERFLASH_BLANKCHECK + 2] =
+            FLEXSPI_LUT_SEQ(CMD_DDR, FLEXSPI_8PAD, 0x33, STOP, FLEXSPI_1PAD, 0x0);
+
         // LUT customized sequence
         config->memConfig.lutCustomSeq[NOR_CMD_INDEX_WRITEENABLE].seqNum = 2;
         config->memConfig.lutCustomSeq[NOR_CMD_INDEX_WRITEENABLE].seqId = NOR_CMD_LUT_SEQ_IDX_WRITEENABLE;
@@ -2438,15 +2913,16 @@ status_t flexspi_nor_generate_config_block_mxic_octalflash(uint32_t instance,
     // SFDP table is not programmed in OctaFlash yet, so use RDID command instead
     const lut_seq_t k_rdid_lut[3] = {
         // Read Identification LUT sequence for 1 pad instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadManufacturerId, READ_SDR, FLEXSPI_1PAD, 3), 0, 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadManufacturerId, READ_SDR, FLEXSPI_1PAD, 3),
+            0, 0, 0 } },
 
         // Read Identification LUT sequence for OPI SDR instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_8PAD, kSerialFlash_ReadManufacturerId, CMD_SDR, FLEXSPI_8PAD, 0x60),
-          FLEXSPI_LUT_SEQ(RADDR_SDR, FLEXSPI_8PAD, 0x20, READ_SDR, FLEXSPI_8PAD, 0x4), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_8PAD, kSerialFlash_ReadManufacturerId, CMD_SDR, FLEXSPI_8PAD, 0x60),
+            FLEXSPI_LUT_SEQ(RADDR_SDR, FLEXSPI_8PAD, 0x20, READ_SDR, FLEXSPI_8PAD, 0x4), 0, 0 } },
 
         // Read Identification LUT sequence for OPI DDR instruction
-        { FLEXSPI_LUT_SEQ(CMD_DDR, FLEXSPI_8PAD, kSerialFlash_ReadManufacturerId, CMD_DDR, FLEXSPI_8PAD, 0x60),
-          FLEXSPI_LUT_SEQ(RADDR_DDR, FLEXSPI_8PAD, 0x20, READ_DDR, FLEXSPI_8PAD, 0x4), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_DDR, FLEXSPI_8PAD, kSerialFlash_ReadManufacturerId, CMD_DDR, FLEXSPI_8PAD, 0x60),
+            FLEXSPI_LUT_SEQ(RADDR_DDR, FLEXSPI_8PAD, 0x20, READ_DDR, FLEXSPI_8PAD, 0x4), 0, 0 } },
     };
 
     do
@@ -2517,7 +2993,7 @@ status_t flexspi_nor_generate_config_block_mxic_octalflash(uint32_t instance,
             config->memConfig.sflashPadType = kSerialFlash_1Pad;
         }
 
-        status = flexspi_nor_flash_init(instance, config);
+        status = flexspi_nor_probe_init(instance, config);
         if (status != kStatus_Success)
         {
             break;
@@ -2758,13 +3234,13 @@ status_t flexspi_nor_generate_config_block_micron_octalflash(uint32_t instance,
 
     const lut_seq_t k_sdfp_lut[2] = {
         // Read SFDP LUT sequence for 1 pad instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_1PAD, 24),
-          FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_1PAD, 8, READ_SDR, FLEXSPI_1PAD, 0xFF), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_1PAD, 24),
+            FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_1PAD, 8, READ_SDR, FLEXSPI_1PAD, 0xFF), 0, 0 } },
 
         // Read SFDP LUT sequence for OPI DDR instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_8PAD, kSerialFlash_ReadSFDP, RADDR_DDR, FLEXSPI_8PAD, 32),
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_8PAD, kSerialFlash_ReadSFDP, RADDR_DDR, FLEXSPI_8PAD, 32),
           //  FLEXSPI_LUT_SEQ(DUMMY_DDR, FLEXSPI_8PAD, 8, READ_DDR, FLEXSPI_8PAD, 0xFF), 0, 0
-          FLEXSPI_LUT_SEQ(READ_DDR, FLEXSPI_8PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 },
+            FLEXSPI_LUT_SEQ(READ_DDR, FLEXSPI_8PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 } },
     };
 
     bool is_sdr_mode = option->option0.B.device_type == kSerialNorCfgOption_DeviceType_MicronOctalSDR;
@@ -2796,7 +3272,7 @@ status_t flexspi_nor_generate_config_block_micron_octalflash(uint32_t instance,
         }
         config->memConfig.sflashPadType = kSerialFlash_8Pads;
 
-        status = flexspi_nor_flash_init(instance, config);
+        status = flexspi_nor_probe_init(instance, config);
         if (status != kStatus_Success)
         {
             break;
@@ -3010,24 +3486,24 @@ status_t flexspi_nor_generate_config_block_adesto_octalflash(uint32_t instance,
 
     const lut_seq_t k_sdfp_lut[5] = {
         // Read SFDP LUT sequence for 1 pad instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_1PAD, 24),
-          FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_1PAD, 8, READ_SDR, FLEXSPI_1PAD, 0xFF), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_1PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_1PAD, 24),
+            FLEXSPI_LUT_SEQ(DUMMY_SDR, FLEXSPI_1PAD, 8, READ_SDR, FLEXSPI_1PAD, 0xFF), 0, 0 } },
 
         // Read SFDP LUT sequence for QPI SDR instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_4PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_4PAD, 24),
-          FLEXSPI_LUT_SEQ(READ_SDR, FLEXSPI_4PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_4PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_4PAD, 24),
+            FLEXSPI_LUT_SEQ(READ_SDR, FLEXSPI_4PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 } },
 
         // Read SFDP LUT sequence for OPI SDR instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_8PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_8PAD, 24),
-          FLEXSPI_LUT_SEQ(READ_SDR, FLEXSPI_8PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_8PAD, kSerialFlash_ReadSFDP, RADDR_SDR, FLEXSPI_8PAD, 24),
+            FLEXSPI_LUT_SEQ(READ_SDR, FLEXSPI_8PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 } },
 
         // Read SFDP LUT sequence for QPI DDR instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_4PAD, kSerialFlash_ReadSFDP, RADDR_DDR, FLEXSPI_4PAD, 24),
-          FLEXSPI_LUT_SEQ(READ_DDR, FLEXSPI_4PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_4PAD, kSerialFlash_ReadSFDP, RADDR_DDR, FLEXSPI_4PAD, 24),
+            FLEXSPI_LUT_SEQ(READ_DDR, FLEXSPI_4PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 } },
 
         // Read SFDP LUT sequence for OPI DDR instruction
-        { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_8PAD, kSerialFlash_ReadSFDP, RADDR_DDR, FLEXSPI_8PAD, 32),
-          FLEXSPI_LUT_SEQ(READ_DDR, FLEXSPI_8PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 },
+        { { FLEXSPI_LUT_SEQ(CMD_SDR, FLEXSPI_8PAD, kSerialFlash_ReadSFDP, RADDR_DDR, FLEXSPI_8PAD, 32),
+            FLEXSPI_LUT_SEQ(READ_DDR, FLEXSPI_8PAD, 0xFF, STOP, FLEXSPI_1PAD, 0), 0, 0 } },
     };
 
     do
@@ -3103,7 +3579,7 @@ status_t flexspi_nor_generate_config_block_adesto_octalflash(uint32_t instance,
             config->memConfig.controllerMiscOption |= FLEXSPI_BITMASK(kFlexSpiMiscOffset_DdrModeEnable);
         }
 
-        status = flexspi_nor_flash_init(instance, config);
+        status = flexspi_nor_probe_init(instance, config);
         if (status != kStatus_Success)
         {
             break;
@@ -3296,6 +3772,62 @@ status_t flexspi_nor_generate_config_block_adesto_octalflash(uint32_t instance,
     return status;
 }
 
+void flexspi_nor_set_default_config(flexspi_nor_config_t *config, serial_nor_config_option_t *option)
+{
+    memset(config, 0, sizeof(flexspi_nor_config_t));
+    config->memConfig.serialClkFreq = kFlexSpiSerialClk_SafeFreq;
+    config->memConfig.sflashA1Size = MAX_24BIT_ADDRESSING_SIZE;
+    config->memConfig.tag = FLEXSPI_CFG_BLK_TAG;
+    config->memConfig.version = FLEXSPI_CFG_BLK_VERSION;
+    config->memConfig.csHoldTime = 3;
+    config->memConfig.csSetupTime = 3;
+    config->ipcmdSerialClkFreq = kFlexSpiSerialClk_SafeFreq;
+
+    if (option->option0.B.option_size > 0)
+    {
+        // Switch to second pinmux group
+        if (option->option1.B.pinmux_group == 1)
+        {
+            config->memConfig.controllerMiscOption |= FLEXSPI_BITMASK(kFlexSpiMiscOffset_SecondPinMux);
+        }
+
+        // Change the Pad Drive Strength
+        if (option->option1.B.drive_strength)
+        {
+            flexspi_update_padsetting(&config->memConfig, option->option1.B.drive_strength);
+        }
+        // Enable parallel mode support
+        if (option->option1.B.flash_connection)
+        {
+            if ((option->option0.B.device_type == kSerialNorCfgOption_DeviceType_ReadSFDP_SDR) ||
+                (option->option0.B.device_type == kSerialNorCfgOption_DeviceType_ReadSFDP_DDR))
+            {
+                uint32_t flashConnection = option->option1.B.flash_connection;
+
+                switch (flashConnection)
+                {
+                    default:
+                    case kSerialNorConnection_SinglePortA:
+                        // This is default setting, do nothing here
+                        break;
+                    case kSerialNorConnection_Parallel:
+                        config->memConfig.controllerMiscOption |=
+                            FLEXSPI_BITMASK(kFlexSpiMiscOffset_ParallelEnable);
+                        break;
+                    case kSerialNorConnection_SinglePortB:
+                        config->memConfig.sflashA1Size = 0;
+                        config->memConfig.sflashB1Size = MAX_24BIT_ADDRESSING_SIZE;
+                        break;
+                }
+            }
+            else
+            {
+                option->option1.B.flash_connection = 0;
+            }
+        }
+    }
+}
+
 #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_GET_CFG)
 // See flexspi_nor_flash.h for more details.
 status_t flexspi_nor_get_config(uint32_t instance, flexspi_nor_config_t *config, serial_nor_config_option_t *option)
@@ -3309,59 +3841,8 @@ status_t flexspi_nor_get_config(uint32_t instance, flexspi_nor_config_t *config,
             break;
         }
 
-        // Configure the Configuration block to default value
-        memset(config, 0, sizeof(flexspi_nor_config_t));
-        config->memConfig.serialClkFreq = kFlexSpiSerialClk_SafeFreq;
-        config->memConfig.sflashA1Size = MAX_24BIT_ADDRESSING_SIZE;
-        config->memConfig.tag = FLEXSPI_CFG_BLK_TAG;
-        config->memConfig.version = FLEXSPI_CFG_BLK_VERSION;
-        config->memConfig.csHoldTime = 3;
-        config->memConfig.csSetupTime = 3;
-        config->ipcmdSerialClkFreq = kFlexSpiSerialClk_SafeFreq;
-
-        if (option->option0.B.option_size > 0)
-        {
-            // Switch to second pinmux group
-            if (option->option1.B.pinmux_group == 1)
-            {
-                config->memConfig.controllerMiscOption |= FLEXSPI_BITMASK(kFlexSpiMiscOffset_SecondPinMux);
-            }
-
-            // Change the Pad Drive Strength
-            if (option->option1.B.drive_strength)
-            {
-                flexspi_update_padsetting(&config->memConfig, option->option1.B.drive_strength);
-            }
-            // Enable parallel mode support
-            if (option->option1.B.flash_connection)
-            {
-                if ((option->option0.B.device_type == kSerialNorCfgOption_DeviceType_ReadSFDP_SDR) ||
-                    (option->option0.B.device_type == kSerialNorCfgOption_DeviceType_ReadSFDP_DDR))
-                {
-                    uint32_t flashConnection = option->option1.B.flash_connection;
-
-                    switch (flashConnection)
-                    {
-                        default:
-                        case kSerialNorConnection_SinglePortA:
-                            // This is default setting, do nothing here
-                            break;
-                        case kSerialNorConnection_Parallel:
-                            config->memConfig.controllerMiscOption |=
-                                FLEXSPI_BITMASK(kFlexSpiMiscOffset_ParallelEnable);
-                            break;
-                        case kSerialNorConnection_SinglePortB:
-                            config->memConfig.sflashA1Size = 0;
-                            config->memConfig.sflashB1Size = MAX_24BIT_ADDRESSING_SIZE;
-                            break;
-                    }
-                }
-                else
-                {
-                    option->option1.B.flash_connection = 0;
-                }
-            }
-        }
+        flexspi_clear_resident_lut(instance);
+        flexspi_nor_set_default_config(config, option);
 
         switch (option->option0.B.device_type)
         {
@@ -3412,72 +3893,752 @@ status_t flexspi_nor_get_config(uint32_t instance, flexspi_nor_config_t *config,
 }
 #endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_GET_CFG)
 
+// The config cache and read tuning have no ROM API, they are built with every ROM API selection
+uint32_t flexspi_nor_config_cache_crc32(const flexspi_nor_config_cache_t *cache)
+{
+    return flexspi_nor_crc32((const uint8_t *)cache, offsetof(flexspi_nor_config_cache_t, crc32));
+}
 
-#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE)
-// See flexspi_nor_flash.h for more details.
-status_t flexspi_nor_flash_erase(uint32_t instance, flexspi_nor_config_t *config, uint32_t start, uint32_t length)
+bool flexspi_nor_config_cache_is_valid(const flexspi_nor_config_cache_t *cache)
 {
-    uint32_t aligned_start;
-    uint32_t aligned_end;
+    return (cache->tag == FLEXSPI_NOR_CONFIG_CACHE_TAG) && (cache->crc32 == flexspi_nor_config_cache_crc32(cache));
+}
 
+// See flexspi_nor_flash.h for more details.
+status_t flexspi_nor_get_config_cached(uint32_t instance,
+                                       flexspi_nor_config_t *config,
+                                       serial_nor_config_option_t *option,
+                                       flexspi_nor_config_cache_t *cache)
+{
     status_t status = kStatus_InvalidArgument;
 
     do
     {
-        if (config == NULL)
+        if ((config == NULL) || (option == NULL))
         {
             break;
         }
 
-        aligned_start = ((start) & -(config->sectorSize));
-        aligned_end   = (-(-(start + length) & -(config->sectorSize)));
+        uint32_t device_type = option->option0.B.device_type;
+        if ((cache == NULL) || ((device_type != kSerialNorCfgOption_DeviceType_ReadSFDP_SDR) &&
+                                (device_type != kSerialNorCfgOption_DeviceType_ReadSFDP_DDR)))
+        {
+            status = flexspi_nor_get_config(instance, config, option);
+            break;
+        }
+
+        uint32_t option1 = (option->option0.B.option_size > 0) ? option->option1.U : 0;
+        uint32_t jedec_id = 0;
+        uint32_t sfdp_crc = 0;
+        flexspi_nor_set_default_config(config, option);
+        status = flexspi_nor_prepare_sfdp_read(instance, config, option);
+        if (status == kStatus_Success)
+        {
+            status = flexspi_nor_read_device_fingerprint(instance, &jedec_id, &sfdp_crc);
+        }
+        bool is_identified = (status == kStatus_Success);
+
+        if (is_identified && flexspi_nor_config_cache_is_valid(cache) && (cache->option0 == option->option0.U) &&
+            (cache->option1 == option1) && (cache->jedecId == jedec_id) && (cache->sfdpCrc == sfdp_crc) &&
+            (cache->config.memConfig.tag == FLEXSPI_CFG_BLK_TAG))
+        {
+            memcpy(config, &cache->config, sizeof(flexspi_nor_config_t));
+            break;
+        }
 
-        // If the block size and sector size is uniform, just do sector erase
-        if (config->isUniformBlockSize || (config->blockSize == 0))
+        // Probe the device as usual, errors are reported by the full probe
+        cache->tag = 0;
+        cache->tuneTag = 0;
+        status = flexspi_nor_get_config(instance, config, option);
+        if ((status == kStatus_Success) && is_identified)
         {
-            while (aligned_start < aligned_end)
+            memcpy(&cache->config, config, sizeof(flexspi_nor_config_t));
+            // QE bit is nonvolatile, it is programmed by the flexspi_nor_flash_init following this call
+            if (cache->config.memConfig.deviceModeType == kDeviceConfigCmdType_QuadEnable)
             {
-                status = flexspi_nor_flash_erase_sector(instance, config, aligned_start);
-                if (status != kStatus_Success)
+                cache->config.memConfig.deviceModeCfgEnable = false;
+            }
+            cache->option0 = option->option0.U;
+            cache->option1 = option1;
+            cache->jedecId = jedec_id;
+            cache->sfdpCrc = sfdp_crc;
+            cache->tag = FLEXSPI_NOR_CONFIG_CACHE_TAG;
+            cache->crc32 = flexspi_nor_config_cache_crc32(cache);
+        }
+
+    } while (0);
+
+    return status;
+}
+
+int32_t flexspi_nor_get_read_dummy_index(flexspi_nor_config_t *config)
+{
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint32_t instruction = config->memConfig.lookupTable[NOR_CMD_LUT_SEQ_IDX_READ * 4 + i / 2] >> ((i & 1) * 16);
+        uint32_t opcode = (instruction & FLEXSPI_LUT_OPCODE0_MASK) >> FLEXSPI_LUT_OPCODE0_SHIFT;
+        if (opcode == STOP)
+        {
+            break;
+        }
+        if ((opcode == DUMMY_SDR) || (opcode == DUMMY_DDR))
+        {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+void flexspi_nor_set_read_point(
+    uint32_t instance, flexspi_nor_config_t *config, uint32_t freq, int32_t dummyIndex, uint32_t dummyCycles)
+{
+    bool isDdrModeEnabled =
+        config->memConfig.controllerMiscOption & FLEXSPI_BITMASK(kFlexSpiMiscOffset_DdrModeEnable) ? true : false;
+
+    if (dummyIndex >= 0)
+    {
+        uint32_t *lut = &config->memConfig.lookupTable[NOR_CMD_LUT_SEQ_IDX_READ * 4 + dummyIndex / 2];
+        uint32_t shift = (dummyIndex & 1) * 16;
+        *lut = (*lut & ~(FLEXSPI_LUT_OPERAND0_MASK << shift)) | (FLEXSPI_LUT_OPERAND0(dummyCycles) << shift);
+        // IP reads copy the read sequence from lookupTable until it is loaded again
+        flexspi_clear_resident_lut(instance);
+    }
+    if (freq != config->memConfig.serialClkFreq)
+    {
+        flexspi_wait_idle(instance);
+        config->memConfig.serialClkFreq = freq;
+        flexspi_clock_config(instance, freq, isDdrModeEnabled);
+        // Re-configure DLLCR
+        flexspi_configure_dll(instance, &config->memConfig);
+        flexspi_nor_wait_clock_stable(instance, isDdrModeEnabled);
+    }
+}
+
+uint32_t flexspi_nor_get_serial_clock(uint32_t instance, flexspi_nor_config_t *config)
+{
+    uint32_t serial_clock = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &serial_clock);
+    if (config->memConfig.controllerMiscOption & FLEXSPI_BITMASK(kFlexSpiMiscOffset_DdrModeEnable))
+    {
+        serial_clock /= 2;
+    }
+    return serial_clock;
+}
+
+status_t flexspi_nor_read_tune_data(uint32_t instance, flexspi_nor_config_t *config, uint32_t region, uint32_t *buffer)
+{
+    flexspi_xfer_t flashXfer;
+    flashXfer.operation = kFlexSpiOperation_Read;
+    flashXfer.seqNum = 1;
+    flashXfer.isParallelModeEnable = flexspi_is_parallel_mode(&config->memConfig);
+    flashXfer.baseAddress = FLEXSPI_NOR_TUNE_ADDRESS + region * FLEXSPI_NOR_TUNE_REGION_STRIDE;
+    flashXfer.rxBuffer = buffer;
+    flashXfer.rxSize = FLEXSPI_NOR_TUNE_SIZE;
+    flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, NOR_CMD_LUT_SEQ_IDX_READ, flashXfer.seqNum);
+
+    return flexspi_command_xfer(instance, &flashXfer);
+}
+
+bool flexspi_nor_check_read_point(uint32_t instance,
+                                  flexspi_nor_config_t *config,
+                                  const uint32_t *reference,
+                                  uint32_t reads)
+{
+    uint32_t buffer[FLEXSPI_NOR_TUNE_SIZE / sizeof(uint32_t)];
+
+    for (uint32_t i = 0; i < reads; i++)
+    {
+        const uint32_t *expected = reference;
+        for (uint32_t region = 0; region < FLEXSPI_NOR_TUNE_REGIONS; region++)
+        {
+            if ((flexspi_nor_read_tune_data(instance, config, region, buffer) != kStatus_Success) ||
+                (memcmp(buffer, expected, sizeof(buffer)) != 0))
+            {
+                return false;
+            }
+            expected += FLEXSPI_NOR_TUNE_SIZE / sizeof(uint32_t);
+        }
+    }
+    return true;
+}
+
+bool flexspi_nor_search_read_point(uint32_t instance,
+                                   flexspi_nor_config_t *config,
+                                   uint32_t freq,
+                                   int32_t dummyIndex,
+                                   uint32_t *dummyCycles,
+                                   const uint32_t *reference)
+{
+    uint32_t last_dummy = *dummyCycles;
+
+    // A faster clock needs at least the dummy cycles of the slower one, a sequence without any only tries the clock
+    if (dummyIndex >= 0)
+    {
+        last_dummy = *dummyCycles + FLEXSPI_NOR_TUNE_DUMMY_SPAN;
+    }
+    for (uint32_t dummy = *dummyCycles; dummy <= last_dummy; dummy++)
+    {
+        flexspi_nor_set_read_point(instance, config, freq, dummyIndex, dummy);
+        if (flexspi_nor_check_read_point(instance, config, reference, FLEXSPI_NOR_TUNE_READS))
+        {
+            *dummyCycles = dummy;
+            return true;
+        }
+    }
+    return false;
+}
+
+// See flexspi_nor_flash.h for more details.
+status_t flexspi_nor_flash_tune_read(uint32_t instance,
+                                     flexspi_nor_config_t *config,
+                                     uint32_t maxFreq,
+                                     uint32_t maxClockHz,
+                                     flexspi_nor_config_cache_t *cache)
+{
+    status_t status = kStatus_InvalidArgument;
+    uint32_t reference[FLEXSPI_NOR_TUNE_REGIONS * FLEXSPI_NOR_TUNE_SIZE / sizeof(uint32_t)];
+
+    do
+    {
+        if (config == NULL)
+        {
+            break;
+        }
+
+        status = kStatus_Success;
+        uint32_t base_freq = config->memConfig.serialClkFreq;
+        if (maxFreq > kFlexSpiSerialClk_200MHz)
+        {
+            maxFreq = kFlexSpiSerialClk_200MHz;
+        }
+        // The safe frequency cannot be restored through ipcmdSerialClkFreq
+        if ((maxFreq <= base_freq) || (base_freq == kFlexSpiSerialClk_SafeFreq))
+        {
+            break;
+        }
+
+        int32_t dummy_index = flexspi_nor_get_read_dummy_index(config);
+        uint32_t base_dummy = 0;
+        if (dummy_index >= 0)
+        {
+            base_dummy = (config->memConfig.lookupTable[NOR_CMD_LUT_SEQ_IDX_READ * 4 + dummy_index / 2] >>
+                          ((dummy_index & 1) * 16)) &
+                         FLEXSPI_LUT_OPERAND0_MASK;
+        }
+
+        for (uint32_t region = 0; (region < FLEXSPI_NOR_TUNE_REGIONS) && (status == kStatus_Success); region++)
+        {
+            status = flexspi_nor_read_tune_data(instance, config, region,
+                                                &reference[region * FLEXSPI_NOR_TUNE_SIZE / sizeof(uint32_t)]);
+        }
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+        // Blank or uniform data reads back the same whatever the dummy cycles
+        const uint8_t *reference_bytes = (const uint8_t *)reference;
+        bool is_uniform = true;
+        for (uint32_t i = 1; is_uniform && (i < sizeof(reference)); i++)
+        {
+            is_uniform = (reference_bytes[i] == reference_bytes[0]);
+        }
+
+        uint32_t tuned_freq = base_freq;
+        uint32_t tuned_dummy = base_dummy;
+        bool is_tuned = false;
+        bool is_cached = (cache != NULL) && flexspi_nor_config_cache_is_valid(cache) &&
+                         (cache->tuneTag == FLEXSPI_NOR_TUNE_TAG) && (cache->tuneBaseFreq == base_freq) &&
+                         (cache->tuneMaxFreq == maxFreq) && (cache->tuneMaxClockHz == maxClockHz);
+        if (is_cached)
+        {
+            // Measured on this device, a uniform reference cannot check it again and the point of config read it
+            flexspi_nor_set_read_point(instance, config, cache->tunedFreq, dummy_index, cache->tunedDummyCycles);
+            is_tuned = is_uniform || ((cache->tunedFreq == base_freq) && (cache->tunedDummyCycles == base_dummy)) ||
+                       flexspi_nor_check_read_point(instance, config, reference, 1);
+            if (is_tuned)
+            {
+                tuned_freq = cache->tunedFreq;
+                tuned_dummy = cache->tunedDummyCycles;
+            }
+            else
+            {
+                cache->tuneTag = 0;
+                cache->crc32 = flexspi_nor_config_cache_crc32(cache);
+            }
+        }
+        if (!is_tuned && is_uniform)
+        {
+            flexspi_nor_set_read_point(instance, config, base_freq, dummy_index, base_dummy);
+        }
+        else if (!is_tuned)
+        {
+            // Fastest clock first, a clock above the rating of the device may read back here and fail over
+            // temperature and voltage
+            uint32_t top_freq = base_freq;
+            for (uint32_t freq = maxFreq; freq > base_freq; freq--)
+            {
+                uint32_t dummy = base_dummy;
+                flexspi_nor_set_read_point(instance, config, freq, dummy_index, dummy);
+                if (flexspi_nor_get_serial_clock(instance, config) > maxClockHz)
                 {
-                    return status;
+                    continue;
+                }
+                if (flexspi_nor_search_read_point(instance, config, freq, dummy_index, &dummy, reference))
+                {
+                    top_freq = freq;
+                    break;
                 }
-                aligned_start += config->sectorSize;
+            }
+            // Keep one clock step of margin below the fastest clock that passed
+            if (top_freq > base_freq + 1)
+            {
+                tuned_freq = top_freq - 1;
+                if (!flexspi_nor_search_read_point(instance, config, tuned_freq, dummy_index, &tuned_dummy, reference))
+                {
+                    tuned_freq = base_freq;
+                    tuned_dummy = base_dummy;
+                }
+            }
+            flexspi_nor_set_read_point(instance, config, tuned_freq, dummy_index, tuned_dummy);
+            is_tuned = true;
+
+            if ((cache != NULL) && flexspi_nor_config_cache_is_valid(cache))
+            {
+                cache->tuneBaseFreq = (uint8_t)base_freq;
+                cache->tuneMaxFreq = (uint8_t)maxFreq;
+                cache->tuneMaxClockHz = maxClockHz;
+                cache->tunedFreq = (uint8_t)tuned_freq;
+                cache->tunedDummyCycles = (uint8_t)tuned_dummy;
+                cache->tuneTag = FLEXSPI_NOR_TUNE_TAG;
+                cache->crc32 = flexspi_nor_config_cache_crc32(cache);
             }
         }
-        else // Try do do erase using maximum granularity in order to improve erase performance
+
+        // Program, erase and the other commands keep the clock the device was configured for
+        if ((tuned_freq != base_freq) && (config->ipcmdSerialClkFreq == 0))
         {
-            while (aligned_start < aligned_end)
+            config->ipcmdSerialClkFreq = (uint8_t)base_freq;
+        }
+        // AHB reads run the read sequence in place
+#if FLEXSPI_ENABLE_RESIDENT_LUT
+        flexspi_load_lut(instance, config->memConfig.lookupTable);
+#else
+        flexspi_update_lut(instance, 0, config->memConfig.lookupTable, 1);
+#endif
+
+    } while (0);
+
+    return status;
+}
+
+#if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE)
+// See flexspi_nor_flash.h for more details.
+status_t flexspi_nor_flash_erase(uint32_t instance, flexspi_nor_config_t *config, uint32_t start, uint32_t length)
+{
+    uint32_t aligned_start;
+    uint32_t aligned_end;
+
+    status_t status = kStatus_InvalidArgument;
+
+    do
+    {
+        if (config == NULL)
+        {
+            break;
+        }
+
+        aligned_start = ((start) & -(config->sectorSize));
+        aligned_end = (-(-(start + length) & -(config->sectorSize)));
+#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+        bool isParallelMode = false;
+#else
+        bool isParallelMode = flexspi_is_parallel_mode((flexspi_mem_config_t *)config);
+#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+
+        // Erase all devices when the region covers them, each one gets the fastest of chip erase and other erases
+        uint32_t device_size = flexspi_nor_get_device_size(config);
+        if ((aligned_start == 0) && (device_size != 0) && (aligned_end >= device_size))
+        {
+            status = flexspi_nor_flash_erase_all(instance, config);
+            break;
+        }
+
+        // The chip selects the range covers are erased at the same time, see flexspi_nor_start_chip
+        status = flexspi_nor_run_chips(instance, config, isParallelMode, aligned_start, aligned_end, NULL);
+    } while (0);
+
+    return status;
+}
+#endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE)
+
+// See flexspi_nor_flash.h for more details.
+status_t flexspi_nor_flash_program(
+    uint32_t instance, flexspi_nor_config_t *config, uint32_t dstAddr, const uint32_t *src, uint32_t length)
+{
+    status_t status = kStatus_InvalidArgument;
+
+    do
+    {
+        if ((config == NULL) || (src == NULL) || (config->pageSize == 0) || (dstAddr % config->pageSize) ||
+            (length % config->pageSize))
+        {
+            break;
+        }
+
+#if !FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+        bool isParallelMode = false;
+#else
+        bool isParallelMode = flexspi_is_parallel_mode((flexspi_mem_config_t *)config);
+#endif // FLEXSPI_FEATURE_HAS_PARALLEL_MODE
+        status = flexspi_nor_run_chips(instance, config, isParallelMode, dstAddr, dstAddr + length, src);
+    } while (0);
+
+    return status;
+}
+
+status_t flexspi_nor_erase_send(uint32_t instance,
+                                flexspi_nor_config_t *config,
+                                bool isParallelMode,
+                                uint32_t address,
+                                uint32_t seqId,
+                                uint32_t cmdIndex)
+{
+    status_t status;
+    flexspi_xfer_t flashXfer;
+    flexspi_mem_config_t *memCfg = (flexspi_mem_config_t *)config;
+
+    do
+    {
+        status = flexspi_nor_write_enable(instance, config, isParallelMode, address);
+        if (status != kStatus_Success)
+        {
+            break;
+        }
+
+        flashXfer.baseAddress = address;
+        flashXfer.operation = kFlexSpiOperation_Command;
+        flashXfer.seqNum = 1;
+        flashXfer.seqId = seqId;
+        flashXfer.isParallelModeEnable = isParallelMode;
+        if ((cmdIndex != NOR_CMD_INDEX_NONE) && memCfg->lutCustomSeqEnable && memCfg->lutCustomSeq[cmdIndex].seqNum)
+        {
+            flashXfer.seqId = memCfg->lutCustomSeq[cmdIndex].seqId;
+            flashXfer.seqNum = memCfg->lutCustomSeq[cmdIndex].seqNum;
+        }
+
+        flashXfer.seqId = flexspi_select_ip_seq(instance, &config->memConfig, flashXfer.seqId, flashXfer.seqNum);
+        status = flexspi_command_xfer(instance, &flashXfer);
+    } while (0);
+
+    return status;
+}
+
+void flexspi_nor_pick_erase_type(flexspi_nor_config_t *config,
+                                 uint32_t address,
+                                 uint32_t remaining_size,
+                                 flexspi_nor_erase_type_t *type)
+{
+    // Use the largest erase type that is aligned at the current address and fits in the remaining size,
+    // erase sizes are powers of 2 so that it also covers the region with the fewest erase operations.
+    if (!config->isUniformBlockSize && is_erase_type_usable(config->blockSize, address, remaining_size))
+    {
+        type->size = config->blockSize;
+        type->timeMs = config->blockEraseTimeMs;
+        type->seqId = NOR_CMD_LUT_SEQ_IDX_ERASEBLOCK;
+        type->cmdIndex = NOR_CMD_INDEX_ERASEBLOCK;
+    }
+    else if (is_erase_type_usable(config->halfBlockSize, address, remaining_size))
+    {
+        type->size = config->halfBlockSize;
+        type->timeMs = config->halfBlockEraseTimeMs;
+        type->seqId = NOR_CMD_LUT_SEQ_IDX_ERASEHALFBLOCK;
+        type->cmdIndex = NOR_CMD_INDEX_NONE;
+    }
+    else
+    {
+        type->size = config->sectorSize;
+        type->timeMs = config->sectorEraseTimeMs;
+        type->seqId = NOR_CMD_LUT_SEQ_IDX_ERASESECTOR;
+        type->cmdIndex = NOR_CMD_INDEX_ERASESECTOR;
+    }
+}
+
+uint32_t flexspi_nor_get_erase_time_ms(flexspi_nor_config_t *config, uint32_t address, uint32_t size)
+{
+    flexspi_nor_erase_type_t type;
+    uint32_t end = address + size;
+    uint32_t timeMs = 0;
+
+    while (address < end)
+    {
+        flexspi_nor_pick_erase_type(config, address, end - address, &type);
+        if (type.size == 0)
+        {
+            break;
+        }
+        timeMs += type.timeMs;
+        address += type.size;
+    }
+
+    return timeMs;
+}
+
+uint32_t flexspi_nor_split_chips(
+    flexspi_nor_config_t *config, bool isParallelMode, uint32_t start, uint32_t end, flexspi_nor_chip_state_t *chips)
+{
+    uint32_t *chipSize = &config->memConfig.sflashA1Size;
+    uint32_t chipBase = 0;
+    uint32_t count = 0;
+
+    memset(chips, 0, sizeof(flexspi_nor_chip_state_t) * FLEXSPI_NOR_MAX_CHIPS);
+    // In parallel mode the address space is interleaved across two devices, they act as one chip
+    if (isParallelMode)
+    {
+        chips[0].next = start;
+        chips[0].end = end;
+        return (start < end) ? 1 : 0;
+    }
+
+    for (uint32_t index = 0; index < FLEXSPI_NOR_MAX_CHIPS; index++)
+    {
+        uint32_t chipEnd = chipBase + chipSize[index];
+        if ((chipSize[index] > 0) && (start < chipEnd) && (end > chipBase))
+        {
+            chips[count].next = (start > chipBase) ? start : chipBase;
+            chips[count].end = (end < chipEnd) ? end : chipEnd;
+            chips[count].chipBase = chipBase;
+            chips[count].chipSize = chipSize[index];
+            count++;
+        }
+        chipBase = chipEnd;
+    }
+
+    return (end > chipBase) ? 0 : count;
+}
+
+status_t flexspi_nor_start_chip(uint32_t instance,
+                                flexspi_nor_config_t *config,
+                                bool isParallelMode,
+                                flexspi_nor_chip_state_t *chip,
+                                uint32_t start,
+                                const uint32_t *src,
+                                uint32_t nowUs)
+{
+    status_t status;
+    uint32_t address = chip->next;
+    uint32_t remaining_size = chip->end - chip->next;
+    uint32_t size;
+
+    if (src != NULL)
+    {
+        size = config->pageSize;
+        chip->typicalUs = config->pageProgramTimeUs;
+        status = flexspi_nor_page_program_send(instance, config, isParallelMode, address,
+                                               &src[(address - start) / sizeof(uint32_t)]);
+    }
+    else
+    {
+        flexspi_nor_erase_type_t type;
+        // A chip select covered entirely gets one chip erase, unless SFDP says the other erases take less time
+        if (chip->chipSize && (address == chip->chipBase) && (remaining_size == chip->chipSize) &&
+            (config->chipEraseTimeMs <= flexspi_nor_get_erase_time_ms(config, address, remaining_size)))
+        {
+            type.size = chip->chipSize;
+            type.timeMs = config->chipEraseTimeMs;
+            type.seqId = NOR_CMD_LUT_SEQ_IDX_CHIPERASE;
+            type.cmdIndex = NOR_CMD_INDEX_CHIPERASE;
+        }
+        else
+        {
+            flexspi_nor_pick_erase_type(config, address, remaining_size, &type);
+        }
+        size = type.size;
+        chip->typicalUs = type.timeMs * 1000;
+        status = flexspi_nor_erase_send(instance, config, isParallelMode, address, type.seqId, type.cmdIndex);
+    }
+
+    // Same schedule as flexspi_device_poll_busy: half of the typical time, then a fraction of it. Without typical
+    // time poll on every pass, or every 1ms if the timeout has to be checked.
+    chip->busyAddress = address;
+    chip->next = address + size;
+    chip->isBusy = (status == kStatus_Success);
+    chip->startUs = nowUs;
+    chip->traceStart = FLEXSPI_TRACE_BEGIN();
+    chip->pollUs = nowUs + chip->typicalUs / 2;
+    chip->intervalUs = chip->typicalUs / FLEXSPI_POLL_INTERVAL_DIVIDER;
+    if (chip->typicalUs == 0)
+    {
+        chip->intervalUs = config->memConfig.timeoutInMs ? 1000 : 0;
+    }
+    else if (chip->intervalUs < FLEXSPI_POLL_INTERVAL_MIN_US)
+    {
+        chip->intervalUs = FLEXSPI_POLL_INTERVAL_MIN_US;
+    }
+    else if (chip->intervalUs > FLEXSPI_POLL_INTERVAL_MAX_US)
+    {
+        chip->intervalUs = FLEXSPI_POLL_INTERVAL_MAX_US;
+    }
+
+    return status;
+}
+
+status_t flexspi_nor_run_chips(uint32_t instance,
+                               flexspi_nor_config_t *config,
+                               bool isParallelMode,
+                               uint32_t start,
+                               uint32_t end,
+                               const uint32_t *src)
+{
+    flexspi_nor_chip_state_t chips[FLEXSPI_NOR_MAX_CHIPS];
+    uint32_t count = flexspi_nor_split_chips(config, isParallelMode, start, end, chips);
+    uint32_t timeoutUs = config->memConfig.timeoutInMs * 1000;
+    uint32_t statusSeqId = flexspi_nor_get_status_seq(config);
+    // Time spent in delays since the start, read status commands are scheduled on it
+    uint32_t nowUs = 0;
+    status_t status = kStatus_Success;
+
+    if ((count == 0) && (start < end))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    // Update serial clock for IP command, for some devices, it cannot erase/program the
+    // device with the highest clock for read.
+    flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Update);
+
+    // Start the next operation of every idle chip, then delay until the earliest read status that is due. A chip
+    // that is still busy never gets a command other than read status.
+    while (status == kStatus_Success)
+    {
+        uint32_t pollUs = UINT32_MAX;
+
+        for (uint32_t index = 0; (index < count) && (status == kStatus_Success); index++)
+        {
+            flexspi_nor_chip_state_t *chip = &chips[index];
+
+            if (chip->isBusy && (nowUs >= chip->pollUs))
             {
-                bool is_addr_block_aligned = !(aligned_start & ~(config->blockSize));
-                uint32_t remaining_size = (aligned_end - aligned_start);
-                if (is_addr_block_aligned && (remaining_size >= config->blockSize))
+                status = flexspi_device_read_busy(instance, &config->memConfig, statusSeqId, isParallelMode,
+                                                  chip->busyAddress, &chip->isBusy);
+                if ((status == kStatus_Success) && !chip->isBusy)
                 {
-                    status = flexspi_nor_flash_erase_block(instance, config, aligned_start);
-                    if (status != kStatus_Success)
-                    {
-                        return status;
-                    }
-                    aligned_start += config->blockSize;
+                    FLEXSPI_TRACE_END(kFlexSpiTracePhase_BusyPoll, chip->traceStart, chip->next - chip->busyAddress);
                 }
-                else
+                if ((status == kStatus_Success) && chip->isBusy)
                 {
-                    status = flexspi_nor_flash_erase_sector(instance, config, aligned_start);
-                    if (status != kStatus_Success)
+                    uint32_t elapsedUs = nowUs - chip->startUs;
+                    if (timeoutUs && (elapsedUs >= timeoutUs))
+                    {
+                        status = kStatus_FLEXSPI_DeviceTimeout;
+                    }
+                    else if (chip->typicalUs && (elapsedUs >= chip->typicalUs) &&
+                             (chip->intervalUs < FLEXSPI_POLL_INTERVAL_MAX_US))
                     {
-                        return status;
+                        chip->intervalUs = (chip->intervalUs * 2 < FLEXSPI_POLL_INTERVAL_MAX_US) ?
+                                               (chip->intervalUs * 2) :
+                                               FLEXSPI_POLL_INTERVAL_MAX_US;
                     }
-                    aligned_start += config->sectorSize;
+                    chip->pollUs = nowUs + chip->intervalUs;
                 }
+#if FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT
+                else if ((status == kStatus_Success) && config->needRestoreNoCmdMode)
+                {
+                    status = flexspi_nor_restore_no_cmd_mode(instance, config, isParallelMode, chip->busyAddress);
+                }
+#endif
+            }
+
+            if ((status == kStatus_Success) && !chip->isBusy && (chip->next < chip->end))
+            {
+                status = flexspi_nor_start_chip(instance, config, isParallelMode, chip, start, src, nowUs);
+            }
+
+            if (chip->isBusy && (chip->pollUs < pollUs))
+            {
+                pollUs = chip->pollUs;
             }
         }
-    } while (0);
+
+        if ((status != kStatus_Success) || (pollUs == UINT32_MAX))
+        {
+            break;
+        }
+        if (pollUs > nowUs)
+        {
+            flexspi_sw_delay_us(pollUs - nowUs);
+            nowUs = pollUs;
+        }
+    }
+
+    // The first error is returned once no chip is left busy, the next command would be rejected by the busy ones
+    if (status != kStatus_Success)
+    {
+        flexspi_nor_wait_chips(instance, config, isParallelMode, chips, count, nowUs);
+    }
+
+    flexspi_clear_cache(instance);
+
+    // Restore clock for AHB command
+    flexspi_change_serial_clock(instance, config, kFlexSpiSerialClk_Restore);
 
     return status;
 }
-#endif // #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_ERASE)
 
 
+void flexspi_nor_wait_chips(uint32_t instance,
+                            flexspi_nor_config_t *config,
+                            bool isParallelMode,
+                            flexspi_nor_chip_state_t *chips,
+                            uint32_t count,
+                            uint32_t nowUs)
+{
+    uint32_t timeoutUs = config->memConfig.timeoutInMs * 1000;
+    uint32_t statusSeqId = flexspi_nor_get_status_seq(config);
+
+    // A chip whose status cannot be read or that exceeds the timeout is given up, it no longer counts as busy
+    while (1)
+    {
+        uint32_t pollUs = UINT32_MAX;
+
+        for (uint32_t index = 0; index < count; index++)
+        {
+            flexspi_nor_chip_state_t *chip = &chips[index];
+
+            if (chip->isBusy && (nowUs >= chip->pollUs))
+            {
+                status_t status = flexspi_device_read_busy(instance, &config->memConfig, statusSeqId, isParallelMode,
+                                                           chip->busyAddress, &chip->isBusy);
+                if ((status != kStatus_Success) || (timeoutUs && ((nowUs - chip->startUs) >= timeoutUs)))
+                {
+                    chip->isBusy = false;
+                }
+#if FLEXSPI_ENABLE_NO_CMD_MODE_SUPPORT
+                else if (!chip->isBusy && config->needRestoreNoCmdMode)
+                {
+                    flexspi_nor_restore_no_cmd_mode(instance, config, isParallelMode, chip->busyAddress);
+                }
+#endif
+                chip->pollUs = nowUs + chip->intervalUs;
+            }
+
+            if (chip->isBusy && (chip->pollUs < pollUs))
+            {
+                pollUs = chip->pollUs;
+            }
+        }
+
+        if (pollUs == UINT32_MAX)
+        {
+            break;
+        }
+        if (pollUs > nowUs)
+        {
+            flexspi_sw_delay_us(pollUs - nowUs);
+            nowUs = pollUs;
+        }
+    }
+}
+
 #if (!BL_FEATURE_HAS_FLEXSPI_NOR_ROMAPI) || (!ROM_API_HAS_FLEXSPI_NOR_READ)
 // See flexspi_nor_flash.h for more details.
 status_t flexspi_nor_flash_read(
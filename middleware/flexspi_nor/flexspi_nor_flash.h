@@ -37,6 +37,7 @@
 #define NOR_CMD_LUT_SEQ_IDX_PAGEPROGRAM \
     CMD_LUT_SEQ_IDX_WRITE                //!< 9  Program sequence id in lookupTable stored in config block
 #define NOR_CMD_LUT_SEQ_IDX_CHIPERASE 11 //!< 11 Chip Erase sequence in lookupTable id stored in config block
+#define NOR_CMD_LUT_SEQ_IDX_ERASEHALFBLOCK 12 //!< 12 Erase Half Block sequence id in lookupTable stored in config block
 #define NOR_CMD_LUT_SEQ_IDX_READ_SFDP 13 //!< 13 Read SFDP sequence in lookupTable id stored in config block
 #define NOR_CMD_LUT_SEQ_IDX_RESTORE_NOCMD \
     14 //!< 14 Restore 0-4-4/0-8-8 mode sequence id in lookupTable stored in config block
@@ -46,7 +47,9 @@
 /* FlexSPI NOR status */
 enum _flexspi_nor_status
 {
+#if !defined(BL_TARGET_ROM_API) // ROM API builds use the status group of the boot ROM, from bootloader_common.h
     kStatusGroup_FLEXSPINOR        = 200,
+#endif
     kStatus_FLEXSPINOR_ProgramFail = MAKE_STATUS(kStatusGroup_FLEXSPINOR, 0), //!< Status for Page programming failure
     kStatus_FLEXSPINOR_EraseSectorFail = MAKE_STATUS(kStatusGroup_FLEXSPINOR, 1), //!< Status for Sector Erase failure
     kStatus_FLEXSPINOR_EraseAllFail = MAKE_STATUS(kStatusGroup_FLEXSPINOR, 2),    //!< Status for Chip Erase failure
@@ -195,9 +198,41 @@ typedef struct _flexspi_nor_config
     uint8_t halfClkForNonReadCmd;   //!< Half the Serial Clock for non-read command: true/false
     uint8_t needRestoreNoCmdMode;   //!< Need to Restore NoCmd mode after IP commmand execution
     uint32_t blockSize;             //!< Block size
-    uint32_t reserve2[11];          //!< Reserved for future use
+    uint32_t halfBlockSize;         //!< Half block size (e.g. 32KB), 0 if not supported
+    uint16_t pageProgramTimeUs;     //!< Typical page program time, 0 if unknown
+    uint16_t sectorEraseTimeMs;     //!< Typical sector erase time, 0 if unknown
+    uint16_t halfBlockEraseTimeMs;  //!< Typical half block erase time, 0 if unknown
+    uint16_t blockEraseTimeMs;      //!< Typical block erase time, 0 if unknown
+    uint32_t chipEraseTimeMs;       //!< Typical chip erase time, 0 if unknown
+    uint32_t reserve2[7];           //!< Reserved for future use
 } flexspi_nor_config_t;
 
+//!@brief Tag of a valid Serial NOR configuration block cache, ascii: "NCFC"
+#define FLEXSPI_NOR_CONFIG_CACHE_TAG (0x4346434EUL)
+
+//!@brief Tag of a valid read tuning result in the configuration block cache, ascii: "NTUN"
+#define FLEXSPI_NOR_TUNE_TAG (0x4E55544EUL)
+
+/*
+ *  Serial NOR configuration block cache, see flexspi_nor_get_config_cached
+ */
+typedef struct _flexspi_nor_config_cache
+{
+    uint32_t tag;                //!< FLEXSPI_NOR_CONFIG_CACHE_TAG if the cache holds a config block
+    uint32_t option0;            //!< option0 the config block was generated with
+    uint32_t option1;            //!< option1 the config block was generated with, 0 if not present
+    uint32_t jedecId;            //!< Manufacturer and device ID of the Flash device
+    uint32_t sfdpCrc;            //!< CRC32 of the SFDP header and parameter headers of the Flash device
+    flexspi_nor_config_t config; //!< Serial NOR configuration block
+    uint32_t tuneTag;            //!< FLEXSPI_NOR_TUNE_TAG if the fields below hold a flexspi_nor_flash_tune_read result
+    uint32_t tuneMaxClockHz;     //!< Rated serial clock of the device the tuning was allowed
+    uint8_t tuneBaseFreq;        //!< serialClkFreq the tuning started from
+    uint8_t tuneMaxFreq;         //!< Highest serialClkFreq the tuning was allowed
+    uint8_t tunedFreq;           //!< serialClkFreq of reads
+    uint8_t tunedDummyCycles;    //!< Dummy cycles of the read sequence
+    uint32_t crc32;              //!< CRC32 of the fields above, the cache is discarded on mismatch
+} flexspi_nor_config_cache_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -211,7 +246,22 @@ status_t flexspi_nor_flash_page_program(uint32_t instance,
                                         uint32_t dstAddr,
                                         const uint32_t *src);
 
-//!@brief Erase all the Serial NOR devices connected on FlexSPI
+//!@brief Start programming data to Serial NOR via FlexSPI, without waiting for the device to complete it
+//!
+//! src is sent to the device when the function returns and can be reused. The device is busy programming
+//! until flexspi_nor_flash_page_program_complete is called with the same dstAddr, which must take place
+//! before any other access to the device, AHB reads included.
+status_t flexspi_nor_flash_page_program_start(uint32_t instance,
+                                              flexspi_nor_config_t *config,
+                                              uint32_t dstAddr,
+                                              const uint32_t *src);
+
+//!@brief Wait until the program started by flexspi_nor_flash_page_program_start completes
+status_t flexspi_nor_flash_page_program_complete(uint32_t instance, flexspi_nor_config_t *config, uint32_t dstAddr);
+
+//!@brief Erase all the Serial NOR devices connected on FlexSPI, they erase at the same time
+//!
+//! Each device gets a chip erase, or block erases when their typical times from SFDP add up to less.
 status_t flexspi_nor_flash_erase_all(uint32_t instance, flexspi_nor_config_t *config);
 
 //!@brief Erase one sector specified by address
@@ -220,12 +270,60 @@ status_t flexspi_nor_flash_erase_sector(uint32_t instance, flexspi_nor_config_t
 //!@brief Erase one block specified by address
 status_t flexspi_nor_flash_erase_block(uint32_t instance, flexspi_nor_config_t *config, uint32_t address);
 
+//!@brief Check whether the sector at address is erased, with the Blank Check command of the device
+//!
+//! The device reads the sector internally, nothing goes over the bus but the command and the status. Only
+//! HyperFLASH supports it, other devices return kStatus_FlexSPINOR_NotSupported.
+status_t flexspi_nor_flash_blank_check(uint32_t instance,
+                                       flexspi_nor_config_t *config,
+                                       uint32_t address,
+                                       bool *isBlank);
+
 //!@brief Get FlexSPI NOR Configuration Block based on specified option
 status_t flexspi_nor_get_config(uint32_t instance, flexspi_nor_config_t *config, serial_nor_config_option_t *option);
 
+//!@brief Get FlexSPI NOR Configuration Block, from the cache if it was generated for the same device and option
+//!
+//! The device is identified by its JEDEC ID and SFDP headers, which take two short reads instead of the whole
+//! SFDP probe. The cache is filled when the config block is generated. Devices that are not probed via SFDP and
+//! a NULL cache always get the config block from flexspi_nor_get_config. The cache lives in RAM the application
+//! may overwrite, a cache whose CRC32 does not match its content is discarded and the device is probed again.
+status_t flexspi_nor_get_config_cached(uint32_t instance,
+                                       flexspi_nor_config_t *config,
+                                       serial_nor_config_option_t *option,
+                                       flexspi_nor_config_cache_t *cache);
+
+//!@brief Raise the serial clock of reads to one step below the fastest one the device reads back reliably at
+//!
+//! Four regions 4KB apart from the start of the device (config block, IVT, vectors and code of a boot image) read
+//! at the clock of config are the reference. Each faster clock from maxFreq down whose serial clock does not
+//! exceed maxClockHz, the fast read rating of the device from its datasheet as SFDP does not provide it, is tried
+//! with the dummy cycles of the read sequence and up to a few more, a point passes when two reads of every region
+//! match the reference. The read sequence gets the clock one step below the first point that passes, never below
+//! the clock of config. Program and erase commands keep the clock of config through ipcmdSerialClkFreq. Nothing
+//! changes when the reference is blank. The result is kept in cache, NULL if none, and reapplied after a single
+//! check while the config block there stays valid.
+status_t flexspi_nor_flash_tune_read(uint32_t instance,
+                                     flexspi_nor_config_t *config,
+                                     uint32_t maxFreq,
+                                     uint32_t maxClockHz,
+                                     flexspi_nor_config_cache_t *cache);
+
 //!@brief Erase Flash Region specified by address and length
+//!
+//! The region is extended to sector boundaries and erased by the largest block, half block or sector erases
+//! aligned at each address. A chip select the region covers entirely gets a chip erase instead, unless the
+//! typical times from SFDP make the other erases faster. Every chip select the region covers is erased at the
+//! same time.
 status_t flexspi_nor_flash_erase(uint32_t instance, flexspi_nor_config_t *config, uint32_t start, uint32_t length);
 
+//!@brief Program whole pages to Serial NOR
+//!
+//! dstAddr and length are multiples of the page size. While a chip select is busy with a page, the next page
+//! of every other chip select the region covers is sent, so that devices on A1/A2/B1/B2 program concurrently.
+status_t flexspi_nor_flash_program(
+    uint32_t instance, flexspi_nor_config_t *config, uint32_t dstAddr, const uint32_t *src, uint32_t length);
+
 //!@brief Read data from Serial NOR
 status_t flexspi_nor_flash_read(
     uint32_t instance, flexspi_nor_config_t *config, uint32_t *dst, uint32_t start, uint32_t bytes);
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __SW_CRC_H__
+#define __SW_CRC_H__
+
+#include <stdint.h>
+
+//!@brief Software CRC methods, from the smallest to the fastest
+//!
+//! Tables are const data generated offline, there is no init code. Each table is a separate object,
+//! the linker only keeps the ones referenced by the methods in use.
+//!
+//!  method   | CRC-16 tables | CRC-32 tables | reads
+//!  ---------|---------------|---------------|-----------------------
+//!  BITWISE  |             0 |             0 | one byte, 8 bit steps
+//!  NIBBLE   |          32 B |          64 B | one byte, 2 lookups
+//!  TABLE    |         512 B |          1 KB | one byte, 1 lookup
+//!  SLICE4   |          2 KB |          4 KB | one word, 4 lookups
+//!  SLICE8   |          4 KB |          8 KB | two words, 8 lookups
+#define SW_CRC_METHOD_BITWISE 0
+#define SW_CRC_METHOD_NIBBLE 1
+#define SW_CRC_METHOD_TABLE 2
+#define SW_CRC_METHOD_SLICE4 3
+#define SW_CRC_METHOD_SLICE8 4
+
+//!@brief Method of sw_crc16() and sw_crc32()
+#ifndef SW_CRC_METHOD
+#define SW_CRC_METHOD SW_CRC_METHOD_SLICE4
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//!@brief CRC-16/XMODEM: polynomial 0x1021, MSB first, initial value 0, no final XOR
+//!
+//! Same value as Crc16() of the IAR flash loader framework. Pass 0 as crc for the first block, then the
+//! result of the previous block to continue.
+uint16_t sw_crc16_bitwise(uint16_t crc, const void *data, uint32_t length);
+uint16_t sw_crc16_nibble(uint16_t crc, const void *data, uint32_t length);
+uint16_t sw_crc16_table(uint16_t crc, const void *data, uint32_t length);
+uint16_t sw_crc16_slice4(uint16_t crc, const void *data, uint32_t length);
+uint16_t sw_crc16_slice8(uint16_t crc, const void *data, uint32_t length);
+
+//!@brief CRC-32 (IEEE 802.3): polynomial 0x04C11DB7 reflected, initial value and final XOR 0xFFFFFFFF
+//!
+//! Pass 0 as crc for the first block, then the result of the previous block to continue.
+uint32_t sw_crc32_bitwise(uint32_t crc, const void *data, uint32_t length);
+uint32_t sw_crc32_nibble(uint32_t crc, const void *data, uint32_t length);
+uint32_t sw_crc32_table(uint32_t crc, const void *data, uint32_t length);
+uint32_t sw_crc32_slice4(uint32_t crc, const void *data, uint32_t length);
+uint32_t sw_crc32_slice8(uint32_t crc, const void *data, uint32_t length);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#if SW_CRC_METHOD == SW_CRC_METHOD_BITWISE
+#define sw_crc16 sw_crc16_bitwise
+#define sw_crc32 sw_crc32_bitwise
+#elif SW_CRC_METHOD == SW_CRC_METHOD_NIBBLE
+#define sw_crc16 sw_crc16_nibble
+#define sw_crc32 sw_crc32_nibble
+#elif SW_CRC_METHOD == SW_CRC_METHOD_TABLE
+#define sw_crc16 sw_crc16_table
+#define sw_crc32 sw_crc32_table
+#elif SW_CRC_METHOD == SW_CRC_METHOD_SLICE4
+#define sw_crc16 sw_crc16_slice4
+#define sw_crc32 sw_crc32_slice4
+#elif SW_CRC_METHOD == SW_CRC_METHOD_SLICE8
+#define sw_crc16 sw_crc16_slice8
+#define sw_crc32 sw_crc32_slice8
+#else
+#error "Unknown SW_CRC_METHOD"
+#endif
+
+#endif // __SW_CRC_H__
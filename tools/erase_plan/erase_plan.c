@@ -0,0 +1,296 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "erase_plan.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+    kSfdp_Signature      = 0x50444653,  //!< 'SFDP'
+    kSfdp_BfptMinDwords  = 9,           //!< JESD216 BFPT, density and erase types
+    kSfdp_BfptTimeDwords = 16,          //!< JESD216A BFPT, typical times
+    kSfdp_MaxEraseSize   = 1024 * 1024, //!< Erase types from 1MB on are not used as block erase
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t sfdp_get32(const uint8_t *src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+static int range_compare(const void *a, const void *b)
+{
+    const erase_plan_range_t *x = (const erase_plan_range_t *)a;
+    const erase_plan_range_t *y = (const erase_plan_range_t *)b;
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+// Sort the ranges and merge the ones that overlap or touch, returns the new count
+static uint32_t range_merge(erase_plan_range_t *ranges, uint32_t count)
+{
+    uint32_t merged = 0;
+
+    qsort(ranges, count, sizeof(ranges[0]), range_compare);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (ranges[i].start == ranges[i].end)
+        {
+            continue;
+        }
+        if (merged && (ranges[i].start <= ranges[merged - 1].end))
+        {
+            if (ranges[i].end > ranges[merged - 1].end)
+            {
+                ranges[merged - 1].end = ranges[i].end;
+            }
+            continue;
+        }
+        ranges[merged++] = ranges[i];
+    }
+    return merged;
+}
+
+static bool is_erase_type_usable(uint32_t erase_size, uint32_t offset, uint32_t remaining_size)
+{
+    return (erase_size != 0) && !(offset & (erase_size - 1)) && (remaining_size >= erase_size);
+}
+
+// Same choice as flexspi_nor_pick_erase_type of the middleware, for uniform devices the block size is left 0
+static uint64_t get_block_plan_ms(const erase_plan_device_t *device, uint32_t offset, uint32_t end)
+{
+    uint64_t timeMs = 0;
+
+    while (offset < end)
+    {
+        uint32_t remaining_size = end - offset;
+        if (is_erase_type_usable(device->blockSize, offset, remaining_size))
+        {
+            timeMs += device->blockEraseMs;
+            offset += device->blockSize;
+        }
+        else if (is_erase_type_usable(device->halfBlockSize, offset, remaining_size))
+        {
+            timeMs += device->halfBlockEraseMs;
+            offset += device->halfBlockSize;
+        }
+        else
+        {
+            timeMs += device->sectorEraseMs;
+            offset += device->sectorSize;
+        }
+    }
+    return timeMs;
+}
+
+// See erase_plan.h for more details.
+bool erase_plan_parse_sfdp(const uint8_t *sfdp, uint32_t size, uint32_t baseAddress, erase_plan_device_t *device)
+{
+    static const uint32_t k_erase_time_units_ms[]      = { 1, 16, 128, 1000 };
+    static const uint32_t k_chip_erase_time_units_ms[] = { 16, 256, 4000, 64000 };
+    uint32_t dw[kSfdp_BfptTimeDwords];
+
+    memset(device, 0, sizeof(*device));
+    device->baseAddress = baseAddress;
+    if ((size < 16) || (sfdp_get32(sfdp) != kSfdp_Signature))
+    {
+        return false;
+    }
+
+    // Parameter header 0 is the BFPT: ID LSB 0x00, ID MSB 0xFF, length in DWORDs and table pointer
+    const uint8_t *header = &sfdp[8];
+    uint32_t dwords       = header[3];
+    uint32_t pointer      = header[4] | ((uint32_t)header[5] << 8) | ((uint32_t)header[6] << 16);
+    if ((header[0] != 0x00) || (header[7] != 0xFF) || (dwords < kSfdp_BfptMinDwords) || (pointer >= size) ||
+        ((size - pointer) / 4 < kSfdp_BfptMinDwords))
+    {
+        return false;
+    }
+    if (dwords > kSfdp_BfptTimeDwords)
+    {
+        dwords = kSfdp_BfptTimeDwords;
+    }
+    if (dwords > (size - pointer) / 4)
+    {
+        dwords = (size - pointer) / 4;
+    }
+    memset(dw, 0, sizeof(dw));
+    for (uint32_t i = 0; i < dwords; i++)
+    {
+        dw[i] = sfdp_get32(&sfdp[pointer + i * 4]);
+    }
+
+    // DWORD2: density in bits
+    if (dw[1] & 0x80000000u)
+    {
+        uint32_t shift = dw[1] & 0x7FFFFFFFu;
+        device->size   = (shift >= 35) ? 0 : (uint32_t)((1ull << shift) / 8u);
+    }
+    else
+    {
+        device->size = (uint32_t)(((uint64_t)dw[1] + 1u) / 8u);
+    }
+
+    // DWORD8-9: 4 erase types as power of 2 sizes, 0 if unused
+    uint32_t eraseSize[4] = { 0 };
+    for (uint32_t index = 0; index < 4; index++)
+    {
+        uint32_t shift   = (dw[7 + index / 2] >> (16 * (index % 2))) & 0xFF;
+        eraseSize[index] = ((shift != 0) && (shift < 32)) ? (1u << shift) : 0;
+        if (eraseSize[index] && (!device->sectorSize || (eraseSize[index] < device->sectorSize)))
+        {
+            device->sectorSize = eraseSize[index];
+        }
+        if ((eraseSize[index] > device->blockSize) && (eraseSize[index] < kSfdp_MaxEraseSize))
+        {
+            device->blockSize = eraseSize[index];
+        }
+    }
+    for (uint32_t index = 0; index < 4; index++)
+    {
+        if ((eraseSize[index] > device->sectorSize) && (eraseSize[index] < device->blockSize) &&
+            (eraseSize[index] > device->halfBlockSize))
+        {
+            device->halfBlockSize = eraseSize[index];
+        }
+    }
+    if ((device->sectorSize == 0) || (device->size == 0))
+    {
+        return false;
+    }
+    if (device->blockSize == device->sectorSize)
+    {
+        device->blockSize = 0;
+    }
+
+    // DWORD10: 5-bit count and 2-bit unit per erase type, DWORD11: chip erase time
+    if (dwords >= kSfdp_BfptTimeDwords)
+    {
+        for (uint32_t index = 0; index < 4; index++)
+        {
+            uint32_t timing = (dw[9] >> (4 + 7 * index)) & 0x7F;
+            uint32_t timeMs = ((timing & 0x1F) + 1) * k_erase_time_units_ms[timing >> 5];
+            if (eraseSize[index] == 0)
+            {
+                continue;
+            }
+            if (eraseSize[index] == device->sectorSize)
+            {
+                device->sectorEraseMs = timeMs;
+            }
+            if (eraseSize[index] == device->halfBlockSize)
+            {
+                device->halfBlockEraseMs = timeMs;
+            }
+            if (eraseSize[index] == device->blockSize)
+            {
+                device->blockEraseMs = timeMs;
+            }
+        }
+        uint32_t chipTiming = (dw[10] >> 24) & 0x7F;
+        device->chipEraseMs = ((chipTiming & 0x1F) + 1) * k_chip_erase_time_units_ms[chipTiming >> 5];
+    }
+
+    return true;
+}
+
+// See erase_plan.h for more details.
+uint64_t erase_plan_get_extent_ms(const erase_plan_device_t *device, uint32_t start, uint32_t end)
+{
+    uint32_t offset = start - device->baseAddress;
+    uint32_t limit  = end - device->baseAddress;
+    uint64_t timeMs = get_block_plan_ms(device, offset, limit);
+
+    // The algorithm erases the whole device by chip erase unless the other erases are faster
+    if ((offset == 0) && (limit == device->size) && (device->chipEraseMs <= timeMs))
+    {
+        timeMs = device->chipEraseMs;
+    }
+    return timeMs;
+}
+
+// See erase_plan.h for more details.
+bool erase_plan_build(const erase_plan_device_t *device,
+                      erase_plan_range_t *ranges,
+                      uint32_t rangeCount,
+                      bool keepOutside,
+                      erase_plan_t *plan)
+{
+    uint32_t deviceEnd = device->baseAddress + device->size;
+    uint32_t mask      = device->sectorSize - 1u;
+    uint32_t count;
+
+    memset(plan, 0, sizeof(*plan));
+    for (uint32_t i = 0; i < rangeCount; i++)
+    {
+        if ((ranges[i].start < device->baseAddress) || (ranges[i].end > deviceEnd) ||
+            (ranges[i].start > ranges[i].end))
+        {
+            return false;
+        }
+    }
+
+    count = range_merge(ranges, rangeCount);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        plan->imageBytes += ranges[i].end - ranges[i].start;
+        ranges[i].start = device->baseAddress + ((ranges[i].start - device->baseAddress) & ~mask);
+        ranges[i].end   = device->baseAddress + ((ranges[i].end - device->baseAddress + mask) & ~mask);
+    }
+    count = range_merge(ranges, count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        plan->sectorMs += (uint64_t)((ranges[i].end - ranges[i].start) / device->sectorSize) * device->sectorEraseMs;
+    }
+
+    // Erasing the gap between two extents pays when it lets block erases replace the sector erases around it
+    uint32_t merged = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!keepOutside && merged)
+        {
+            erase_plan_range_t *last = &ranges[merged - 1];
+            uint64_t apartMs = erase_plan_get_extent_ms(device, last->start, last->end) +
+                               erase_plan_get_extent_ms(device, ranges[i].start, ranges[i].end);
+            if (erase_plan_get_extent_ms(device, last->start, ranges[i].end) <= apartMs)
+            {
+                last->end = ranges[i].end;
+                continue;
+            }
+        }
+        ranges[merged++] = ranges[i];
+    }
+    count = merged;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        plan->plannedMs += erase_plan_get_extent_ms(device, ranges[i].start, ranges[i].end);
+        plan->erasedBytes += ranges[i].end - ranges[i].start;
+    }
+
+    uint64_t wholeMs = erase_plan_get_extent_ms(device, device->baseAddress, deviceEnd);
+    if (count && (wholeMs < plan->plannedMs) && !keepOutside)
+    {
+        count             = 1;
+        ranges[0].start   = device->baseAddress;
+        ranges[0].end     = deviceEnd;
+        plan->plannedMs   = wholeMs;
+        plan->erasedBytes = device->size;
+    }
+
+    plan->extents     = ranges;
+    plan->extentCount = count;
+    plan->wholeDevice = (count == 1) && (ranges[0].start == device->baseAddress) && (ranges[0].end == deviceEnd);
+    return true;
+}
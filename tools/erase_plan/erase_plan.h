@@ -0,0 +1,89 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __ERASE_PLAN_H__
+#define __ERASE_PLAN_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Erase types of a serial NOR device and their typical times
+//!
+//! Sizes and times are the ones flexspi_nor_flash keeps in its config block: sector is the smallest erase type
+//! of SFDP, block the largest one under 1MB and half block the one between them, 0 if there is none.
+typedef struct _erase_plan_device
+{
+    uint32_t baseAddress;      //!< Address of the device in the memory map, e.g. 0x60000000
+    uint32_t size;             //!< Device size in bytes
+    uint32_t sectorSize;       //!< Smallest erase size, the FlashDev sector
+    uint32_t halfBlockSize;    //!< 0 if the device has none
+    uint32_t blockSize;        //!< 0 if the device has none
+    uint32_t sectorEraseMs;    //!< Typical erase times, 0 if unknown
+    uint32_t halfBlockEraseMs;
+    uint32_t blockEraseMs;
+    uint32_t chipEraseMs;
+} erase_plan_device_t;
+
+//!@brief Address range [start, end)
+typedef struct _erase_plan_range
+{
+    uint32_t start;
+    uint32_t end;
+} erase_plan_range_t;
+
+//!@brief Erase plan of an image
+typedef struct _erase_plan
+{
+    bool wholeDevice;            //!< The plan is one extent over the whole device
+    erase_plan_range_t *extents; //!< Sector aligned extents in ascending order, one range erase each
+    uint32_t extentCount;
+    uint64_t imageBytes;  //!< Bytes the image occupies
+    uint64_t erasedBytes; //!< Bytes the plan erases
+    uint64_t sectorMs;    //!< One sector erase per sector the image touches, as EraseSector does
+    uint64_t plannedMs;   //!< Erase types the algorithm picks for the extents
+} erase_plan_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//!@brief Get the erase types and typical times of a device from its SFDP, returns false if it has no valid BFPT
+//!
+//! sfdp holds the SFDP space from address 0. Decodes the density, the erase types of DWORD8-9, their typical
+//! times in DWORD10 and the typical chip erase time in DWORD11 of the Basic Flash Parameter Table (JESD216).
+bool erase_plan_parse_sfdp(const uint8_t *sfdp, uint32_t size, uint32_t baseAddress, erase_plan_device_t *device);
+
+//!@brief Typical time of the erases the algorithm picks for [start, end)
+//!
+//! Mirrors flexspi_nor_flash_erase: the largest block, half block or sector erase aligned at each address, and
+//! for the whole device the fastest of that and a chip erase.
+uint64_t erase_plan_get_extent_ms(const erase_plan_device_t *device, uint32_t start, uint32_t end);
+
+//!@brief Build the cheapest erase plan of an image
+//!
+//! ranges holds the rangeCount address ranges the image occupies, in any order, and receives the extents.
+//! With keepOutside the plan only erases the sectors the image touches. Otherwise the data outside the image
+//! may go: two extents are merged when erasing the gap costs less than it saves, and the plan becomes the
+//! whole device when that is faster. Returns false if a range is outside the device.
+bool erase_plan_build(const erase_plan_device_t *device,
+                      erase_plan_range_t *ranges,
+                      uint32_t rangeCount,
+                      bool keepOutside,
+                      erase_plan_t *plan);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // __ERASE_PLAN_H__
@@ -0,0 +1,390 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "erase_plan.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Device base address and load address of BIN images, can be overridden by -b
+#if !defined(ERASE_PLAN_BASE_ADDRESS)
+#define ERASE_PLAN_BASE_ADDRESS (0x60000000u)
+#endif
+
+//!@brief Largest SFDP dump read by -s
+#define ERASE_PLAN_SFDP_SIZE (4096u)
+
+//!@brief Ranges an image occupies
+typedef struct _image_ranges
+{
+    erase_plan_range_t *ranges;
+    uint32_t count;
+    uint32_t capacity;
+} image_ranges_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t get_le32(const uint8_t *src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+static uint32_t get_le16(const uint8_t *src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8);
+}
+
+// Add [start, start + size), extending the last range when it follows it as HEX records do
+static int image_add(image_ranges_t *image, uint32_t start, uint32_t size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+    if (image->count && (image->ranges[image->count - 1].end == start))
+    {
+        image->ranges[image->count - 1].end += size;
+        return 0;
+    }
+    if (image->count == image->capacity)
+    {
+        uint32_t capacity = image->capacity ? (2u * image->capacity) : 64u;
+        erase_plan_range_t *ranges =
+            (erase_plan_range_t *)realloc(image->ranges, capacity * sizeof(erase_plan_range_t));
+        if (ranges == NULL)
+        {
+            return -1;
+        }
+        image->ranges   = ranges;
+        image->capacity = capacity;
+    }
+    image->ranges[image->count].start = start;
+    image->ranges[image->count].end   = start + size;
+    image->count++;
+    return 0;
+}
+
+static uint8_t *read_file(const char *path, uint32_t *size)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t *data = NULL;
+    long length;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    if ((fseek(file, 0, SEEK_END) == 0) && ((length = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0))
+    {
+        data = (uint8_t *)malloc((size_t)length + 1u);
+        if ((data != NULL) && (fread(data, 1, (size_t)length, file) != (size_t)length))
+        {
+            free(data);
+            data = NULL;
+        }
+        if (data != NULL)
+        {
+            data[length] = 0;
+            *size        = (uint32_t)length;
+        }
+    }
+    fclose(file);
+    return data;
+}
+
+// PT_LOAD segments with file content, at their physical (load) address
+static int parse_elf(const uint8_t *data, uint32_t size, image_ranges_t *image)
+{
+    if ((size < 52) || (data[4] != 1) || (data[5] != 1))
+    {
+        fprintf(stderr, "Only 32-bit little endian ELF files are supported\n");
+        return -1;
+    }
+    uint32_t phoff     = get_le32(&data[28]);
+    uint32_t phentsize = get_le16(&data[42]);
+    uint32_t phnum     = get_le16(&data[44]);
+    if ((phentsize < 32) || (phoff > size) || ((uint64_t)phnum * phentsize > size - phoff))
+    {
+        fprintf(stderr, "Truncated ELF program headers\n");
+        return -1;
+    }
+    for (uint32_t i = 0; i < phnum; i++)
+    {
+        const uint8_t *ph = &data[phoff + i * phentsize];
+        if ((get_le32(&ph[0]) == 1) && image_add(image, get_le32(&ph[12]), get_le32(&ph[16])))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int hex_digit(char digit)
+{
+    if ((digit >= '0') && (digit <= '9'))
+    {
+        return digit - '0';
+    }
+    digit = (char)tolower((unsigned char)digit);
+    return ((digit >= 'a') && (digit <= 'f')) ? (digit - 'a' + 10) : -1;
+}
+
+// Value of the two hex digits at text, -1 if they are not, the text ends with a NUL
+static int hex_byte(const char *text)
+{
+    int high = hex_digit(text[0]);
+    int low  = (high < 0) ? -1 : hex_digit(text[1]);
+    return (low < 0) ? -1 : ((high << 4) | low);
+}
+
+// Data records of an Intel HEX file, with extended segment and linear addresses
+static int parse_hex(const char *text, image_ranges_t *image)
+{
+    uint32_t upper = 0;
+    uint32_t line  = 0;
+
+    while (*text != '\0')
+    {
+        const char *record = strchr(text, ':');
+        uint8_t bytes[256 + 5];
+        uint32_t count;
+
+        if (record == NULL)
+        {
+            break;
+        }
+        line++;
+        int length = hex_byte(record + 1);
+        if (length < 0)
+        {
+            fprintf(stderr, "Invalid HEX record %u\n", line);
+            return -1;
+        }
+        count = (uint32_t)length + 5u;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            int value = hex_byte(record + 1 + 2 * i);
+            if (value < 0)
+            {
+                fprintf(stderr, "Invalid HEX record %u\n", line);
+                return -1;
+            }
+            bytes[i] = (uint8_t)value;
+        }
+        text = record + 1 + 2 * count;
+
+        uint32_t offset = ((uint32_t)bytes[1] << 8) | bytes[2];
+        switch (bytes[3])
+        {
+            case 0x00:
+                if (image_add(image, upper + offset, (uint32_t)length))
+                {
+                    return -1;
+                }
+                break;
+            case 0x01:
+                return 0;
+            case 0x02:
+                upper = (((uint32_t)bytes[4] << 8) | bytes[5]) << 4;
+                break;
+            case 0x04:
+                upper = (((uint32_t)bytes[4] << 8) | bytes[5]) << 16;
+                break;
+            default:
+                // Start addresses
+                break;
+        }
+    }
+    return 0;
+}
+
+static int parse_image(const char *path, uint32_t baseAddress, image_ranges_t *image)
+{
+    uint32_t size;
+    uint8_t *data = read_file(path, &size);
+    int status;
+
+    if (data == NULL)
+    {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return -1;
+    }
+    if ((size >= 4) && (memcmp(data, "\x7F" "ELF", 4) == 0))
+    {
+        status = parse_elf(data, size, image);
+    }
+    else if ((size >= 1) && (data[0] == ':'))
+    {
+        status = parse_hex((const char *)data, image);
+    }
+    else
+    {
+        status = image_add(image, baseAddress, size);
+    }
+    free(data);
+    return status;
+}
+
+static int parse_list(const char *text, uint32_t *values, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        char *end;
+        values[i] = (uint32_t)strtoul(text, &end, 0);
+        if ((end == text) || ((*end != ',') && (*end != '\0')) || ((*end == '\0') && (i != count - 1)))
+        {
+            return -1;
+        }
+        text = end + 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    erase_plan_device_t device = { 0 };
+    image_ranges_t image       = { 0 };
+    erase_plan_t plan;
+    uint32_t baseAddress       = ERASE_PLAN_BASE_ADDRESS;
+    const char *sfdpPath       = NULL;
+    const char *scriptPath     = NULL;
+    uint32_t sizes[4]          = { 0 };
+    uint32_t times[4]          = { 0 };
+    bool hasSizes              = false;
+    bool hasTimes              = false;
+    bool keepOutside           = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:s:d:t:kj:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                baseAddress = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sfdpPath = optarg;
+                break;
+            case 'd':
+                hasSizes = (parse_list(optarg, sizes, 4) == 0);
+                break;
+            case 't':
+                hasTimes = (parse_list(optarg, times, 4) == 0);
+                break;
+            case 'k':
+                keepOutside = true;
+                break;
+            case 'j':
+                scriptPath = optarg;
+                break;
+            default:
+                optind = argc + 1;
+                break;
+        }
+    }
+    if ((optind >= argc) || (!sfdpPath && !(hasSizes && hasTimes)))
+    {
+        printf("Usage: %s [-b base] [-k] [-j jlink script] (-s sfdp.bin | -d size,sector,halfblock,block\n"
+               "       -t sector_ms,halfblock_ms,block_ms,chip_ms) image...\n",
+               argv[0]);
+        return 2;
+    }
+
+    if (sfdpPath != NULL)
+    {
+        uint32_t size = 0;
+        uint8_t *sfdp = read_file(sfdpPath, &size);
+        if (size > ERASE_PLAN_SFDP_SIZE)
+        {
+            size = ERASE_PLAN_SFDP_SIZE;
+        }
+        bool valid = (sfdp != NULL) && erase_plan_parse_sfdp(sfdp, size, baseAddress, &device);
+        free(sfdp);
+        if (!valid)
+        {
+            fprintf(stderr, "No Basic Flash Parameter Table in %s\n", sfdpPath);
+            return 1;
+        }
+    }
+    // Explicit values override the SFDP ones
+    if (hasSizes)
+    {
+        device.baseAddress   = baseAddress;
+        device.size          = sizes[0];
+        device.sectorSize    = sizes[1];
+        device.halfBlockSize = sizes[2];
+        device.blockSize     = sizes[3];
+    }
+    if (hasTimes)
+    {
+        device.sectorEraseMs    = times[0];
+        device.halfBlockEraseMs = times[1];
+        device.blockEraseMs     = times[2];
+        device.chipEraseMs      = times[3];
+    }
+    if ((device.size == 0) || (device.sectorSize == 0) || (device.sectorSize & (device.sectorSize - 1u)))
+    {
+        fprintf(stderr, "Invalid device size or sector size\n");
+        return 2;
+    }
+
+    for (int i = optind; i < argc; i++)
+    {
+        if (parse_image(argv[i], baseAddress, &image))
+        {
+            return 1;
+        }
+    }
+    if (!erase_plan_build(&device, image.ranges, image.count, keepOutside, &plan))
+    {
+        fprintf(stderr, "The image does not fit in the device at 0x%08x, %u bytes\n", baseAddress, device.size);
+        return 1;
+    }
+
+    printf("Device: 0x%08x, %u bytes, sector %u (%u ms), half block %u (%u ms), block %u (%u ms), chip %u ms\n",
+           device.baseAddress, device.size, device.sectorSize, device.sectorEraseMs, device.halfBlockSize,
+           device.halfBlockEraseMs, device.blockSize, device.blockEraseMs, device.chipEraseMs);
+    printf("Image: %llu bytes, %s\n", (unsigned long long)plan.imageBytes,
+           keepOutside ? "data outside it is kept" : "data outside it may be erased");
+    printf("%-8s %10s %10s %10s %12s\n", "extent", "start", "end", "bytes", "ms");
+    for (uint32_t i = 0; i < plan.extentCount; i++)
+    {
+        const erase_plan_range_t *extent = &plan.extents[i];
+        printf("%-8u 0x%08x 0x%08x %10u %12llu\n", i, extent->start, extent->end, extent->end - extent->start,
+               (unsigned long long)erase_plan_get_extent_ms(&device, extent->start, extent->end));
+    }
+    printf("Plan: %u extent(s)%s, %llu bytes erased, %llu ms, sector by sector %llu ms\n", plan.extentCount,
+           plan.wholeDevice ? " (whole device)" : "", (unsigned long long)plan.erasedBytes,
+           (unsigned long long)plan.plannedMs, (unsigned long long)plan.sectorMs);
+
+    // J-Link Commander erases each range through the SEGGER_OPEN_Erase entry of the flash algorithm
+    if (scriptPath != NULL)
+    {
+        FILE *script = fopen(scriptPath, "w");
+        if (script == NULL)
+        {
+            fprintf(stderr, "Cannot write %s\n", scriptPath);
+            return 1;
+        }
+        for (uint32_t i = 0; i < plan.extentCount; i++)
+        {
+            fprintf(script, "erase 0x%08x 0x%08x\n", plan.extents[i].start, plan.extents[i].end);
+        }
+        fclose(script);
+    }
+
+    free(image.ranges);
+    return 0;
+}
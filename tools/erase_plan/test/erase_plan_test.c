@@ -0,0 +1,199 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "erase_plan.h"
+#include "nor_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief FlexSPI AHB window the images are linked at
+#define ERASE_PLAN_TEST_BASE (0x60000000u)
+
+//!@brief Most ranges of one layout
+#define ERASE_PLAN_TEST_MAX_RANGES (8)
+
+//!@brief Image layout and the plan it must get
+typedef struct _erase_plan_case
+{
+    const char *name;
+    const char *part;
+    bool keepOutside;
+    erase_plan_range_t ranges[ERASE_PLAN_TEST_MAX_RANGES]; //!< Offsets from the device start, ends with { 0, 0 }
+    uint32_t extentCount;                                  //!< Expected extents
+    bool wholeDevice;                                      //!< Expected whole device plan
+} erase_plan_case_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static const erase_plan_case_t s_cases[] = {
+    // RT1050 EVKB XIP application: FlexSPI config block, IVT and boot data, then the application
+    { "rt1050 xip", "is25wp256d", false,
+      { { 0x00000000u, 0x00000200u }, { 0x00001000u, 0x00001030u }, { 0x00002000u, 0x0004A3C0u } }, 1, false },
+    // MCUboot on RT1020: bootloader and primary slot, the secondary slot and scratch area must stay
+    { "mcuboot", "is25lp064a", true,
+      { { 0x00000000u, 0x0000C800u }, { 0x00040000u, 0x000B2400u }, { 0x003F0000u, 0x003F0020u } }, 3, false },
+    // Same image when the rest of the device may go: the gaps cost more to erase than they save
+    { "mcuboot all", "is25lp064a", false,
+      { { 0x00000000u, 0x0000C800u }, { 0x00040000u, 0x000B2400u }, { 0x003F0000u, 0x003F0020u } }, 3, false },
+    // 48MB of resources on a 64MB device: 64KB blocks instead of 12288 sectors
+    { "48MB of 64MB", "is25wp512m", false, { { 0x00000000u, 0x03000000u } }, 1, false },
+    // Whole 16MB device on RT1010: the chip erase is faster than the blocks
+    { "full 16MB", "at25sf128a", false, { { 0x00000000u, 0x01000000u } }, 1, true },
+    // 15MB of 16MB: erasing the last MB too lets the chip erase replace the blocks
+    { "15MB of 16MB", "at25sf128a", false, { { 0x00000000u, 0x00F00000u } }, 1, true },
+    // Same with the last MB kept
+    { "15MB kept", "at25sf128a", true, { { 0x00000000u, 0x00F00000u } }, 1, false },
+    // Whole 32MB device: SFDP gives 90s for the chip erase, the 64KB blocks take less
+    { "full 32MB", "is25wp256d", false, { { 0x00000000u, 0x02000000u } }, 1, true },
+    // HEX records out of order with small holes, merged into one extent
+    { "hex records", "w25q64jv", false,
+      { { 0x00010000u, 0x00018000u }, { 0x00000000u, 0x00008000u }, { 0x00008100u, 0x00010000u },
+        { 0x00018000u, 0x0001F000u } }, 1, false },
+    // Application and a 4KB settings sector at the device end
+    { "settings", "gd25q64c", false, { { 0x00000000u, 0x00021000u }, { 0x007FF000u, 0x00800000u } }, 2, false },
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+// SFDP of the part as the serial NOR model publishes it
+static bool test_get_device(const nor_emu_part_t *part, erase_plan_device_t *device)
+{
+    static nor_emu_device_t s_dev;
+    uint8_t *array = (uint8_t *)malloc(part->size);
+    bool status;
+
+    if (array == NULL)
+    {
+        return false;
+    }
+    nor_emu_init(&s_dev, part, array);
+    status = erase_plan_parse_sfdp(s_dev.sfdp, sizeof(s_dev.sfdp), ERASE_PLAN_TEST_BASE, device);
+    free(array);
+    return status;
+}
+
+// Typical times SFDP encodes are rounded up to its units, never down
+static bool test_sfdp(void)
+{
+    bool pass = true;
+
+    printf("%-12s %10s %8s %8s %8s %8s %8s %8s %10s\n", "part", "size", "sector", "half", "block", "tSE", "tBE32",
+           "tBE64", "tCE");
+    for (const nor_emu_part_t *part = nor_emu_get_parts(); part->name != NULL; part++)
+    {
+        erase_plan_device_t device;
+        bool valid = test_get_device(part, &device);
+
+        valid = valid && (device.size == part->size) && (device.sectorSize == 4096u) &&
+                (device.halfBlockSize == 32768u) && (device.blockSize == 65536u) &&
+                (device.sectorEraseMs * 1000u >= part->tSE_us) && (device.halfBlockEraseMs * 1000u >= part->tBE32_us) &&
+                (device.blockEraseMs * 1000u >= part->tBE64_us) && (device.chipEraseMs >= part->tCE_ms);
+        printf("%-12s %10u %8u %8u %8u %8u %8u %8u %10u %s\n", part->name, device.size, device.sectorSize,
+               device.halfBlockSize, device.blockSize, device.sectorEraseMs, device.halfBlockEraseMs,
+               device.blockEraseMs, device.chipEraseMs, valid ? "" : "FAIL");
+        pass = pass && valid;
+    }
+    return pass;
+}
+
+static bool test_case(const erase_plan_case_t *item)
+{
+    const nor_emu_part_t *part = nor_emu_find_part(item->part);
+    erase_plan_range_t ranges[ERASE_PLAN_TEST_MAX_RANGES];
+    erase_plan_device_t device;
+    erase_plan_t plan;
+    uint32_t count = 0;
+
+    if ((part == NULL) || !test_get_device(part, &device))
+    {
+        printf("%-14s no device %s FAIL\n", item->name, item->part);
+        return false;
+    }
+    while ((count < ERASE_PLAN_TEST_MAX_RANGES) && (item->ranges[count].end != 0))
+    {
+        ranges[count].start = ERASE_PLAN_TEST_BASE + item->ranges[count].start;
+        ranges[count].end   = ERASE_PLAN_TEST_BASE + item->ranges[count].end;
+        count++;
+    }
+    bool pass = erase_plan_build(&device, ranges, count, item->keepOutside, &plan);
+
+    // Every byte of the image is erased, extents are sector aligned, ascending and apart, and the plan never
+    // takes longer than the sector by sector erase
+    for (uint32_t i = 0; pass && (item->ranges[i].end != 0); i++)
+    {
+        uint32_t start = ERASE_PLAN_TEST_BASE + item->ranges[i].start;
+        uint32_t end   = ERASE_PLAN_TEST_BASE + item->ranges[i].end;
+        bool covered   = false;
+        for (uint32_t j = 0; j < plan.extentCount; j++)
+        {
+            covered = covered || ((start >= plan.extents[j].start) && (end <= plan.extents[j].end));
+        }
+        pass = covered;
+    }
+    for (uint32_t j = 0; pass && (j < plan.extentCount); j++)
+    {
+        pass = !((plan.extents[j].start | plan.extents[j].end) & (device.sectorSize - 1u)) &&
+               ((j == 0) || (plan.extents[j].start > plan.extents[j - 1].end));
+    }
+    pass = pass && (plan.plannedMs <= plan.sectorMs) && (plan.extentCount == item->extentCount) &&
+           (plan.wholeDevice == item->wholeDevice);
+    // With keepOutside nothing but the sectors of the image is erased
+    if (pass && item->keepOutside)
+    {
+        pass = (plan.erasedBytes * device.sectorEraseMs == plan.sectorMs * device.sectorSize);
+    }
+
+    double saved = plan.sectorMs ? 100.0 * (double)(plan.sectorMs - plan.plannedMs) / plan.sectorMs : 0.0;
+    printf("%-14s %-12s %12llu %12llu %7u %12llu %12llu %7.1f%% %s\n", item->name, item->part,
+           (unsigned long long)plan.imageBytes, (unsigned long long)plan.erasedBytes, plan.extentCount,
+           (unsigned long long)plan.sectorMs, (unsigned long long)plan.plannedMs, saved, pass ? "" : "FAIL");
+    return pass;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    failures += test_sfdp() ? 0 : 1;
+
+    printf("\n%-14s %-12s %12s %12s %7s %12s %12s %8s\n", "layout", "part", "image", "erased", "extents",
+           "sector_ms", "plan_ms", "saved");
+    for (uint32_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++)
+    {
+        failures += test_case(&s_cases[i]) ? 0 : 1;
+    }
+
+    // Ranges outside the device are refused
+    {
+        erase_plan_device_t device;
+        erase_plan_range_t range = { ERASE_PLAN_TEST_BASE + 0x007FF000u, ERASE_PLAN_TEST_BASE + 0x00801000u };
+        erase_plan_t plan;
+        if (!test_get_device(nor_emu_find_part("is25lp064a"), &device) ||
+            erase_plan_build(&device, &range, 1, false, &plan))
+        {
+            printf("range outside the device was accepted FAIL\n");
+            failures++;
+        }
+    }
+
+    if (failures)
+    {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,554 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FlashOS.H"
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1, can be overridden by -p
+#if !defined(FLASH_SUITE_PART)
+#define FLASH_SUITE_PART "at25sf128a"
+#endif
+
+//!@brief Bytes programmed sequentially from the device start, can be overridden by -s
+#if !defined(FLASH_SUITE_SIZE)
+#define FLASH_SUITE_SIZE (1024u * 1024u)
+#endif
+
+//!@brief FlashDev pages programmed at random places behind the sequential image, can be overridden by -k
+#if !defined(FLASH_SUITE_SPARSE_PAGES)
+#define FLASH_SUITE_SPARSE_PAGES (64u)
+#endif
+
+//!@brief Percent of throughput lost against the baseline that fails the suite, can be overridden by -r
+#if !defined(FLASH_SUITE_THRESHOLD)
+#define FLASH_SUITE_THRESHOLD (5.0)
+#endif
+
+//!@brief Image programmed by the suite, placed below 4GB where the 32-bit eDMA addresses reach it
+#define FLASH_SUITE_IMAGE_ADDRESS (0x10000000u)
+
+//!@brief Longest line of a result file
+#define FLASH_SUITE_LINE_SIZE (256u)
+
+#if defined(FLEXSPI)
+#define FLASH_SUITE_BASE FLEXSPI_BASE
+#elif defined(FLEXSPI0)
+#define FLASH_SUITE_BASE FLEXSPI0_BASE
+#elif defined(FLEXSPI1)
+#define FLASH_SUITE_BASE FLEXSPI1_BASE
+#endif
+
+//!@brief FlexSPI instance used by the algorithm, FLEXSPI_NOR_INSTANCE of FlashPrg
+#if !defined(FLASH_SUITE_INSTANCE)
+#define FLASH_SUITE_INSTANCE (0)
+#endif
+
+//!@brief Result of one operation of the suite
+typedef struct _suite_result
+{
+    const char *op;
+    uint32_t bytes;
+    uint32_t calls; // FlashOS calls, each one a debugger round-trip on the target
+    uint64_t ps;
+    flexspi_emu_stats_t ctrl;
+    nor_emu_stats_t nor;
+} suite_result_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+extern struct FlashDevice const FlashDevice;
+extern int UnInit(unsigned long fnc);
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+static uint32_t s_seed = 0x12345678u;
+static uint64_t s_protocolErrors; // model protocol errors of the whole suite
+static uint64_t s_probeErrors;    // the ones of the read points Init tried while tuning the read clock
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t suite_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void suite_seed_reset_values(void)
+{
+#if defined(CCM_ANALOG_PFD_480_PFD0_FRAC_MASK)
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+#endif
+#if defined(CCM_CSCMR1_FLEXSPI_PODF_MASK)
+    CCM->CSCMR1 = 0x04900080u;
+#endif
+#if defined(CCM_CBCDR_IPG_PODF_MASK)
+    CCM->CBCDR = 0x000A8300u;
+#endif
+}
+
+// Bytes of one AHB read of the core: a line fill with the D-Cache on, a word without
+static uint32_t suite_ahb_access_size(void)
+{
+#if defined(SCB_CCR_DC_Msk)
+    if (SCB->CCR & SCB_CCR_DC_Msk)
+    {
+        return 32u;
+    }
+#endif
+    return 4u;
+}
+
+// D-Cache setup the algorithm must hand back as it found it: CCR.DC and CACR
+static uint64_t suite_cache_state(void)
+{
+#if defined(SCB_CCR_DC_Msk)
+    return ((uint64_t)(SCB->CCR & SCB_CCR_DC_Msk) << 32) | SCB->CACR;
+#else
+    return 0;
+#endif
+}
+
+static uint32_t suite_random(void)
+{
+    s_seed = s_seed * 1103515245u + 12345u;
+    return s_seed >> 8;
+}
+
+static void suite_begin(suite_result_t *result, const char *op, uint32_t bytes)
+{
+    memset(result, 0, sizeof(*result));
+    result->op    = op;
+    result->bytes = bytes;
+    flexspi_emu_reset_stats(s_ctrl);
+    memset(&s_nor->stats, 0, sizeof(s_nor->stats));
+    result->ps = flexspi_emu_now();
+}
+
+static void suite_end(suite_result_t *result)
+{
+    result->ps   = flexspi_emu_now() - result->ps;
+    result->ctrl = *flexspi_emu_get_stats(s_ctrl);
+    result->nor  = s_nor->stats;
+    s_protocolErrors += s_nor->stats.protocol_errors;
+}
+
+// Init, reading at a point the part does not support is expected while it tunes the read clock
+static int suite_init(unsigned long fnc)
+{
+    uint64_t errors = s_nor->stats.protocol_errors;
+    int status      = Init(FlashDevice.DevAdr, 0, fnc);
+
+    s_probeErrors += s_nor->stats.protocol_errors - errors;
+    return status;
+}
+
+static double suite_get_ms(const suite_result_t *result)
+{
+    return (double)result->ps / FLEXSPI_EMU_PS_PER_MS;
+}
+
+static double suite_get_mbps(uint32_t bytes, double ms)
+{
+    return (ms > 0.0) ? (double)bytes / (ms * 1000.0) : 0.0;
+}
+
+static void suite_print_header(void)
+{
+    printf("%-14s %10s %7s %12s %10s %8s %8s %8s %10s\n", "op", "bytes", "calls", "ms", "MB/s", "ip_cmds",
+           "lut_upd", "swreset", "polls");
+}
+
+static void suite_print(const suite_result_t *result)
+{
+    double ms = suite_get_ms(result);
+
+    printf("%-14s %10u %7u %12.3f %10.4f %8llu %8llu %8llu %10llu\n", result->op, result->bytes, result->calls, ms,
+           suite_get_mbps(result->bytes, ms), (unsigned long long)result->ctrl.ip_cmds,
+           (unsigned long long)result->ctrl.lut_unlocks, (unsigned long long)result->ctrl.swresets,
+           (unsigned long long)(result->nor.status_reads + result->ctrl.skipped_polls));
+}
+
+// One CSV line per operation: board,part,op,bytes,calls,ms,mb_per_s,ip_cmds,lut_upd,swreset,polls
+static void suite_save(FILE *file, const char *board, const char *part, const suite_result_t *result)
+{
+    double ms = suite_get_ms(result);
+
+    fprintf(file, "%s,%s,%s,%u,%u,%.6f,%.4f,%llu,%llu,%llu,%llu\n", board, part, result->op, result->bytes,
+            result->calls, ms, suite_get_mbps(result->bytes, ms), (unsigned long long)result->ctrl.ip_cmds,
+            (unsigned long long)result->ctrl.lut_unlocks, (unsigned long long)result->ctrl.swresets,
+            (unsigned long long)(result->nor.status_reads + result->ctrl.skipped_polls));
+}
+
+// Compare with the baseline line of the same board, part and op, false if the throughput dropped beyond threshold.
+// Operations without bytes (Init) compare their time.
+static bool suite_check(
+    const char *path, const char *board, const char *part, const suite_result_t *result, double threshold)
+{
+    FILE *file = fopen(path, "r");
+    char line[FLASH_SUITE_LINE_SIZE];
+    bool pass  = true;
+    bool found = false;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Cannot open the baseline %s\n", path);
+        return false;
+    }
+    while (!found && (fgets(line, sizeof(line), file) != NULL))
+    {
+        char lineBoard[64], linePart[32], lineOp[32];
+        unsigned int bytes;
+        double ms;
+
+        if ((sscanf(line, "%63[^,],%31[^,],%31[^,],%u,%*u,%lf", lineBoard, linePart, lineOp, &bytes, &ms) != 5) ||
+            strcmp(lineBoard, board) || strcmp(linePart, part) || strcmp(lineOp, result->op))
+        {
+            continue;
+        }
+        found        = true;
+        double newMs = suite_get_ms(result);
+        double loss; // percent, negative when faster
+        if (result->bytes && bytes)
+        {
+            double baseMbps = suite_get_mbps(bytes, ms);
+            double newMbps  = suite_get_mbps(result->bytes, newMs);
+            loss            = (baseMbps > 0.0) ? (1.0 - newMbps / baseMbps) * 100.0 : 0.0;
+        }
+        else
+        {
+            loss = (ms > 0.0) ? (newMs / ms - 1.0) * 100.0 : 0.0;
+        }
+        pass = (loss <= threshold);
+        printf("  %-14s baseline %12.3f ms, throughput %+8.2f%% %s\n", result->op, ms, -loss,
+               pass ? "ok" : "REGRESSION");
+    }
+    fclose(file);
+    if (!found)
+    {
+        printf("  %-14s not in the baseline\n", result->op);
+    }
+
+    return pass;
+}
+
+// Program the image one FlashDev page per call, the last call takes the rest the way the debugger does
+static int suite_program(uint32_t offset, const uint8_t *image, uint32_t size, uint32_t *calls)
+{
+    int status = 0;
+
+    for (uint32_t done = 0; (done < size) && !status; done += FlashDevice.szPage)
+    {
+        uint32_t bytes = size - done;
+        if (bytes > FlashDevice.szPage)
+        {
+            bytes = FlashDevice.szPage;
+        }
+        status = ProgramPage(FlashDevice.DevAdr + offset + done, bytes, (unsigned char *)&image[done]);
+        (*calls)++;
+    }
+    return status;
+}
+
+static void suite_usage(const char *name)
+{
+    printf("Usage: %s [-p part] [-s bytes] [-k pages] [-n board] [-o file] [-g file] [-r percent] [-x]\n", name);
+    printf("  -p part     serial NOR part connected to A1, default %s\n", FLASH_SUITE_PART);
+    printf("  -s bytes    bytes programmed sequentially, default %u\n", FLASH_SUITE_SIZE);
+    printf("  -k pages    FlashDev pages programmed at random places, default %u\n", FLASH_SUITE_SPARSE_PAGES);
+    printf("  -n board    board name of the result lines, default the FlashDev device name\n");
+    printf("  -o file     append the results to a CSV file\n");
+    printf("  -g file     fail if throughput dropped against the results of this CSV file\n");
+    printf("  -r percent  throughput loss that fails -g, default %.1f\n", FLASH_SUITE_THRESHOLD);
+    printf("  -x          exact polling, simulate every status read\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName     = FLASH_SUITE_PART;
+    const char *board        = FlashDevice.DevName;
+    const char *outputPath   = NULL;
+    const char *baselinePath = NULL;
+    uint32_t size            = FLASH_SUITE_SIZE;
+    uint32_t sparsePages     = FLASH_SUITE_SPARSE_PAGES;
+    double threshold         = FLASH_SUITE_THRESHOLD;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:k:n:o:g:r:xh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'k':
+                sparsePages = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                board = optarg;
+                break;
+            case 'o':
+                outputPath = optarg;
+                break;
+            case 'g':
+                baselinePath = optarg;
+                break;
+            case 'r':
+                threshold = strtod(optarg, NULL);
+                break;
+            case 'x':
+                flexspi_emu_set_fast_poll(false);
+                break;
+            default:
+                suite_usage(argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if (part == NULL)
+    {
+        fprintf(stderr, "Unknown part %s\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    suite_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl = flexspi_emu_attach(FLASH_SUITE_INSTANCE, FLASH_SUITE_BASE, FlashDevice.DevAdr,
+                                suite_get_serial_root_clock);
+#if defined(DMAMUX)
+    flexspi_emu_attach_dma(s_ctrl, DMA0_BASE, DMAMUX_BASE, kDmaRequestMuxFlexSPIRx, kDmaRequestMuxFlexSPITx);
+#endif
+    s_nor  = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if (s_nor == NULL)
+    {
+        return 1;
+    }
+
+    // Sequential image from the device start, sparse pages in the page slots behind it
+    uint32_t pageSize = FlashDevice.szPage;
+    uint32_t devSize  = (part->size < FlashDevice.szDev) ? part->size : FlashDevice.szDev;
+    size              = (size + pageSize - 1u) / pageSize * pageSize;
+    if (size > devSize / 2u)
+    {
+        size = devSize / 2u / pageSize * pageSize;
+    }
+    uint32_t slots = (devSize - size) / pageSize;
+    if (sparsePages > slots)
+    {
+        sparsePages = slots;
+    }
+    uint32_t sparseSize = sparsePages * pageSize;
+    uint32_t *slot      = (uint32_t *)malloc(slots * sizeof(uint32_t));
+    uint8_t *pattern    = (uint8_t *)flexspi_emu_map_region(FLASH_SUITE_IMAGE_ADDRESS, size + sparseSize);
+    if ((pattern == NULL) || (slot == NULL))
+    {
+        fprintf(stderr, "Cannot map the image at 0x%08x\n", FLASH_SUITE_IMAGE_ADDRESS);
+        return 1;
+    }
+    for (uint32_t i = 0; i < size + sparseSize; i++)
+    {
+        pattern[i] = (uint8_t)(suite_random() >> 8);
+    }
+    // Random order of distinct slots, a partial Fisher-Yates shuffle
+    for (uint32_t i = 0; i < slots; i++)
+    {
+        slot[i] = i;
+    }
+    for (uint32_t i = 0; i < sparsePages; i++)
+    {
+        uint32_t j = i + suite_random() % (slots - i);
+        uint32_t t = slot[i];
+        slot[i]    = slot[j];
+        slot[j]    = t;
+    }
+
+    FILE *output = NULL;
+    if (outputPath != NULL)
+    {
+        output = fopen(outputPath, "a");
+        if (output == NULL)
+        {
+            fprintf(stderr, "Cannot open %s\n", outputPath);
+            return 1;
+        }
+        if (ftell(output) == 0)
+        {
+            fprintf(output, "board,part,op,bytes,calls,ms,mb_per_s,ip_cmds,lut_upd,swreset,polls\n");
+        }
+    }
+
+    printf("Algorithm: %s, board %s\n", FlashDevice.DevName, board);
+    printf("Part: %s, %u bytes, page %u, sequential %u bytes, sparse %u pages\n", part->name, part->size, pageSize,
+           size, sparsePages);
+    suite_print_header();
+
+    const uint8_t *flash = (const uint8_t *)(uintptr_t)FlashDevice.DevAdr;
+    suite_result_t results[5];
+    uint32_t count      = 0;
+    int status          = 0;
+    uint64_t cacheState = suite_cache_state();
+
+    do
+    {
+        // Leave programmed content behind so that EraseChip has real work to do
+        memset(s_nor->array, 0x00, devSize);
+
+        suite_result_t *result = &results[count++];
+        suite_begin(result, "Init", 0);
+        status = suite_init(1);
+        result->calls++;
+        suite_end(result);
+        suite_print(result);
+        if (status)
+        {
+            fprintf(stderr, "Init failed\n");
+            break;
+        }
+
+        result = &results[count++];
+        suite_begin(result, "EraseChip", part->size);
+        status = EraseChip() || UnInit(1);
+        result->calls += 2;
+        suite_end(result);
+        suite_print(result);
+        if (status || (s_nor->array[0] != FlashDevice.valEmpty) ||
+            (s_nor->array[part->size - 1u] != FlashDevice.valEmpty))
+        {
+            fprintf(stderr, "EraseChip failed\n");
+            status = 1;
+            break;
+        }
+
+        result = &results[count++];
+        suite_begin(result, "ProgramSeq", size);
+        status = suite_init(2) || suite_program(0, pattern, size, &result->calls);
+        result->calls++;
+        suite_end(result);
+        suite_print(result);
+        if (status)
+        {
+            fprintf(stderr, "ProgramPage failed\n");
+            break;
+        }
+
+        // The last page programmed may still be busy, UnInit waits for it
+        result = &results[count++];
+        suite_begin(result, "ProgramSparse", sparseSize);
+        for (uint32_t i = 0; (i < sparsePages) && !status; i++)
+        {
+            status = suite_program(size + slot[i] * pageSize, &pattern[size + i * pageSize], pageSize,
+                                   &result->calls);
+        }
+        status = status || UnInit(2);
+        result->calls++;
+        suite_end(result);
+        suite_print(result);
+        if (status)
+        {
+            fprintf(stderr, "ProgramPage of sparse pages failed\n");
+            break;
+        }
+
+        // Verify through the AHB window, whose reads the model times from the state Init left
+        result = &results[count++];
+        suite_begin(result, "Verify", size + sparseSize);
+        status = suite_init(3);
+        result->calls++;
+        uint32_t accessSize = suite_ahb_access_size();
+        if (!status && (Verify(FlashDevice.DevAdr, size, pattern) != FlashDevice.DevAdr + size))
+        {
+            status = 1;
+        }
+        flexspi_emu_advance(flexspi_emu_ahb_read_time(s_ctrl, FlashDevice.DevAdr, size, accessSize));
+        result->calls++;
+        for (uint32_t i = 0; (i < sparsePages) && !status; i++)
+        {
+            uint32_t adr = FlashDevice.DevAdr + size + slot[i] * pageSize;
+            if (Verify(adr, pageSize, &pattern[size + i * pageSize]) != adr + pageSize)
+            {
+                status = 1;
+            }
+            flexspi_emu_advance(flexspi_emu_ahb_read_time(s_ctrl, adr, pageSize, accessSize));
+            result->calls++;
+        }
+        status = status || UnInit(3);
+        result->calls++;
+        suite_end(result);
+        suite_print(result);
+        if (status || memcmp(flash, pattern, size))
+        {
+            fprintf(stderr, "Verify failed\n");
+            status = 1;
+            break;
+        }
+    } while (0);
+
+    if ((s_protocolErrors > s_probeErrors) || s_nor->stats.unknown_cmds)
+    {
+        fprintf(stderr, "Serial NOR model reported %llu protocol errors outside Init, %llu unknown commands\n",
+                (unsigned long long)(s_protocolErrors - s_probeErrors),
+                (unsigned long long)s_nor->stats.unknown_cmds);
+        status = 1;
+    }
+    if (!status && (suite_cache_state() != cacheState))
+    {
+        fprintf(stderr, "UnInit did not restore the D-Cache setup\n");
+        status = 1;
+    }
+    if (!status && (output != NULL))
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            suite_save(output, board, part->name, &results[i]);
+        }
+    }
+    if (!status && (baselinePath != NULL))
+    {
+        printf("Baseline %s, threshold %.1f%%\n", baselinePath, threshold);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (!suite_check(baselinePath, board, part->name, &results[i], threshold))
+            {
+                status = 1;
+            }
+        }
+    }
+    if (output != NULL)
+    {
+        fclose(output);
+    }
+    free(slot);
+
+    return status ? 1 : 0;
+}
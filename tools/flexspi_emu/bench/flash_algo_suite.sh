@@ -0,0 +1,76 @@
+#!/bin/sh
+#
+# Copyright 2019 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Builds bench/flash_algo_suite.c with the Keil_JLink algorithm of every board on the shared middleware, runs it
+# against the model of the board flash and gates the throughput against bench/flash_algo_baseline.csv.
+#
+#   tools/flexspi_emu/bench/flash_algo_suite.sh              run and check, results in $BUILD/results.csv
+#   BASELINE= tools/flexspi_emu/bench/flash_algo_suite.sh    run only, e.g. to write a new baseline
+#
+# Environment: BUILD (build directory), BASELINE (CSV file, empty to skip the gate), THRESHOLD (percent),
+# CFLAGS_EXTRA (more compiler flags, e.g. -DBACKGROUND_PROGRAM=0), ARGS (more suite options).
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/../../.." && pwd)
+E=tools/flexspi_emu
+BUILD=${BUILD:-${TMPDIR:-/tmp}/flash_algo_suite}
+BASELINE=${BASELINE-$ROOT/$E/bench/flash_algo_baseline.csv}
+THRESHOLD=${THRESHOLD:-5}
+
+# board directory, device, CPU define, FlashPrg, FlashDev, part of the board, defines of the board project
+BOARDS="
+nxp_evkmimxrt1010_rev.c MIMXRT1011 CPU_MIMXRT1011DAE5A FlashPrg_at25sf128a.c FlashDev_at25sf128a.c at25sf128a
+nxp_evkmimxrt1020_rev.b MIMXRT1021 CPU_MIMXRT1021DAG5A FlashPrg_is25lp064a.c FlashDev_is25lp064a.c is25lp064a
+nxp_evkbmimxrt1050_rev.a1 MIMXRT1052 CPU_MIMXRT1052DVL6B FlashPrg_is25wp256.c FlashDev_is25wp256.c is25wp256d
+nxp_evkbmimxrt1050_rev.a1 MIMXRT1052 CPU_MIMXRT1052DVL6B FlashPrg_s26ks512s.c FlashDev_s26ks512s.c s26ks512s \
+    -DPROGRAM_PAGE_BUFFER_SIZE=512
+hon_rt1050_xproject MIMXRT1052 CPU_MIMXRT1052DVL6B FlashPrg_is25lp064.c FlashDev_is25lp064.c is25lp064a \
+    -DFLEXSPI_ENABLE_DDR_SAFE_CONFIG_FREQ=0
+"
+
+cd "$ROOT"
+mkdir -p "$BUILD"
+rm -f "$BUILD/results.csv"
+
+echo "$BOARDS" | while read -r board dev cpu prg flashdev part defines; do
+    [ -n "$board" ] || continue
+    B=boards/$board/flash_algo/Keil_JLink
+    OUT=$BUILD/$board
+    # CMSIS and the SDK device headers are vendor code written for the 32-bit target, as system headers their
+    # pointer casts do not warn on the 64-bit host. Warnings in the shared middleware and in the board sources fail
+    # the build.
+    CFLAGS="-O2 -Wall -Wextra -D$cpu $defines $CFLAGS_EXTRA -I$E/host -I$E -Imiddleware -I$B -isystem CMSIS/Include \
+            -isystem devices/$dev -isystem devices/$dev/drivers"
+
+    mkdir -p "$OUT"
+    rm -f "$OUT"/*.o
+    for f in middleware/flexspi_nor/flexspi_nor_flash.c middleware/flash_incremental/flash_incremental.c \
+             middleware/flash_program/flash_program.c middleware/flash_program/flash_program_dcache.c \
+             $B/$prg $B/$flashdev $B/bsp/src/*.c; do
+        gcc -std=gnu99 $CFLAGS -Werror -c "$f" -o "$OUT/$(basename "$f").o"
+    done
+    g++ -x c++ -std=gnu++14 -fpermissive $CFLAGS -Werror -c middleware/flexspi/fsl_flexspi.c -o "$OUT/fsl_flexspi.o"
+    for f in devices/$dev/system_$dev.c devices/$dev/drivers/fsl_clock.c $E/flexspi_emu.c $E/nor_emu.c $E/bench/flash_algo_suite.c; do
+        gcc -std=gnu99 $CFLAGS -c "$f" -o "$OUT/$(basename "$f").o"
+    done
+    g++ -no-pie "$OUT"/*.o -o "$OUT/flash_algo_suite"
+
+    echo "=== $board"
+    if [ -n "$BASELINE" ]; then
+        "$OUT/flash_algo_suite" -p "$part" -n "$board" -o "$BUILD/results.csv" -g "$BASELINE" -r "$THRESHOLD" $ARGS ||
+            touch "$BUILD/failed"
+    else
+        "$OUT/flash_algo_suite" -p "$part" -n "$board" -o "$BUILD/results.csv" $ARGS || touch "$BUILD/failed"
+    fi
+done
+
+if [ -f "$BUILD/failed" ]; then
+    rm -f "$BUILD/failed"
+    echo "flash_algo_suite: FAILED, results in $BUILD/results.csv"
+    exit 1
+fi
+echo "flash_algo_suite: passed, results in $BUILD/results.csv"
@@ -0,0 +1,436 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FlashOS.H"
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1, can be overridden by -p
+#if !defined(FLEXSPI_BENCH_PART)
+#define FLEXSPI_BENCH_PART "at25sf128a"
+#endif
+
+//!@brief Bytes erased and programmed by default, can be overridden by -s
+#if !defined(FLEXSPI_BENCH_SIZE)
+#define FLEXSPI_BENCH_SIZE (256u * 1024u)
+#endif
+
+//!@brief Image programmed by the bench, placed below 4GB where the 32-bit eDMA addresses reach it
+#define FLEXSPI_BENCH_IMAGE_ADDRESS (0x10000000u)
+
+#if defined(FLEXSPI)
+#define FLEXSPI_BENCH_BASE FLEXSPI_BASE
+#elif defined(FLEXSPI0)
+#define FLEXSPI_BENCH_BASE FLEXSPI0_BASE
+#elif defined(FLEXSPI1)
+#define FLEXSPI_BENCH_BASE FLEXSPI1_BASE
+#endif
+
+//!@brief FlexSPI instance used by the algorithm, FLEXSPI_NOR_INSTANCE of FlashPrg
+#if !defined(FLEXSPI_BENCH_INSTANCE)
+#define FLEXSPI_BENCH_INSTANCE (0)
+#endif
+
+//!@brief Sectors changed by the Reflash pass, one in FLEXSPI_BENCH_REFLASH_STRIDE
+#if !defined(FLEXSPI_BENCH_REFLASH_STRIDE)
+#define FLEXSPI_BENCH_REFLASH_STRIDE (8)
+#endif
+
+//!@brief Result of one benchmarked operation
+typedef struct _bench_result
+{
+    const char *op;
+    uint32_t bytes;
+    uint64_t ps;
+    flexspi_emu_stats_t ctrl;
+    nor_emu_stats_t nor;
+} bench_result_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+extern struct FlashDevice const FlashDevice;
+extern int UnInit(unsigned long fnc);
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+static uint32_t s_programCalls; // ProgramPage calls, each one a debugger round-trip on the target
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t bench_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void bench_seed_reset_values(void)
+{
+#if defined(CCM_ANALOG_PFD_480_PFD0_FRAC_MASK)
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+#endif
+#if defined(CCM_CSCMR1_FLEXSPI_PODF_MASK)
+    CCM->CSCMR1 = 0x04900080u;
+#endif
+#if defined(CCM_CBCDR_IPG_PODF_MASK)
+    CCM->CBCDR = 0x000A8300u;
+#endif
+}
+
+static void bench_begin(bench_result_t *result, const char *op, uint32_t bytes)
+{
+    memset(result, 0, sizeof(*result));
+    result->op    = op;
+    result->bytes = bytes;
+    flexspi_emu_reset_stats(s_ctrl);
+    result->ps = flexspi_emu_now();
+}
+
+static void bench_end(bench_result_t *result)
+{
+    result->ps   = flexspi_emu_now() - result->ps;
+    result->ctrl = *flexspi_emu_get_stats(s_ctrl);
+    result->nor  = s_nor->stats;
+}
+
+static void bench_print_header(void)
+{
+    printf("%-12s %10s %12s %12s %8s %8s %8s %10s %12s\n", "op", "bytes", "ms", "bytes/s", "ip_cmds", "lut_upd",
+           "swreset", "polls", "stall_ms");
+}
+
+static void bench_print(const bench_result_t *result)
+{
+    double ms  = (double)result->ps / FLEXSPI_EMU_PS_PER_MS;
+    double bps = result->ps ? (double)result->bytes * FLEXSPI_EMU_PS_PER_S / result->ps : 0.0;
+
+    printf("%-12s %10u %12.3f %12.0f %8llu %8llu %8llu %10llu %12.3f\n", result->op, result->bytes, ms, bps,
+           (unsigned long long)result->ctrl.ip_cmds, (unsigned long long)result->ctrl.lut_unlocks,
+           (unsigned long long)result->ctrl.swresets,
+           (unsigned long long)(result->nor.status_reads + result->ctrl.skipped_polls),
+           (double)result->ctrl.stall_ps / FLEXSPI_EMU_PS_PER_MS);
+}
+
+static void bench_dump_state(void)
+{
+    const volatile uint32_t *reg = (const volatile uint32_t *)(uintptr_t)FLEXSPI_BENCH_BASE;
+
+    printf("  serial root clock %u Hz, MCR0 0x%08x, FLSHCR0[0] 0x%08x, FLSHCR1[0] 0x%08x\n",
+           bench_get_serial_root_clock(FLEXSPI_BENCH_INSTANCE), reg[0], reg[0x60 / 4], reg[0x70 / 4]);
+    for (uint32_t seq = 0; seq < 16; seq++)
+    {
+        const volatile uint32_t *lut = &reg[0x200 / 4 + seq * 4];
+        if (lut[0] | lut[1] | lut[2] | lut[3])
+        {
+            printf("  LUT[%2u] 0x%08x 0x%08x 0x%08x 0x%08x\n", seq, lut[0], lut[1], lut[2], lut[3]);
+        }
+    }
+    printf("  SR1 0x%02x SR2 0x%02x SR3 0x%02x, commands %llu, protocol errors %llu\n", s_nor->sr1, s_nor->sr2,
+           s_nor->sr3, (unsigned long long)s_nor->stats.commands, (unsigned long long)s_nor->stats.protocol_errors);
+}
+
+static bool bench_is_blank(const uint8_t *mem, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        if (mem[i] != FlashDevice.valEmpty)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Program the image one FlashDev page per call, the last call takes the rest the way the debugger does
+static int bench_program(const uint8_t *image, uint32_t size)
+{
+    int status = 0;
+
+    for (uint32_t offset = 0; (offset < size) && !status; offset += FlashDevice.szPage)
+    {
+        uint32_t bytes = size - offset;
+        if (bytes > FlashDevice.szPage)
+        {
+            bytes = FlashDevice.szPage;
+        }
+        status = ProgramPage(FlashDevice.DevAdr + offset, bytes, (unsigned char *)&image[offset]);
+        s_programCalls++;
+    }
+    return status;
+}
+
+// Erase then program the image the way a download does, each phase framed by Init/UnInit
+static int bench_download(const uint8_t *image, uint32_t size)
+{
+    uint32_t sectorSize = FlashDevice.sectors[0].szSector;
+    int status          = Init(FlashDevice.DevAdr, 0, 1);
+
+    for (uint32_t offset = 0; (offset < size) && !status; offset += sectorSize)
+    {
+        status = EraseSector(FlashDevice.DevAdr + offset);
+    }
+    return status || UnInit(1) || Init(FlashDevice.DevAdr, 0, 2) || bench_program(image, size) || UnInit(2);
+}
+
+// Save the trace the algorithm attached, as a debugger would dump it from TRACE_ADDRESS
+static int bench_save_trace(const char *path)
+{
+#if FLEXSPI_ENABLE_TRACE
+    const flexspi_trace_t *trace = flexspi_trace_get();
+    FILE *file                   = fopen(path, "wb");
+    int status                   = 1;
+
+    if ((trace != NULL) && (file != NULL))
+    {
+        status = (fwrite(trace, sizeof(*trace), 1, file) == 1) ? 0 : 1;
+    }
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+    if (status)
+    {
+        fprintf(stderr, "Cannot save the trace to %s\n", path);
+    }
+    return status;
+#else
+    (void)path;
+    fprintf(stderr, "Build with -DFLEXSPI_ENABLE_TRACE=1 to save the trace\n");
+    return 1;
+#endif
+}
+
+static void bench_usage(const char *name)
+{
+    printf("Usage: %s [-p part] [-s bytes] [-c] [-x] [-v] [-t file] [-l]\n", name);
+    printf("  -p part   serial NOR part connected to A1, default %s\n", FLEXSPI_BENCH_PART);
+    printf("  -s bytes  bytes to erase/program from the device start, default %u\n", FLEXSPI_BENCH_SIZE);
+    printf("  -c        skip EraseChip\n");
+    printf("  -x        exact polling, simulate every status read\n");
+    printf("  -v        dump controller and device state after Init\n");
+    printf("  -t file   save the trace of a FLEXSPI_ENABLE_TRACE build, see tools/flexspi_trace\n");
+    printf("  -l        list supported parts\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName  = FLEXSPI_BENCH_PART;
+    uint32_t size         = FLEXSPI_BENCH_SIZE;
+    bool skipChipErase    = false;
+    bool verbose          = false;
+    const char *tracePath = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:cxvt:lh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                skipChipErase = true;
+                break;
+            case 'x':
+                flexspi_emu_set_fast_poll(false);
+                break;
+            case 'v':
+                verbose = true;
+                break;
+            case 't':
+                tracePath = optarg;
+                break;
+            case 'l':
+                for (const nor_emu_part_t *part = nor_emu_get_parts(); part->name; part++)
+                {
+                    printf("%-12s %3u MB\n", part->name, part->size >> 20);
+                }
+                return 0;
+            default:
+                bench_usage(argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if (part == NULL)
+    {
+        fprintf(stderr, "Unknown part %s\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    bench_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl = flexspi_emu_attach(FLEXSPI_BENCH_INSTANCE, FLEXSPI_BENCH_BASE, FlashDevice.DevAdr,
+                                bench_get_serial_root_clock);
+#if defined(DMAMUX)
+    flexspi_emu_attach_dma(s_ctrl, DMA0_BASE, DMAMUX_BASE, kDmaRequestMuxFlexSPIRx, kDmaRequestMuxFlexSPITx);
+#endif
+    s_nor  = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if (s_nor == NULL)
+    {
+        return 1;
+    }
+
+    uint32_t sectorSize = FlashDevice.sectors[0].szSector;
+    uint32_t pageSize   = FlashDevice.szPage;
+    if (size > part->size)
+    {
+        size = part->size;
+    }
+    size = (size + sectorSize - 1u) / sectorSize * sectorSize;
+
+    uint8_t *pattern = (uint8_t *)flexspi_emu_map_region(FLEXSPI_BENCH_IMAGE_ADDRESS, size);
+    uint32_t seed    = 0x12345678u;
+    if (pattern == NULL)
+    {
+        fprintf(stderr, "Cannot map the image at 0x%08x\n", FLEXSPI_BENCH_IMAGE_ADDRESS);
+        return 1;
+    }
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed       = seed * 1103515245u + 12345u;
+        pattern[i] = (uint8_t)(seed >> 16);
+    }
+
+    printf("Algorithm: %s\n", FlashDevice.DevName);
+    printf("Part: %s, %u bytes, page %u, sector %u\n", part->name, part->size, pageSize, sectorSize);
+    bench_print_header();
+
+    const uint8_t *flash = (const uint8_t *)(uintptr_t)FlashDevice.DevAdr;
+    bench_result_t result;
+    int status = 0;
+
+    do
+    {
+        bench_begin(&result, "Init", 0);
+        status = Init(FlashDevice.DevAdr, 0, 1);
+        bench_end(&result);
+        bench_print(&result);
+        if (status)
+        {
+            fprintf(stderr, "Init failed\n");
+            break;
+        }
+        if (verbose)
+        {
+            bench_dump_state();
+        }
+
+        // Leave programmed content behind so that EraseSector has real work to do.
+        memset(s_nor->array, 0x00, size);
+
+        bench_begin(&result, "EraseSector", size);
+        for (uint32_t offset = 0; (offset < size) && !status; offset += sectorSize)
+        {
+            status = EraseSector(FlashDevice.DevAdr + offset);
+        }
+        bench_end(&result);
+        bench_print(&result);
+#if !INCREMENTAL_PROGRAM
+        // Deferred erases only take place when the pages are programmed
+        if (!status && (!bench_is_blank(flash, size) || BlankCheck(FlashDevice.DevAdr, size, FlashDevice.valEmpty)))
+        {
+            status = 1;
+        }
+#endif
+        if (status)
+        {
+            fprintf(stderr, "EraseSector failed\n");
+            status = 1;
+            break;
+        }
+
+        bench_begin(&result, "ProgramPage", size);
+        s_programCalls = 0;
+        status         = bench_program(pattern, size);
+        bench_end(&result);
+        bench_print(&result);
+        printf("  %u calls of %u bytes\n", s_programCalls, pageSize);
+        if (status || memcmp(flash, pattern, size) ||
+            (Verify(FlashDevice.DevAdr, size, pattern) != FlashDevice.DevAdr + size))
+        {
+            fprintf(stderr, "ProgramPage failed\n");
+            status = 1;
+            break;
+        }
+
+        // Program the image again with one sector in FLEXSPI_BENCH_REFLASH_STRIDE changed
+        for (uint32_t offset = 0; offset < size; offset += sectorSize * FLEXSPI_BENCH_REFLASH_STRIDE)
+        {
+            pattern[offset] ^= 0x5a;
+        }
+        memset(&g_incrementalStats, 0, sizeof(g_incrementalStats));
+        bench_begin(&result, "Reflash", size);
+        status = bench_download(pattern, size);
+        bench_end(&result);
+        bench_print(&result);
+        printf("  erase hits %u misses %u, program hits %u misses %u\n", g_incrementalStats.eraseHits,
+               g_incrementalStats.eraseMisses, g_incrementalStats.programHits, g_incrementalStats.programMisses);
+        if (status || memcmp(flash, pattern, size))
+        {
+            fprintf(stderr, "Reflash failed\n");
+            status = 1;
+            break;
+        }
+
+        if (!skipChipErase)
+        {
+            bench_begin(&result, "EraseChip", part->size);
+            status = EraseChip();
+            bench_end(&result);
+            bench_print(&result);
+            if (status || !bench_is_blank(flash, part->size))
+            {
+                fprintf(stderr, "EraseChip failed\n");
+                status = 1;
+                break;
+            }
+        }
+
+        UnInit(2);
+    } while (0);
+
+    if (tracePath != NULL)
+    {
+        status = bench_save_trace(tracePath) || status;
+    }
+
+    if (s_nor->stats.protocol_errors || s_nor->stats.unknown_cmds)
+    {
+        fprintf(stderr, "Serial NOR model reported %llu protocol errors, %llu unknown commands\n",
+                (unsigned long long)s_nor->stats.protocol_errors, (unsigned long long)s_nor->stats.unknown_cmds);
+    }
+
+    return status ? 1 : 0;
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FlashOS.H"
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1, can be overridden by -p
+#if !defined(FLEXSPI_DMA_BENCH_PART)
+#define FLEXSPI_DMA_BENCH_PART "at25sf128a"
+#endif
+
+//!@brief Bytes programmed and read back, can be overridden by -s
+#if !defined(FLEXSPI_DMA_BENCH_SIZE)
+#define FLEXSPI_DMA_BENCH_SIZE (256u * 1024u)
+#endif
+
+//!@brief Bytes read back by one flexspi_nor_flash_read call
+#if !defined(FLEXSPI_DMA_BENCH_READ_CHUNK)
+#define FLEXSPI_DMA_BENCH_READ_CHUNK (4096u)
+#endif
+
+//!@brief Host buffers, placed below 4GB where the 32-bit eDMA addresses reach them
+#define FLEXSPI_DMA_BENCH_BUFFER_ADDRESS (0x10000000u)
+
+//!@brief Address left unmapped, the eDMA model raises a bus error on it
+#define FLEXSPI_DMA_BENCH_UNMAPPED_ADDRESS (0x30000000u)
+
+#if defined(FLEXSPI)
+#define FLEXSPI_DMA_BENCH_BASE FLEXSPI_BASE
+#elif defined(FLEXSPI0)
+#define FLEXSPI_DMA_BENCH_BASE FLEXSPI0_BASE
+#elif defined(FLEXSPI1)
+#define FLEXSPI_DMA_BENCH_BASE FLEXSPI1_BASE
+#endif
+
+//!@brief FlexSPI instance used by the algorithm, FLEXSPI_NOR_INSTANCE of FlashPrg
+#if !defined(FLEXSPI_DMA_BENCH_INSTANCE)
+#define FLEXSPI_DMA_BENCH_INSTANCE (0)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+extern struct FlashDevice const FlashDevice;
+extern int UnInit(unsigned long fnc);
+extern flexspi_nor_config_t config;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t bench_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void bench_seed_reset_values(void)
+{
+#if defined(CCM_ANALOG_PFD_480_PFD0_FRAC_MASK)
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+#endif
+#if defined(CCM_CSCMR1_FLEXSPI_PODF_MASK)
+    CCM->CSCMR1 = 0x04900080u;
+#endif
+#if defined(CCM_CBCDR_IPG_PODF_MASK)
+    CCM->CBCDR = 0x000A8300u;
+#endif
+}
+
+static void bench_print(const char *op, uint32_t bytes, uint64_t ps)
+{
+    const flexspi_emu_stats_t *stats = flexspi_emu_get_stats(s_ctrl);
+    double bps                       = ps ? (double)bytes * FLEXSPI_EMU_PS_PER_S / ps : 0.0;
+
+    printf("%-12s %10u %12.3f %12.0f %8llu %10llu %10llu %10llu %10.3f\n", op, bytes,
+           (double)ps / FLEXSPI_EMU_PS_PER_MS, bps, (unsigned long long)stats->ip_cmds,
+           (unsigned long long)stats->reg_reads, (unsigned long long)stats->reg_writes,
+           (unsigned long long)stats->dma_bytes, (double)stats->stall_ps / FLEXSPI_EMU_PS_PER_MS);
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName = FLEXSPI_DMA_BENCH_PART;
+    uint32_t size        = FLEXSPI_DMA_BENCH_SIZE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("Usage: %s [-p part] [-s bytes]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if (part == NULL)
+    {
+        fprintf(stderr, "Unknown part %s\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    bench_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl = flexspi_emu_attach(FLEXSPI_DMA_BENCH_INSTANCE, FLEXSPI_DMA_BENCH_BASE, FlashDevice.DevAdr,
+                                bench_get_serial_root_clock);
+#if defined(DMAMUX)
+    flexspi_emu_attach_dma(s_ctrl, DMA0_BASE, DMAMUX_BASE, kDmaRequestMuxFlexSPIRx, kDmaRequestMuxFlexSPITx);
+#endif
+    s_nor = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if ((s_nor == NULL) || Init(FlashDevice.DevAdr, 0, 1))
+    {
+        fprintf(stderr, "Init failed\n");
+        return 1;
+    }
+
+    if (size > part->size)
+    {
+        size = part->size;
+    }
+    size = (size + config.pageSize - 1u) / config.pageSize * config.pageSize;
+
+    uint8_t *image    = (uint8_t *)flexspi_emu_map_region(FLEXSPI_DMA_BENCH_BUFFER_ADDRESS, 2u * size);
+    uint8_t *readback = image + size;
+    if (image == NULL)
+    {
+        fprintf(stderr, "Cannot map the buffers at 0x%08x\n", FLEXSPI_DMA_BENCH_BUFFER_ADDRESS);
+        return 1;
+    }
+    uint32_t seed = 0x12345678u;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed     = seed * 1103515245u + 12345u;
+        image[i] = (uint8_t)(seed >> 16);
+    }
+
+    printf("Algorithm: %s, FLEXSPI_ENABLE_DMA_TRANSFER %d\n", FlashDevice.DevName, FLEXSPI_ENABLE_DMA_TRANSFER);
+    printf("Part: %s, %u bytes, page %u, read chunk %u\n", part->name, part->size, config.pageSize,
+           FLEXSPI_DMA_BENCH_READ_CHUNK);
+    printf("%-12s %10s %12s %12s %8s %10s %10s %10s %10s\n", "op", "bytes", "ms", "bytes/s", "ip_cmds", "reg_reads",
+           "reg_writes", "dma_bytes", "stall_ms");
+
+    const uint8_t *flash = (const uint8_t *)(uintptr_t)FlashDevice.DevAdr;
+    status_t status      = kStatus_Success;
+    uint64_t ps;
+
+    memset(s_nor->array, 0xFF, size);
+    flexspi_emu_reset_stats(s_ctrl);
+    ps = flexspi_emu_now();
+    for (uint32_t offset = 0; (offset < size) && (status == kStatus_Success); offset += config.pageSize)
+    {
+        status = flexspi_nor_flash_page_program(FLEXSPI_DMA_BENCH_INSTANCE, &config, offset,
+                                                (const uint32_t *)&image[offset]);
+    }
+    bench_print("PageProgram", size, flexspi_emu_now() - ps);
+    if ((status != kStatus_Success) || memcmp(flash, image, size))
+    {
+        fprintf(stderr, "Page program failed\n");
+        return 1;
+    }
+
+    flexspi_emu_reset_stats(s_ctrl);
+    ps = flexspi_emu_now();
+    for (uint32_t offset = 0; (offset < size) && (status == kStatus_Success); offset += FLEXSPI_DMA_BENCH_READ_CHUNK)
+    {
+        uint32_t bytes = size - offset;
+        if (bytes > FLEXSPI_DMA_BENCH_READ_CHUNK)
+        {
+            bytes = FLEXSPI_DMA_BENCH_READ_CHUNK;
+        }
+        status = flexspi_nor_flash_read(FLEXSPI_DMA_BENCH_INSTANCE, &config, (uint32_t *)&readback[offset], offset,
+                                        bytes);
+    }
+    bench_print("Readback", size, flexspi_emu_now() - ps);
+    if ((status != kStatus_Success) || memcmp(readback, image, size))
+    {
+        fprintf(stderr, "Readback failed\n");
+        return 1;
+    }
+
+#if FLEXSPI_ENABLE_DMA_TRANSFER
+    // A bus error fails the command, the next ones have to work again
+    uint32_t *unmapped = (uint32_t *)(uintptr_t)FLEXSPI_DMA_BENCH_UNMAPPED_ADDRESS;
+    uint32_t offset    = size - config.pageSize;
+    flexspi_emu_reset_stats(s_ctrl);
+    ps     = flexspi_emu_now();
+    status = flexspi_nor_flash_read(FLEXSPI_DMA_BENCH_INSTANCE, &config, unmapped, 0, FLEXSPI_DMA_BENCH_READ_CHUNK);
+    bench_print("ReadBusErr", FLEXSPI_DMA_BENCH_READ_CHUNK, flexspi_emu_now() - ps);
+    if ((status == kStatus_Success) || (flexspi_emu_get_stats(s_ctrl)->dma_errors == 0))
+    {
+        fprintf(stderr, "Read to an unmapped buffer did not fail\n");
+        return 1;
+    }
+    memset(readback, 0, FLEXSPI_DMA_BENCH_READ_CHUNK);
+    status = flexspi_nor_flash_read(FLEXSPI_DMA_BENCH_INSTANCE, &config, (uint32_t *)readback, 0,
+                                    FLEXSPI_DMA_BENCH_READ_CHUNK);
+    if ((status != kStatus_Success) || memcmp(readback, image, FLEXSPI_DMA_BENCH_READ_CHUNK))
+    {
+        fprintf(stderr, "Readback after the bus error failed\n");
+        return 1;
+    }
+
+    memset(&s_nor->array[offset], 0xFF, config.pageSize);
+    flexspi_emu_reset_stats(s_ctrl);
+    ps     = flexspi_emu_now();
+    status = flexspi_nor_flash_page_program(FLEXSPI_DMA_BENCH_INSTANCE, &config, offset, unmapped);
+    bench_print("ProgBusErr", config.pageSize, flexspi_emu_now() - ps);
+    if ((status == kStatus_Success) || (flexspi_emu_get_stats(s_ctrl)->dma_errors == 0))
+    {
+        fprintf(stderr, "Page program from an unmapped buffer did not fail\n");
+        return 1;
+    }
+    status = flexspi_nor_flash_page_program(FLEXSPI_DMA_BENCH_INSTANCE, &config, offset,
+                                            (const uint32_t *)&image[offset]);
+    if ((status != kStatus_Success) || memcmp(&flash[offset], &image[offset], config.pageSize))
+    {
+        fprintf(stderr, "Page program after the bus error failed\n");
+        return 1;
+    }
+#endif // FLEXSPI_ENABLE_DMA_TRANSFER
+
+    UnInit(2);
+    if (s_nor->stats.protocol_errors || s_nor->stats.unknown_cmds)
+    {
+        fprintf(stderr, "Serial NOR model reported %llu protocol errors, %llu unknown commands\n",
+                (unsigned long long)s_nor->stats.protocol_errors, (unsigned long long)s_nor->stats.unknown_cmds);
+        return 1;
+    }
+
+    return 0;
+}
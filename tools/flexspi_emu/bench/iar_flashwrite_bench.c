@@ -0,0 +1,269 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
+#include "flash_config.h"
+#include "flash_loader.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1, can be overridden by -p
+#if !defined(IAR_BENCH_PART)
+#define IAR_BENCH_PART "is25wp064a"
+#endif
+
+//!@brief Bytes programmed by default, can be overridden by -s
+#if !defined(IAR_BENCH_SIZE)
+#define IAR_BENCH_SIZE (256u * 1024u)
+#endif
+
+//!@brief Bytes passed to one FlashWrite call, the RAM buffer of the IAR flash loader framework, -b
+#if !defined(IAR_BENCH_BUFFER_SIZE)
+#define IAR_BENCH_BUFFER_SIZE (0x8000u)
+#endif
+
+//!@brief FlexSPI instance and AHB window of the loader, FLEXSPI_NOR_INSTANCE and FLASH_BASE_ADDR
+#define IAR_BENCH_INSTANCE (0)
+#define IAR_BENCH_FLASH_BASE (0x60000000u)
+
+//!@brief Cost of programming the image once
+typedef struct _bench_result
+{
+    const char *op;
+    uint32_t pages;
+    uint64_t ps;
+    flexspi_emu_stats_t ctrl;
+} bench_result_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Config block filled by FlashInit of the loader, same layout as the ROM one
+extern flexspi_nor_config_t config;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+// ROM bl_api stand-ins: the loader links against the middleware, which is the ROM FlexSPI NOR driver source
+void bl_api_init(void)
+{
+}
+
+uint16_t Crc16(uint8_t const *p, uint32_t len)
+{
+    (void)p;
+    (void)len;
+    return 0;
+}
+
+static uint32_t bench_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void bench_seed_reset_values(void)
+{
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+    CCM->CSCMR1         = 0x04900080u;
+    CCM->CBCDR          = 0x000A8300u;
+}
+
+// FlashWrite loop before the streaming page program, kept as the reference: one ROM page program per page
+static uint32_t bench_reference_write(void *block_start, uint32_t offset_into_block, uint32_t count, char const *buffer)
+{
+    uint32_t addr = (uint32_t)(uintptr_t)block_start + offset_into_block - IAR_BENCH_FLASH_BASE;
+
+    for (uint32_t size = 0; size < count; size += config.pageSize, buffer += config.pageSize, addr += config.pageSize)
+    {
+        if (flexspi_nor_flash_page_program(IAR_BENCH_INSTANCE, &config, addr, (const uint32_t *)buffer) != RESULT_OK)
+        {
+            return RESULT_ERROR;
+        }
+    }
+    return RESULT_OK;
+}
+
+// Program the image into a blank device in buffer sized FlashWrite calls, then check it through the AHB window
+static bool bench_write(const char *op, bool reference, const uint8_t *image, uint32_t size, uint32_t bufferSize,
+                        bench_result_t *result)
+{
+    void *base      = (void *)(uintptr_t)IAR_BENCH_FLASH_BASE;
+    uint32_t status = RESULT_OK;
+
+    memset(s_nor->array, 0xFF, size);
+    memset(result, 0, sizeof(*result));
+    result->op    = op;
+    result->pages = size / config.pageSize;
+    flexspi_emu_reset_stats(s_ctrl);
+    result->ps = flexspi_emu_now();
+    for (uint32_t offset = 0; (offset < size) && (status == RESULT_OK); offset += bufferSize)
+    {
+        uint32_t count = ((size - offset) < bufferSize) ? (size - offset) : bufferSize;
+        if (reference)
+        {
+            status = bench_reference_write(base, offset, count, (char const *)&image[offset]);
+        }
+        else
+        {
+            status = FlashWrite(base, offset, count, (char const *)&image[offset]);
+        }
+    }
+    result->ps   = flexspi_emu_now() - result->ps;
+    result->ctrl = *flexspi_emu_get_stats(s_ctrl);
+
+    return (status == RESULT_OK) && !memcmp((const void *)base, image, size);
+}
+
+static void bench_print(const bench_result_t *result, uint32_t tPP_us)
+{
+    double pageUs     = (double)result->ps / FLEXSPI_EMU_PS_PER_US / result->pages;
+    double overheadUs = pageUs - tPP_us;
+
+    printf("%-12s %8u %12.3f %10.2f %12.2f %10.2f %10.2f %10.3f\n", result->op, result->pages,
+           (double)result->ps / FLEXSPI_EMU_PS_PER_MS, pageUs, overheadUs,
+           (double)result->ctrl.ip_cmds / result->pages, (double)result->ctrl.lut_unlocks / result->pages,
+           (double)result->ctrl.swresets / result->pages);
+}
+
+static void bench_usage(const char *name)
+{
+    printf("Usage: %s [-p part] [-s bytes] [-b bytes] [-x]\n", name);
+    printf("  -p part   serial NOR part connected to A1, default %s\n", IAR_BENCH_PART);
+    printf("  -s bytes  bytes to program from the device start, default %u\n", IAR_BENCH_SIZE);
+    printf("  -b bytes  bytes passed to one FlashWrite call, default %u\n", IAR_BENCH_BUFFER_SIZE);
+    printf("  -x        exact polling, simulate every status read\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName = IAR_BENCH_PART;
+    uint32_t size        = IAR_BENCH_SIZE;
+    uint32_t bufferSize  = IAR_BENCH_BUFFER_SIZE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:b:xh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                bufferSize = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'x':
+                flexspi_emu_set_fast_poll(false);
+                break;
+            default:
+                bench_usage(argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if ((part == NULL) || (bufferSize == 0))
+    {
+        fprintf(stderr, "Unknown part %s\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    bench_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl = flexspi_emu_attach(IAR_BENCH_INSTANCE, FLEXSPI_BASE, IAR_BENCH_FLASH_BASE, bench_get_serial_root_clock);
+    s_nor  = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if (s_nor == NULL)
+    {
+        return 1;
+    }
+
+#if USE_ARGC_ARGV
+    char const *loaderArgv[] = { "--Qspi" };
+    uint32_t status          = FlashInit((void *)(uintptr_t)IAR_BENCH_FLASH_BASE, 0, 0, 0, 1, loaderArgv);
+#else
+    uint32_t status = FlashInit((void *)(uintptr_t)IAR_BENCH_FLASH_BASE, 0, 0, 0);
+#endif
+    if (status != RESULT_OK)
+    {
+        fprintf(stderr, "FlashInit failed\n");
+        return 1;
+    }
+
+    if (size > part->size)
+    {
+        size = part->size;
+    }
+    size = size / config.pageSize * config.pageSize;
+
+    uint8_t *image = (uint8_t *)malloc(size);
+    uint32_t seed  = 0x12345678u;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed     = seed * 1103515245u + 12345u;
+        image[i] = (uint8_t)(seed >> 16);
+    }
+
+    printf("Part: %s, page %u, tPP %u us, FlashWrite buffer %u bytes\n", part->name, config.pageSize, part->tPP_us,
+           bufferSize);
+    printf("%-12s %8s %12s %10s %12s %10s %10s %10s\n", "op", "pages", "ms", "us/page", "overhead_us", "ip_cmds",
+           "lut_upd", "swreset");
+
+    bench_result_t reference;
+    bench_result_t streamed;
+    int failures = 0;
+
+    if (!bench_write("ROM loop", true, image, size, bufferSize, &reference))
+    {
+        fprintf(stderr, "ROM page program loop failed\n");
+        failures++;
+    }
+    bench_print(&reference, part->tPP_us);
+    if (!bench_write("FlashWrite", false, image, size, bufferSize, &streamed))
+    {
+        fprintf(stderr, "FlashWrite failed\n");
+        failures++;
+    }
+    bench_print(&streamed, part->tPP_us);
+
+    if (s_nor->stats.protocol_errors || s_nor->stats.unknown_cmds || s_nor->stats.ignored_wel)
+    {
+        fprintf(stderr, "Serial NOR model reported %llu protocol errors, %llu unknown commands, %llu ignored\n",
+                (unsigned long long)s_nor->stats.protocol_errors, (unsigned long long)s_nor->stats.unknown_cmds,
+                (unsigned long long)s_nor->stats.ignored_wel);
+        failures++;
+    }
+
+    free(image);
+    return failures ? 1 : 0;
+}
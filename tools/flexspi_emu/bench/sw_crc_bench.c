@@ -0,0 +1,170 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sw_crc.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Bytes of one checksum run, can be overridden by -s
+#if !defined(SW_CRC_BENCH_SIZE)
+#define SW_CRC_BENCH_SIZE (1024u * 1024u)
+#endif
+
+//!@brief Minimum host time measured per method
+#define SW_CRC_BENCH_MIN_SECONDS (0.2)
+
+//!@brief One software CRC method of both widths
+typedef struct _crc_method
+{
+    const char *name;
+    uint16_t (*crc16)(uint16_t crc, const void *data, uint32_t length);
+    uint32_t (*crc32)(uint32_t crc, const void *data, uint32_t length);
+    uint32_t crc16TableBytes;
+    uint32_t crc32TableBytes;
+} crc_method_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static const crc_method_t s_methods[] = {
+    { "bitwise", sw_crc16_bitwise, sw_crc32_bitwise, 0u, 0u },
+    { "nibble", sw_crc16_nibble, sw_crc32_nibble, 16u * 2u, 16u * 4u },
+    { "table", sw_crc16_table, sw_crc32_table, 256u * 2u, 256u * 4u },
+    { "slice4", sw_crc16_slice4, sw_crc32_slice4, 4u * 256u * 2u, 4u * 256u * 4u },
+    { "slice8", sw_crc16_slice8, sw_crc32_slice8, 8u * 256u * 2u, 8u * 256u * 4u },
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static double bench_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Every method against the bitwise one, for all alignments, short lengths and a split into two calls
+static int bench_check(const crc_method_t *m, const uint8_t *data, uint32_t size)
+{
+    static const uint8_t check[] = "123456789";
+    int failures                 = 0;
+
+    if ((m->crc16(0, check, 9) != 0x31C3u) || (m->crc32(0, check, 9) != 0xCBF43926u))
+    {
+        fprintf(stderr, "%s: wrong check value\n", m->name);
+        failures++;
+    }
+    for (uint32_t offset = 0; offset < 8; offset++)
+    {
+        for (uint32_t length = 0; length < 64; length++)
+        {
+            if ((m->crc16(0, data + offset, length) != sw_crc16_bitwise(0, data + offset, length)) ||
+                (m->crc32(0, data + offset, length) != sw_crc32_bitwise(0, data + offset, length)))
+            {
+                fprintf(stderr, "%s: mismatch at offset %u length %u\n", m->name, offset, length);
+                failures++;
+            }
+        }
+        uint32_t length = size - offset;
+        uint32_t split  = length / 3u + offset;
+        if ((m->crc16(m->crc16(0, data + offset, split), data + offset + split, length - split) !=
+             sw_crc16_bitwise(0, data + offset, length)) ||
+            (m->crc32(m->crc32(0, data + offset, split), data + offset + split, length - split) !=
+             sw_crc32_bitwise(0, data + offset, length)))
+        {
+            fprintf(stderr, "%s: mismatch over %u bytes at offset %u\n", m->name, length, offset);
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+// Bytes per second of one method, repeated until it ran long enough to be measured
+static double bench_rate(const crc_method_t *m, bool isCrc32, const uint8_t *data, uint32_t size)
+{
+    volatile uint32_t sink = 0;
+    uint64_t bytes         = 0;
+    double start           = bench_seconds();
+    double elapsed;
+
+    do
+    {
+        sink  = isCrc32 ? m->crc32(sink, data, size) : m->crc16((uint16_t)sink, data, size);
+        bytes += size;
+        elapsed = bench_seconds() - start;
+    } while (elapsed < SW_CRC_BENCH_MIN_SECONDS);
+
+    return (double)bytes / elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t size = SW_CRC_BENCH_SIZE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("Usage: %s [-s bytes]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (size < 64u)
+    {
+        size = 64u;
+    }
+
+    uint8_t *data = (uint8_t *)malloc(size + 8u);
+    uint32_t seed = 0x12345678u;
+    for (uint32_t i = 0; i < size + 8u; i++)
+    {
+        seed    = seed * 1103515245u + 12345u;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+
+    int failures = 0;
+    for (uint32_t i = 0; i < sizeof(s_methods) / sizeof(s_methods[0]); i++)
+    {
+        failures += bench_check(&s_methods[i], data, size);
+    }
+
+    printf("Host, %u bytes per call\n", size);
+    printf("%-10s %12s %12s %12s %12s\n", "method", "crc16_table", "crc16_MB/s", "crc32_table", "crc32_MB/s");
+    for (uint32_t i = 0; i < sizeof(s_methods) / sizeof(s_methods[0]); i++)
+    {
+        const crc_method_t *m = &s_methods[i];
+
+        printf("%-10s %12u %12.1f %12u %12.1f\n", m->name, m->crc16TableBytes, bench_rate(m, false, data, size) / 1e6,
+               m->crc32TableBytes, bench_rate(m, true, data, size) / 1e6);
+    }
+    free(data);
+
+    if (failures)
+    {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,1466 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief FlexSPI register offsets, identical on all i.MXRT FlexSPI instances
+enum
+{
+    kReg_MCR0        = 0x00,
+    kReg_AHBCR       = 0x0C,
+    kReg_INTR        = 0x14,
+    kReg_LUTCR       = 0x1C,
+    kReg_AHBRXBUFCR0 = 0x20,
+    kReg_FLSHCR0     = 0x60,
+    kReg_FLSHCR1     = 0x70,
+    kReg_FLSHCR2     = 0x80,
+    kReg_IPCR0       = 0xA0,
+    kReg_IPCR1       = 0xA4,
+    kReg_IPCMD       = 0xB0,
+    kReg_IPRXFCR     = 0xB8,
+    kReg_IPTXFCR     = 0xBC,
+    kReg_STS0        = 0xE0,
+    kReg_STS1        = 0xE4,
+    kReg_IPRXFSTS    = 0xF0,
+    kReg_IPTXFSTS    = 0xF4,
+    kReg_RFDR        = 0x100,
+    kReg_TFDR        = 0x180,
+    kReg_LUT         = 0x200,
+    kReg_BlockSize   = 0x1000,
+};
+
+//!@brief FlexSPI register fields used by the model
+#define MCR0_SWRESET (1u << 0)
+#define MCR0_HSEN (1u << 11)
+#define INTR_IPCMDDONE (1u << 0)
+#define INTR_IPCMDERR (1u << 3)
+#define INTR_IPRXWA (1u << 5)
+#define INTR_IPTXWE (1u << 6)
+#define LUTCR_UNLOCK (1u << 1)
+#define AHBCR_APAREN (1u << 0)
+#define AHBCR_PREFETCHEN (1u << 5)
+#define AHBRXBUFCR0_BUFSZ(x) ((x)&0xFFu)
+#define AHBRXBUFCR0_MSTRID(x) (((x) >> 16) & 0xFu)
+#define AHBRXBUFCR0_PREFETCHEN (1u << 31)
+#define AHBRXBUF_COUNT (4u)
+#define FLSHCR1_TCSS(x) ((x)&0x1Fu)
+#define FLSHCR1_TCSH(x) (((x) >> 5) & 0x1Fu)
+#define FLSHCR1_WA(x) (((x) >> 10) & 0x1u)
+#define FLSHCR1_CAS(x) (((x) >> 11) & 0xFu)
+#define FLSHCR1_CSINTERVALUNIT(x) (((x) >> 15) & 0x1u)
+#define FLSHCR1_CSINTERVAL(x) (((x) >> 16) & 0xFFFFu)
+#define FLSHCR2_ARDSEQID(x) ((x)&0xFu)
+#define FLSHCR2_CLRINSTRPTR (1u << 31)
+#define IPCR1_IDATSZ(x) ((x)&0xFFFFu)
+#define IPCR1_ISEQID(x) (((x) >> 16) & 0xFu)
+#define IPCR1_ISEQNUM(x) (((x) >> 24) & 0x7u)
+#define IPCR1_IPAREN(x) (((x) >> 31) & 0x1u)
+#define IPCMD_TRG (1u << 0)
+#define IPFCR_CLR (1u << 0)
+#define IPFCR_WMRK(x) (((x) >> 2) & 0xFu)
+#define STS0_IDLE (0x3u)
+#define STS1_IPCMDERR(id, code) ((((id)&0xFu) << 16) | (((code)&0xFu) << 24))
+
+#define IPFCR_DMAEN (1u << 1)
+
+//!@brief eDMA register offsets, TCD fields are relative to the TCD of the channel
+enum
+{
+    kDma_ES        = 0x04,
+    kDma_ERQ       = 0x0C,
+    kDma_CERR      = 0x1E,
+    kDma_ERR       = 0x2C,
+    kDma_TCD       = 0x1000,
+    kDma_TCDSize   = 0x20,
+    kDma_Channels  = 32,
+    kTcd_SADDR     = 0x00,
+    kTcd_SOFF      = 0x04,
+    kTcd_ATTR      = 0x06,
+    kTcd_NBYTES    = 0x08,
+    kTcd_SLAST     = 0x0C,
+    kTcd_DADDR     = 0x10,
+    kTcd_DOFF      = 0x14,
+    kTcd_CITER     = 0x16,
+    kTcd_DLASTSGA  = 0x18,
+    kTcd_CSR       = 0x1C,
+    kTcd_BITER     = 0x1E,
+};
+
+//!@brief eDMA and DMAMUX fields used by the model
+#define TCD_ATTR_DSIZE(x) ((x)&0x7u)
+#define TCD_ATTR_DMOD(x) (((x) >> 3) & 0x1Fu)
+#define TCD_ATTR_SSIZE(x) (((x) >> 8) & 0x7u)
+#define TCD_ATTR_SMOD(x) (((x) >> 11) & 0x1Fu)
+#define TCD_ITER(x) ((x)&0x7FFFu)
+#define TCD_CSR_DREQ (1u << 3)
+#define TCD_CSR_DONE (1u << 7)
+#define DMA_ES_DBE (1u << 0)
+#define DMA_ES_SBE (1u << 1)
+#define DMA_ES_ERRCHN(x) (((x)&0x1Fu) << 8)
+#define DMA_ES_VLD (1u << 31)
+#define DMA_CERR_CAEI (1u << 6)
+#define DMA_CERR_NOP (1u << 7)
+#define DMAMUX_CHCFG_ENBL (1u << 31)
+#define DMAMUX_CHCFG_SOURCE(x) ((x)&0x7Fu)
+
+//!@brief LUT instruction opcodes, DDR variants have bit5 set
+enum
+{
+    kLutOp_Stop      = 0x00,
+    kLutOp_Cmd       = 0x01,
+    kLutOp_RowAddr   = 0x02,
+    kLutOp_ColAddr   = 0x03,
+    kLutOp_Mode1     = 0x04,
+    kLutOp_Mode2     = 0x05,
+    kLutOp_Mode4     = 0x06,
+    kLutOp_Mode8     = 0x07,
+    kLutOp_Write     = 0x08,
+    kLutOp_Read      = 0x09,
+    kLutOp_Learn     = 0x0A,
+    kLutOp_DataSize  = 0x0B,
+    kLutOp_Dummy     = 0x0C,
+    kLutOp_DummyRwds = 0x0D,
+    kLutOp_JmpOnCs   = 0x1F,
+    kLutOp_DdrFlag   = 0x20,
+};
+
+//!@brief IP command error codes, see STS1[IPCMDERRCODE]
+enum
+{
+    kIpCmdError_JumpOnCs      = 2,
+    kIpCmdError_UnknownOpCode = 3,
+    kIpCmdError_InvalidAddress = 6,
+};
+
+//!@brief IP command engine states
+enum
+{
+    kEngine_Idle,
+    kEngine_Header, //!< Chip select setup, command, address, mode and dummy phases
+    kEngine_Data,   //!< Data phase, throttled by the IP FIFOs
+    kEngine_Tail,   //!< Instructions after data and chip select hold
+};
+
+//!@brief IP RX/TX FIFO depth in bytes, i.e. sizeof(RFDR)
+#define FIFO_SIZE (128u)
+
+//!@brief Regions mapped by flexspi_emu_map_region, other addresses are bus errors for the eDMA model
+#define MAPPED_REGIONS_MAX (16u)
+
+//!@brief Largest IP transfer, IDATSZ bytes for each of 8 sequences
+#define XFER_MAX (8u * 0x10000u + FIFO_SIZE)
+
+//!@brief Dynamic registers tracked to detect polling loops
+enum
+{
+    kPoll_MCR0,
+    kPoll_INTR,
+    kPoll_STS0,
+    kPoll_IPRXFSTS,
+    kPoll_IPTXFSTS,
+    kPoll_Count,
+};
+
+struct _flexspi_emu_ctrl
+{
+    bool used;
+    uint32_t instance;
+    uint32_t regBase;
+    volatile uint32_t *reg;
+    uint32_t ahbBase;
+    uint32_t ahbUsed;
+    flexspi_emu_clock_fn_t getSerialRootClock;
+    nor_emu_device_t device[kFlexSpiEmuPort_Count];
+    bool connected[kFlexSpiEmuPort_Count];
+
+    uint32_t intr; //!< Sticky INTR flags, IPRXWA and IPTXWE are computed
+    uint32_t sts1;
+
+    uint8_t rxData[XFER_MAX];
+    uint32_t rxProduced;
+    uint32_t rxPopped;
+    bool rxDirty;
+    uint8_t txData[XFER_MAX];
+    uint32_t txPushed;
+    uint32_t txConsumed;
+
+    uint32_t state;
+    uint32_t seqId;
+    uint32_t seqLeft;
+    uint32_t ipAddr;
+    uint32_t ipSize;
+    bool parallel;
+    uint32_t port;
+    uint32_t devAddr;
+    uint64_t cmdStart;
+    uint64_t t;        //!< Start of the current state, or last data progress in data phase
+    uint64_t headerPs; //!< Duration of the header state
+    uint64_t tailPs;   //!< Duration of the tail state
+    uint64_t bytePs;   //!< Time to transfer one byte in data phase
+    uint32_t dataSize;
+    uint32_t dataDone;
+    uint32_t dataBase; //!< Offset of the current sequence data in rxData/txData
+    bool dataRead;
+    bool dataWrite;
+    uint64_t csIntervalPs;
+    uint64_t lastCsHigh;
+    nor_emu_xfer_t xfer;
+
+    bool pollValid[kPoll_Count];
+    uint32_t pollValue[kPoll_Count];
+    uint64_t lastBusyPoll;   //!< End of the last status read that found the device busy
+    uint64_t lastPollPeriod; //!< Time between the last two status reads that found the device busy
+
+    bool dmaAttached;
+    uint32_t dmaBase;
+    uint32_t dmamuxBase;
+    uint32_t dmaRxSource;
+    uint32_t dmaTxSource;
+
+    flexspi_emu_stats_t stats;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t s_ctrl[FLEXSPI_EMU_MAX_CONTROLLERS];
+static uint32_t s_mapped[MAPPED_REGIONS_MAX][2];
+static uint32_t s_mappedCount;
+static uint64_t s_now;
+static uint32_t s_coreClockHz = 500000000u;
+static bool s_fastPoll        = true;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static void emu_check_hang(void)
+{
+    if (s_now > FLEXSPI_EMU_HANG_LIMIT_PS)
+    {
+        fprintf(stderr, "flexspi_emu: virtual time exceeded %llu s, the algorithm looks hung\n",
+                (unsigned long long)(FLEXSPI_EMU_HANG_LIMIT_PS / FLEXSPI_EMU_PS_PER_S));
+        abort();
+    }
+}
+
+// See flexspi_emu.h for more details.
+void *flexspi_emu_map_region(uint32_t address, uint32_t size)
+{
+    void *hint = (void *)(uintptr_t)address;
+#if defined(MAP_FIXED_NOREPLACE)
+    void *ptr = mmap(hint, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+#else
+    void *ptr = mmap(hint, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#endif
+    if (ptr == MAP_FAILED)
+    {
+        return NULL;
+    }
+    if (ptr != hint)
+    {
+        munmap(ptr, size);
+        return NULL;
+    }
+    if (s_mappedCount < MAPPED_REGIONS_MAX)
+    {
+        s_mapped[s_mappedCount][0] = address;
+        s_mapped[s_mappedCount][1] = size;
+        s_mappedCount++;
+    }
+    return ptr;
+}
+
+// Whether the bytes at address are backed by a region mapped by flexspi_emu_map_region
+static bool emu_is_mapped(uint32_t address, uint32_t size)
+{
+    for (uint32_t i = 0; i < s_mappedCount; i++)
+    {
+        if ((address >= s_mapped[i][0]) && ((uint64_t)address + size <= (uint64_t)s_mapped[i][0] + s_mapped[i][1]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// See flexspi_emu.h for more details.
+int flexspi_emu_map_soc(void)
+{
+    // OCRAM/DTCM, peripherals (including the secure alias of RT500/RT600) and System Control Space
+    static const uint32_t k_regions[][2] = {
+        { 0x20000000u, 0x01000000u },
+        { 0x40000000u, 0x20000000u },
+        { 0xE0000000u, 0x00100000u },
+    };
+
+    for (uint32_t i = 0; i < sizeof(k_regions) / sizeof(k_regions[0]); i++)
+    {
+        if (flexspi_emu_map_region(k_regions[i][0], k_regions[i][1]) == NULL)
+        {
+            fprintf(stderr, "flexspi_emu: cannot map 0x%08x, build with -no-pie\n", k_regions[i][0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// See flexspi_emu.h for more details.
+void flexspi_emu_set_core_clock(uint32_t coreClockHz)
+{
+    s_coreClockHz = coreClockHz;
+}
+
+// See flexspi_emu.h for more details.
+void flexspi_emu_set_fast_poll(bool enable)
+{
+    s_fastPoll = enable;
+}
+
+// See flexspi_emu.h for more details.
+uint64_t flexspi_emu_now(void)
+{
+    return s_now;
+}
+
+// See flexspi_emu.h for more details.
+void flexspi_emu_advance(uint64_t ps)
+{
+    s_now += ps;
+    emu_check_hang();
+}
+
+// See flexspi_emu.h for more details.
+void flexspi_emu_cpu_cycles(uint32_t cycles)
+{
+    flexspi_emu_advance((uint64_t)cycles * FLEXSPI_EMU_PS_PER_S / s_coreClockHz);
+}
+
+// See flexspi_emu.h for more details.
+uint32_t flexspi_emu_get_cycles(void)
+{
+    // Whole seconds apart, the product of picoseconds and Hz overflows 64 bits after 36ms at 500MHz
+    uint64_t seconds = s_now / FLEXSPI_EMU_PS_PER_S;
+    uint64_t ns      = (s_now % FLEXSPI_EMU_PS_PER_S) / 1000u;
+    return (uint32_t)(seconds * s_coreClockHz + ns * s_coreClockHz / 1000000000u);
+}
+
+// See flexspi_emu.h for more details.
+flexspi_emu_ctrl_t *flexspi_emu_attach(uint32_t instance,
+                                       uint32_t regBase,
+                                       uint32_t ahbBase,
+                                       flexspi_emu_clock_fn_t getSerialRootClock)
+{
+    for (uint32_t i = 0; i < FLEXSPI_EMU_MAX_CONTROLLERS; i++)
+    {
+        flexspi_emu_ctrl_t *ctrl = &s_ctrl[i];
+        if (!ctrl->used)
+        {
+            memset(ctrl, 0, sizeof(*ctrl));
+            ctrl->used               = true;
+            ctrl->instance           = instance;
+            ctrl->regBase            = regBase;
+            ctrl->reg                = (volatile uint32_t *)(uintptr_t)regBase;
+            ctrl->ahbBase            = ahbBase;
+            ctrl->getSerialRootClock = getSerialRootClock;
+            ctrl->reg[kReg_STS0 / 4] = STS0_IDLE;
+            // Reset values the AHB read model depends on: every buffer 256 bytes with prefetch, for master n
+            ctrl->reg[kReg_AHBCR / 4] = 0x18u;
+            for (uint32_t n = 0; n < AHBRXBUF_COUNT; n++)
+            {
+                ctrl->reg[kReg_AHBRXBUFCR0 / 4 + n] = AHBRXBUFCR0_PREFETCHEN | (n << 16) | 0x20u;
+            }
+            return ctrl;
+        }
+    }
+    return NULL;
+}
+
+// See flexspi_emu.h for more details.
+void flexspi_emu_attach_dma(
+    flexspi_emu_ctrl_t *ctrl, uint32_t dmaBase, uint32_t dmamuxBase, uint32_t rxSource, uint32_t txSource)
+{
+    ctrl->dmaAttached = true;
+    ctrl->dmaBase     = dmaBase;
+    ctrl->dmamuxBase  = dmamuxBase;
+    ctrl->dmaRxSource = DMAMUX_CHCFG_SOURCE(rxSource);
+    ctrl->dmaTxSource = DMAMUX_CHCFG_SOURCE(txSource);
+    // CERR reads as 0 on hardware, NOP here lets the model see every write including that of channel 0
+    *(volatile uint8_t *)(uintptr_t)(dmaBase + kDma_CERR) = DMA_CERR_NOP;
+}
+
+// See flexspi_emu.h for more details.
+nor_emu_device_t *flexspi_emu_connect(flexspi_emu_ctrl_t *ctrl, uint32_t port, const nor_emu_part_t *part)
+{
+    if ((ctrl == NULL) || (port >= kFlexSpiEmuPort_Count) || ctrl->connected[port] || (part == NULL))
+    {
+        return NULL;
+    }
+    uint8_t *array = (uint8_t *)flexspi_emu_map_region(ctrl->ahbBase + ctrl->ahbUsed, part->size);
+    if (array == NULL)
+    {
+        fprintf(stderr, "flexspi_emu: cannot map AHB window at 0x%08x\n", ctrl->ahbBase + ctrl->ahbUsed);
+        return NULL;
+    }
+    ctrl->ahbUsed += part->size;
+    ctrl->connected[port] = true;
+    nor_emu_init(&ctrl->device[port], part, array);
+    return &ctrl->device[port];
+}
+
+// See flexspi_emu.h for more details.
+nor_emu_device_t *flexspi_emu_get_device(flexspi_emu_ctrl_t *ctrl, uint32_t port)
+{
+    if ((ctrl == NULL) || (port >= kFlexSpiEmuPort_Count) || !ctrl->connected[port])
+    {
+        return NULL;
+    }
+    return &ctrl->device[port];
+}
+
+// See flexspi_emu.h for more details.
+const flexspi_emu_stats_t *flexspi_emu_get_stats(flexspi_emu_ctrl_t *ctrl)
+{
+    return &ctrl->stats;
+}
+
+// See flexspi_emu.h for more details.
+void flexspi_emu_reset_stats(flexspi_emu_ctrl_t *ctrl)
+{
+    memset(&ctrl->stats, 0, sizeof(ctrl->stats));
+    for (uint32_t port = 0; port < kFlexSpiEmuPort_Count; port++)
+    {
+        memset(&ctrl->device[port].stats, 0, sizeof(ctrl->device[port].stats));
+    }
+}
+
+static flexspi_emu_ctrl_t *emu_find_ctrl(const volatile void *reg, uint32_t *offset)
+{
+    uintptr_t addr = (uintptr_t)reg;
+    for (uint32_t i = 0; i < FLEXSPI_EMU_MAX_CONTROLLERS; i++)
+    {
+        flexspi_emu_ctrl_t *ctrl = &s_ctrl[i];
+        if (ctrl->used && (addr >= ctrl->regBase) && (addr < (uintptr_t)ctrl->regBase + kReg_BlockSize))
+        {
+            *offset = (uint32_t)(addr - ctrl->regBase);
+            return ctrl;
+        }
+    }
+    fprintf(stderr, "flexspi_emu: access to unknown FlexSPI register %p\n", (const void *)reg);
+    abort();
+    return NULL;
+}
+
+static uint32_t emu_rx_watermark(flexspi_emu_ctrl_t *ctrl)
+{
+    return (IPFCR_WMRK(ctrl->reg[kReg_IPRXFCR / 4]) + 1u) * 8u;
+}
+
+static uint32_t emu_tx_watermark(flexspi_emu_ctrl_t *ctrl)
+{
+    return (IPFCR_WMRK(ctrl->reg[kReg_IPTXFCR / 4]) + 1u) * 8u;
+}
+
+// Push one TX watermark of TFDR into the TX FIFO, as INTR[IPTXWE] write or a DMA minor loop does
+static uint32_t emu_push_tx(flexspi_emu_ctrl_t *ctrl)
+{
+    uint32_t space = FIFO_SIZE - (ctrl->txPushed - ctrl->txConsumed);
+    uint32_t push  = emu_tx_watermark(ctrl);
+    if (push > space)
+    {
+        push = space;
+    }
+    if (ctrl->txPushed + push > XFER_MAX)
+    {
+        return 0;
+    }
+    memcpy(&ctrl->txData[ctrl->txPushed], (const void *)&ctrl->reg[kReg_TFDR / 4], push);
+    ctrl->txPushed += push;
+    return push;
+}
+
+// Pop one RX watermark from the RX FIFO, as INTR[IPRXWA] write or a DMA minor loop does
+static uint32_t emu_pop_rx(flexspi_emu_ctrl_t *ctrl)
+{
+    uint32_t fill = ctrl->rxProduced - ctrl->rxPopped;
+    uint32_t pop  = emu_rx_watermark(ctrl);
+    if (pop > fill)
+    {
+        pop = fill;
+    }
+    ctrl->rxPopped += pop;
+    ctrl->rxDirty = true;
+    return pop;
+}
+
+// Channel routed to the DMA request source with its request enabled and a major loop in progress, -1 if none
+static int32_t emu_dma_channel(flexspi_emu_ctrl_t *ctrl, uint32_t source)
+{
+    const volatile uint32_t *chcfg = (const volatile uint32_t *)(uintptr_t)ctrl->dmamuxBase;
+    uint32_t erq                   = *(const volatile uint32_t *)(uintptr_t)(ctrl->dmaBase + kDma_ERQ);
+    uint32_t err                   = *(const volatile uint32_t *)(uintptr_t)(ctrl->dmaBase + kDma_ERR);
+
+    for (uint32_t ch = 0; ch < kDma_Channels; ch++)
+    {
+        uint16_t citer;
+        memcpy(&citer, (const void *)(uintptr_t)(ctrl->dmaBase + kDma_TCD + ch * kDma_TCDSize + kTcd_CITER),
+               sizeof(citer));
+        // A channel with its error flag set is halted until the flag is cleared through CERR
+        if ((chcfg[ch] & DMAMUX_CHCFG_ENBL) && (DMAMUX_CHCFG_SOURCE(chcfg[ch]) == source) && (erq & (1u << ch)) &&
+            !(err & (1u << ch)) && TCD_ITER(citer))
+        {
+            return (int32_t)ch;
+        }
+    }
+    return -1;
+}
+
+// Next address of a TCD address field, the upper bits are kept by the modulo feature
+static uint32_t emu_dma_next_address(uint32_t addr, int16_t offset, uint32_t mod)
+{
+    uint32_t next = addr + (uint32_t)(int32_t)offset;
+    if (mod)
+    {
+        uint32_t mask = (1u << mod) - 1u;
+        next          = (addr & ~mask) | (next & mask);
+    }
+    return next;
+}
+
+// Apply the writes to CERR made since the last request was served
+static void emu_dma_clear_errors(flexspi_emu_ctrl_t *ctrl)
+{
+    volatile uint8_t *cerr = (volatile uint8_t *)(uintptr_t)(ctrl->dmaBase + kDma_CERR);
+    volatile uint32_t *err = (volatile uint32_t *)(uintptr_t)(ctrl->dmaBase + kDma_ERR);
+
+    if (!(*cerr & DMA_CERR_NOP))
+    {
+        *err &= (*cerr & DMA_CERR_CAEI) ? 0u : ~(1u << (*cerr & 0x1Fu));
+    }
+    *cerr = DMA_CERR_NOP;
+}
+
+// Halt the channel on a bus error, the TCD keeps the state of the minor loop that failed
+static void emu_dma_bus_error(flexspi_emu_ctrl_t *ctrl, uint32_t ch, uint32_t errorBits)
+{
+    *(volatile uint32_t *)(uintptr_t)(ctrl->dmaBase + kDma_ES) = DMA_ES_VLD | DMA_ES_ERRCHN(ch) | errorBits;
+    *(volatile uint32_t *)(uintptr_t)(ctrl->dmaBase + kDma_ERR) |= 1u << ch;
+    ctrl->stats.dma_errors++;
+}
+
+// Run one minor loop of the channel and update its TCD as the eDMA engine does, returns false on a bus error
+static bool emu_dma_minor_loop(flexspi_emu_ctrl_t *ctrl, uint32_t ch)
+{
+    uint8_t *tcd = (uint8_t *)(uintptr_t)(ctrl->dmaBase + kDma_TCD + ch * kDma_TCDSize);
+    uint32_t saddr, daddr, nbytes, slast, dlast;
+    int16_t soff, doff;
+    uint16_t attr, citer, csr, biter;
+
+    memcpy(&saddr, tcd + kTcd_SADDR, sizeof(saddr));
+    memcpy(&soff, tcd + kTcd_SOFF, sizeof(soff));
+    memcpy(&attr, tcd + kTcd_ATTR, sizeof(attr));
+    memcpy(&nbytes, tcd + kTcd_NBYTES, sizeof(nbytes));
+    memcpy(&slast, tcd + kTcd_SLAST, sizeof(slast));
+    memcpy(&daddr, tcd + kTcd_DADDR, sizeof(daddr));
+    memcpy(&doff, tcd + kTcd_DOFF, sizeof(doff));
+    memcpy(&citer, tcd + kTcd_CITER, sizeof(citer));
+    memcpy(&dlast, tcd + kTcd_DLASTSGA, sizeof(dlast));
+    memcpy(&csr, tcd + kTcd_CSR, sizeof(csr));
+    memcpy(&biter, tcd + kTcd_BITER, sizeof(biter));
+
+    // The model moves source-sized beats, the channels of the FlexSPI hooks use the same source and destination size
+    uint32_t beat = 1u << TCD_ATTR_SSIZE(attr);
+    for (uint32_t done = 0; done < nbytes; done += beat)
+    {
+        if (!emu_is_mapped(saddr, beat) || !emu_is_mapped(daddr, beat))
+        {
+            emu_dma_bus_error(ctrl, ch, emu_is_mapped(saddr, beat) ? DMA_ES_DBE : DMA_ES_SBE);
+            return false;
+        }
+        memcpy((void *)(uintptr_t)daddr, (const void *)(uintptr_t)saddr, beat);
+        saddr = emu_dma_next_address(saddr, soff, TCD_ATTR_SMOD(attr));
+        daddr = emu_dma_next_address(daddr, doff, TCD_ATTR_DMOD(attr));
+    }
+
+    citer = (uint16_t)((citer & ~0x7FFFu) | (TCD_ITER(citer) - 1u));
+    if (TCD_ITER(citer) == 0)
+    {
+        volatile uint32_t *erq = (volatile uint32_t *)(uintptr_t)(ctrl->dmaBase + kDma_ERQ);
+        saddr += slast;
+        daddr += dlast;
+        citer = biter;
+        csr |= TCD_CSR_DONE;
+        if (csr & TCD_CSR_DREQ)
+        {
+            *erq &= ~(1u << ch);
+        }
+    }
+
+    memcpy(tcd + kTcd_SADDR, &saddr, sizeof(saddr));
+    memcpy(tcd + kTcd_DADDR, &daddr, sizeof(daddr));
+    memcpy(tcd + kTcd_CITER, &citer, sizeof(citer));
+    memcpy(tcd + kTcd_CSR, &csr, sizeof(csr));
+    ctrl->stats.dma_bytes += nbytes;
+    return true;
+}
+
+static void emu_update_rfdr(flexspi_emu_ctrl_t *ctrl);
+
+// Serve the FIFO watermark DMA requests that are pending, returns true if data was moved
+static bool emu_dma_service(flexspi_emu_ctrl_t *ctrl)
+{
+    bool moved = false;
+
+    if (!ctrl->dmaAttached)
+    {
+        return false;
+    }
+    emu_dma_clear_errors(ctrl);
+    while (ctrl->reg[kReg_IPTXFCR / 4] & IPFCR_DMAEN)
+    {
+        int32_t ch = emu_dma_channel(ctrl, ctrl->dmaTxSource);
+        if ((ch < 0) || ((FIFO_SIZE - (ctrl->txPushed - ctrl->txConsumed)) < emu_tx_watermark(ctrl)) ||
+            (ctrl->txPushed + emu_tx_watermark(ctrl) > XFER_MAX))
+        {
+            break;
+        }
+        if (!emu_dma_minor_loop(ctrl, (uint32_t)ch))
+        {
+            break;
+        }
+        emu_push_tx(ctrl);
+        moved = true;
+    }
+    while (ctrl->reg[kReg_IPRXFCR / 4] & IPFCR_DMAEN)
+    {
+        int32_t ch = emu_dma_channel(ctrl, ctrl->dmaRxSource);
+        if ((ch < 0) || ((ctrl->rxProduced - ctrl->rxPopped) < emu_rx_watermark(ctrl)))
+        {
+            break;
+        }
+        if (ctrl->rxDirty)
+        {
+            emu_update_rfdr(ctrl);
+        }
+        if (!emu_dma_minor_loop(ctrl, (uint32_t)ch))
+        {
+            break;
+        }
+        emu_pop_rx(ctrl);
+        moved = true;
+    }
+    return moved;
+}
+
+// Serial clock period in pico-seconds for a sequence
+static uint64_t emu_sck_period(flexspi_emu_ctrl_t *ctrl, bool ddrSequence)
+{
+    uint64_t rootHz = ctrl->getSerialRootClock ? ctrl->getSerialRootClock(ctrl->instance) : 30000000u;
+    if (rootHz == 0)
+    {
+        rootHz = 30000000u;
+    }
+    uint64_t period = FLEXSPI_EMU_PS_PER_S / rootHz;
+    // In DDR sequences the serial root clock is twice the serial clock, see halfClkForNonReadCmd
+    if (ddrSequence)
+    {
+        period *= 2;
+    }
+    if (ctrl->reg[kReg_MCR0 / 4] & MCR0_HSEN)
+    {
+        period *= 2;
+    }
+    return period;
+}
+
+// Select the chip select from IPCR0 based on the flash sizes in FLSHCR0
+static bool emu_select_port(flexspi_emu_ctrl_t *ctrl, uint32_t addr, uint32_t *port, uint32_t *devAddr)
+{
+    uint64_t base = 0;
+    for (uint32_t i = 0; i < kFlexSpiEmuPort_Count; i++)
+    {
+        uint64_t size = (uint64_t)(ctrl->reg[kReg_FLSHCR0 / 4 + i] & 0x7FFFFFu) * 1024u;
+        if ((addr >= base) && (addr < base + size))
+        {
+            *port    = i;
+            *devAddr = (uint32_t)(addr - base);
+            return true;
+        }
+        base += size;
+    }
+    return false;
+}
+
+static void emu_set_error(flexspi_emu_ctrl_t *ctrl, uint32_t code)
+{
+    ctrl->intr |= INTR_IPCMDERR | INTR_IPCMDDONE;
+    ctrl->sts1  = STS1_IPCMDERR(ctrl->seqId, code);
+    ctrl->state = kEngine_Idle;
+    ctrl->stats.ip_cmd_errors++;
+}
+
+// Build the device transaction and timing of the current sequence, returns IP command error code
+static uint32_t emu_start_sequence(flexspi_emu_ctrl_t *ctrl, uint64_t start)
+{
+    volatile uint32_t *lut = &ctrl->reg[kReg_LUT / 4 + ctrl->seqId * 4];
+    uint16_t inst[8];
+    bool ddrSequence = false;
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        uint32_t word   = lut[i];
+        inst[i * 2]     = (uint16_t)word;
+        inst[i * 2 + 1] = (uint16_t)(word >> 16);
+    }
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint32_t opcode = inst[i] >> 10;
+        if (opcode == kLutOp_Stop)
+        {
+            break;
+        }
+        if ((opcode != kLutOp_JmpOnCs) && (opcode & kLutOp_DdrFlag))
+        {
+            ddrSequence = true;
+        }
+    }
+
+    uint32_t flshcr1   = ctrl->reg[kReg_FLSHCR1 / 4 + ctrl->port];
+    uint64_t sckPs     = emu_sck_period(ctrl, ddrSequence);
+    uint64_t halfPs    = sckPs / 2;
+    uint64_t header    = 2u * (FLSHCR1_TCSS(flshcr1) + 1u);
+    uint64_t tail      = 2u * (FLSHCR1_TCSH(flshcr1) + 1u);
+    uint64_t *phaseSum = &header;
+    uint32_t colBits   = FLSHCR1_CAS(flshcr1);
+    uint32_t addr      = ctrl->devAddr;
+    nor_emu_xfer_t *xfer = &ctrl->xfer;
+
+    if (FLSHCR1_WA(flshcr1))
+    {
+        addr >>= 1;
+    }
+
+    memset(xfer, 0, sizeof(*xfer));
+    xfer->sckHz     = (uint32_t)(FLEXSPI_EMU_PS_PER_S / sckPs);
+    ctrl->dataRead  = false;
+    ctrl->dataWrite = false;
+    ctrl->dataSize  = 0;
+    ctrl->dataDone  = 0;
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint32_t opcode  = inst[i] >> 10;
+        uint32_t pads    = 1u << ((inst[i] >> 8) & 0x3u);
+        uint32_t operand = inst[i] & 0xFFu;
+        bool ddr         = (opcode != kLutOp_JmpOnCs) && (opcode & kLutOp_DdrFlag);
+        uint32_t rate    = ddr ? 1u : 2u; // half cycles per bit-time
+        nor_emu_phase_t *phase = &xfer->phase[xfer->phaseCount];
+
+        if (opcode == kLutOp_Stop)
+        {
+            break;
+        }
+        phase->pads = (uint8_t)pads;
+        phase->ddr  = ddr;
+        switch (opcode & ~kLutOp_DdrFlag)
+        {
+            case kLutOp_Cmd:
+            case kLutOp_DataSize:
+                phase->type  = kNorEmuPhase_Cmd;
+                phase->bits  = 8;
+                phase->value = operand;
+                *phaseSum += (8u / pads ? 8u / pads : 1u) * rate;
+                break;
+            case kLutOp_RowAddr:
+            case kLutOp_ColAddr:
+            {
+                uint32_t value = ((opcode & ~kLutOp_DdrFlag) == kLutOp_RowAddr) ? (addr >> colBits) :
+                                                                                   (addr & ((1u << colBits) - 1u));
+                phase->type  = ((opcode & ~kLutOp_DdrFlag) == kLutOp_RowAddr) ? kNorEmuPhase_RowAddr :
+                                                                                 kNorEmuPhase_ColAddr;
+                phase->bits  = (uint8_t)operand;
+                phase->value = (operand >= 32) ? value : (value & ((1u << operand) - 1u));
+                *phaseSum += ((operand + pads - 1u) / pads) * rate;
+                break;
+            }
+            case kLutOp_Mode1:
+            case kLutOp_Mode2:
+            case kLutOp_Mode4:
+            case kLutOp_Mode8:
+            {
+                uint32_t bits = 1u << ((opcode & ~kLutOp_DdrFlag) - kLutOp_Mode1);
+                phase->type   = kNorEmuPhase_Mode;
+                phase->bits   = (uint8_t)bits;
+                phase->value  = operand & ((1u << bits) - 1u);
+                *phaseSum += ((bits + pads - 1u) / pads) * rate;
+                break;
+            }
+            case kLutOp_Dummy:
+            case kLutOp_DummyRwds:
+            case kLutOp_Learn:
+                phase->type = kNorEmuPhase_Dummy;
+                phase->bits = (uint8_t)operand;
+                *phaseSum += ddr ? operand : operand * 2u;
+                break;
+            case kLutOp_Read:
+            case kLutOp_Write:
+                phase->type     = ((opcode & ~kLutOp_DdrFlag) == kLutOp_Read) ? kNorEmuPhase_Read : kNorEmuPhase_Write;
+                ctrl->dataRead  = (phase->type == kNorEmuPhase_Read);
+                ctrl->dataWrite = !ctrl->dataRead;
+                // With IDATSZ = 0 the instruction operand gives the data size, used by config commands
+                ctrl->dataSize = ctrl->ipSize ? ctrl->ipSize : operand;
+                // Each device of a parallel pair carries half of the data
+                ctrl->bytePs = (8u / pads ? 8u / pads : 1u) * rate * halfPs;
+                if (ctrl->parallel)
+                {
+                    ctrl->bytePs /= 2u;
+                }
+                phaseSum = &tail;
+                break;
+            case kLutOp_JmpOnCs:
+                return kIpCmdError_JumpOnCs;
+            default:
+                return kIpCmdError_UnknownOpCode;
+        }
+        if (xfer->phaseCount < NOR_EMU_MAX_PHASES)
+        {
+            xfer->phaseCount++;
+        }
+    }
+
+    ctrl->headerPs = header * halfPs;
+    ctrl->tailPs   = tail * halfPs;
+    ctrl->csIntervalPs =
+        (uint64_t)FLSHCR1_CSINTERVAL(flshcr1) * (FLSHCR1_CSINTERVALUNIT(flshcr1) ? 256u : 1u) * sckPs;
+    ctrl->state = kEngine_Header;
+    ctrl->t     = start;
+    ctrl->stats.sequences++;
+
+    // Read data is sampled from the device when the sequence starts.
+    if (ctrl->dataRead)
+    {
+        ctrl->dataBase = ctrl->rxProduced;
+        if (ctrl->dataBase + ctrl->dataSize > XFER_MAX)
+        {
+            ctrl->dataBase = 0;
+        }
+        uint8_t *dst = &ctrl->rxData[ctrl->dataBase];
+        memset(dst, 0xFF, ctrl->dataSize);
+        if (ctrl->parallel)
+        {
+            uint8_t half[0x10000];
+            uint32_t halfSize = ctrl->dataSize / 2u;
+            for (uint32_t dev = 0; dev < 2; dev++)
+            {
+                uint32_t port = ctrl->port + dev * 2u;
+                if (ctrl->connected[port])
+                {
+                    xfer->data     = half;
+                    xfer->dataSize = halfSize;
+                    nor_emu_execute(&ctrl->device[port], xfer, start);
+                    for (uint32_t i = 0; i < halfSize; i++)
+                    {
+                        dst[i * 2u + dev] = half[i];
+                    }
+                }
+            }
+        }
+        else if (ctrl->connected[ctrl->port])
+        {
+            xfer->data     = dst;
+            xfer->dataSize = ctrl->dataSize;
+            nor_emu_execute(&ctrl->device[ctrl->port], xfer, start);
+        }
+    }
+    else if (ctrl->dataWrite)
+    {
+        ctrl->dataBase = ctrl->txConsumed;
+    }
+
+    return 0;
+}
+
+// Apply the current sequence to the device(s) when chip select is released
+static void emu_end_sequence(flexspi_emu_ctrl_t *ctrl)
+{
+    uint64_t end         = ctrl->t;
+    nor_emu_xfer_t *xfer = &ctrl->xfer;
+
+    if (!ctrl->dataRead)
+    {
+        uint8_t *src = &ctrl->txData[ctrl->dataBase];
+        if (ctrl->parallel)
+        {
+            uint8_t half[0x10000];
+            uint32_t halfSize = ctrl->dataSize / 2u;
+            for (uint32_t dev = 0; dev < 2; dev++)
+            {
+                uint32_t port = ctrl->port + dev * 2u;
+                for (uint32_t i = 0; i < halfSize; i++)
+                {
+                    half[i] = src[i * 2u + dev];
+                }
+                if (ctrl->connected[port])
+                {
+                    xfer->data     = ctrl->dataWrite ? half : NULL;
+                    xfer->dataSize = ctrl->dataWrite ? halfSize : 0;
+                    nor_emu_execute(&ctrl->device[port], xfer, end);
+                }
+            }
+        }
+        else if (ctrl->connected[ctrl->port])
+        {
+            xfer->data     = ctrl->dataWrite ? src : NULL;
+            xfer->dataSize = ctrl->dataWrite ? ctrl->dataSize : 0;
+            nor_emu_execute(&ctrl->device[ctrl->port], xfer, end);
+        }
+    }
+
+    // The CPU keeps polling the status register until the device is ready, so with a stable poll period
+    // the polls in between can be skipped without changing the time the ready status is observed. The
+    // period must have been the same twice, a poll loop with back-off changes it from one poll to the next.
+    if (xfer->idleUntil > end)
+    {
+        uint64_t period = (ctrl->lastBusyPoll && (end > ctrl->lastBusyPoll)) ? (end - ctrl->lastBusyPoll) : 0;
+        if (s_fastPoll && period && (period == ctrl->lastPollPeriod))
+        {
+            uint64_t polls = (xfer->idleUntil - end) / period;
+            if (polls > 1)
+            {
+                polls -= 1;
+                ctrl->stats.skipped_polls += polls;
+                s_now += polls * period;
+                end += polls * period;
+            }
+        }
+        ctrl->lastPollPeriod = period;
+        ctrl->lastBusyPoll   = end;
+    }
+    else if (ctrl->dataRead)
+    {
+        ctrl->lastBusyPoll   = 0;
+        ctrl->lastPollPeriod = 0;
+    }
+
+    ctrl->lastCsHigh = end;
+    if (--ctrl->seqLeft)
+    {
+        ctrl->seqId = (ctrl->seqId + 1u) & 0xFu;
+        uint32_t err = emu_start_sequence(ctrl, end + ctrl->csIntervalPs);
+        if (err)
+        {
+            emu_set_error(ctrl, err);
+        }
+    }
+    else
+    {
+        ctrl->state = kEngine_Idle;
+        ctrl->intr |= INTR_IPCMDDONE;
+        ctrl->stats.busy_ps += end - ctrl->cmdStart;
+    }
+}
+
+// Move the command engine forward to virtual time now
+static void emu_advance_engine(flexspi_emu_ctrl_t *ctrl, uint64_t now)
+{
+    emu_dma_service(ctrl);
+    while (ctrl->state != kEngine_Idle)
+    {
+        if (ctrl->state == kEngine_Header)
+        {
+            if (now < ctrl->t + ctrl->headerPs)
+            {
+                return;
+            }
+            ctrl->t += ctrl->headerPs;
+            ctrl->state = (ctrl->dataSize && (ctrl->dataRead || ctrl->dataWrite)) ? kEngine_Data : kEngine_Tail;
+        }
+        else if (ctrl->state == kEngine_Data)
+        {
+            uint64_t possible  = ctrl->bytePs ? (now - ctrl->t) / ctrl->bytePs : (now - ctrl->t);
+            uint32_t remaining = ctrl->dataSize - ctrl->dataDone;
+            uint32_t capacity;
+            if (ctrl->dataRead)
+            {
+                capacity = FIFO_SIZE - (ctrl->rxProduced - ctrl->rxPopped);
+            }
+            else
+            {
+                capacity = ctrl->txPushed - ctrl->txConsumed;
+            }
+            uint32_t n = remaining;
+            if (n > capacity)
+            {
+                n = capacity;
+            }
+            if (n > possible)
+            {
+                n = (uint32_t)possible;
+            }
+            ctrl->dataDone += n;
+            ctrl->t += (uint64_t)n * ctrl->bytePs;
+            if (ctrl->dataRead)
+            {
+                ctrl->rxProduced += n;
+                ctrl->stats.rx_bytes += n;
+                ctrl->rxDirty = true;
+            }
+            else
+            {
+                ctrl->txConsumed += n;
+                ctrl->stats.tx_bytes += n;
+            }
+            // DMA requests are served as soon as the FIFO crosses its watermark
+            bool served = emu_dma_service(ctrl);
+            if (ctrl->dataDone == ctrl->dataSize)
+            {
+                ctrl->state = kEngine_Tail;
+                continue;
+            }
+            if ((n < possible) && served)
+            {
+                continue;
+            }
+            if (n < possible)
+            {
+                // Serial clock is stopped until the CPU serves the FIFO
+                ctrl->stats.stall_ps += now - ctrl->t;
+                ctrl->t = now;
+            }
+            return;
+        }
+        else
+        {
+            if (now < ctrl->t + ctrl->tailPs)
+            {
+                return;
+            }
+            ctrl->t += ctrl->tailPs;
+            emu_end_sequence(ctrl);
+        }
+    }
+}
+
+// Time of the next state change visible to the CPU, 0 if the engine waits for the CPU
+static uint64_t emu_next_event(flexspi_emu_ctrl_t *ctrl)
+{
+    switch (ctrl->state)
+    {
+        case kEngine_Header:
+            return ctrl->t + ctrl->headerPs;
+        case kEngine_Tail:
+            return ctrl->t + ctrl->tailPs;
+        case kEngine_Data:
+        {
+            uint32_t remaining = ctrl->dataSize - ctrl->dataDone;
+            uint32_t capacity  = ctrl->dataRead ? (FIFO_SIZE - (ctrl->rxProduced - ctrl->rxPopped)) :
+                                                 (ctrl->txPushed - ctrl->txConsumed);
+            uint32_t n         = remaining < capacity ? remaining : capacity;
+            if (n == 0)
+            {
+                return 0;
+            }
+            if (n > 8u)
+            {
+                n = 8u;
+            }
+            return ctrl->t + (uint64_t)n * ctrl->bytePs;
+        }
+        default:
+            return 0;
+    }
+}
+
+// Mirror the head of the RX FIFO into RFDR
+static void emu_update_rfdr(flexspi_emu_ctrl_t *ctrl)
+{
+    uint32_t fill = ctrl->rxProduced - ctrl->rxPopped;
+    uint8_t window[FIFO_SIZE];
+
+    memset(window, 0, sizeof(window));
+    memcpy(window, &ctrl->rxData[ctrl->rxPopped], fill > FIFO_SIZE ? FIFO_SIZE : fill);
+    memcpy((void *)&ctrl->reg[kReg_RFDR / 4], window, sizeof(window));
+    ctrl->rxDirty = false;
+}
+
+static void emu_trigger(flexspi_emu_ctrl_t *ctrl)
+{
+    uint32_t ipcr1 = ctrl->reg[kReg_IPCR1 / 4];
+
+    ctrl->stats.ip_cmds++;
+    if (ctrl->state != kEngine_Idle)
+    {
+        // IP command is granted only when the arbitrator is idle.
+        return;
+    }
+
+    ctrl->ipAddr   = ctrl->reg[kReg_IPCR0 / 4];
+    ctrl->ipSize   = IPCR1_IDATSZ(ipcr1);
+    ctrl->seqId    = IPCR1_ISEQID(ipcr1);
+    ctrl->seqLeft  = IPCR1_ISEQNUM(ipcr1) + 1u;
+    ctrl->parallel = IPCR1_IPAREN(ipcr1);
+    ctrl->cmdStart = s_now;
+    ctrl->intr &= ~INTR_IPCMDDONE;
+
+    if (!emu_select_port(ctrl, ctrl->ipAddr, &ctrl->port, &ctrl->devAddr))
+    {
+        emu_set_error(ctrl, kIpCmdError_InvalidAddress);
+        return;
+    }
+    if (ctrl->parallel)
+    {
+        ctrl->port &= 1u;
+        ctrl->devAddr /= 2u;
+    }
+
+    uint64_t start = s_now;
+    if (start < ctrl->lastCsHigh + ctrl->csIntervalPs)
+    {
+        start = ctrl->lastCsHigh + ctrl->csIntervalPs;
+    }
+    uint32_t err = emu_start_sequence(ctrl, start);
+    if (err)
+    {
+        emu_set_error(ctrl, err);
+    }
+}
+
+static uint32_t emu_read_value(flexspi_emu_ctrl_t *ctrl, uint32_t offset)
+{
+    switch (offset)
+    {
+        case kReg_MCR0:
+            return ctrl->reg[kReg_MCR0 / 4] & ~MCR0_SWRESET;
+        case kReg_INTR:
+        {
+            uint32_t value = ctrl->intr;
+            if ((ctrl->rxProduced - ctrl->rxPopped) >= emu_rx_watermark(ctrl))
+            {
+                value |= INTR_IPRXWA;
+            }
+            if ((FIFO_SIZE - (ctrl->txPushed - ctrl->txConsumed)) >= emu_tx_watermark(ctrl))
+            {
+                value |= INTR_IPTXWE;
+            }
+            return value;
+        }
+        case kReg_STS0:
+            return (ctrl->state == kEngine_Idle) ? STS0_IDLE : 0u;
+        case kReg_STS1:
+            return ctrl->sts1;
+        case kReg_IPRXFSTS:
+        {
+            uint32_t fill = ctrl->rxProduced - ctrl->rxPopped;
+            // A partial entry is visible once the whole transfer has been received
+            fill = (ctrl->state == kEngine_Idle) ? (fill + 7u) / 8u : fill / 8u;
+            return fill | ((ctrl->rxProduced / 8u) << 16);
+        }
+        case kReg_IPTXFSTS:
+            return ((ctrl->txPushed - ctrl->txConsumed) / 8u) | ((ctrl->txConsumed / 8u) << 16);
+        default:
+            return ctrl->reg[offset / 4];
+    }
+}
+
+static int32_t emu_poll_index(uint32_t offset)
+{
+    switch (offset)
+    {
+        case kReg_MCR0:
+            return kPoll_MCR0;
+        case kReg_INTR:
+            return kPoll_INTR;
+        case kReg_STS0:
+            return kPoll_STS0;
+        case kReg_IPRXFSTS:
+            return kPoll_IPRXFSTS;
+        case kReg_IPTXFSTS:
+            return kPoll_IPTXFSTS;
+        default:
+            return -1;
+    }
+}
+
+// See flexspi_emu.h for more details.
+uint32_t flexspi_emu_reg_read(const volatile void *reg)
+{
+    uint32_t offset;
+    flexspi_emu_ctrl_t *ctrl = emu_find_ctrl(reg, &offset);
+
+    flexspi_emu_cpu_cycles(FLEXSPI_EMU_REG_ACCESS_CYCLES);
+    ctrl->stats.reg_reads++;
+    emu_advance_engine(ctrl, s_now);
+
+    uint32_t value = emu_read_value(ctrl, offset);
+    int32_t poll   = emu_poll_index(offset);
+    if (poll >= 0)
+    {
+        // Same value as the last read of this register: the CPU is spinning, skip to the next event.
+        if (ctrl->pollValid[poll] && (ctrl->pollValue[poll] == value))
+        {
+            uint64_t next = emu_next_event(ctrl);
+            if (next > s_now)
+            {
+                s_now = next;
+                emu_check_hang();
+                emu_advance_engine(ctrl, s_now);
+                value = emu_read_value(ctrl, offset);
+            }
+        }
+        ctrl->pollValid[poll] = true;
+        ctrl->pollValue[poll] = value;
+    }
+    if (ctrl->rxDirty)
+    {
+        emu_update_rfdr(ctrl);
+    }
+    return value;
+}
+
+// See flexspi_emu.h for more details.
+void flexspi_emu_reg_write(volatile void *reg, uint32_t value)
+{
+    uint32_t offset;
+    flexspi_emu_ctrl_t *ctrl = emu_find_ctrl(reg, &offset);
+
+    flexspi_emu_cpu_cycles(FLEXSPI_EMU_REG_ACCESS_CYCLES);
+    ctrl->stats.reg_writes++;
+    emu_advance_engine(ctrl, s_now);
+    memset(ctrl->pollValid, 0, sizeof(ctrl->pollValid));
+
+    switch (offset)
+    {
+        case kReg_MCR0:
+            if (value & MCR0_SWRESET)
+            {
+                // Software reset flushes AHB buffers and IP FIFOs and aborts the running sequence
+                ctrl->state      = kEngine_Idle;
+                ctrl->rxProduced = 0;
+                ctrl->rxPopped   = 0;
+                ctrl->txPushed   = 0;
+                ctrl->txConsumed = 0;
+                ctrl->rxDirty    = true;
+                ctrl->stats.swresets++;
+                s_now += FLEXSPI_EMU_SWRESET_CYCLES * emu_sck_period(ctrl, false);
+                emu_check_hang();
+            }
+            ctrl->reg[offset / 4] = value & ~MCR0_SWRESET;
+            break;
+        case kReg_INTR:
+            if (value & INTR_IPRXWA)
+            {
+                emu_pop_rx(ctrl);
+            }
+            if (value & INTR_IPTXWE)
+            {
+                emu_push_tx(ctrl);
+            }
+            ctrl->intr &= ~value;
+            break;
+        case kReg_LUTCR:
+            if (value & LUTCR_UNLOCK)
+            {
+                ctrl->stats.lut_unlocks++;
+            }
+            ctrl->reg[offset / 4] = value;
+            break;
+        case kReg_IPCMD:
+            if (value & IPCMD_TRG)
+            {
+                emu_trigger(ctrl);
+            }
+            break;
+        case kReg_IPRXFCR:
+            if (value & IPFCR_CLR)
+            {
+                ctrl->rxProduced = 0;
+                ctrl->rxPopped   = 0;
+                ctrl->rxDirty    = true;
+            }
+            ctrl->reg[offset / 4] = value & ~IPFCR_CLR;
+            break;
+        case kReg_IPTXFCR:
+            if (value & IPFCR_CLR)
+            {
+                ctrl->txPushed   = 0;
+                ctrl->txConsumed = 0;
+            }
+            ctrl->reg[offset / 4] = value & ~IPFCR_CLR;
+            break;
+        case kReg_FLSHCR2:
+        case kReg_FLSHCR2 + 4:
+        case kReg_FLSHCR2 + 8:
+        case kReg_FLSHCR2 + 12:
+            ctrl->reg[offset / 4] = value & ~FLSHCR2_CLRINSTRPTR;
+            break;
+        case kReg_STS0:
+        case kReg_STS1:
+        case kReg_IPRXFSTS:
+        case kReg_IPTXFSTS:
+            // Read-only
+            break;
+        default:
+            ctrl->reg[offset / 4] = value;
+            break;
+    }
+
+    emu_advance_engine(ctrl, s_now);
+    if (ctrl->rxDirty)
+    {
+        emu_update_rfdr(ctrl);
+    }
+}
+
+// Cost of the AHB read sequence of a port in half serial clock cycles, false if the sequence has no read
+static bool emu_ahb_sequence_cost(
+    flexspi_emu_ctrl_t *ctrl, uint32_t port, uint64_t *header, uint64_t *tail, uint64_t *perByte, bool *ddrSequence)
+{
+    uint32_t seqId     = FLSHCR2_ARDSEQID(ctrl->reg[kReg_FLSHCR2 / 4 + port]);
+    uint32_t flshcr1   = ctrl->reg[kReg_FLSHCR1 / 4 + port];
+    uint64_t *phaseSum = header;
+    bool read          = false;
+
+    *header      = 2u * (FLSHCR1_TCSS(flshcr1) + 1u);
+    *tail        = 2u * (FLSHCR1_TCSH(flshcr1) + 1u);
+    *perByte     = 0;
+    *ddrSequence = false;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint32_t word    = ctrl->reg[kReg_LUT / 4 + seqId * 4 + i / 2];
+        uint16_t inst    = (uint16_t)((i & 1u) ? (word >> 16) : word);
+        uint32_t opcode  = inst >> 10;
+        uint32_t pads    = 1u << ((inst >> 8) & 0x3u);
+        uint32_t operand = inst & 0xFFu;
+        bool ddr         = (opcode != kLutOp_JmpOnCs) && (opcode & kLutOp_DdrFlag);
+        uint32_t rate    = ddr ? 1u : 2u;
+
+        if (opcode == kLutOp_Stop)
+        {
+            break;
+        }
+        *ddrSequence = *ddrSequence || ddr;
+        switch (opcode & ~kLutOp_DdrFlag)
+        {
+            case kLutOp_Cmd:
+            case kLutOp_DataSize:
+                *phaseSum += (8u / pads ? 8u / pads : 1u) * rate;
+                break;
+            case kLutOp_RowAddr:
+            case kLutOp_ColAddr:
+                *phaseSum += ((operand + pads - 1u) / pads) * rate;
+                break;
+            case kLutOp_Mode1:
+            case kLutOp_Mode2:
+            case kLutOp_Mode4:
+            case kLutOp_Mode8:
+            {
+                uint32_t bits = 1u << ((opcode & ~kLutOp_DdrFlag) - kLutOp_Mode1);
+                *phaseSum += ((bits + pads - 1u) / pads) * rate;
+                break;
+            }
+            case kLutOp_Dummy:
+            case kLutOp_DummyRwds:
+            case kLutOp_Learn:
+                *phaseSum += ddr ? operand : operand * 2u;
+                break;
+            case kLutOp_Read:
+                *perByte = (8u / pads ? 8u / pads : 1u) * rate;
+                read     = true;
+                phaseSum = tail;
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return read;
+}
+
+// See flexspi_emu.h for more details.
+uint64_t flexspi_emu_ahb_read_time(flexspi_emu_ctrl_t *ctrl, uint32_t address, uint32_t size, uint32_t accessSize)
+{
+    uint32_t port;
+    uint32_t devAddr;
+    uint64_t header;
+    uint64_t tail;
+    uint64_t perByte;
+    bool ddrSequence;
+
+    if ((size == 0) || (accessSize == 0) || (accessSize & (accessSize - 1u)) ||
+        !emu_select_port(ctrl, address - ctrl->ahbBase, &port, &devAddr) ||
+        !emu_ahb_sequence_cost(ctrl, port, &header, &tail, &perByte, &ddrSequence))
+    {
+        return 0;
+    }
+
+    uint32_t ahbcr    = ctrl->reg[kReg_AHBCR / 4];
+    uint32_t flshcr1  = ctrl->reg[kReg_FLSHCR1 / 4 + port];
+    uint64_t halfPs   = emu_sck_period(ctrl, ddrSequence) / 2u;
+    uint64_t headerPs = header * halfPs;
+    uint64_t tailPs   = tail * halfPs;
+    uint64_t bytePs   = perByte * halfPs;
+    uint64_t csIntervalPs =
+        (uint64_t)FLSHCR1_CSINTERVAL(flshcr1) * (FLSHCR1_CSINTERVALUNIT(flshcr1) ? 256u : 1u) * halfPs * 2u;
+    uint64_t accessPs = (uint64_t)FLEXSPI_EMU_AHB_ACCESS_CYCLES * FLEXSPI_EMU_PS_PER_S / s_coreClockHz;
+
+    // Each device of a parallel pair carries half of the data
+    if (ahbcr & AHBCR_APAREN)
+    {
+        bytePs /= 2u;
+    }
+
+    // The core (master 0) reads through its own buffer if it has a size, through the last buffer otherwise
+    uint32_t bufcr = ctrl->reg[kReg_AHBRXBUFCR0 / 4 + AHBRXBUF_COUNT - 1u];
+    for (uint32_t n = 0; n < AHBRXBUF_COUNT - 1u; n++)
+    {
+        uint32_t value = ctrl->reg[kReg_AHBRXBUFCR0 / 4 + n];
+        if ((AHBRXBUFCR0_MSTRID(value) == 0) && AHBRXBUFCR0_BUFSZ(value))
+        {
+            bufcr = value;
+            break;
+        }
+    }
+
+    // Without prefetch a sequence reads the access, 8 bytes at least, with it the whole buffer
+    uint32_t burst = (accessSize + 7u) & ~7u;
+    if ((ahbcr & AHBCR_PREFETCHEN) && (bufcr & AHBRXBUFCR0_PREFETCHEN) && (AHBRXBUFCR0_BUFSZ(bufcr) * 8u > burst))
+    {
+        burst = AHBRXBUFCR0_BUFSZ(bufcr) * 8u;
+    }
+
+    uint64_t t          = 0;
+    uint64_t dataStart  = 0;
+    uint64_t lastCsHigh = 0;
+    uint32_t bufStart   = 0;
+    uint32_t bufEnd     = 0;
+    uint32_t end        = address + size;
+
+    // A read missing the buffer starts a sequence at the access, a read hitting it waits for its last byte
+    for (uint32_t addr = address & ~(accessSize - 1u); addr < end; addr += accessSize)
+    {
+        if ((addr < bufStart) || (addr + accessSize > bufEnd))
+        {
+            uint64_t start = (lastCsHigh && (lastCsHigh + csIntervalPs > t)) ? lastCsHigh + csIntervalPs : t;
+            bufStart       = addr;
+            bufEnd         = addr + burst;
+            dataStart      = start + headerPs;
+            lastCsHigh     = dataStart + burst * bytePs + tailPs;
+        }
+        uint64_t ready = dataStart + (uint64_t)(addr + accessSize - bufStart) * bytePs;
+        t              = ((ready > t) ? ready : t) + accessPs;
+    }
+
+    return t;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __FLEXSPI_EMU_H__
+#define __FLEXSPI_EMU_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "nor_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Virtual time base, all timestamps are in pico-seconds
+#define FLEXSPI_EMU_PS_PER_US (1000000ULL)
+#define FLEXSPI_EMU_PS_PER_MS (1000000000ULL)
+#define FLEXSPI_EMU_PS_PER_S (1000000000000ULL)
+
+//!@brief Max FlexSPI controllers that can be emulated at the same time
+#define FLEXSPI_EMU_MAX_CONTROLLERS (2)
+
+//!@brief Core cycles consumed by one __NOP() in a delay loop (NOP + decrement + compare + branch)
+#define FLEXSPI_EMU_NOP_LOOP_CYCLES (3)
+
+//!@brief Core cycles consumed by one FlexSPI register access over the IP bus
+#define FLEXSPI_EMU_REG_ACCESS_CYCLES (8)
+
+//!@brief Core cycles of one AHB read served from the AHB RX buffer, see flexspi_emu_ahb_read_time
+#define FLEXSPI_EMU_AHB_ACCESS_CYCLES (16)
+
+//!@brief Controller cycles (serial root clock) spent by MCR0[SWRESET]
+#define FLEXSPI_EMU_SWRESET_CYCLES (64)
+
+//!@brief Virtual time limit, an algorithm that runs longer than this is considered as hung
+#define FLEXSPI_EMU_HANG_LIMIT_PS (3600ULL * FLEXSPI_EMU_PS_PER_S)
+
+//!@brief Chip selects of one FlexSPI controller
+enum
+{
+    kFlexSpiEmuPort_A1,
+    kFlexSpiEmuPort_A2,
+    kFlexSpiEmuPort_B1,
+    kFlexSpiEmuPort_B2,
+    kFlexSpiEmuPort_Count,
+};
+
+//!@brief Callback to query the current serial root clock of a FlexSPI instance, in Hz
+typedef uint32_t (*flexspi_emu_clock_fn_t)(uint32_t instance);
+
+//!@brief Statistics collected by the controller model
+typedef struct _flexspi_emu_stats
+{
+    uint64_t reg_reads;     //!< IP bus register reads
+    uint64_t reg_writes;    //!< IP bus register writes
+    uint64_t ip_cmds;       //!< IPCMD[TRG] events
+    uint64_t ip_cmd_errors; //!< IP commands that ended with INTR[IPCMDERR]
+    uint64_t sequences;     //!< LUT sequences executed (one chip select assertion each)
+    uint64_t lut_unlocks;   //!< LUTCR unlock events, i.e. LUT updates
+    uint64_t swresets;      //!< MCR0[SWRESET] events, i.e. AHB buffer flushes
+    uint64_t tx_bytes;      //!< Bytes moved through the IP TX FIFO
+    uint64_t rx_bytes;      //!< Bytes moved through the IP RX FIFO
+    uint64_t stall_ps;      //!< Time the serial clock was stopped by an empty TX or full RX FIFO
+    uint64_t busy_ps;       //!< Time spent executing IP sequences
+    uint64_t skipped_polls; //!< Busy status reads skipped by the fast poll, see flexspi_emu_set_fast_poll
+    uint64_t dma_bytes;     //!< Bytes moved between memory and the IP FIFOs by the eDMA model
+    uint64_t dma_errors;    //!< Bus errors raised by the eDMA model
+} flexspi_emu_stats_t;
+
+//!@brief Opaque FlexSPI controller model
+typedef struct _flexspi_emu_ctrl flexspi_emu_ctrl_t;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//!@brief Map the SoC address space (peripherals, OCRAM, SCS) used by the algorithms at their target addresses
+int flexspi_emu_map_soc(void);
+
+//!@brief Map a zero-filled region at a fixed target address, returns the host pointer or NULL
+void *flexspi_emu_map_region(uint32_t address, uint32_t size);
+
+//!@brief Attach a FlexSPI controller model to the register block at regBase
+//!
+//! Registers must have been mapped by flexspi_emu_map_soc. The AHB window at ahbBase is
+//! mapped on demand and backs the memory array of all attached devices.
+flexspi_emu_ctrl_t *flexspi_emu_attach(uint32_t instance,
+                                       uint32_t regBase,
+                                       uint32_t ahbBase,
+                                       flexspi_emu_clock_fn_t getSerialRootClock);
+
+//!@brief Attach an eDMA and DMAMUX model serving the IP FIFO DMA requests of the controller
+//!
+//! Registers must have been mapped by flexspi_emu_map_soc. While IPRXFCR[RXDMAEN] or IPTXFCR[TXDMAEN] is set,
+//! each FIFO watermark request runs one minor loop of the channel that the DMAMUX routes rxSource or txSource
+//! to and has its ERQ bit set, then CITER, the addresses, CSR[DONE] and ERQ are updated as by the hardware.
+//! A beat outside the regions mapped by flexspi_emu_map_region is a bus error: ES and ERR are set and the channel
+//! is halted until its ERR bit is cleared through CERR.
+//! Like the CPU copies to RFDR/TFDR, the transfers take no virtual time.
+void flexspi_emu_attach_dma(
+    flexspi_emu_ctrl_t *ctrl, uint32_t dmaBase, uint32_t dmamuxBase, uint32_t rxSource, uint32_t txSource);
+
+//!@brief Connect a serial NOR device to the specified chip select of the controller
+//!
+//! The device array is placed in the AHB window in A1, A2, B1, B2 order, matching FLSHCR0.
+nor_emu_device_t *flexspi_emu_connect(flexspi_emu_ctrl_t *ctrl, uint32_t port, const nor_emu_part_t *part);
+
+//!@brief Get the device connected to the specified chip select, NULL if there is none
+nor_emu_device_t *flexspi_emu_get_device(flexspi_emu_ctrl_t *ctrl, uint32_t port);
+
+//!@brief Get the controller statistics
+const flexspi_emu_stats_t *flexspi_emu_get_stats(flexspi_emu_ctrl_t *ctrl);
+
+//!@brief Reset controller and device statistics
+void flexspi_emu_reset_stats(flexspi_emu_ctrl_t *ctrl);
+
+//!@brief Set core clock used to convert CPU cycles into virtual time
+void flexspi_emu_set_core_clock(uint32_t coreClockHz);
+
+//!@brief Enable or disable the fast poll (enabled by default)
+//!
+//! When a device stays busy, status polls issued with a stable period are skipped by advancing
+//! the virtual time, which keeps long erase operations fast to simulate. Polls skipped are still
+//! accounted in the virtual time, so throughput numbers are the same with or without it.
+void flexspi_emu_set_fast_poll(bool enable);
+
+//!@brief Get current virtual time
+uint64_t flexspi_emu_now(void);
+
+//!@brief Advance virtual time by the specified core cycles
+void flexspi_emu_cpu_cycles(uint32_t cycles);
+
+//!@brief Get the virtual time in core cycles, wrapping like DWT CYCCNT
+uint32_t flexspi_emu_get_cycles(void);
+
+//!@brief Advance virtual time by the specified pico-seconds
+void flexspi_emu_advance(uint64_t ps);
+
+//!@brief Virtual time the core takes to read size bytes from address through the AHB window, in pico-seconds
+//!
+//! The AHB window is plain memory on the host, the reads of the algorithms take no virtual time. This times a
+//! sequential read from the registers the algorithm left: the AHB read sequence of FLSHCR2, its serial clock,
+//! AHBCR and the AHB RX buffer of the core. accessSize is the bytes of one AHB read, 32 for the line fills of a
+//! cached window, 4 for the word reads of an uncached one. A read that misses the buffer starts a read sequence
+//! of the whole buffer with prefetch, of the access without, and every read costs FLEXSPI_EMU_AHB_ACCESS_CYCLES
+//! once its data arrived. The virtual time is not advanced.
+uint64_t flexspi_emu_ahb_read_time(flexspi_emu_ctrl_t *ctrl, uint32_t address, uint32_t size, uint32_t accessSize);
+
+//!@brief Hooks called by the register proxies, see host/flexspi_emu_regs.h
+uint32_t flexspi_emu_reg_read(const volatile void *reg);
+void flexspi_emu_reg_write(volatile void *reg, uint32_t value);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // __FLEXSPI_EMU_H__
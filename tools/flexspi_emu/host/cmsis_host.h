@@ -0,0 +1,104 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __CMSIS_HOST_H__
+#define __CMSIS_HOST_H__
+
+#include <stdint.h>
+
+#include "flexspi_emu.h"
+
+//!@brief Host replacement of cmsis_compiler.h, core intrinsics are modelled by the emulator
+#define __CMSIS_COMPILER_H
+
+#define __ASM __asm
+#define __INLINE inline
+#define __STATIC_INLINE static inline
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#define __NO_RETURN __attribute__((__noreturn__))
+#define __USED __attribute__((used))
+#define __WEAK __attribute__((weak))
+#define __PACKED __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#define __RESTRICT __restrict
+#define __COMPILER_BARRIER() __asm volatile("" ::: "memory")
+
+#define __UNALIGNED_UINT16_READ(addr) (*(const uint16_t *)(addr))
+#define __UNALIGNED_UINT16_WRITE(addr, val) ((void)(*(uint16_t *)(addr) = (val)))
+#define __UNALIGNED_UINT32_READ(addr) (*(const uint32_t *)(addr))
+#define __UNALIGNED_UINT32_WRITE(addr, val) ((void)(*(uint32_t *)(addr) = (val)))
+
+//!@brief The trace of the middleware counts core cycles of the virtual time, DWT is plain memory here
+#define FLEXSPI_TRACE_GET_CYCLES() flexspi_emu_get_cycles()
+
+//!@brief A __NOP() is always part of a software delay loop in the algorithms
+__STATIC_FORCEINLINE void __NOP(void)
+{
+    flexspi_emu_cpu_cycles(FLEXSPI_EMU_NOP_LOOP_CYCLES);
+}
+
+__STATIC_FORCEINLINE void __DSB(void)
+{
+    __COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE void __ISB(void)
+{
+    __COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE void __DMB(void)
+{
+    __COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE void __WFI(void)
+{
+}
+
+__STATIC_FORCEINLINE void __WFE(void)
+{
+}
+
+__STATIC_FORCEINLINE void __SEV(void)
+{
+}
+
+static uint32_t s_hostPrimask;
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)
+{
+    return s_hostPrimask;
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask)
+{
+    s_hostPrimask = priMask;
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+    s_hostPrimask = 1;
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+    s_hostPrimask = 0;
+}
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value)
+{
+    return __builtin_bswap32(value);
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+    return value ? (uint8_t)__builtin_clz(value) : 32u;
+}
+
+#endif // __CMSIS_HOST_H__
@@ -0,0 +1,14 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __HOST_CORE_CM7_H__
+#define __HOST_CORE_CM7_H__
+
+//!@brief Host build of core_cm7.h, intrinsics are provided by cmsis_host.h instead of cmsis_gcc.h
+#include "cmsis_host.h"
+#include_next <core_cm7.h>
+
+#endif // __HOST_CORE_CM7_H__
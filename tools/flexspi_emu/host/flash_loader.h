@@ -0,0 +1,45 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __HOST_FLASH_LOADER_H__
+#define __HOST_FLASH_LOADER_H__
+
+#include <stdint.h>
+
+//!@brief Host replacement of the IAR flash loader framework API declarations
+//!
+//! The loader project provides flash_config.h, the framework entry points are called by the bench.
+#include "flash_config.h"
+
+#define RESULT_OK 0
+#define RESULT_ERROR 1
+
+#define FLAG_ERASE_ONLY 0x1
+#define FLAG_MASS_ERASE 0x2
+
+#define OPTIONAL_CHECKSUM
+#define OPTIONAL_SIGNOFF
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if USE_ARGC_ARGV
+uint32_t FlashInit(void *base_of_flash, uint32_t image_size, uint32_t link_address, uint32_t flags, int argc,
+                   char const *argv[]);
+#else
+uint32_t FlashInit(void *base_of_flash, uint32_t image_size, uint32_t link_address, uint32_t flags);
+#endif
+uint32_t FlashWrite(void *block_start, uint32_t offset_into_block, uint32_t count, char const *buffer);
+uint32_t FlashErase(void *block_start, uint32_t block_size);
+uint32_t FlashChecksum(void const *begin, uint32_t count);
+uint32_t FlashSignoff(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // __HOST_FLASH_LOADER_H__
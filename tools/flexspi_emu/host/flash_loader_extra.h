@@ -0,0 +1,26 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __HOST_FLASH_LOADER_EXTRA_H__
+#define __HOST_FLASH_LOADER_EXTRA_H__
+
+#include <stdint.h>
+
+//!@brief Host replacement of the IAR flash loader framework helpers, provided by the bench
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+uint16_t Crc16(uint8_t const *p, uint32_t len);
+
+//!@brief ROM API table setup of the loader, the bench links the middleware in place of the ROM
+void bl_api_init(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // __HOST_FLASH_LOADER_EXTRA_H__
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __FLEXSPI_EMU_REGS_H__
+#define __FLEXSPI_EMU_REGS_H__
+
+#if !defined(__cplusplus)
+#error "flexspi_emu_regs.h is only used by the FlexSPI driver built as C++"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flexspi_emu.h"
+
+//!@brief FlexSPI register proxy, reads and writes are forwarded to the controller model
+struct flexspi_emu_reg_t
+{
+    uint32_t value;
+
+    operator uint32_t() const volatile { return flexspi_emu_reg_read(this); }
+    // Assignments yield the value written like on a plain volatile register, a volatile reference to the
+    // proxy would be an implicit read the driver discards
+    uint32_t operator=(uint32_t v) volatile
+    {
+        flexspi_emu_reg_write(this, v);
+        return v;
+    }
+    uint32_t operator|=(uint32_t v) volatile
+    {
+        v |= flexspi_emu_reg_read(this);
+        flexspi_emu_reg_write(this, v);
+        return v;
+    }
+    uint32_t operator&=(uint32_t v) volatile
+    {
+        v &= flexspi_emu_reg_read(this);
+        flexspi_emu_reg_write(this, v);
+        return v;
+    }
+    uint32_t operator^=(uint32_t v) volatile
+    {
+        v ^= flexspi_emu_reg_read(this);
+        flexspi_emu_reg_write(this, v);
+        return v;
+    }
+};
+
+static_assert(sizeof(flexspi_emu_reg_t) == sizeof(uint32_t), "Register proxy must be 32-bit");
+
+//!@brief Place a register at the same offset as in the device header
+#define FLEXSPI_EMU_REG(type, name, ...)                 \
+    struct                                              \
+    {                                                   \
+        uint8_t name##_pad[offsetof(FLEXSPI_HW_Type, name)]; \
+        type name __VA_ARGS__;                          \
+    }
+
+#define FLEXSPI_EMU_REG_COUNT(name) (sizeof(FLEXSPI_HW_Type::name) / sizeof(uint32_t))
+
+//!@brief FLEXSPI register layout seen by the driver on host
+//!
+//! Control and status registers are proxies. The FIFO data registers and the LUT are plain memory,
+//! the model reads TFDR/LUT and fills RFDR when the corresponding events occur.
+typedef union
+{
+    uint8_t raw[sizeof(FLEXSPI_HW_Type)];
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, MCR0);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, MCR1);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, MCR2);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, AHBCR);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, INTEN);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, INTR);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, LUTKEY);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, LUTCR);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, AHBRXBUFCR0, [FLEXSPI_EMU_REG_COUNT(AHBRXBUFCR0)]);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, FLSHCR0, [FLEXSPI_EMU_REG_COUNT(FLSHCR0)]);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, FLSHCR1, [FLEXSPI_EMU_REG_COUNT(FLSHCR1)]);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, FLSHCR2, [FLEXSPI_EMU_REG_COUNT(FLSHCR2)]);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, FLSHCR4);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, IPCR0);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, IPCR1);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, IPCMD);
+#if defined(FLEXSPI_DLPR_DLP_MASK)
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, DLPR);
+#endif
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, IPRXFCR);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, IPTXFCR);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, DLLCR, [FLEXSPI_EMU_REG_COUNT(DLLCR)]);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, STS0);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, STS1);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, STS2);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, AHBSPNDSTS);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, IPRXFSTS);
+    FLEXSPI_EMU_REG(flexspi_emu_reg_t, IPTXFSTS);
+    FLEXSPI_EMU_REG(volatile uint32_t, RFDR, [FLEXSPI_EMU_REG_COUNT(RFDR)]);
+    FLEXSPI_EMU_REG(volatile uint32_t, TFDR, [FLEXSPI_EMU_REG_COUNT(TFDR)]);
+    FLEXSPI_EMU_REG(volatile uint32_t, LUT, [FLEXSPI_EMU_REG_COUNT(LUT)]);
+} FLEXSPI_Type;
+
+static_assert(sizeof(FLEXSPI_Type) == sizeof(FLEXSPI_HW_Type), "FLEXSPI_Type layout mismatch");
+
+#endif // __FLEXSPI_EMU_REGS_H__
@@ -0,0 +1,24 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __HOST_FSL_DEVICE_REGISTERS_H__
+#define __HOST_FSL_DEVICE_REGISTERS_H__
+
+//!@brief Host build of fsl_device_registers.h
+//!
+//! C++ translation units (the FlexSPI driver) see FLEXSPI_Type as a layout-compatible set of
+//! register proxies so every FlexSPI register access is routed to the controller model.
+//! C translation units see the original plain register layout.
+#if defined(__cplusplus)
+#define FLEXSPI_Type FLEXSPI_HW_Type
+#include_next "fsl_device_registers.h"
+#undef FLEXSPI_Type
+#include "flexspi_emu_regs.h"
+#else
+#include_next "fsl_device_registers.h"
+#endif
+
+#endif // __HOST_FSL_DEVICE_REGISTERS_H__
@@ -0,0 +1,17 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __HOST_INTRINSICS_H__
+#define __HOST_INTRINSICS_H__
+
+//!@brief Host replacement of the IAR intrinsics used by the IAR flash loaders
+#define __disable_interrupt()
+#define __enable_interrupt()
+#define __no_operation() __NOP()
+
+#include "cmsis_host.h"
+
+#endif // __HOST_INTRINSICS_H__
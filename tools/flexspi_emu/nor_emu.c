@@ -0,0 +1,1056 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <ctype.h>
+#include <string.h>
+#include "nor_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+#define PS_PER_US (1000000ULL)
+
+#define SR1_WIP (1u << 0)
+#define SR1_WEL (1u << 1)
+
+//!@brief HyperFLASH status register and geometry
+#define HB_SR_DRB (1u << 7)          //!< Device Ready
+#define HB_SR_ESB (1u << 5)          //!< Erase Status, set by an erase failure or a Blank Check of a programmed sector
+#define HB_SECTOR_SIZE (0x40000u)    //!< Uniform sector of S26KS/S26KL
+#define HB_UNLOCK1_ADDR (0x555u)     //!< Word address of the first unlock cycle and of the commands
+#define HB_UNLOCK2_ADDR (0x2AAu)     //!< Word address of the second unlock cycle
+#define HB_ADDR_MASK (0xFFFu)        //!< Command addresses are decoded within the sector
+
+//!@brief SFDP layout used by the model
+enum
+{
+    kSfdp_BfptOffset     = 0x30,
+    kSfdp_BfptDwords     = 16,
+    kSfdp_4BaitOffset    = 0x80,
+    kSfdp_4BaitDwords    = 2,
+    kSfdp_ReadDummy      = 8,
+    kSfdp_SignatureValue = 0x50444653,
+};
+
+//!@brief Command formats understood by the model
+enum
+{
+    kCmdType_Unknown,
+    kCmdType_Nop,
+    kCmdType_WriteEnable,
+    kCmdType_WriteDisable,
+    kCmdType_ReadStatus1,
+    kCmdType_ReadStatus2,
+    kCmdType_ReadStatus3,
+    kCmdType_WriteStatus,
+    kCmdType_WriteStatus2,
+    kCmdType_WriteStatus3,
+    kCmdType_ReadId,
+    kCmdType_ReadSfdp,
+    kCmdType_Read,
+    kCmdType_Program,
+    kCmdType_Erase4K,
+    kCmdType_Erase32K,
+    kCmdType_Erase64K,
+    kCmdType_EraseChip,
+    kCmdType_Enter4B,
+    kCmdType_Exit4B,
+    kCmdType_ResetEnable,
+    kCmdType_Reset,
+};
+
+//!@brief Expected format of one opcode
+typedef struct _nor_emu_cmd
+{
+    uint8_t opcode;
+    uint8_t type;
+    uint8_t addrBits; //!< 0: no address, 24: 3-byte or 4-byte depending on mode, 32: 4-byte opcode
+    uint8_t addrPads;
+    uint8_t dataPads;
+    uint8_t ddr;
+    uint8_t needQe;
+} nor_emu_cmd_t;
+
+// Dummy cycles are not part of the table, they depend on the part, see nor_emu_expected_dummy()
+static const nor_emu_cmd_t s_cmdTable[] = {
+    { 0x00, kCmdType_Nop, 0, 0, 0, 0, 0 },           { 0xFF, kCmdType_Nop, 0, 0, 0, 0, 0 },
+    { 0xAB, kCmdType_Nop, 0, 0, 0, 0, 0 },           { 0xB9, kCmdType_Nop, 0, 0, 0, 0, 0 },
+    { 0x06, kCmdType_WriteEnable, 0, 0, 0, 0, 0 },   { 0x50, kCmdType_WriteEnable, 0, 0, 0, 0, 0 },
+    { 0x04, kCmdType_WriteDisable, 0, 0, 0, 0, 0 },  { 0x05, kCmdType_ReadStatus1, 0, 0, 1, 0, 0 },
+    { 0x35, kCmdType_ReadStatus2, 0, 0, 1, 0, 0 },   { 0x3F, kCmdType_ReadStatus2, 0, 0, 1, 0, 0 },
+    { 0x15, kCmdType_ReadStatus3, 0, 0, 1, 0, 0 },   { 0x01, kCmdType_WriteStatus, 0, 0, 1, 0, 0 },
+    { 0x31, kCmdType_WriteStatus2, 0, 0, 1, 0, 0 },  { 0x11, kCmdType_WriteStatus3, 0, 0, 1, 0, 0 },
+    { 0x9F, kCmdType_ReadId, 0, 0, 1, 0, 0 },        { 0x5A, kCmdType_ReadSfdp, 24, 1, 1, 0, 0 },
+    { 0x03, kCmdType_Read, 24, 1, 1, 0, 0 },         { 0x13, kCmdType_Read, 32, 1, 1, 0, 0 },
+    { 0x0B, kCmdType_Read, 24, 1, 1, 0, 0 },         { 0x0C, kCmdType_Read, 32, 1, 1, 0, 0 },
+    { 0x3B, kCmdType_Read, 24, 1, 2, 0, 0 },         { 0x3C, kCmdType_Read, 32, 1, 2, 0, 0 },
+    { 0xBB, kCmdType_Read, 24, 2, 2, 0, 0 },         { 0xBC, kCmdType_Read, 32, 2, 2, 0, 0 },
+    { 0x6B, kCmdType_Read, 24, 1, 4, 0, 1 },         { 0x6C, kCmdType_Read, 32, 1, 4, 0, 1 },
+    { 0xEB, kCmdType_Read, 24, 4, 4, 0, 1 },         { 0xEC, kCmdType_Read, 32, 4, 4, 0, 1 },
+    { 0xED, kCmdType_Read, 24, 4, 4, 1, 1 },         { 0xEE, kCmdType_Read, 32, 4, 4, 1, 1 },
+    { 0x02, kCmdType_Program, 24, 1, 1, 0, 0 },      { 0x12, kCmdType_Program, 32, 1, 1, 0, 0 },
+    { 0x32, kCmdType_Program, 24, 1, 4, 0, 1 },      { 0x34, kCmdType_Program, 32, 1, 4, 0, 1 },
+    { 0x38, kCmdType_Program, 24, 4, 4, 0, 1 },      { 0x3E, kCmdType_Program, 32, 4, 4, 0, 1 },
+    { 0x20, kCmdType_Erase4K, 24, 1, 0, 0, 0 },      { 0x21, kCmdType_Erase4K, 32, 1, 0, 0, 0 },
+    { 0x52, kCmdType_Erase32K, 24, 1, 0, 0, 0 },     { 0x5C, kCmdType_Erase32K, 32, 1, 0, 0, 0 },
+    { 0xD8, kCmdType_Erase64K, 24, 1, 0, 0, 0 },     { 0xDC, kCmdType_Erase64K, 32, 1, 0, 0, 0 },
+    { 0x60, kCmdType_EraseChip, 0, 0, 0, 0, 0 },     { 0xC7, kCmdType_EraseChip, 0, 0, 0, 0, 0 },
+    { 0xB7, kCmdType_Enter4B, 0, 0, 0, 0, 0 },       { 0xE9, kCmdType_Exit4B, 0, 0, 0, 0, 0 },
+    { 0x66, kCmdType_ResetEnable, 0, 0, 0, 0, 0 },   { 0x99, kCmdType_Reset, 0, 0, 0, 0, 0 },
+};
+
+//!@brief Decoded chip select transaction
+typedef struct _nor_emu_frame
+{
+    uint8_t opcode;
+    uint8_t cmdPads;
+    uint8_t cmdDdr;
+    uint32_t cmdBytes;
+    uint32_t addr;
+    uint32_t addrBits;
+    uint32_t addrPads;
+    uint32_t waitHalfCycles; //!< Mode + dummy cycles in half serial clock cycles
+    bool hasData;
+    bool isRead;
+    uint32_t dataPads;
+    uint32_t dataDdr;
+    uint32_t sckHz;
+} nor_emu_frame_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+// Typical timing from the datasheets of the parts used by the boards in this repo.
+static const nor_emu_part_t s_parts[] = {
+    // name          JEDEC ID              size        page qe                      144 114 ddr 4B  tPP  tBP  tSE     tBE32   tBE64   tCE     tW     fR  hb tBC
+    { "at25sf128a", { 0x1F, 0x89, 0x01 }, 0x1000000, 256, kNorEmuQe_Sr2Bit1_0x35, 6, 8, 0, 0, 400, 30, 65000, 160000, 300000, 40000, 5000, 104, 0, 0 },
+    { "is25lp064a", { 0x9D, 0x60, 0x17 }, 0x0800000, 256, kNorEmuQe_Sr1Bit6, 6, 8, 12, 0, 200, 8, 70000, 100000, 150000, 30000, 2000, 133, 0, 0 },
+    { "is25wp064a", { 0x9D, 0x70, 0x17 }, 0x0800000, 256, kNorEmuQe_Sr1Bit6, 6, 8, 12, 0, 200, 8, 70000, 100000, 150000, 30000, 2000, 133, 0, 0 },
+    { "is25wp256d", { 0x9D, 0x70, 0x19 }, 0x2000000, 256, kNorEmuQe_Sr1Bit6, 6, 8, 12, 1, 200, 8, 70000, 100000, 150000, 90000, 2000, 133, 0, 0 },
+    { "is25lp256d", { 0x9D, 0x60, 0x19 }, 0x2000000, 256, kNorEmuQe_Sr1Bit6, 6, 8, 12, 1, 200, 8, 70000, 100000, 150000, 90000, 2000, 133, 0, 0 },
+    { "is25wp512m", { 0x9D, 0x70, 0x1A }, 0x4000000, 256, kNorEmuQe_Sr1Bit6, 6, 8, 12, 1, 200, 8, 70000, 100000, 150000, 180000, 2000, 133, 0, 0 },
+    { "w25q64jv", { 0xEF, 0x40, 0x17 }, 0x0800000, 256, kNorEmuQe_Sr2Bit1_0x35, 6, 8, 0, 0, 400, 30, 45000, 120000, 150000, 20000, 10000, 133, 0, 0 },
+    { "w25q256jv", { 0xEF, 0x40, 0x19 }, 0x2000000, 256, kNorEmuQe_Sr2Bit1_0x35, 6, 8, 0, 1, 400, 30, 45000, 120000, 150000, 80000, 10000, 133, 0, 0 },
+    { "gd25q64c", { 0xC8, 0x40, 0x17 }, 0x0800000, 256, kNorEmuQe_Sr2Bit1_0x35, 6, 8, 0, 0, 500, 30, 50000, 150000, 200000, 25000, 5000, 120, 0, 0 },
+    { "gd25le128e", { 0xC8, 0x60, 0x18 }, 0x1000000, 256, kNorEmuQe_Sr2Bit1_0x35, 6, 8, 0, 0, 500, 30, 45000, 150000, 200000, 45000, 5000, 133, 0, 0 },
+    // HyperFLASH, the page is the write buffer, tSE is the 256KB sector, tCE the sum of the sectors. Only the
+    // manufacturer ID is given, no command reads it. tBC (last) is an estimate, the array read at bus rate.
+    { "s26ks512s", { 0x01, 0x00, 0x00 }, 0x4000000, 512, kNorEmuQe_None, 0, 0, 0, 0, 475, 475, 930000, 0, 0, 238080, 0, 0, 1, 1000 },
+    { NULL },
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static void sfdp_put32(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+// Encode a typical time as JESD216B count/units, units are ascending, count is 5 bits (or less) wide
+static uint32_t sfdp_encode_time(uint32_t time_us, const uint32_t *units_us, uint32_t unitCount, uint32_t countBits)
+{
+    uint32_t maxCount = 1u << countBits;
+    for (uint32_t unit = 0; unit < unitCount; unit++)
+    {
+        uint32_t count = (time_us + units_us[unit] - 1) / units_us[unit];
+        if (count == 0)
+        {
+            count = 1;
+        }
+        if ((count <= maxCount) || (unit == unitCount - 1))
+        {
+            if (count > maxCount)
+            {
+                count = maxCount;
+            }
+            return (count - 1) | (unit << countBits);
+        }
+    }
+    return 0;
+}
+
+static void nor_emu_build_sfdp(nor_emu_device_t *dev)
+{
+    const nor_emu_part_t *part = dev->part;
+    uint8_t *sfdp              = dev->sfdp;
+    bool is4B                  = part->size > 0x1000000;
+    uint32_t dw[kSfdp_BfptDwords];
+
+    memset(sfdp, 0xFF, sizeof(dev->sfdp));
+
+    // SFDP header, JESD216B
+    sfdp_put32(&sfdp[0], kSfdp_SignatureValue);
+    sfdp[4] = 6;
+    sfdp[5] = 1;
+    sfdp[6] = part->has4ByteTable ? 1 : 0;
+    sfdp[7] = 0xFF;
+
+    // Parameter header 0: Basic Flash Parameter Table
+    sfdp[8]  = 0x00;
+    sfdp[9]  = 6;
+    sfdp[10] = 1;
+    sfdp[11] = kSfdp_BfptDwords;
+    sfdp[12] = kSfdp_BfptOffset;
+    sfdp[13] = 0;
+    sfdp[14] = 0;
+    sfdp[15] = 0xFF;
+
+    // Parameter header 1: 4-byte Address Instruction Table
+    if (part->has4ByteTable)
+    {
+        sfdp[16] = 0x84;
+        sfdp[17] = 0;
+        sfdp[18] = 1;
+        sfdp[19] = kSfdp_4BaitDwords;
+        sfdp[20] = kSfdp_4BaitOffset;
+        sfdp[21] = 0;
+        sfdp[22] = 0;
+        sfdp[23] = 0xFF;
+    }
+
+    // DWORD1: 4KB erase, 1-1-2/1-2-2/1-4-4/1-1-4 reads, addressing mode, DTR
+    dw[0] = 0x01u | (1u << 2) | (0x20u << 8) | (1u << 16) | (1u << 20) | (1u << 21) | (1u << 22) | 0xFF800000u;
+    dw[0] |= (is4B ? 1u : 0u) << 17;
+    dw[0] |= (part->readDummyDdr ? 1u : 0u) << 19;
+    // DWORD2: density in bits - 1
+    dw[1] = part->size * 8u - 1u;
+    // DWORD3: 1-4-4 (2 mode clocks) and 1-1-4 read
+    dw[2] = ((part->readDummy_144 - 2u) & 0x1F) | (2u << 5) | (0xEBu << 8) | ((part->readDummy_114 & 0x1Fu) << 16) |
+            (0x6Bu << 24);
+    // DWORD4: 1-2-2 and 1-1-2 read
+    dw[3] = 4u | (0xBBu << 8) | (8u << 16) | (0x3Bu << 24);
+    // DWORD5-7: 2-2-2 and 4-4-4 are not supported
+    dw[4] = 0xFFFFFFEEu;
+    dw[5] = 0x0000FFFFu;
+    dw[6] = 0x0000FFFFu;
+    // DWORD8-9: erase types 4KB/32KB/64KB
+    dw[7] = 0x0Cu | (0x20u << 8) | (0x0Fu << 16) | (0x52u << 24);
+    dw[8] = 0x10u | (0xD8u << 8);
+    // DWORD10: typical erase times
+    {
+        static const uint32_t units[] = { 1000, 16000, 128000, 1000000 };
+        dw[9] = 0x3u;
+        dw[9] |= sfdp_encode_time(part->tSE_us, units, 4, 5) << 4;
+        dw[9] |= sfdp_encode_time(part->tBE32_us, units, 4, 5) << 11;
+        dw[9] |= sfdp_encode_time(part->tBE64_us, units, 4, 5) << 18;
+    }
+    // DWORD11: page size and typical program/chip erase times
+    {
+        static const uint32_t ppUnits[]   = { 8, 64 };
+        static const uint32_t byteUnits[] = { 1, 8 };
+        static const uint32_t ceUnits[]   = { 16000, 256000, 4000000, 64000000 };
+        uint32_t pageShift                = 0;
+        while ((1u << pageShift) < part->pageSize)
+        {
+            pageShift++;
+        }
+        dw[10] = 0x3u | (pageShift << 4);
+        dw[10] |= sfdp_encode_time(part->tPP_us, ppUnits, 2, 5) << 8;
+        dw[10] |= sfdp_encode_time(part->tBP_us, byteUnits, 2, 4) << 14;
+        dw[10] |= sfdp_encode_time(part->tBP_us, byteUnits, 2, 4) << 19;
+        dw[10] |= sfdp_encode_time(part->tCE_ms * 1000u, ceUnits, 4, 5) << 24;
+        dw[10] |= 0x80000000u;
+    }
+    // DWORD12-14: suspend/resume is not supported, poll busy via 0x05 bit0
+    dw[11] = 0xFFFFFFFFu;
+    dw[12] = 0xFFFFFFFFu;
+    dw[13] = 0x00000007u;
+    // DWORD15: Quad Enable Requirement
+    dw[14] = (uint32_t)part->qe << 20;
+    // DWORD16: 0xB7/0xE9 4-byte addressing, 0x66/0x99 soft reset
+    dw[15] = 0x01u | (0x10u << 8);
+    if (is4B)
+    {
+        dw[15] |= (0x01u << 14) | (0x01u << 24);
+    }
+
+    for (uint32_t i = 0; i < kSfdp_BfptDwords; i++)
+    {
+        sfdp_put32(&sfdp[kSfdp_BfptOffset + i * 4], dw[i]);
+    }
+
+    if (part->has4ByteTable)
+    {
+        // 1-1-1/1-1-1 fast/1-1-4/1-4-4 reads, 1-1-1/1-1-4 page program, erase type 1-3
+        sfdp_put32(&sfdp[kSfdp_4BaitOffset], 0xFFF00000u | (1u << 0) | (1u << 1) | (1u << 4) | (1u << 5) |
+                                                 (1u << 6) | (1u << 7) | (1u << 9) | (1u << 10) | (1u << 11));
+        sfdp_put32(&sfdp[kSfdp_4BaitOffset + 4], 0x21u | (0x5Cu << 8) | (0xDCu << 16) | (0xFFu << 24));
+    }
+}
+
+static uint32_t nor_emu_log2(uint32_t value)
+{
+    uint32_t shift = 0;
+    while ((1u << (shift + 1u)) <= value)
+    {
+        shift++;
+    }
+    return shift;
+}
+
+// Word of the CFI space, stored big-endian like the array words of HyperFLASH
+static void cfi_put16(uint8_t *cfi, uint32_t word, uint32_t value)
+{
+    cfi[word * 2u]      = (uint8_t)(value >> 8);
+    cfi[word * 2u + 1u] = (uint8_t)value;
+}
+
+// CFI query of HyperFLASH, JESD68.01 words from 0x10
+static void nor_emu_build_cfi(nor_emu_device_t *dev)
+{
+    const nor_emu_part_t *part = dev->part;
+    uint8_t *cfi               = dev->sfdp;
+    uint32_t sectors           = part->size / HB_SECTOR_SIZE;
+
+    memset(cfi, 0x00, sizeof(dev->sfdp));
+    cfi_put16(cfi, 0x00, part->jedecId[0]);
+    // "QRY", AMD/Spansion command set
+    cfi_put16(cfi, 0x10, 'Q');
+    cfi_put16(cfi, 0x11, 'R');
+    cfi_put16(cfi, 0x12, 'Y');
+    cfi_put16(cfi, 0x13, 0x0002);
+    // Typical times as 2^N: word program us, write buffer program us, sector erase ms, chip erase ms
+    cfi_put16(cfi, 0x1F, nor_emu_log2(part->tBP_us));
+    cfi_put16(cfi, 0x20, nor_emu_log2(part->tPP_us));
+    cfi_put16(cfi, 0x21, nor_emu_log2(part->tSE_us / 1000u));
+    cfi_put16(cfi, 0x22, nor_emu_log2(part->tCE_ms));
+    // Device size 2^N bytes, write buffer 2^N bytes, one region of uniform sectors
+    cfi_put16(cfi, 0x27, nor_emu_log2(part->size));
+    cfi_put16(cfi, 0x2A, nor_emu_log2(part->pageSize));
+    cfi_put16(cfi, 0x2C, 1);
+    cfi_put16(cfi, 0x2D, (sectors - 1u) & 0xFFu);
+    cfi_put16(cfi, 0x2E, (sectors - 1u) >> 8);
+    cfi_put16(cfi, 0x2F, (HB_SECTOR_SIZE / 256u) & 0xFFu);
+    cfi_put16(cfi, 0x30, (HB_SECTOR_SIZE / 256u) >> 8);
+}
+
+// See nor_emu.h for more details.
+const nor_emu_part_t *nor_emu_get_parts(void)
+{
+    return s_parts;
+}
+
+// See nor_emu.h for more details.
+const nor_emu_part_t *nor_emu_find_part(const char *name)
+{
+    for (const nor_emu_part_t *part = s_parts; part->name != NULL; part++)
+    {
+        const char *a = part->name;
+        const char *b = name;
+        while ((*a != '\0') && (tolower((unsigned char)*a) == tolower((unsigned char)*b)))
+        {
+            a++;
+            b++;
+        }
+        if ((*a == '\0') && (*b == '\0'))
+        {
+            return part;
+        }
+    }
+    return NULL;
+}
+
+// See nor_emu.h for more details.
+void nor_emu_init(nor_emu_device_t *dev, const nor_emu_part_t *part, uint8_t *array)
+{
+    memset(dev, 0, sizeof(*dev));
+    dev->part  = part;
+    dev->array = array;
+    memset(array, 0xFF, part->size);
+    if (part->hyperBus)
+    {
+        nor_emu_build_cfi(dev);
+    }
+    else
+    {
+        nor_emu_build_sfdp(dev);
+    }
+}
+
+// See nor_emu.h for more details.
+bool nor_emu_is_busy(const nor_emu_device_t *dev, uint64_t now)
+{
+    return now < dev->busyUntil;
+}
+
+static bool nor_emu_qe_enabled(const nor_emu_device_t *dev)
+{
+    switch (dev->part->qe)
+    {
+        case kNorEmuQe_None:
+            return true;
+        case kNorEmuQe_Sr1Bit6:
+            return (dev->sr1 & (1u << 6)) != 0;
+        case kNorEmuQe_Sr2Bit7:
+            return (dev->sr2 & (1u << 7)) != 0;
+        default:
+            return (dev->sr2 & (1u << 1)) != 0;
+    }
+}
+
+static uint8_t nor_emu_status1(const nor_emu_device_t *dev, uint64_t now)
+{
+    uint8_t status = dev->sr1 & (uint8_t)~(SR1_WIP | SR1_WEL);
+    if (dev->wel)
+    {
+        status |= SR1_WEL;
+    }
+    if (nor_emu_is_busy(dev, now))
+    {
+        status |= SR1_WIP;
+    }
+    return status;
+}
+
+static const nor_emu_cmd_t *nor_emu_lookup(const nor_emu_device_t *dev, uint8_t opcode, bool hasAddr)
+{
+    // 0x3E is Write Status 2 on devices with QE in SR2[7], 4-byte Quad Page Program otherwise
+    if ((opcode == 0x3E) && (dev->part->qe == kNorEmuQe_Sr2Bit7) && !hasAddr)
+    {
+        static const nor_emu_cmd_t k_wrsr2 = { 0x3E, kCmdType_WriteStatus2, 0, 0, 1, 0, 0 };
+        return &k_wrsr2;
+    }
+    for (uint32_t i = 0; i < sizeof(s_cmdTable) / sizeof(s_cmdTable[0]); i++)
+    {
+        if (s_cmdTable[i].opcode == opcode)
+        {
+            return &s_cmdTable[i];
+        }
+    }
+    return NULL;
+}
+
+// Mode + dummy cycles required by a read command, in half serial clock cycles
+static uint32_t nor_emu_expected_wait(const nor_emu_device_t *dev, uint8_t opcode)
+{
+    switch (opcode)
+    {
+        case 0x03:
+        case 0x13:
+            return 0;
+        case 0x6B:
+        case 0x6C:
+            return dev->part->readDummy_114 * 2u;
+        case 0xEB:
+        case 0xEC:
+            return dev->part->readDummy_144 * 2u;
+        case 0xED:
+        case 0xEE:
+            return dev->part->readDummyDdr;
+        case 0xBB:
+        case 0xBC:
+            return 4u * 2u;
+        default:
+            return kSfdp_ReadDummy * 2u;
+    }
+}
+
+static void nor_emu_decode(const nor_emu_xfer_t *xfer, nor_emu_frame_t *frame)
+{
+    memset(frame, 0, sizeof(*frame));
+    frame->sckHz = xfer->sckHz;
+    for (uint32_t i = 0; i < xfer->phaseCount; i++)
+    {
+        const nor_emu_phase_t *phase = &xfer->phase[i];
+        switch (phase->type)
+        {
+            case kNorEmuPhase_Cmd:
+                if (frame->cmdBytes == 0)
+                {
+                    frame->opcode  = (uint8_t)phase->value;
+                    frame->cmdPads = phase->pads;
+                    frame->cmdDdr  = phase->ddr;
+                }
+                frame->cmdBytes++;
+                break;
+            case kNorEmuPhase_RowAddr:
+            case kNorEmuPhase_ColAddr:
+                frame->addr = (phase->bits >= 32) ? phase->value : ((frame->addr << phase->bits) | phase->value);
+                frame->addrBits += phase->bits;
+                frame->addrPads = phase->pads;
+                break;
+            case kNorEmuPhase_Mode:
+                frame->waitHalfCycles += (phase->bits / phase->pads) * (phase->ddr ? 1u : 2u);
+                break;
+            case kNorEmuPhase_Dummy:
+                frame->waitHalfCycles += phase->ddr ? phase->bits : phase->bits * 2u;
+                break;
+            case kNorEmuPhase_Read:
+            case kNorEmuPhase_Write:
+                frame->hasData  = true;
+                frame->isRead   = (phase->type == kNorEmuPhase_Read);
+                frame->dataPads = phase->pads;
+                frame->dataDdr  = phase->ddr;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static void nor_emu_fill_garbage(uint8_t *data, uint32_t size, uint32_t seed)
+{
+    uint32_t x = seed | 1u;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        data[i] = (uint8_t)x;
+    }
+}
+
+static void nor_emu_start_operation(nor_emu_device_t *dev, uint64_t now, uint64_t duration_ps)
+{
+    dev->busyUntil = now + duration_ps;
+    dev->wel       = false;
+    dev->stats.busy_ps += duration_ps;
+}
+
+static void nor_emu_erase(nor_emu_device_t *dev, uint32_t addr, uint32_t size, uint64_t now, uint32_t time_us)
+{
+    addr &= ~(size - 1u);
+    memset(&dev->array[addr], 0xFF, size);
+    nor_emu_start_operation(dev, now, (uint64_t)time_us * PS_PER_US);
+}
+
+static void nor_emu_program(nor_emu_device_t *dev, uint32_t addr, const uint8_t *data, uint32_t size, uint64_t now)
+{
+    const nor_emu_part_t *part = dev->part;
+    uint32_t pageMask          = part->pageSize - 1u;
+    uint32_t pageBase          = addr & ~pageMask;
+    uint32_t offset            = addr & pageMask;
+
+    // Only the last page of data is latched if more than one page is sent
+    if (size > part->pageSize)
+    {
+        offset = (offset + size - part->pageSize) & pageMask;
+        data += size - part->pageSize;
+        size = part->pageSize;
+    }
+    for (uint32_t i = 0; i < size; i++)
+    {
+        dev->array[pageBase + ((offset + i) & pageMask)] &= data[i];
+    }
+
+    uint64_t time_us = (uint64_t)part->tPP_us * size / part->pageSize;
+    if (time_us < part->tBP_us)
+    {
+        time_us = part->tBP_us;
+    }
+    nor_emu_start_operation(dev, now, time_us * PS_PER_US);
+    dev->stats.page_programs++;
+    dev->stats.program_bytes += size;
+}
+
+static void nor_emu_write_status(nor_emu_device_t *dev, uint32_t type, const uint8_t *data, uint32_t size, uint64_t now)
+{
+    if (size < 1)
+    {
+        return;
+    }
+    switch (type)
+    {
+        case kCmdType_WriteStatus:
+            dev->sr1 = data[0] & (uint8_t)~(SR1_WIP | SR1_WEL);
+            if (size > 1)
+            {
+                dev->sr2 = data[1];
+            }
+            break;
+        case kCmdType_WriteStatus2:
+            dev->sr2 = data[0];
+            break;
+        default:
+            dev->sr3 = data[0];
+            break;
+    }
+    nor_emu_start_operation(dev, now, (uint64_t)dev->part->tW_us * PS_PER_US);
+}
+
+static void nor_emu_read(nor_emu_device_t *dev, const nor_emu_cmd_t *cmd, nor_emu_frame_t *frame, uint8_t *data,
+                         uint32_t size)
+{
+    const nor_emu_part_t *part = dev->part;
+    bool valid                 = (frame->waitHalfCycles == nor_emu_expected_wait(dev, cmd->opcode)) &&
+                 (frame->dataPads == cmd->dataPads) && (frame->dataDdr == cmd->ddr);
+
+    if (cmd->needQe && !nor_emu_qe_enabled(dev))
+    {
+        valid = false;
+    }
+    // Fast reads clocked faster than the part allows at its dummy cycles output data too late to be sampled
+    if (part->fRead_MHz && (frame->sckHz > part->fRead_MHz * 1000000u) && nor_emu_expected_wait(dev, cmd->opcode))
+    {
+        valid = false;
+    }
+    if (!valid)
+    {
+        // Data sampled at the wrong clock edge or on undriven pins
+        dev->stats.protocol_errors++;
+        nor_emu_fill_garbage(data, size, frame->addr ^ frame->waitHalfCycles);
+        return;
+    }
+
+    uint32_t addrMask = part->size - 1u;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        data[i] = dev->array[(frame->addr + i) & addrMask];
+    }
+    dev->stats.read_bytes += size;
+}
+
+// Command-Address of a HyperBus transaction and the word of its command data, false if it is not 8-pad DDR
+static bool nor_emu_hyperbus_decode(const nor_emu_xfer_t *xfer, uint64_t *ca, uint32_t *word, uint32_t *cmdBytes)
+{
+    uint32_t caBits = 0;
+
+    *ca       = 0;
+    *word     = 0;
+    *cmdBytes = 0;
+    for (uint32_t i = 0; i < xfer->phaseCount; i++)
+    {
+        const nor_emu_phase_t *phase = &xfer->phase[i];
+        if ((phase->pads != 8) || !phase->ddr)
+        {
+            return false;
+        }
+        switch (phase->type)
+        {
+            case kNorEmuPhase_Cmd:
+                // The first 6 bytes are the Command-Address, the next ones the data word of a register write
+                if (caBits < 48)
+                {
+                    *ca = (*ca << 8) | phase->value;
+                    caBits += 8;
+                }
+                else
+                {
+                    *word = ((*word << 8) | phase->value) & 0xFFFFu;
+                    (*cmdBytes)++;
+                }
+                break;
+            case kNorEmuPhase_RowAddr:
+            case kNorEmuPhase_ColAddr:
+                *ca = (*ca << phase->bits) | phase->value;
+                caBits += phase->bits;
+                break;
+            default:
+                break;
+        }
+    }
+    return caBits == 48;
+}
+
+// Status register with DRB computed, returned as the low byte of a big-endian word
+static uint8_t nor_emu_hyperbus_status(const nor_emu_device_t *dev, uint64_t now)
+{
+    uint8_t status = dev->hbStatus & (uint8_t)~HB_SR_DRB;
+    if (!nor_emu_is_busy(dev, now))
+    {
+        status |= HB_SR_DRB;
+    }
+    return status;
+}
+
+// Command cycle, a word written outside of a Word Program
+static void nor_emu_hyperbus_command(nor_emu_device_t *dev, uint32_t addr, uint32_t value, uint64_t now)
+{
+    const nor_emu_part_t *part = dev->part;
+    uint32_t offset            = addr & HB_ADDR_MASK;
+    uint32_t sector            = (addr * 2u) & (part->size - 1u) & ~(HB_SECTOR_SIZE - 1u);
+    uint8_t command            = (uint8_t)value;
+    uint8_t unlock             = dev->hbUnlock;
+    uint8_t pending            = dev->hbCommand;
+
+    // Every cycle but an unlock one ends the unlock sequence
+    dev->hbUnlock  = 0;
+    dev->hbCommand = 0;
+
+    if ((command == 0xAA) && (offset == HB_UNLOCK1_ADDR) && (unlock == 0))
+    {
+        dev->hbUnlock  = 1;
+        dev->hbCommand = pending;
+    }
+    else if ((command == 0x55) && (offset == HB_UNLOCK2_ADDR) && (unlock == 1))
+    {
+        dev->hbUnlock  = 2;
+        dev->hbCommand = pending;
+    }
+    else if ((command == 0xA0) && (offset == HB_UNLOCK1_ADDR) && (unlock == 2))
+    {
+        dev->hbCommand = 0xA0;
+    }
+    else if ((command == 0x80) && (offset == HB_UNLOCK1_ADDR) && (unlock == 2))
+    {
+        dev->hbCommand = 0x80;
+    }
+    else if ((command == 0x30) && (unlock == 2) && (pending == 0x80))
+    {
+        memset(&dev->array[sector], 0xFF, HB_SECTOR_SIZE);
+        dev->hbStatus &= (uint8_t)~HB_SR_ESB;
+        nor_emu_start_operation(dev, now, (uint64_t)part->tSE_us * PS_PER_US);
+        dev->stats.sector_erases++;
+    }
+    else if ((command == 0x10) && (offset == HB_UNLOCK1_ADDR) && (unlock == 2) && (pending == 0x80))
+    {
+        memset(dev->array, 0xFF, part->size);
+        dev->hbStatus &= (uint8_t)~HB_SR_ESB;
+        nor_emu_start_operation(dev, now, (uint64_t)part->tCE_ms * 1000u * PS_PER_US);
+        dev->stats.chip_erases++;
+    }
+    else if ((command == 0x33) && (offset == HB_UNLOCK1_ADDR))
+    {
+        // Blank Check of the sector the address is in
+        dev->hbStatus &= (uint8_t)~HB_SR_ESB;
+        for (uint32_t i = 0; i < HB_SECTOR_SIZE; i++)
+        {
+            if (dev->array[sector + i] != 0xFF)
+            {
+                dev->hbStatus |= HB_SR_ESB;
+                break;
+            }
+        }
+        nor_emu_start_operation(dev, now, (uint64_t)part->tBC_us * PS_PER_US);
+        dev->stats.blank_checks++;
+    }
+    else if ((command == 0x70) && (offset == HB_UNLOCK1_ADDR))
+    {
+        dev->hbStatusRead = true;
+    }
+    else if ((command == 0x71) && (offset == HB_UNLOCK1_ADDR))
+    {
+        dev->hbStatus &= (uint8_t)~HB_SR_ESB;
+    }
+    else if ((command == 0x98) && ((offset & 0xFFu) == 0x55u))
+    {
+        dev->hbCfi = true;
+    }
+    else if (command == 0xF0)
+    {
+        dev->hbCfi = false;
+    }
+    else
+    {
+        dev->stats.unknown_cmds++;
+    }
+}
+
+// HyperFLASH on HyperBus: the Command-Address selects a read or a write of array words, commands are
+// writes of single words to magic addresses. Latency is not checked, the controller samples reads with RWDS.
+static void nor_emu_hyperbus_execute(nor_emu_device_t *dev, nor_emu_xfer_t *xfer, uint64_t now)
+{
+    const nor_emu_part_t *part = dev->part;
+    uint64_t ca;
+    uint32_t word;
+    uint32_t cmdBytes;
+    bool hasData = false;
+    bool isRead  = false;
+
+    dev->stats.commands++;
+    for (uint32_t i = 0; i < xfer->phaseCount; i++)
+    {
+        if ((xfer->phase[i].type == kNorEmuPhase_Read) || (xfer->phase[i].type == kNorEmuPhase_Write))
+        {
+            hasData = true;
+            isRead  = (xfer->phase[i].type == kNorEmuPhase_Read);
+        }
+    }
+    uint8_t *data = xfer->data;
+    uint32_t size = hasData ? xfer->dataSize : 0;
+
+    do
+    {
+        // CA[47] read, CA[46] register space, CA[44:16] upper and CA[2:0] lower word address
+        bool valid    = nor_emu_hyperbus_decode(xfer, &ca, &word, &cmdBytes);
+        bool caRead   = valid && ((ca >> 47) & 1u);
+        uint32_t addr = (uint32_t)((((ca >> 16) & 0x1FFFFFFFu) << 3) | (ca & 0x7u));
+        if (!valid || ((ca >> 46) & 1u) || (caRead != isRead) || (cmdBytes && (cmdBytes != 2)))
+        {
+            dev->stats.protocol_errors++;
+            break;
+        }
+
+        if (isRead)
+        {
+            if (dev->hbStatusRead || nor_emu_is_busy(dev, now))
+            {
+                // The status register, a busy device returns it to any read
+                uint8_t status = nor_emu_hyperbus_status(dev, now);
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    data[i] = (i & 1u) ? status : 0x00;
+                }
+                if (nor_emu_is_busy(dev, now))
+                {
+                    xfer->idleUntil = dev->busyUntil;
+                }
+                dev->hbStatusRead = false;
+                dev->stats.status_reads++;
+            }
+            else if (dev->hbCfi)
+            {
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    uint32_t offset = addr * 2u + i;
+                    data[i]         = (offset < NOR_EMU_SFDP_SIZE) ? dev->sfdp[offset] : 0x00;
+                }
+            }
+            else
+            {
+                uint32_t addrMask = part->size - 1u;
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    data[i] = dev->array[(addr * 2u + i) & addrMask];
+                }
+                dev->stats.read_bytes += size;
+            }
+            break;
+        }
+
+        // Only the status register can be read while an embedded operation is in progress
+        if (nor_emu_is_busy(dev, now))
+        {
+            if ((cmdBytes == 2) && ((word & 0xFFu) == 0x70) && ((addr & HB_ADDR_MASK) == HB_UNLOCK1_ADDR))
+            {
+                dev->hbStatusRead = true;
+            }
+            else
+            {
+                dev->stats.ignored_busy++;
+            }
+            break;
+        }
+
+        if (dev->hbCommand == 0xA0)
+        {
+            // Word Program takes a burst of words within one write buffer line
+            uint32_t lineMask = part->pageSize - 1u;
+            uint32_t byteAddr = (addr * 2u) & (part->size - 1u);
+            uint8_t bytes[2]  = { (uint8_t)(word >> 8), (uint8_t)word };
+            const uint8_t *src = cmdBytes ? bytes : data;
+            uint32_t count     = cmdBytes ? 2u : size;
+
+            dev->hbCommand = 0;
+            dev->hbUnlock  = 0;
+            if ((count == 0) || ((byteAddr & lineMask) + count > part->pageSize))
+            {
+                dev->stats.protocol_errors++;
+                break;
+            }
+            nor_emu_program(dev, byteAddr, src, count, now);
+            break;
+        }
+
+        if (cmdBytes == 0)
+        {
+            // Command words come in the LUT, data of an array write needs a Word Program first
+            if (size >= 2)
+            {
+                word = ((uint32_t)data[0] << 8) | data[1];
+            }
+            else
+            {
+                dev->stats.protocol_errors++;
+                break;
+            }
+        }
+        nor_emu_hyperbus_command(dev, addr, word, now);
+    } while (0);
+}
+
+// See nor_emu.h for more details.
+void nor_emu_execute(nor_emu_device_t *dev, nor_emu_xfer_t *xfer, uint64_t now)
+{
+    nor_emu_frame_t frame;
+
+    if (dev->part->hyperBus)
+    {
+        nor_emu_hyperbus_execute(dev, xfer, now);
+        return;
+    }
+    nor_emu_decode(xfer, &frame);
+
+    uint8_t *data  = xfer->data;
+    uint32_t size  = frame.hasData ? xfer->dataSize : 0;
+    bool busy      = nor_emu_is_busy(dev, now);
+    bool readFloat = frame.hasData && frame.isRead;
+
+    dev->stats.commands++;
+
+    do
+    {
+        if ((frame.cmdBytes == 0) || (frame.cmdPads != 1) || frame.cmdDdr)
+        {
+            // The model only implements SPI (1-x-x) protocol, e.g. QPI exit sequences are ignored silently.
+            if (frame.cmdBytes && (frame.opcode != 0xFF))
+            {
+                dev->stats.protocol_errors++;
+            }
+            break;
+        }
+
+        const nor_emu_cmd_t *cmd = nor_emu_lookup(dev, frame.opcode, frame.addrBits != 0);
+        if (cmd == NULL)
+        {
+            dev->stats.unknown_cmds++;
+            break;
+        }
+
+        // Check address format
+        uint32_t expectedAddrBits = cmd->addrBits;
+        if ((expectedAddrBits == 24) && dev->addr4b && (cmd->type != kCmdType_ReadSfdp))
+        {
+            expectedAddrBits = 32;
+        }
+        if ((frame.addrBits != expectedAddrBits) || (expectedAddrBits && (frame.addrPads != cmd->addrPads)))
+        {
+            dev->stats.protocol_errors++;
+            break;
+        }
+
+        // Only status reads are accepted while an embedded operation is in progress
+        if (busy && (cmd->type != kCmdType_ReadStatus1) && (cmd->type != kCmdType_ReadStatus2) &&
+            (cmd->type != kCmdType_ReadStatus3))
+        {
+            dev->stats.ignored_busy++;
+            break;
+        }
+
+        readFloat = false;
+        switch (cmd->type)
+        {
+            case kCmdType_Nop:
+            case kCmdType_ResetEnable:
+                break;
+            case kCmdType_WriteEnable:
+                dev->wel = true;
+                break;
+            case kCmdType_WriteDisable:
+                dev->wel = false;
+                break;
+            case kCmdType_ReadStatus1:
+            case kCmdType_ReadStatus2:
+            case kCmdType_ReadStatus3:
+            {
+                uint8_t value = (cmd->type == kCmdType_ReadStatus1) ?
+                                    nor_emu_status1(dev, now) :
+                                    ((cmd->type == kCmdType_ReadStatus2) ? dev->sr2 : dev->sr3);
+                if (size)
+                {
+                    memset(data, value, size);
+                }
+                if (busy)
+                {
+                    xfer->idleUntil = dev->busyUntil;
+                }
+                dev->stats.status_reads++;
+                break;
+            }
+            case kCmdType_ReadId:
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    data[i] = dev->part->jedecId[i % 3];
+                }
+                break;
+            case kCmdType_ReadSfdp:
+                if (frame.waitHalfCycles != kSfdp_ReadDummy * 2u)
+                {
+                    dev->stats.protocol_errors++;
+                    nor_emu_fill_garbage(data, size, frame.addr);
+                    break;
+                }
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    uint32_t offset = frame.addr + i;
+                    data[i]         = (offset < NOR_EMU_SFDP_SIZE) ? dev->sfdp[offset] : 0xFF;
+                }
+                break;
+            case kCmdType_Read:
+                nor_emu_read(dev, cmd, &frame, data, size);
+                break;
+            case kCmdType_Program:
+                if (!dev->wel)
+                {
+                    dev->stats.ignored_wel++;
+                    break;
+                }
+                if ((frame.dataPads != cmd->dataPads) || (cmd->needQe && !nor_emu_qe_enabled(dev)))
+                {
+                    dev->stats.protocol_errors++;
+                    break;
+                }
+                nor_emu_program(dev, frame.addr & (dev->part->size - 1u), data, size, now);
+                break;
+            case kCmdType_Erase4K:
+            case kCmdType_Erase32K:
+            case kCmdType_Erase64K:
+            case kCmdType_EraseChip:
+                if (!dev->wel)
+                {
+                    dev->stats.ignored_wel++;
+                    break;
+                }
+                if (cmd->type == kCmdType_Erase4K)
+                {
+                    nor_emu_erase(dev, frame.addr & (dev->part->size - 1u), 0x1000, now, dev->part->tSE_us);
+                    dev->stats.sector_erases++;
+                }
+                else if (cmd->type == kCmdType_Erase32K)
+                {
+                    nor_emu_erase(dev, frame.addr & (dev->part->size - 1u), 0x8000, now, dev->part->tBE32_us);
+                    dev->stats.block_erases++;
+                }
+                else if (cmd->type == kCmdType_Erase64K)
+                {
+                    nor_emu_erase(dev, frame.addr & (dev->part->size - 1u), 0x10000, now, dev->part->tBE64_us);
+                    dev->stats.block_erases++;
+                }
+                else
+                {
+                    memset(dev->array, 0xFF, dev->part->size);
+                    nor_emu_start_operation(dev, now, (uint64_t)dev->part->tCE_ms * 1000u * PS_PER_US);
+                    dev->stats.chip_erases++;
+                }
+                break;
+            case kCmdType_WriteStatus:
+            case kCmdType_WriteStatus2:
+            case kCmdType_WriteStatus3:
+                if (!dev->wel)
+                {
+                    dev->stats.ignored_wel++;
+                    break;
+                }
+                nor_emu_write_status(dev, cmd->type, data, size, now);
+                break;
+            case kCmdType_Enter4B:
+                dev->addr4b = true;
+                break;
+            case kCmdType_Exit4B:
+                dev->addr4b = false;
+                break;
+            case kCmdType_Reset:
+                dev->addr4b = false;
+                dev->wel    = false;
+                break;
+            default:
+                break;
+        }
+    } while (0);
+
+    // Nobody drives the data lines, pull-ups return all ones
+    if (readFloat && size)
+    {
+        memset(data, 0xFF, size);
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __NOR_EMU_H__
+#define __NOR_EMU_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Max phases of one chip select transaction, a LUT sequence has 8 instructions at most
+#define NOR_EMU_MAX_PHASES (8)
+
+//!@brief Size of the SFDP space exposed by the model
+#define NOR_EMU_SFDP_SIZE (256)
+
+//!@brief Quad Enable bit location, encoded as JESD216B BFPT DWORD15 Quad Enable Requirements
+enum
+{
+    kNorEmuQe_None          = 0, //!< No QE bit, IO2/IO3 are always data pins
+    kNorEmuQe_Sr2Bit1       = 1, //!< QE is SR2[1], written by 0x01 with two bytes
+    kNorEmuQe_Sr1Bit6       = 2, //!< QE is SR1[6], written by 0x01
+    kNorEmuQe_Sr2Bit7       = 3, //!< QE is SR2[7], read by 0x3F and written by 0x3E
+    kNorEmuQe_Sr2Bit1_0x35  = 4, //!< QE is SR2[1], read by 0x35 and written by 0x01 with two bytes
+    kNorEmuQe_Sr2Bit1_0x31  = 6, //!< QE is SR2[1], read by 0x35 and written by 0x31
+};
+
+//!@brief Phase types of a chip select transaction, one per LUT instruction
+enum
+{
+    kNorEmuPhase_Cmd,
+    kNorEmuPhase_RowAddr,
+    kNorEmuPhase_ColAddr,
+    kNorEmuPhase_Mode,
+    kNorEmuPhase_Dummy,
+    kNorEmuPhase_Read,
+    kNorEmuPhase_Write,
+};
+
+//!@brief One phase of a chip select transaction
+typedef struct _nor_emu_phase
+{
+    uint8_t type;   //!< See kNorEmuPhase_*
+    uint8_t pads;   //!< Data lines used, 1/2/4/8
+    uint8_t ddr;    //!< Data transferred on both clock edges
+    uint8_t bits;   //!< Command/Address/Mode bits, dummy cycles for dummy phase
+    uint32_t value; //!< Command/Address/Mode value
+} nor_emu_phase_t;
+
+//!@brief Chip select transaction as seen by the serial NOR device
+typedef struct _nor_emu_xfer
+{
+    nor_emu_phase_t phase[NOR_EMU_MAX_PHASES];
+    uint32_t phaseCount;
+    uint8_t *data;     //!< Read or write data, NULL if there is no data phase
+    uint32_t dataSize; //!< Bytes of read or write data
+    uint32_t sckHz;    //!< Serial clock of the transaction, 0 if unknown
+    uint64_t idleUntil; //!< Set by a status read that finds the device busy, the time the device becomes ready
+} nor_emu_xfer_t;
+
+//!@brief Serial NOR part description, timing numbers are typical values from the datasheet
+typedef struct _nor_emu_part
+{
+    const char *name;
+    uint8_t jedecId[3];
+    uint32_t size;
+    uint32_t pageSize;
+    uint8_t qe;            //!< Quad Enable requirement, see kNorEmuQe_*
+    uint8_t readDummy_144; //!< Mode + dummy cycles of 0xEB
+    uint8_t readDummy_114; //!< Dummy cycles of 0x6B
+    uint8_t readDummyDdr;  //!< Dummy cycles of 0xED in DDR half cycles, 0 if DTR read is not supported
+    uint8_t has4ByteTable; //!< Publishes JESD216B 4-byte address instruction table
+    uint32_t tPP_us;       //!< Page program time for a full page
+    uint32_t tBP_us;       //!< Byte program time, lower bound of any program operation
+    uint32_t tSE_us;       //!< 4KB sector erase time
+    uint32_t tBE32_us;     //!< 32KB block erase time
+    uint32_t tBE64_us;     //!< 64KB block erase time
+    uint32_t tCE_ms;       //!< Chip erase time
+    uint32_t tW_us;        //!< Write status register time
+    uint32_t fRead_MHz;    //!< Highest serial clock of the fast reads at their dummy cycles, 0 if unlimited
+    uint8_t hyperBus;      //!< HyperFLASH: word addressed, commands are writes to the array, tSE_us is a 256KB sector
+    uint32_t tBC_us;       //!< Blank Check time of a sector, HyperFLASH only
+} nor_emu_part_t;
+
+//!@brief Statistics collected by the serial NOR model
+typedef struct _nor_emu_stats
+{
+    uint64_t commands;       //!< Transactions decoded
+    uint64_t status_reads;   //!< Status register reads
+    uint64_t page_programs;  //!< Program operations
+    uint64_t program_bytes;  //!< Bytes programmed
+    uint64_t sector_erases;  //!< 4KB erase operations
+    uint64_t block_erases;   //!< 32KB and 64KB erase operations
+    uint64_t chip_erases;    //!< Chip erase operations
+    uint64_t blank_checks;   //!< Blank Check operations of HyperFLASH
+    uint64_t read_bytes;     //!< Bytes read through array read commands
+    uint64_t ignored_busy;   //!< Commands ignored because an embedded operation was in progress
+    uint64_t ignored_wel;    //!< Program/erase/write status commands ignored because WEL was not set
+    uint64_t protocol_errors; //!< Transactions that do not match the command format expected by the device
+    uint64_t unknown_cmds;   //!< Unsupported opcodes
+    uint64_t busy_ps;        //!< Time spent in embedded program/erase operations
+} nor_emu_stats_t;
+
+//!@brief Serial NOR device state
+typedef struct _nor_emu_device
+{
+    const nor_emu_part_t *part;
+    uint8_t *array;        //!< Memory array, part->size bytes
+    uint8_t sr1;           //!< Status register 1, WIP and WEL are computed
+    uint8_t sr2;           //!< Status register 2
+    uint8_t sr3;           //!< Status register 3
+    bool wel;              //!< Write enable latch
+    bool addr4b;           //!< 4-byte address mode entered by 0xB7
+    uint64_t busyUntil;    //!< WIP stays set until this virtual time
+    uint8_t sfdp[NOR_EMU_SFDP_SIZE]; //!< SFDP space, the CFI space of HyperFLASH
+    uint8_t hbUnlock;      //!< HyperFLASH unlock cycles seen, 0 to 2
+    uint8_t hbCommand;     //!< HyperFLASH Word Program or Erase Setup waiting for the rest of its cycles, 0 if none
+    uint8_t hbStatus;      //!< HyperFLASH status register, DRB is computed
+    bool hbStatusRead;     //!< HyperFLASH returns the status register on the next read
+    bool hbCfi;            //!< HyperFLASH returns the CFI space on reads
+    nor_emu_stats_t stats;
+} nor_emu_device_t;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//!@brief Find a part by name (case insensitive), NULL if it is unknown
+const nor_emu_part_t *nor_emu_find_part(const char *name);
+
+//!@brief Get the part table, terminated by an entry with NULL name
+const nor_emu_part_t *nor_emu_get_parts(void);
+
+//!@brief Initialize a device in factory state (erased array, QE cleared)
+void nor_emu_init(nor_emu_device_t *dev, const nor_emu_part_t *part, uint8_t *array);
+
+//!@brief Execute one chip select transaction at virtual time now
+void nor_emu_execute(nor_emu_device_t *dev, nor_emu_xfer_t *xfer, uint64_t now);
+
+//!@brief Check whether an embedded operation is in progress at virtual time now
+bool nor_emu_is_busy(const nor_emu_device_t *dev, uint64_t now);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // __NOR_EMU_H__
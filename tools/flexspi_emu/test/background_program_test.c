@@ -0,0 +1,268 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FlashOS.H"
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1, can be overridden by -p
+#if !defined(FLEXSPI_TEST_PART)
+#define FLEXSPI_TEST_PART "at25sf128a"
+#endif
+
+//!@brief Bytes programmed from the device start, can be overridden by -s
+#if !defined(FLEXSPI_TEST_SIZE)
+#define FLEXSPI_TEST_SIZE (256u * 1024u)
+#endif
+
+//!@brief Debugger download rate of the ProgramPage buffer in bytes/s, can be overridden by -d
+#if !defined(FLEXSPI_TEST_DOWNLOAD_RATE)
+#define FLEXSPI_TEST_DOWNLOAD_RATE (1000000u)
+#endif
+
+//!@brief Host buffer of the image, placed below 4GB like the bench one
+#define FLEXSPI_TEST_IMAGE_ADDRESS (0x10000000u)
+
+#if defined(FLEXSPI)
+#define FLEXSPI_TEST_BASE FLEXSPI_BASE
+#elif defined(FLEXSPI0)
+#define FLEXSPI_TEST_BASE FLEXSPI0_BASE
+#elif defined(FLEXSPI1)
+#define FLEXSPI_TEST_BASE FLEXSPI1_BASE
+#endif
+
+//!@brief FlexSPI instance used by the algorithm, FLEXSPI_NOR_INSTANCE of FlashPrg
+#if !defined(FLEXSPI_TEST_INSTANCE)
+#define FLEXSPI_TEST_INSTANCE (0)
+#endif
+
+#if !defined(BACKGROUND_PROGRAM)
+#define BACKGROUND_PROGRAM 0
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+extern struct FlashDevice const FlashDevice;
+extern int UnInit(unsigned long fnc);
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t test_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void test_seed_reset_values(void)
+{
+#if defined(CCM_ANALOG_PFD_480_PFD0_FRAC_MASK)
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+#endif
+#if defined(CCM_CSCMR1_FLEXSPI_PODF_MASK)
+    CCM->CSCMR1 = 0x04900080u;
+#endif
+#if defined(CCM_CBCDR_IPG_PODF_MASK)
+    CCM->CBCDR = 0x000A8300u;
+#endif
+}
+
+// Time the device stays busy after the algorithm returned to the debugger
+static uint64_t test_busy_ps(void)
+{
+    uint64_t now = flexspi_emu_now();
+    return (s_nor->busyUntil > now) ? (s_nor->busyUntil - now) : 0;
+}
+
+static double test_ms(uint64_t ps)
+{
+    return (double)ps / FLEXSPI_EMU_PS_PER_MS;
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName = FLEXSPI_TEST_PART;
+    uint32_t size        = FLEXSPI_TEST_SIZE;
+    uint32_t rate        = FLEXSPI_TEST_DOWNLOAD_RATE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:d:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                rate = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("Usage: %s [-p part] [-s bytes] [-d download bytes/s]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if ((part == NULL) || (rate == 0))
+    {
+        fprintf(stderr, "Unknown part %s or no download rate\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    test_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl = flexspi_emu_attach(FLEXSPI_TEST_INSTANCE, FLEXSPI_TEST_BASE, FlashDevice.DevAdr,
+                                test_get_serial_root_clock);
+    s_nor  = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if (s_nor == NULL)
+    {
+        return 1;
+    }
+
+    uint32_t sectorSize = FlashDevice.sectors[0].szSector;
+    if (size > part->size)
+    {
+        size = part->size;
+    }
+    size = (size + sectorSize - 1u) / sectorSize * sectorSize;
+
+    uint8_t *image = (uint8_t *)flexspi_emu_map_region(FLEXSPI_TEST_IMAGE_ADDRESS, size);
+    uint32_t seed  = 0x12345678u;
+    if (image == NULL)
+    {
+        fprintf(stderr, "Cannot map the image at 0x%08x\n", FLEXSPI_TEST_IMAGE_ADDRESS);
+        return 1;
+    }
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed     = seed * 1103515245u + 12345u;
+        image[i] = (uint8_t)(seed >> 16);
+    }
+    memset(s_nor->array, 0xFF, size);
+
+    printf("Algorithm: %s, BACKGROUND_PROGRAM %d\n", FlashDevice.DevName, BACKGROUND_PROGRAM);
+    printf("Part: %s, image %u bytes, ProgramPage %lu bytes, download %u bytes/s\n", part->name, size,
+           FlashDevice.szPage, rate);
+
+    const uint8_t *flash = (const uint8_t *)(uintptr_t)FlashDevice.DevAdr;
+    uint64_t downloadPs  = 0;
+    uint64_t programPs   = 0;
+    uint64_t overlapPs   = 0;
+    uint32_t calls       = 0;
+    uint32_t busyCalls   = 0;
+    int failures         = 0;
+
+    if (Init(FlashDevice.DevAdr, 0, 2))
+    {
+        fprintf(stderr, "Init failed\n");
+        return 1;
+    }
+
+    // The debugger downloads each buffer while the core is halted, then runs ProgramPage on it
+    uint64_t start = flexspi_emu_now();
+    for (uint32_t offset = 0; offset < size; offset += FlashDevice.szPage)
+    {
+        uint32_t bytes = size - offset;
+        if (bytes > FlashDevice.szPage)
+        {
+            bytes = FlashDevice.szPage;
+        }
+        uint64_t ps = (uint64_t)bytes * FLEXSPI_EMU_PS_PER_S / rate;
+        flexspi_emu_advance(ps);
+        downloadPs += ps;
+
+        ps = flexspi_emu_now();
+        if (ProgramPage(FlashDevice.DevAdr + offset, bytes, &image[offset]))
+        {
+            fprintf(stderr, "ProgramPage failed at 0x%08x\n", offset);
+            return 1;
+        }
+        programPs += flexspi_emu_now() - ps;
+        calls++;
+
+        ps = test_busy_ps();
+        overlapPs += ps;
+        busyCalls += ps ? 1u : 0u;
+    }
+
+    // The device is still busy with the last page, BlankCheck has to wait for it before reading
+    if (!BlankCheck(FlashDevice.DevAdr + size - FlashDevice.szPage, FlashDevice.szPage, 0xFF) || test_busy_ps())
+    {
+        fprintf(stderr, "BlankCheck read the device while it was busy\n");
+        failures++;
+    }
+    if (UnInit(2) || test_busy_ps())
+    {
+        fprintf(stderr, "UnInit returned while the device was busy\n");
+        failures++;
+    }
+    uint64_t totalPs = flexspi_emu_now() - start;
+
+    if (memcmp(flash, image, size) || (Init(FlashDevice.DevAdr, 0, 3)) ||
+        (Verify(FlashDevice.DevAdr, size, image) != FlashDevice.DevAdr + size) || UnInit(3))
+    {
+        fprintf(stderr, "Programmed content differs from the image\n");
+        failures++;
+    }
+    if (s_nor->stats.ignored_busy || s_nor->stats.protocol_errors || s_nor->stats.unknown_cmds)
+    {
+        fprintf(stderr, "Serial NOR model ignored %llu commands while busy, %llu protocol errors, %llu unknown\n",
+                (unsigned long long)s_nor->stats.ignored_busy, (unsigned long long)s_nor->stats.protocol_errors,
+                (unsigned long long)s_nor->stats.unknown_cmds);
+        failures++;
+    }
+#if BACKGROUND_PROGRAM
+    if (busyCalls == 0)
+    {
+        fprintf(stderr, "No ProgramPage call returned while the device was programming\n");
+        failures++;
+    }
+#endif
+
+    printf("%-10s %12s %12s %12s %12s %12s\n", "calls", "download_ms", "program_ms", "overlap_ms", "total_ms",
+           "serial_ms");
+    printf("%-10u %12.3f %12.3f %12.3f %12.3f %12.3f\n", calls, test_ms(downloadPs), test_ms(programPs),
+           test_ms(overlapPs), test_ms(totalPs), test_ms(totalPs + overlapPs));
+    printf("%u of %u calls returned while the device was programming\n", busyCalls, calls);
+
+    if (failures)
+    {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FlashOS.H"
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1, can be overridden by -p
+#if !defined(FLEXSPI_TEST_PART)
+#define FLEXSPI_TEST_PART "at25sf128a"
+#endif
+
+#if defined(FLEXSPI)
+#define FLEXSPI_TEST_BASE FLEXSPI_BASE
+#elif defined(FLEXSPI0)
+#define FLEXSPI_TEST_BASE FLEXSPI0_BASE
+#elif defined(FLEXSPI1)
+#define FLEXSPI_TEST_BASE FLEXSPI1_BASE
+#endif
+
+//!@brief FlexSPI instance used by the algorithm, FLEXSPI_NOR_INSTANCE of FlashPrg
+#if !defined(FLEXSPI_TEST_INSTANCE)
+#define FLEXSPI_TEST_INSTANCE (0)
+#endif
+
+//!@brief Region erased by one test case, UINT32_MAX as length means up to the device end
+typedef struct _erase_case
+{
+    const char *name;
+    uint32_t start;
+    uint32_t length;
+} erase_case_t;
+
+//!@brief Cost of erasing one region
+typedef struct _erase_cost
+{
+    uint64_t ps;
+    uint64_t commands;
+    nor_emu_stats_t nor;
+} erase_cost_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+extern struct FlashDevice const FlashDevice;
+extern int UnInit(unsigned long fnc);
+extern flexspi_nor_config_t config;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+
+static const erase_case_t s_cases[] = {
+    { "unaligned", 0x00001800u, 0x0007E000u },
+    { "32KB edges", 0x00018000u, 0x00028000u },
+    { "1MB", 0x00100000u, 0x00100000u },
+    { "tail", 0x00003000u, UINT32_MAX },
+    { "device", 0x00000000u, UINT32_MAX },
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t test_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void test_seed_reset_values(void)
+{
+#if defined(CCM_ANALOG_PFD_480_PFD0_FRAC_MASK)
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+#endif
+#if defined(CCM_CSCMR1_FLEXSPI_PODF_MASK)
+    CCM->CSCMR1 = 0x04900080u;
+#endif
+#if defined(CCM_CBCDR_IPG_PODF_MASK)
+    CCM->CBCDR = 0x000A8300u;
+#endif
+}
+
+// Erase loop of flexspi_nor_flash_erase before the erase planner, kept as the reference: the block
+// alignment test masked with ~blockSize, so that only the first two blocks were erased as blocks.
+static status_t test_reference_erase(uint32_t start, uint32_t length)
+{
+    uint32_t aligned_start = ((start) & -(config.sectorSize));
+    uint32_t aligned_end   = (-(-(start + length) & -(config.sectorSize)));
+    status_t status        = kStatus_Success;
+
+    while ((aligned_start < aligned_end) && (status == kStatus_Success))
+    {
+        bool is_addr_block_aligned = !(aligned_start & ~(config.blockSize));
+        if (!config.isUniformBlockSize && is_addr_block_aligned && ((aligned_end - aligned_start) >= config.blockSize))
+        {
+            status = flexspi_nor_flash_erase_block(FLEXSPI_TEST_INSTANCE, &config, aligned_start);
+            aligned_start += config.blockSize;
+        }
+        else
+        {
+            status = flexspi_nor_flash_erase_sector(FLEXSPI_TEST_INSTANCE, &config, aligned_start);
+            aligned_start += config.sectorSize;
+        }
+    }
+    return status;
+}
+
+// Erase the region on a programmed device and check that exactly its sectors became blank
+static bool test_erase(const erase_case_t *item, bool reference, erase_cost_t *cost)
+{
+    uint32_t size   = s_nor->part->size;
+    uint32_t length = (item->length == UINT32_MAX) ? (size - item->start) : item->length;
+    uint32_t start  = item->start & -(config.sectorSize);
+    uint32_t end    = -(-(item->start + length) & -(config.sectorSize));
+    uint8_t *flash  = (uint8_t *)(uintptr_t)FlashDevice.DevAdr;
+    status_t status;
+
+    memset(s_nor->array, 0x00, size);
+    memset(&s_nor->stats, 0, sizeof(s_nor->stats));
+    flexspi_emu_reset_stats(s_ctrl);
+    cost->ps = flexspi_emu_now();
+    if (reference)
+    {
+        status = test_reference_erase(item->start, length);
+    }
+    else
+    {
+        status = flexspi_nor_flash_erase(FLEXSPI_TEST_INSTANCE, &config, item->start, length);
+    }
+    cost->ps       = flexspi_emu_now() - cost->ps;
+    cost->nor      = s_nor->stats;
+    cost->commands = cost->nor.sector_erases + cost->nor.block_erases + cost->nor.chip_erases;
+
+    if (status != kStatus_Success)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < size; i++)
+    {
+        uint8_t expected = ((i >= start) && (i < end)) ? 0xFF : 0x00;
+        if (flash[i] != expected)
+        {
+            printf("  mismatch at 0x%08x: 0x%02x\n", i, flash[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName = FLEXSPI_TEST_PART;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            default:
+                printf("Usage: %s [-p part]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if (part == NULL)
+    {
+        fprintf(stderr, "Unknown part %s\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    test_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl = flexspi_emu_attach(FLEXSPI_TEST_INSTANCE, FLEXSPI_TEST_BASE, FlashDevice.DevAdr,
+                                test_get_serial_root_clock);
+#if defined(DMAMUX)
+    flexspi_emu_attach_dma(s_ctrl, DMA0_BASE, DMAMUX_BASE, kDmaRequestMuxFlexSPIRx, kDmaRequestMuxFlexSPITx);
+#endif
+    s_nor  = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if ((s_nor == NULL) || Init(FlashDevice.DevAdr, 0, 1))
+    {
+        fprintf(stderr, "Init failed\n");
+        return 1;
+    }
+
+    printf("Algorithm: %s\n", FlashDevice.DevName);
+    printf("Part: %s, %u bytes, sector %u, half block %u, block %u\n", part->name, part->size, config.sectorSize,
+           config.halfBlockSize, config.blockSize);
+    printf("%-12s %10s %10s %8s %12s %8s %12s %8s\n", "case", "start", "bytes", "ref_ops", "ref_ms", "ops", "ms",
+           "saved");
+
+    int failures = 0;
+    for (uint32_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++)
+    {
+        const erase_case_t *item = &s_cases[i];
+        erase_cost_t reference = { 0 };
+        erase_cost_t planned   = { 0 };
+        bool pass = test_erase(item, true, &reference) && test_erase(item, false, &planned);
+        double saved = reference.ps ? 100.0 * ((double)reference.ps - (double)planned.ps) / reference.ps : 0.0;
+
+        // The planner must never take more time nor more erase commands than the sector/block loop
+        pass = pass && (planned.ps <= reference.ps) && (planned.commands <= reference.commands);
+        printf("%-12s 0x%08x %10u %8llu %12.3f %8llu %12.3f %7.1f%% %s\n", item->name, item->start,
+               (item->length == UINT32_MAX) ? (part->size - item->start) : item->length,
+               (unsigned long long)reference.commands, (double)reference.ps / FLEXSPI_EMU_PS_PER_MS,
+               (unsigned long long)planned.commands, (double)planned.ps / FLEXSPI_EMU_PS_PER_MS, saved,
+               pass ? "" : "FAIL");
+        failures += pass ? 0 : 1;
+    }
+
+    UnInit(1);
+    if (s_nor->stats.protocol_errors || s_nor->stats.unknown_cmds)
+    {
+        fprintf(stderr, "Serial NOR model reported %llu protocol errors, %llu unknown commands\n",
+                (unsigned long long)s_nor->stats.protocol_errors, (unsigned long long)s_nor->stats.unknown_cmds);
+        failures++;
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FlashOS.H"
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
+#include "flash_incremental/flash_incremental.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief HyperFLASH part connected to A1, can be overridden by -p
+#if !defined(FLEXSPI_TEST_PART)
+#define FLEXSPI_TEST_PART "s26ks512s"
+#endif
+
+//!@brief Bytes of one AHB read of the former blank check, a D-Cache line fill
+#define FLEXSPI_TEST_AHB_ACCESS (32u)
+
+// EraseSector only checks whether a sector is blank in incremental programming
+#if !INCREMENTAL_PROGRAM
+#error "Build with -DINCREMENTAL_PROGRAM=1"
+#endif
+
+#if defined(FLEXSPI)
+#define FLEXSPI_TEST_BASE FLEXSPI_BASE
+#elif defined(FLEXSPI0)
+#define FLEXSPI_TEST_BASE FLEXSPI0_BASE
+#endif
+
+//!@brief FlexSPI instance used by the algorithm, FLEXSPI_NOR_INSTANCE of FlashPrg
+#if !defined(FLEXSPI_TEST_INSTANCE)
+#define FLEXSPI_TEST_INSTANCE (0)
+#endif
+
+//!@brief One EraseSector case, the sector holds a programmed byte at offset unless it is blank
+typedef struct _test_case
+{
+    const char *name;
+    bool blank;
+    uint32_t offset;
+} test_case_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+extern struct FlashDevice const FlashDevice;
+extern int UnInit(unsigned long fnc);
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t test_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void test_seed_reset_values(void)
+{
+#if defined(CCM_ANALOG_PFD_480_PFD0_FRAC_MASK)
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+#endif
+#if defined(CCM_CSCMR1_FLEXSPI_PODF_MASK)
+    CCM->CSCMR1 = 0x04900080u;
+#endif
+#if defined(CCM_CBCDR_IPG_PODF_MASK)
+    CCM->CBCDR = 0x000A8300u;
+#endif
+}
+
+static double test_ms(uint64_t ps)
+{
+    return (double)ps / FLEXSPI_EMU_PS_PER_MS;
+}
+
+static bool test_is_blank(uint32_t offset, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        if (s_nor->array[offset + i] != 0xFF)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Commands the model could not execute, its statistics are cleared with the ones of the controller
+static uint64_t test_model_errors(void)
+{
+    if (s_nor->stats.ignored_busy || s_nor->stats.protocol_errors || s_nor->stats.unknown_cmds)
+    {
+        fprintf(stderr, "HyperFLASH model ignored %llu commands while busy, %llu protocol errors, %llu unknown\n",
+                (unsigned long long)s_nor->stats.ignored_busy, (unsigned long long)s_nor->stats.protocol_errors,
+                (unsigned long long)s_nor->stats.unknown_cmds);
+    }
+    return s_nor->stats.ignored_busy + s_nor->stats.protocol_errors + s_nor->stats.unknown_cmds;
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName = FLEXSPI_TEST_PART;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            default:
+                printf("Usage: %s [-p part]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if ((part == NULL) || !part->hyperBus)
+    {
+        fprintf(stderr, "Unknown part %s or not a HyperFLASH\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    test_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl = flexspi_emu_attach(FLEXSPI_TEST_INSTANCE, FLEXSPI_TEST_BASE, FlashDevice.DevAdr,
+                                test_get_serial_root_clock);
+    s_nor  = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if (s_nor == NULL)
+    {
+        return 1;
+    }
+
+    uint32_t sectorSize = FlashDevice.sectors[0].szSector;
+    const test_case_t cases[] = {
+        { "blank", true, 0 },
+        { "first byte", false, 0 },
+        { "last byte", false, sectorSize - 1u },
+        { "middle", false, sectorSize / 2u + 3u },
+    };
+    int failures = 0;
+
+    printf("Algorithm: %s\n", FlashDevice.DevName);
+    printf("Part: %s, %u bytes, sector %u, write buffer %u\n", part->name, part->size, sectorSize, part->pageSize);
+
+    if (Init(FlashDevice.DevAdr, 0, 1))
+    {
+        fprintf(stderr, "Init failed\n");
+        return 1;
+    }
+    failures += test_model_errors() ? 1 : 0;
+
+    printf("%-12s %10s %8s %8s %12s %8s\n", "case", "sector", "checks", "erases", "ms", "lut_upd");
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const test_case_t *tc = &cases[i];
+        uint32_t sector       = (i + 1u) * sectorSize;
+
+        memset(&s_nor->array[sector], 0xFF, sectorSize);
+        if (!tc->blank)
+        {
+            s_nor->array[sector + tc->offset] = 0x7F;
+        }
+        // Clears the statistics of the model too
+        flexspi_emu_reset_stats(s_ctrl);
+        uint64_t start = flexspi_emu_now();
+        if (EraseSector(FlashDevice.DevAdr + sector))
+        {
+            fprintf(stderr, "EraseSector failed at 0x%08x\n", sector);
+            failures++;
+        }
+        uint64_t ps      = flexspi_emu_now() - start;
+        uint64_t checks  = s_nor->stats.blank_checks;
+        uint64_t erases  = s_nor->stats.sector_erases;
+        uint64_t updates = flexspi_emu_get_stats(s_ctrl)->lut_unlocks;
+
+        printf("%-12s 0x%08x %8llu %8llu %12.3f %8llu\n", tc->name, sector, (unsigned long long)checks,
+               (unsigned long long)erases, test_ms(ps), (unsigned long long)updates);
+        if ((checks != 1) || (erases != (tc->blank ? 0u : 1u)) || !test_is_blank(sector, sectorSize))
+        {
+            fprintf(stderr, "%s: the sector must be erased unless it is blank, and checked once\n", tc->name);
+            failures++;
+        }
+        if (updates)
+        {
+            fprintf(stderr, "%s: the LUT was updated, the sequences must run from the resident lookupTable\n",
+                    tc->name);
+            failures++;
+        }
+        failures += test_model_errors() ? 1 : 0;
+    }
+    if (UnInit(1))
+    {
+        fprintf(stderr, "UnInit failed\n");
+        failures++;
+    }
+
+    printf("AHB read of a sector in %u-byte reads: %.3f ms\n", FLEXSPI_TEST_AHB_ACCESS,
+           test_ms(flexspi_emu_ahb_read_time(s_ctrl, FlashDevice.DevAdr, sectorSize, FLEXSPI_TEST_AHB_ACCESS)));
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
+#include "flash_loader.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1, can be overridden by -p
+#if !defined(IAR_TEST_PART)
+#define IAR_TEST_PART "is25wp064a"
+#endif
+
+//!@brief Bytes of the image checked from the device start, can be overridden by -s
+#if !defined(IAR_TEST_SIZE)
+#define IAR_TEST_SIZE (1024u * 1024u)
+#endif
+
+//!@brief FlexSPI instance and AHB window of the loader, FLEXSPI_NOR_INSTANCE and FLASH_BASE_ADDR
+#define IAR_TEST_INSTANCE (0)
+#define IAR_TEST_FLASH_BASE (0x60000000u)
+
+//!@brief Range of the AHB window passed to FlashChecksum
+//!
+//! UINT32_MAX as offset means the image end, as length up to the image end.
+typedef struct _checksum_case
+{
+    const char *name;
+    uint32_t offset;
+    uint32_t length;
+} checksum_case_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+
+static const checksum_case_t s_cases[] = {
+    { "empty", 0x00000000u, 0u },
+    { "1 byte", 0x00000003u, 1u },
+    { "word", 0x00000004u, 4u },
+    { "unaligned", 0x00000001u, 255u },
+    { "odd tail", 0x00000002u, 0x00001007u },
+    { "page", 0x00000100u, 256u },
+    { "image", 0x00000000u, UINT32_MAX },
+    { "image+1", 0x00000001u, UINT32_MAX },
+    { "erased", UINT32_MAX, 0x00010000u },
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+// ROM bl_api stand-in: the loader links against the middleware, which is the ROM FlexSPI NOR driver source
+void bl_api_init(void)
+{
+}
+
+// Crc16() of the IAR flash loader framework, the value the debugger compares FlashChecksum with
+uint16_t Crc16(uint8_t const *p, uint32_t len)
+{
+    static const uint8_t zero[2] = { 0, 0 };
+    uint16_t sum                 = 0;
+
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        for (uint32_t i = 0; i < len; i++)
+        {
+            uint8_t byte = p[i];
+            for (uint32_t bit = 0; bit < 8; bit++)
+            {
+                uint32_t osum = sum;
+                sum           = (uint16_t)((sum << 1) | ((byte & 0x80u) ? 1u : 0u));
+                if (osum & 0x8000u)
+                {
+                    sum ^= 0x1021u;
+                }
+                byte <<= 1;
+            }
+        }
+        p   = zero;
+        len = sizeof(zero);
+    }
+
+    return sum;
+}
+
+static double test_host_ms(clock_t start)
+{
+    return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName = IAR_TEST_PART;
+    uint32_t size        = IAR_TEST_SIZE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("Usage: %s [-p part] [-s bytes]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if (part == NULL)
+    {
+        fprintf(stderr, "Unknown part %s\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    s_ctrl = flexspi_emu_attach(IAR_TEST_INSTANCE, FLEXSPI_BASE, IAR_TEST_FLASH_BASE, NULL);
+    s_nor  = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if (s_nor == NULL)
+    {
+        return 1;
+    }
+
+    // The check value of CRC-16/XMODEM, which the framework Crc16() computes
+    if (Crc16((const uint8_t *)"123456789", 9) != 0x31C3u)
+    {
+        fprintf(stderr, "Reference Crc16 is wrong\n");
+        return 1;
+    }
+
+    // Image programmed at the device start, erased flash behind it
+    if (size > part->size - 0x00010000u)
+    {
+        size = part->size - 0x00010000u;
+    }
+    uint32_t seed = 0x12345678u;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed            = seed * 1103515245u + 12345u;
+        s_nor->array[i] = (uint8_t)(seed >> 16);
+    }
+
+    printf("Part: %s, image %u bytes, AHB window 0x%08x\n", part->name, size, IAR_TEST_FLASH_BASE);
+    printf("%-12s %10s %10s %10s %8s\n", "case", "offset", "bytes", "checksum", "result");
+
+    int failures = 0;
+    for (uint32_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++)
+    {
+        const checksum_case_t *c = &s_cases[i];
+        uint32_t offset          = (c->offset == UINT32_MAX) ? size : c->offset;
+        uint32_t length          = (c->length == UINT32_MAX) ? size - offset : c->length;
+        const uint8_t *begin     = (const uint8_t *)(uintptr_t)(IAR_TEST_FLASH_BASE + offset);
+        uint32_t expected        = Crc16(begin, length);
+        uint32_t actual          = FlashChecksum(begin, length);
+        bool pass                = (actual == expected);
+
+        printf("%-12s 0x%08x %10u     0x%04x %8s\n", c->name, offset, length, actual, pass ? "ok" : "FAIL");
+        if (!pass)
+        {
+            fprintf(stderr, "%s: FlashChecksum 0x%04x, Crc16 0x%04x\n", c->name, actual, expected);
+            failures++;
+        }
+    }
+
+    // Host time only, the model does not time AHB reads
+    const uint8_t *image = (const uint8_t *)(uintptr_t)IAR_TEST_FLASH_BASE;
+    volatile uint32_t sum;
+    clock_t start     = clock();
+    sum               = Crc16(image, size);
+    double crc16Ms    = test_host_ms(start);
+    start             = clock();
+    sum               = FlashChecksum(image, size);
+    double checksumMs = test_host_ms(start);
+    (void)sum;
+    printf("Host time: Crc16 %.3f ms, FlashChecksum %.3f ms\n", crc16Ms, checksumMs);
+
+    if (failures)
+    {
+        fprintf(stderr, "%d checksum case(s) failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
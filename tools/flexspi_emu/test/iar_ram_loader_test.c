@@ -0,0 +1,257 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "flash_loader.h"
+#include "flexspi_emu.h"
+#include "sw_crc.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief DTCM block of FlashIMXRT1060_DTCM.flash, mapped as plain memory by flexspi_emu_map_soc()
+#define RAM_TEST_BASE (0x20000000u)
+#define RAM_TEST_BLOCK_SIZE (0x00080000u)
+
+//!@brief Bytes of the image, can be overridden by -s
+#if !defined(RAM_TEST_SIZE)
+#define RAM_TEST_SIZE (RAM_TEST_BLOCK_SIZE - 0x1000u)
+#endif
+
+//!@brief Offset of the image in the block, unaligned on purpose
+#define RAM_TEST_OFFSET (0x00000003u)
+
+//!@brief FlashWrite buffer of the framework, can be overridden by -b
+#if !defined(RAM_TEST_BUFFER_SIZE)
+#define RAM_TEST_BUFFER_SIZE (0x8000u)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t s_image[RAM_TEST_BLOCK_SIZE];
+static uint8_t s_expected[RAM_TEST_BLOCK_SIZE];
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+// Crc16() of the IAR flash loader framework, the value the debugger compares FlashChecksum with
+uint16_t Crc16(uint8_t const *p, uint32_t len)
+{
+    static const uint8_t zero[2] = { 0, 0 };
+    uint16_t sum                 = 0;
+
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        for (uint32_t i = 0; i < len; i++)
+        {
+            uint8_t byte = p[i];
+            for (uint32_t bit = 0; bit < 8; bit++)
+            {
+                uint32_t osum = sum;
+                sum           = (uint16_t)((sum << 1) | ((byte & 0x80u) ? 1u : 0u));
+                if (osum & 0x8000u)
+                {
+                    sum ^= 0x1021u;
+                }
+                byte <<= 1;
+            }
+        }
+        p   = zero;
+        len = sizeof(zero);
+    }
+
+    return sum;
+}
+
+static double test_host_ms(clock_t start)
+{
+    return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+static void test_fill(uint8_t *dst, uint32_t size, uint32_t seed)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        seed   = seed * 1103515245u + 12345u;
+        dst[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+// Download the way the framework does: FlashWrite per buffer, the last one partial
+static uint32_t test_download(uint32_t offset, const uint8_t *image, uint32_t size, uint32_t bufferSize)
+{
+    for (uint32_t done = 0; done < size;)
+    {
+        uint32_t count = (size - done < bufferSize) ? size - done : bufferSize;
+        if (FlashWrite((void *)(uintptr_t)RAM_TEST_BASE, offset + done, count, (const char *)&image[done]) !=
+            RESULT_OK)
+        {
+            return RESULT_ERROR;
+        }
+        done += count;
+    }
+
+    return RESULT_OK;
+}
+
+// Compare RAM with the expected content and FlashChecksum of a range with Crc16
+static int test_check(const char *name, uint32_t offset, uint32_t length)
+{
+    uint8_t *ram      = (uint8_t *)(uintptr_t)RAM_TEST_BASE;
+    uint32_t expected = Crc16(&s_expected[offset], length);
+    uint32_t actual   = FlashChecksum(&ram[offset], length);
+    bool pass         = (memcmp(ram, s_expected, RAM_TEST_BLOCK_SIZE) == 0) && (actual == expected);
+
+    printf("%-16s 0x%08x %10u     0x%04x %8s\n", name, offset, length, actual, pass ? "ok" : "FAIL");
+    if (!pass)
+    {
+        fprintf(stderr, "%s: FlashChecksum 0x%04x, Crc16 0x%04x%s\n", name, actual, expected,
+                memcmp(ram, s_expected, RAM_TEST_BLOCK_SIZE) ? ", content differs" : "");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t size       = RAM_TEST_SIZE;
+    uint32_t bufferSize = RAM_TEST_BUFFER_SIZE;
+    const char *args[]  = { NULL };
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:b:")) != -1)
+    {
+        switch (opt)
+        {
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                bufferSize = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("Usage: %s [-s bytes] [-b buffer bytes]\n", argv[0]);
+                return 2;
+        }
+    }
+    if ((size == 0) || (size > RAM_TEST_BLOCK_SIZE - RAM_TEST_OFFSET - 0x100u) || (bufferSize == 0))
+    {
+        fprintf(stderr, "Image size must be 1 to %u bytes, buffer at least 1 byte\n",
+                RAM_TEST_BLOCK_SIZE - RAM_TEST_OFFSET - 0x100u);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+
+    uint8_t *ram = (uint8_t *)(uintptr_t)RAM_TEST_BASE;
+    int failures = 0;
+
+    printf("RAM block 0x%08x, image %u bytes at offset %u, FlashWrite buffer %u bytes\n", RAM_TEST_BASE, size,
+           RAM_TEST_OFFSET, bufferSize);
+    printf("%-16s %10s %10s %10s %8s\n", "case", "offset", "bytes", "checksum", "result");
+
+    // RAM keeps what it held before the download, FlashErase does not touch it
+    test_fill(ram, RAM_TEST_BLOCK_SIZE, 0xA5A5A5A5u);
+    memcpy(s_expected, ram, RAM_TEST_BLOCK_SIZE);
+    if ((FlashInit(ram, size, 0, 0, 0, args) != RESULT_OK) ||
+        (FlashErase(ram, RAM_TEST_BLOCK_SIZE) != RESULT_OK))
+    {
+        fprintf(stderr, "FlashInit or FlashErase failed\n");
+        return 1;
+    }
+    failures += test_check("erase", 0, RAM_TEST_BLOCK_SIZE);
+
+    // Image in framework buffers, unaligned start and partial last buffer
+    test_fill(s_image, size, 0x12345678u);
+    memcpy(&s_expected[RAM_TEST_OFFSET], s_image, size);
+    if (test_download(RAM_TEST_OFFSET, s_image, size, bufferSize) != RESULT_OK)
+    {
+        fprintf(stderr, "FlashWrite failed\n");
+        return 1;
+    }
+    failures += test_check("image", RAM_TEST_OFFSET, size);
+    failures += test_check("image+1", RAM_TEST_OFFSET + 1, size - 1);
+    failures += test_check("first buffer", RAM_TEST_OFFSET, (size < bufferSize) ? size : bufferSize);
+
+    // A second range behind the image is its own run, the image run stays valid
+    uint32_t tailOffset = RAM_TEST_OFFSET + size + 0x10u;
+    uint32_t tailSize   = RAM_TEST_BLOCK_SIZE - tailOffset;
+    test_fill(&s_expected[tailOffset], tailSize, 0x0BADF00Du);
+    if (FlashWrite(ram, tailOffset, tailSize, (const char *)&s_expected[tailOffset]) != RESULT_OK)
+    {
+        return 1;
+    }
+    failures += test_check("second run", tailOffset, tailSize);
+    failures += test_check("image again", RAM_TEST_OFFSET, size);
+
+    // Writing into the image makes its run stale, FlashChecksum has to read the RAM again
+    uint32_t patchOffset = RAM_TEST_OFFSET + size / 2u + 5u;
+    uint32_t patchSize   = (size - size / 2u > 300u) ? 295u : size - size / 2u - 5u;
+    if (size > 16u)
+    {
+        test_fill(&s_expected[patchOffset], patchSize, 0xCAFEBABEu);
+        if (FlashWrite(ram, patchOffset, patchSize, (const char *)&s_expected[patchOffset]) != RESULT_OK)
+        {
+            return 1;
+        }
+        failures += test_check("overwritten", RAM_TEST_OFFSET, size);
+    }
+
+    // A new FlashInit forgets the runs of the former download
+    if (FlashInit(ram, size, 0, 0, 0, args) != RESULT_OK)
+    {
+        return 1;
+    }
+    failures += test_check("after init", tailOffset, tailSize);
+
+    // Host time of a download and verify: the former loop erased with memset, copied with memcpy and read the
+    // RAM again for the checksum
+    volatile uint32_t sum;
+    clock_t start = clock();
+    for (uint32_t block = 0; block < 8; block++)
+    {
+        memset(ram, 0xFF, RAM_TEST_BLOCK_SIZE);
+        for (uint32_t done = 0; done < size; done += bufferSize)
+        {
+            uint32_t count = (size - done < bufferSize) ? size - done : bufferSize;
+            memcpy(&ram[RAM_TEST_OFFSET + done], &s_image[done], count);
+        }
+        sum = sw_crc16(0, &ram[RAM_TEST_OFFSET], size);
+    }
+    double formerMs = test_host_ms(start) / 8;
+    start           = clock();
+    for (uint32_t block = 0; block < 8; block++)
+    {
+        FlashInit(ram, size, 0, 0, 0, args);
+        FlashErase(ram, RAM_TEST_BLOCK_SIZE);
+        test_download(RAM_TEST_OFFSET, s_image, size, bufferSize);
+        sum = FlashChecksum(&ram[RAM_TEST_OFFSET], size);
+    }
+    double loaderMs = test_host_ms(start) / 8;
+    (void)sum;
+    printf("Host time per download: memset+memcpy+sw_crc16 %.3f ms, FlashErase+FlashWrite+FlashChecksum %.3f ms\n",
+           formerMs, loaderMs);
+
+    if (failures)
+    {
+        fprintf(stderr, "%d case(s) failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,325 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FlashOS.H"
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1 and B1, can be overridden by -p
+#if !defined(FLEXSPI_TEST_PART)
+#define FLEXSPI_TEST_PART "at25sf128a"
+#endif
+
+//!@brief Bytes of each chip covered by a test case, can be overridden by -s
+#if !defined(FLEXSPI_TEST_SIZE)
+#define FLEXSPI_TEST_SIZE (256u * 1024u)
+#endif
+
+//!@brief Timeout of the case where B1 never gets ready, shorter than programming the A1 part of the range
+#define FLEXSPI_TEST_TIMEOUT_MS (20u)
+
+//!@brief Host buffer of the image, placed below 4GB like the bench one
+#define FLEXSPI_TEST_IMAGE_ADDRESS (0x10000000u)
+
+#if defined(FLEXSPI)
+#define FLEXSPI_TEST_BASE FLEXSPI_BASE
+#elif defined(FLEXSPI0)
+#define FLEXSPI_TEST_BASE FLEXSPI0_BASE
+#elif defined(FLEXSPI1)
+#define FLEXSPI_TEST_BASE FLEXSPI1_BASE
+#endif
+
+//!@brief FlexSPI instance used by the algorithm, FLEXSPI_NOR_INSTANCE of FlashPrg
+#if !defined(FLEXSPI_TEST_INSTANCE)
+#define FLEXSPI_TEST_INSTANCE (0)
+#endif
+
+//!@brief Region of a test case, relative to the end of A1
+typedef struct _multi_chip_case
+{
+    const char *name;
+    bool program;
+    int32_t offset;
+} multi_chip_case_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+extern struct FlashDevice const FlashDevice;
+extern int UnInit(unsigned long fnc);
+extern flexspi_nor_config_t config;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor[2];
+static uint8_t *s_image;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t test_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void test_seed_reset_values(void)
+{
+#if defined(CCM_ANALOG_PFD_480_PFD0_FRAC_MASK)
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+#endif
+#if defined(CCM_CSCMR1_FLEXSPI_PODF_MASK)
+    CCM->CSCMR1 = 0x04900080u;
+#endif
+#if defined(CCM_CBCDR_IPG_PODF_MASK)
+    CCM->CBCDR = 0x000A8300u;
+#endif
+}
+
+// Program or erase [start, start + length) in one call, or with one call per chip select as the reference
+static status_t test_run(bool program, bool reference, uint32_t start, uint32_t length)
+{
+    uint32_t chipEnd = config.memConfig.sflashA1Size;
+    uint32_t parts[2][2] = { { start, length }, { 0, 0 } };
+    status_t status = kStatus_Success;
+
+    if (reference && (start < chipEnd) && (start + length > chipEnd))
+    {
+        parts[0][1] = chipEnd - start;
+        parts[1][0] = chipEnd;
+        parts[1][1] = length - parts[0][1];
+    }
+    for (uint32_t i = 0; (i < 2) && parts[i][1] && (status == kStatus_Success); i++)
+    {
+        if (program)
+        {
+            status = flexspi_nor_flash_program(FLEXSPI_TEST_INSTANCE, &config, parts[i][0],
+                                               (const uint32_t *)&s_image[parts[i][0] - start], parts[i][1]);
+        }
+        else
+        {
+            status = flexspi_nor_flash_erase(FLEXSPI_TEST_INSTANCE, &config, parts[i][0], parts[i][1]);
+        }
+    }
+
+    return status;
+}
+
+// Run a case on both devices and check that exactly its region was programmed or erased
+static bool test_case(bool program, bool reference, uint32_t start, uint32_t length, uint64_t *ps)
+{
+    uint32_t chipSize = s_nor[0]->part->size;
+    const uint8_t *flash = (const uint8_t *)(uintptr_t)FlashDevice.DevAdr;
+    uint8_t fill = program ? 0xFF : 0x00;
+
+    // Only the region and a sector around it are checked, the arrays are large
+    uint32_t low  = (start > config.sectorSize) ? (start - config.sectorSize) : 0;
+    uint32_t high = start + length + config.sectorSize;
+    if (high > 2u * chipSize)
+    {
+        high = 2u * chipSize;
+    }
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        memset(s_nor[i]->array, fill, chipSize);
+        memset(&s_nor[i]->stats, 0, sizeof(s_nor[i]->stats));
+    }
+    *ps = flexspi_emu_now();
+    status_t status = test_run(program, reference, start, length);
+    *ps = flexspi_emu_now() - *ps;
+    if (status != kStatus_Success)
+    {
+        printf("  status %d\n", (int)status);
+        return false;
+    }
+
+    for (uint32_t i = low; i < high; i++)
+    {
+        uint8_t expected = fill;
+        if ((i >= start) && (i < start + length))
+        {
+            expected = program ? s_image[i - start] : 0xFF;
+        }
+        if (flash[i] != expected)
+        {
+            printf("  mismatch at 0x%08x: 0x%02x\n", i, flash[i]);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        if (s_nor[i]->stats.ignored_busy || s_nor[i]->stats.protocol_errors || s_nor[i]->stats.unknown_cmds)
+        {
+            printf("  chip %u ignored %llu commands while busy, %llu protocol errors, %llu unknown\n", i,
+                   (unsigned long long)s_nor[i]->stats.ignored_busy,
+                   (unsigned long long)s_nor[i]->stats.protocol_errors,
+                   (unsigned long long)s_nor[i]->stats.unknown_cmds);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName = FLEXSPI_TEST_PART;
+    uint32_t size        = FLEXSPI_TEST_SIZE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("Usage: %s [-p part] [-s bytes]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if (part == NULL)
+    {
+        fprintf(stderr, "Unknown part %s\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    test_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl   = flexspi_emu_attach(FLEXSPI_TEST_INSTANCE, FLEXSPI_TEST_BASE, FlashDevice.DevAdr,
+                                  test_get_serial_root_clock);
+    s_nor[0] = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if ((s_nor[0] == NULL) || Init(FlashDevice.DevAdr, 0, 1))
+    {
+        fprintf(stderr, "Init failed\n");
+        return 1;
+    }
+
+    // Same part on B1, configured like A1 by Init (QE is nonvolatile), then mapped after A1 in FLSHCR0
+    s_nor[1] = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_B1, part);
+    if (s_nor[1] == NULL)
+    {
+        return 1;
+    }
+    s_nor[1]->sr1                 = s_nor[0]->sr1;
+    s_nor[1]->sr2                 = s_nor[0]->sr2;
+    config.memConfig.sflashB1Size = config.memConfig.sflashA1Size;
+    if (flexspi_nor_flash_init(FLEXSPI_TEST_INSTANCE, &config) != kStatus_Success)
+    {
+        fprintf(stderr, "Init of A1 + B1 failed\n");
+        return 1;
+    }
+
+    size = (size + config.sectorSize - 1u) / config.sectorSize * config.sectorSize;
+    if ((size == 0) || (size > part->size))
+    {
+        size = part->size;
+    }
+    s_image = (uint8_t *)flexspi_emu_map_region(FLEXSPI_TEST_IMAGE_ADDRESS, 2u * size);
+    if (s_image == NULL)
+    {
+        fprintf(stderr, "Cannot map the image at 0x%08x\n", FLEXSPI_TEST_IMAGE_ADDRESS);
+        return 1;
+    }
+    uint32_t seed = 0x12345678u;
+    for (uint32_t i = 0; i < 2u * size; i++)
+    {
+        seed       = seed * 1103515245u + 12345u;
+        s_image[i] = (uint8_t)(seed >> 16);
+    }
+
+    const multi_chip_case_t cases[] = {
+        { "erase", false, -(int32_t)size },
+        { "program", true, -(int32_t)size },
+        { "erase A1", false, -(int32_t)(2u * size) },
+        { "program A1", true, -(int32_t)(2u * size) },
+    };
+
+    printf("Algorithm: %s\n", FlashDevice.DevName);
+    printf("Part: %s on A1 and B1, %u bytes of each chip\n", part->name, size);
+    printf("%-12s %10s %10s %12s %12s %8s\n", "case", "start", "bytes", "ref_ms", "ms", "speedup");
+
+    int failures = 0;
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const multi_chip_case_t *item = &cases[i];
+        // With -s the size of a chip, the whole of A1 and B1 is covered and there is no room for the A1 cases
+        if ((int64_t)config.memConfig.sflashA1Size + item->offset < 0)
+        {
+            continue;
+        }
+        uint32_t start  = config.memConfig.sflashA1Size + item->offset;
+        uint32_t length = 2u * size;
+        uint64_t referencePs = 0;
+        uint64_t ps          = 0;
+        bool pass = test_case(item->program, true, start, length, &referencePs) &&
+                    test_case(item->program, false, start, length, &ps);
+        double speedup  = ps ? (double)referencePs / ps : 0.0;
+        bool bothChips  = (start + length) > config.memConfig.sflashA1Size;
+
+        // A range over both chips must take close to half the time, one chip must not get slower
+        pass = pass && (bothChips ? (speedup >= 1.8) : (ps <= referencePs));
+        printf("%-12s 0x%08x %10u %12.3f %12.3f %7.2fx %s\n", item->name, start, length,
+               (double)referencePs / FLEXSPI_EMU_PS_PER_MS, (double)ps / FLEXSPI_EMU_PS_PER_MS, speedup,
+               pass ? "" : "FAIL");
+        failures += pass ? 0 : 1;
+    }
+
+    // B1 stays busy past the timeout while A1 programs, the error must only come back once A1 is idle again
+    uint32_t timeoutInMs = config.memConfig.timeoutInMs;
+    uint32_t start       = config.memConfig.sflashA1Size - size;
+    uint64_t ps          = flexspi_emu_now();
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        memset(s_nor[i]->array, 0xFF, part->size);
+    }
+    // The fast poll would skip the read status loop of B1 up to its end, and with it the timeout
+    flexspi_emu_set_fast_poll(false);
+    config.memConfig.timeoutInMs = FLEXSPI_TEST_TIMEOUT_MS;
+    s_nor[1]->busyUntil          = ps + 10u * FLEXSPI_EMU_PS_PER_S;
+    status_t status              = test_run(true, false, start, 2u * size);
+    ps                           = flexspi_emu_now() - ps;
+    bool pass = (status != kStatus_Success) && !nor_emu_is_busy(s_nor[0], flexspi_emu_now());
+    printf("%-12s 0x%08x %10u %12s %12.3f %8s %s\n", "timeout B1", start, 2u * size, "-",
+           (double)ps / FLEXSPI_EMU_PS_PER_MS, "-", pass ? "" : "FAIL");
+    failures += pass ? 0 : 1;
+    config.memConfig.timeoutInMs = timeoutInMs;
+    s_nor[1]->busyUntil          = 0;
+    flexspi_emu_set_fast_poll(true);
+
+    UnInit(1);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,383 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FlashOS.H"
+#include "fsl_device_registers.h"
+#include "flexspi/fsl_flexspi.h"
+#include "flexspi_nor/flexspi_nor_flash.h"
+#include "flexspi_emu.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Serial NOR part connected to A1, can be overridden by -p
+#if !defined(FLEXSPI_TEST_PART)
+#define FLEXSPI_TEST_PART "at25sf128a"
+#endif
+
+//!@brief Bytes read back at the configured and the tuned clock, can be overridden by -s
+#if !defined(FLEXSPI_TEST_SIZE)
+#define FLEXSPI_TEST_SIZE (64u * 1024u)
+#endif
+
+//!@brief Bytes read back by one flexspi_nor_flash_read call
+#define FLEXSPI_TEST_READ_SIZE (32u * 1024u)
+
+//!@brief Host buffer of the read back, placed below 4GB like the bench one
+#define FLEXSPI_TEST_BUFFER_ADDRESS (0x10000000u)
+
+#if defined(FLEXSPI)
+#define FLEXSPI_TEST_BASE FLEXSPI_BASE
+#elif defined(FLEXSPI0)
+#define FLEXSPI_TEST_BASE FLEXSPI0_BASE
+#elif defined(FLEXSPI1)
+#define FLEXSPI_TEST_BASE FLEXSPI1_BASE
+#endif
+
+//!@brief FlexSPI instance used by the algorithm, FLEXSPI_NOR_INSTANCE of FlashPrg
+#if !defined(FLEXSPI_TEST_INSTANCE)
+#define FLEXSPI_TEST_INSTANCE (0)
+#endif
+
+//!@brief Config block cache of the algorithm, CONFIG_CACHE_ADDRESS of FlashPrg. Define it for both to check that a
+//! cache the application overwrote is discarded, 0 skips the check
+#if !defined(CONFIG_CACHE_ADDRESS)
+#define CONFIG_CACHE_ADDRESS (0)
+#endif
+
+//!@brief Read point and cost of an Init
+typedef struct _read_tune_result
+{
+    uint32_t freq;
+    uint32_t dummyCycles;
+    uint32_t sckHz;
+    uint64_t ipCmds;
+    uint64_t probeErrors;
+    uint64_t ps;
+} read_tune_result_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototypes
+////////////////////////////////////////////////////////////////////////////////
+
+extern struct FlashDevice const FlashDevice;
+extern int UnInit(unsigned long fnc);
+extern flexspi_nor_config_t config;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+static flexspi_emu_ctrl_t *s_ctrl;
+static nor_emu_device_t *s_nor;
+static uint8_t *s_buffer;
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t test_get_serial_root_clock(uint32_t instance)
+{
+    uint32_t freq = 0;
+    flexspi_get_clock(instance, kFlexSpiClock_SerialRootClock, &freq);
+    return freq;
+}
+
+// Registers are mapped zero-filled, seed the reset values the clock code divides by
+static void test_seed_reset_values(void)
+{
+#if defined(CCM_ANALOG_PFD_480_PFD0_FRAC_MASK)
+    CCM_ANALOG->PFD_480 = 0x0F1A231Au;
+#endif
+#if defined(CCM_CSCMR1_FLEXSPI_PODF_MASK)
+    CCM->CSCMR1 = 0x04900080u;
+#endif
+#if defined(CCM_CBCDR_IPG_PODF_MASK)
+    CCM->CBCDR = 0x000A8300u;
+#endif
+}
+
+// Dummy cycles of the read sequence, 0 if it has none
+static uint32_t test_get_read_dummy_cycles(const flexspi_nor_config_t *nor)
+{
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint32_t instruction = nor->memConfig.lookupTable[NOR_CMD_LUT_SEQ_IDX_READ * 4 + i / 2] >> ((i & 1) * 16);
+        uint32_t opcode      = (instruction >> 10) & 0x3Fu;
+        if (opcode == STOP)
+        {
+            break;
+        }
+        if ((opcode == DUMMY_SDR) || (opcode == DUMMY_DDR))
+        {
+            return instruction & 0xFFu;
+        }
+    }
+    return 0;
+}
+
+// Run Init and record the read point it leaves
+static bool test_init(read_tune_result_t *result)
+{
+    flexspi_emu_reset_stats(s_ctrl);
+    memset(&s_nor->stats, 0, sizeof(s_nor->stats));
+    uint64_t start = flexspi_emu_now();
+    if (Init(FlashDevice.DevAdr, 0, 2))
+    {
+        printf("  Init failed\n");
+        return false;
+    }
+    result->ps          = flexspi_emu_now() - start;
+    result->ipCmds      = flexspi_emu_get_stats(s_ctrl)->ip_cmds;
+    result->probeErrors = s_nor->stats.protocol_errors;
+    result->freq        = config.memConfig.serialClkFreq;
+    result->dummyCycles = test_get_read_dummy_cycles(&config);
+    result->sckHz       = test_get_serial_root_clock(FLEXSPI_TEST_INSTANCE);
+    if (config.memConfig.controllerMiscOption & FLEXSPI_BITMASK(kFlexSpiMiscOffset_DdrModeEnable))
+    {
+        result->sckHz /= 2u;
+    }
+    return true;
+}
+
+// Read [0, size) through IP commands with the given config and check it against the array
+static bool test_read(flexspi_nor_config_t *nor, uint32_t size, uint64_t *ps)
+{
+    if (flexspi_nor_flash_init(FLEXSPI_TEST_INSTANCE, nor) != kStatus_Success)
+    {
+        printf("  flexspi_nor_flash_init failed\n");
+        return false;
+    }
+    memset(s_buffer, 0, size);
+    memset(&s_nor->stats, 0, sizeof(s_nor->stats));
+    status_t status = kStatus_Success;
+    *ps = flexspi_emu_now();
+    for (uint32_t offset = 0; (offset < size) && (status == kStatus_Success); offset += FLEXSPI_TEST_READ_SIZE)
+    {
+        uint32_t length = (size - offset < FLEXSPI_TEST_READ_SIZE) ? (size - offset) : FLEXSPI_TEST_READ_SIZE;
+        status = flexspi_nor_flash_read(FLEXSPI_TEST_INSTANCE, nor, (uint32_t *)&s_buffer[offset], offset, length);
+    }
+    *ps = flexspi_emu_now() - *ps;
+    if ((status != kStatus_Success) || (s_nor->stats.protocol_errors != 0))
+    {
+        printf("  read status %d, %llu protocol errors\n", (int)status,
+               (unsigned long long)s_nor->stats.protocol_errors);
+        return false;
+    }
+    if (memcmp(s_buffer, s_nor->array, size) != 0)
+    {
+        printf("  read back differs\n");
+        return false;
+    }
+    return true;
+}
+
+// Erase and program a sector after the reference data with the given config, then read it back
+static bool test_program(flexspi_nor_config_t *nor, uint32_t size, uint64_t *ps)
+{
+    uint32_t address = size;
+    memset(&s_nor->stats, 0, sizeof(s_nor->stats));
+    *ps = flexspi_emu_now();
+    if ((flexspi_nor_flash_erase(FLEXSPI_TEST_INSTANCE, nor, address, nor->sectorSize) != kStatus_Success) ||
+        (flexspi_nor_flash_program(FLEXSPI_TEST_INSTANCE, nor, address, (const uint32_t *)&s_buffer[size],
+                                   nor->sectorSize) != kStatus_Success))
+    {
+        printf("  erase or program failed\n");
+        return false;
+    }
+    *ps = flexspi_emu_now() - *ps;
+    if (memcmp(&s_nor->array[address], &s_buffer[size], nor->sectorSize) != 0)
+    {
+        printf("  programmed data differs\n");
+        return false;
+    }
+    if (s_nor->stats.protocol_errors || s_nor->stats.ignored_busy || s_nor->stats.ignored_wel)
+    {
+        printf("  %llu protocol errors, %llu commands ignored while busy, %llu without WEL\n",
+               (unsigned long long)s_nor->stats.protocol_errors, (unsigned long long)s_nor->stats.ignored_busy,
+               (unsigned long long)s_nor->stats.ignored_wel);
+        return false;
+    }
+    uint64_t readPs;
+    return test_read(nor, size, &readPs);
+}
+
+static void test_print(const char *name, const read_tune_result_t *result, bool pass)
+{
+    printf("%-8s %8llu %10llu %10.3f %9.3f %6u %s\n", name, (unsigned long long)result->ipCmds,
+           (unsigned long long)result->probeErrors, (double)result->ps / FLEXSPI_EMU_PS_PER_MS,
+           result->sckHz / 1000000.0, result->dummyCycles, pass ? "" : "FAIL");
+}
+
+int main(int argc, char **argv)
+{
+    const char *partName = FLEXSPI_TEST_PART;
+    uint32_t size        = FLEXSPI_TEST_SIZE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                partName = optarg;
+                break;
+            case 's':
+                size = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("Usage: %s [-p part] [-s bytes]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    const nor_emu_part_t *part = nor_emu_find_part(partName);
+    if (part == NULL)
+    {
+        fprintf(stderr, "Unknown part %s\n", partName);
+        return 2;
+    }
+    if (flexspi_emu_map_soc() != 0)
+    {
+        return 1;
+    }
+    test_seed_reset_values();
+    flexspi_emu_set_core_clock(SystemCoreClock);
+
+    s_ctrl = flexspi_emu_attach(FLEXSPI_TEST_INSTANCE, FLEXSPI_TEST_BASE, FlashDevice.DevAdr,
+                                test_get_serial_root_clock);
+    s_nor  = flexspi_emu_connect(s_ctrl, kFlexSpiEmuPort_A1, part);
+    if (s_nor == NULL)
+    {
+        return 1;
+    }
+    size = (size + 4095u) & ~4095u;
+    if ((size == 0) || (size + 4096u > part->size))
+    {
+        size = part->size / 2u;
+    }
+    s_buffer = (uint8_t *)flexspi_emu_map_region(FLEXSPI_TEST_BUFFER_ADDRESS, size + 4096u);
+    if (s_buffer == NULL)
+    {
+        fprintf(stderr, "Cannot map the buffer at 0x%08x\n", FLEXSPI_TEST_BUFFER_ADDRESS);
+        return 1;
+    }
+
+    printf("Algorithm: %s\n", FlashDevice.DevName);
+    printf("Part: %s, fast reads up to %u MHz\n", part->name, part->fRead_MHz);
+    printf("%-8s %8s %10s %10s %9s %6s\n", "init", "ip_cmds", "probe_errs", "ms", "read_MHz", "dummy");
+
+    // Blank device: the reference cannot tell read points apart, Init keeps the configured one
+    read_tune_result_t blank;
+    bool pass = test_init(&blank) && (config.ipcmdSerialClkFreq == 0);
+    flexspi_nor_config_t baseConfig = config;
+    test_print("blank", &blank, pass);
+    int failures = pass ? 0 : 1;
+
+    uint32_t seed = 0x12345678u;
+    for (uint32_t i = 0; i < size + 4096u; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        if (i < size)
+        {
+            s_nor->array[i] = (uint8_t)(seed >> 16);
+        }
+        else
+        {
+            s_buffer[i] = (uint8_t)(seed >> 16);
+        }
+    }
+
+    // Data at the start of the device: Init tunes, within the limit of the part and not below the configured clock
+    read_tune_result_t tuned;
+    pass = test_init(&tuned) && (tuned.freq >= blank.freq) && (tuned.sckHz >= blank.sckHz) &&
+           ((part->fRead_MHz == 0) || (tuned.sckHz <= part->fRead_MHz * 1000000u));
+    test_print("tune", &tuned, pass);
+    failures += pass ? 0 : 1;
+
+    // Next Init of the download: the cached result is checked with one read
+    read_tune_result_t cached;
+    pass = test_init(&cached) && (cached.freq == tuned.freq) && (cached.dummyCycles == tuned.dummyCycles) &&
+           (cached.ipCmds <= tuned.ipCmds) && (cached.probeErrors == 0);
+    test_print("cached", &cached, pass);
+    failures += pass ? 0 : 1;
+
+    // Cache overwritten by the application between two Inits: its CRC32 no longer matches, Init probes and tunes again
+    if (CONFIG_CACHE_ADDRESS)
+    {
+        flexspi_nor_config_cache_t *cache = (flexspi_nor_config_cache_t *)CONFIG_CACHE_ADDRESS;
+        // No tuning result when the configured clock is already the limit
+        bool isTuneCached = (cache->tuneTag == FLEXSPI_NOR_TUNE_TAG);
+        cache->config.memConfig.lookupTable[NOR_CMD_LUT_SEQ_IDX_READ * 4] ^= 0xFFu;
+
+        read_tune_result_t stale;
+        pass = test_init(&stale) && (stale.freq == tuned.freq) && (stale.dummyCycles == tuned.dummyCycles) &&
+               (stale.ipCmds > cached.ipCmds) && (cache->tag == FLEXSPI_NOR_CONFIG_CACHE_TAG) &&
+               ((cache->tuneTag == FLEXSPI_NOR_TUNE_TAG) == isTuneCached);
+        test_print("stale", &stale, pass);
+        failures += pass ? 0 : 1;
+    }
+
+    // Config block erased and cache lost: the reference also covers the IVT, vectors and code 4KB apart
+    if (CONFIG_CACHE_ADDRESS)
+    {
+        flexspi_nor_config_cache_t *cache = (flexspi_nor_config_cache_t *)CONFIG_CACHE_ADDRESS;
+        cache->crc32 ^= 1u;
+        memset(s_nor->array, 0xFF, 512);
+
+        read_tune_result_t erased;
+        pass = test_init(&erased) && (erased.freq == tuned.freq) && (erased.dummyCycles == tuned.dummyCycles);
+        test_print("erased", &erased, pass);
+        failures += pass ? 0 : 1;
+    }
+
+    // One clock step of margin: the step above the tuned one is a faster clock that reads back too
+    if (tuned.freq > blank.freq)
+    {
+        uint64_t marginPs = 0;
+        flexspi_nor_config_t marginConfig = config;
+        marginConfig.memConfig.serialClkFreq++;
+        pass = test_read(&marginConfig, size, &marginPs);
+        uint32_t marginHz = test_get_serial_root_clock(FLEXSPI_TEST_INSTANCE);
+        if (marginConfig.memConfig.controllerMiscOption & FLEXSPI_BITMASK(kFlexSpiMiscOffset_DdrModeEnable))
+        {
+            marginHz /= 2u;
+        }
+        pass = pass && (marginHz > tuned.sckHz);
+        printf("read at the step above the tuned one: %.3f MHz %s\n", marginHz / 1000000.0, pass ? "" : "FAIL");
+        failures += pass ? 0 : 1;
+    }
+
+    // IP reads at the configured and the tuned clock
+    uint64_t basePs  = 0;
+    uint64_t tunedPs = 0;
+    flexspi_nor_config_t tunedConfig = config;
+    pass = test_read(&baseConfig, size, &basePs) && test_read(&config, size, &tunedPs) && (tunedPs <= basePs);
+    printf("read %u bytes: %.3f ms at %.3f MHz, %.3f ms at %.3f MHz, %.2fx %s\n", size,
+           (double)basePs / FLEXSPI_EMU_PS_PER_MS, blank.sckHz / 1000000.0, (double)tunedPs / FLEXSPI_EMU_PS_PER_MS,
+           tuned.sckHz / 1000000.0, tunedPs ? (double)basePs / tunedPs : 0.0, pass ? "" : "FAIL");
+    failures += pass ? 0 : 1;
+
+    // Program and erase switch back to the configured clock, which costs the clock changes around each command
+    basePs  = 0;
+    tunedPs = 0;
+    pass    = (memcmp(&tunedConfig, &config, sizeof(config)) == 0) && test_program(&baseConfig, size, &basePs) &&
+           test_program(&config, size, &tunedPs);
+    printf("erase and program %u bytes: %.3f ms at the configured point, %.3f ms at the tuned one %s\n",
+           config.sectorSize, (double)basePs / FLEXSPI_EMU_PS_PER_MS, (double)tunedPs / FLEXSPI_EMU_PS_PER_MS,
+           pass ? "" : "FAIL");
+    failures += pass ? 0 : 1;
+
+    UnInit(2);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2019 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "fsl_flexspi_trace.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Offsets in the flexspi_trace_t dump, which may come from a build with other FLEXSPI_TRACE_ENTRIES
+enum
+{
+    kTrace_HeaderSize     = 24,
+    kTrace_PhaseStatsSize = 24 + 4 * FLEXSPI_TRACE_BUCKETS,
+    kTrace_EntrySize      = 16,
+};
+
+// Same layout as the target, where uint64_t is 8 byte aligned as well
+_Static_assert(offsetof(flexspi_trace_t, phases) == kTrace_HeaderSize, "flexspi_trace_t header");
+_Static_assert(sizeof(flexspi_trace_phase_stats_t) == kTrace_PhaseStatsSize, "flexspi_trace_phase_stats_t");
+_Static_assert(sizeof(flexspi_trace_entry_t) == kTrace_EntrySize, "flexspi_trace_entry_t");
+
+//!@brief Width of the histogram bars
+#define TRACE_BAR_WIDTH (40u)
+
+//!@brief Phase stats decoded from the dump
+typedef struct _trace_phase
+{
+    uint64_t totalCycles;
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t buckets[FLEXSPI_TRACE_BUCKETS];
+} trace_phase_t;
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables
+////////////////////////////////////////////////////////////////////////////////
+
+//!@brief Names of flexspi_trace_phase_t
+static const char *const s_phaseNames[] = {
+    "ClockSwitch", "WriteEnable", "FifoFill", "FifoDrain", "BusyPoll", "CacheClear", "Init", "EraseSector", "ProgramPage",
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t get_le32(const uint8_t *src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+static uint32_t get_le16(const uint8_t *src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8);
+}
+
+static const char *get_phase_name(uint32_t phase)
+{
+    return (phase < sizeof(s_phaseNames) / sizeof(s_phaseNames[0])) ? s_phaseNames[phase] : "?";
+}
+
+static double cycles_to_us(uint64_t cycles, uint32_t coreClockHz)
+{
+    return (double)cycles * 1000000.0 / coreClockHz;
+}
+
+static double delta_to_us(int32_t cycles, uint32_t coreClockHz)
+{
+    return (double)cycles * 1000000.0 / coreClockHz;
+}
+
+static uint8_t *read_file(const char *path, uint32_t *size)
+{
+    FILE *file    = fopen(path, "rb");
+    uint8_t *data = NULL;
+    long length;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    if ((fseek(file, 0, SEEK_END) == 0) && ((length = ftell(file)) > 0) && (fseek(file, 0, SEEK_SET) == 0))
+    {
+        data = (uint8_t *)malloc((size_t)length);
+        if ((data != NULL) && (fread(data, 1, (size_t)length, file) != (size_t)length))
+        {
+            free(data);
+            data = NULL;
+        }
+        *size = (data != NULL) ? (uint32_t)length : 0;
+    }
+    fclose(file);
+    return data;
+}
+
+// First word aligned trace in a RAM dump, its size is checked against the counts of its header
+static const uint8_t *find_trace(const uint8_t *data, uint32_t size)
+{
+    for (uint32_t offset = 0; offset + kTrace_HeaderSize <= size; offset += 4)
+    {
+        const uint8_t *trace = &data[offset];
+        if ((get_le32(&trace[0]) != FLEXSPI_TRACE_TAG) || (get_le32(&trace[4]) != FLEXSPI_TRACE_VERSION))
+        {
+            continue;
+        }
+        uint64_t bytes = kTrace_HeaderSize + (uint64_t)get_le16(&trace[12]) * kTrace_PhaseStatsSize +
+                         (uint64_t)get_le16(&trace[14]) * kTrace_EntrySize;
+        if (bytes <= size - offset)
+        {
+            return trace;
+        }
+    }
+    return NULL;
+}
+
+static void get_phase(const uint8_t *trace, uint32_t phase, trace_phase_t *stats)
+{
+    const uint8_t *src = &trace[kTrace_HeaderSize + phase * kTrace_PhaseStatsSize];
+
+    stats->totalCycles = get_le32(&src[0]) | ((uint64_t)get_le32(&src[4]) << 32);
+    stats->count       = get_le32(&src[8]);
+    stats->minCycles   = get_le32(&src[12]);
+    stats->maxCycles   = get_le32(&src[16]);
+    for (uint32_t i = 0; i < FLEXSPI_TRACE_BUCKETS; i++)
+    {
+        stats->buckets[i] = get_le32(&src[24 + 4 * i]);
+    }
+}
+
+static void print_summary(const uint8_t *trace, uint32_t phaseCount, uint32_t coreClockHz)
+{
+    printf("%-12s %9s %12s %10s %10s %10s\n", "phase", "count", "total_ms", "min_us", "avg_us", "max_us");
+    for (uint32_t phase = 0; phase < phaseCount; phase++)
+    {
+        trace_phase_t stats;
+        get_phase(trace, phase, &stats);
+        if (stats.count == 0)
+        {
+            continue;
+        }
+        printf("%-12s %9u %12.3f %10.3f %10.3f %10.3f\n", get_phase_name(phase), stats.count,
+               cycles_to_us(stats.totalCycles, coreClockHz) / 1000.0, cycles_to_us(stats.minCycles, coreClockHz),
+               cycles_to_us(stats.totalCycles, coreClockHz) / stats.count, cycles_to_us(stats.maxCycles, coreClockHz));
+    }
+}
+
+static void print_histograms(const uint8_t *trace, uint32_t phaseCount, uint32_t coreClockHz)
+{
+    for (uint32_t phase = 0; phase < phaseCount; phase++)
+    {
+        trace_phase_t stats;
+        uint32_t peak = 0;
+
+        get_phase(trace, phase, &stats);
+        if (stats.count == 0)
+        {
+            continue;
+        }
+        for (uint32_t i = 0; i < FLEXSPI_TRACE_BUCKETS; i++)
+        {
+            peak = (stats.buckets[i] > peak) ? stats.buckets[i] : peak;
+        }
+
+        printf("\n%s, %u in us\n", get_phase_name(phase), stats.count);
+        for (uint32_t i = 0; i < FLEXSPI_TRACE_BUCKETS; i++)
+        {
+            uint32_t width;
+            if (stats.buckets[i] == 0)
+            {
+                continue;
+            }
+            width = (uint32_t)(((uint64_t)stats.buckets[i] * TRACE_BAR_WIDTH + peak - 1) / peak);
+            printf("  %12.3f - %-12.3f %9u ", cycles_to_us(i ? (1ull << i) : 0, coreClockHz),
+                   cycles_to_us(1ull << (i + 1), coreClockHz), stats.buckets[i]);
+            for (uint32_t bar = 0; bar < width; bar++)
+            {
+                putchar('#');
+            }
+            putchar('\n');
+        }
+    }
+}
+
+// Ring entries from the oldest one, start times relative to it. Entries are recorded when phases end, so a phase
+// that encloses others starts before them
+static void print_entries(const uint8_t *trace, uint32_t phaseCount, uint32_t entryCount, uint32_t coreClockHz,
+                          uint32_t limit)
+{
+    const uint8_t *entries = &trace[kTrace_HeaderSize + phaseCount * kTrace_PhaseStatsSize];
+    uint32_t writeIndex    = get_le32(&trace[16]);
+    uint32_t count         = (writeIndex < entryCount) ? writeIndex : entryCount;
+    uint32_t first;
+
+    if ((limit != 0) && (limit < count))
+    {
+        count = limit;
+    }
+    first = writeIndex - count;
+
+    printf("\n%-10s %12s %-12s %12s %10s\n", "index", "start_us", "phase", "us", "bytes");
+    uint32_t origin = get_le32(&entries[(first % entryCount) * kTrace_EntrySize]);
+    for (uint32_t index = first; index != writeIndex; index++)
+    {
+        const uint8_t *entry = &entries[(index % entryCount) * kTrace_EntrySize];
+        printf("%-10u %12.3f %-12s %12.3f %10u\n", index, delta_to_us((int32_t)(get_le32(&entry[0]) - origin), coreClockHz),
+               get_phase_name(get_le32(&entry[8])), cycles_to_us(get_le32(&entry[4]), coreClockHz),
+               get_le32(&entry[12]));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t coreClockHz = 0;
+    uint32_t entryLimit  = 0;
+    bool printEntries    = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:e:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'c':
+                coreClockHz = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'e':
+                printEntries = true;
+                entryLimit   = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                optind = argc + 1;
+                break;
+        }
+    }
+    if (optind != argc - 1)
+    {
+        printf("Usage: %s [-c core_clock_hz] [-e entries] dump.bin\n", argv[0]);
+        printf("  -c hz     core clock the cycles count, default the one the trace recorded\n");
+        printf("  -e count  also print the last count phases of the ring, 0 for all it holds\n");
+        return 2;
+    }
+
+    uint32_t size = 0;
+    uint8_t *data = read_file(argv[optind], &size);
+    const uint8_t *trace = (data != NULL) ? find_trace(data, size) : NULL;
+    if (trace == NULL)
+    {
+        fprintf(stderr, "No trace in %s\n", argv[optind]);
+        free(data);
+        return 1;
+    }
+
+    uint32_t phaseCount = get_le16(&trace[12]);
+    uint32_t entryCount = get_le16(&trace[14]);
+    if (coreClockHz == 0)
+    {
+        coreClockHz = get_le32(&trace[8]);
+    }
+    if (coreClockHz == 0)
+    {
+        fprintf(stderr, "The trace has no core clock, give it with -c\n");
+        free(data);
+        return 1;
+    }
+
+    printf("Trace at 0x%x of %s, core clock %u Hz, %u phases recorded, ring of %u\n", (uint32_t)(trace - data),
+           argv[optind], coreClockHz, get_le32(&trace[16]), entryCount);
+    print_summary(trace, phaseCount, coreClockHz);
+    print_histograms(trace, phaseCount, coreClockHz);
+    if (printEntries && entryCount)
+    {
+        print_entries(trace, phaseCount, entryCount, coreClockHz, entryLimit);
+    }
+
+    free(data);
+    return 0;
+}